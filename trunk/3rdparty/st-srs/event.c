@@ -48,6 +48,12 @@
 #ifdef MD_HAVE_EPOLL
 #include <sys/epoll.h>
 #endif
+#ifdef MD_HAVE_IO_URING
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
 
 // Global stat.
 #if defined(DEBUG) && defined(DEBUG_STATS)
@@ -147,6 +153,70 @@ static __thread struct _st_epolldata {
 
 #endif  /* MD_HAVE_EPOLL */
 
+
+#ifdef MD_HAVE_IO_URING
+typedef struct _uring_fd_data {
+    int rd_ref_cnt;
+    int wr_ref_cnt;
+    int ex_ref_cnt;
+    int revents;
+    /* The events of the pending poll SQE, zero if not armed. */
+    int armed;
+    /* The generation of the poll SQE, to drop the stale completions. */
+    unsigned int gen;
+} _uring_fd_data_t;
+
+static __thread struct _st_uringdata {
+    _uring_fd_data_t *fd_data;
+    int fd_data_size;
+    /* The fds fired in current dispatch, which will be armed again. */
+    int *fired;
+    int fired_size;
+    int fired_cnt;
+    int ring_fd;
+    /* The submission queue, mapped from kernel. */
+    void *sq_ring;
+    size_t sq_ring_size;
+    unsigned *sq_khead;
+    unsigned *sq_ktail;
+    unsigned *sq_kmask;
+    unsigned *sq_array;
+    unsigned sq_entries;
+    struct io_uring_sqe *sqes;
+    size_t sqes_size;
+    /* The completion queue, might share the mapping with the submission queue. */
+    void *cq_ring;
+    size_t cq_ring_size;
+    unsigned *cq_khead;
+    unsigned *cq_ktail;
+    unsigned *cq_kmask;
+    struct io_uring_cqe *cqes;
+} *_st_uring_data;
+
+#ifndef ST_URING_ENTRIES
+    /* Not a limit, the SQEs are submitted when the ring is full */
+    #define ST_URING_ENTRIES 4096
+#endif
+
+/* The user data of the POLL_REMOVE SQE, whose completion is ignored. */
+#define ST_URING_REMOVE_TAG      0xffffffffffffffffULL
+
+#define _ST_URING_READ_CNT(fd)   (_st_uring_data->fd_data[fd].rd_ref_cnt)
+#define _ST_URING_WRITE_CNT(fd)  (_st_uring_data->fd_data[fd].wr_ref_cnt)
+#define _ST_URING_EXCEP_CNT(fd)  (_st_uring_data->fd_data[fd].ex_ref_cnt)
+#define _ST_URING_REVENTS(fd)    (_st_uring_data->fd_data[fd].revents)
+#define _ST_URING_ARMED(fd)      (_st_uring_data->fd_data[fd].armed)
+#define _ST_URING_GEN(fd)        (_st_uring_data->fd_data[fd].gen)
+#define _ST_URING_USER_DATA(fd)  (((__u64)_ST_URING_GEN(fd) << 32) | (__u32)(fd))
+
+#define _ST_URING_READ_BIT(fd)   (_ST_URING_READ_CNT(fd) ? POLLIN : 0)
+#define _ST_URING_WRITE_BIT(fd)  (_ST_URING_WRITE_CNT(fd) ? POLLOUT : 0)
+#define _ST_URING_EXCEP_BIT(fd)  (_ST_URING_EXCEP_CNT(fd) ? POLLPRI : 0)
+#define _ST_URING_EVENTS(fd) \
+    (_ST_URING_READ_BIT(fd)|_ST_URING_WRITE_BIT(fd)|_ST_URING_EXCEP_BIT(fd))
+
+#endif  /* MD_HAVE_IO_URING */
+
 __thread _st_eventsys_t *_st_eventsys = NULL;
 
 
@@ -1230,6 +1300,542 @@ static _st_eventsys_t _st_epoll_eventsys = {
 #endif  /* MD_HAVE_EPOLL */
 
 
+#ifdef MD_HAVE_IO_URING
+/*****************************************
+ * io_uring event system
+ *
+ * Each interested fd has a one-shot IORING_OP_POLL_ADD in the ring. The SQEs to arm, re-arm and remove the
+ * polls are queued in the submission ring, then submitted in batch together with waiting for completions,
+ * by a single io_uring_enter in dispatch, so there is no epoll_ctl for each fired fd. The completions are
+ * reaped in batch to wake the threads on the I/O queue, then the I/O is done by the nonblocking syscalls.
+ */
+ST_HIDDEN int _st_uring_setup(unsigned entries, struct io_uring_params *p)
+{
+    return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+ST_HIDDEN int _st_uring_enter(unsigned to_submit, unsigned min_complete, unsigned flags, void *arg, size_t argsz)
+{
+    return (int) syscall(__NR_io_uring_enter, _st_uring_data->ring_fd, to_submit, min_complete, flags, arg, argsz);
+}
+
+ST_HIDDEN unsigned _st_uring_sq_pending(void)
+{
+    return *_st_uring_data->sq_ktail - __atomic_load_n(_st_uring_data->sq_khead, __ATOMIC_ACQUIRE);
+}
+
+ST_HIDDEN int _st_uring_init(void)
+{
+    struct io_uring_params p;
+    unsigned entries = ST_URING_ENTRIES;
+    size_t size;
+    int fdlim;
+    int err = 0;
+    int rv = 0;
+
+    _st_uring_data = (struct _st_uringdata *) calloc(1, sizeof(*_st_uring_data));
+    if (!_st_uring_data)
+        return -1;
+    _st_uring_data->ring_fd = -1;
+
+    /*
+     * The ring might be limited by RLIMIT_MEMLOCK for old kernels, so try a smaller one. The params must be zero
+     * for each setup, because the kernel rejects garbage in resv, and honors any flags such as IORING_SETUP_SQPOLL
+     * or IORING_SETUP_R_DISABLED, even after a failed setup.
+     */
+    for (;;) {
+        memset(&p, 0, sizeof(p));
+        if ((_st_uring_data->ring_fd = _st_uring_setup(entries, &p)) >= 0 || errno != ENOMEM || entries <= 64)
+            break;
+        entries >>= 1;
+    }
+    if (_st_uring_data->ring_fd < 0) {
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+    fcntl(_st_uring_data->ring_fd, F_SETFD, FD_CLOEXEC);
+
+    /* Map the rings, which share one mapping if supported. */
+    _st_uring_data->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    _st_uring_data->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        size = _st_uring_data->sq_ring_size;
+        if (size < _st_uring_data->cq_ring_size)
+            size = _st_uring_data->cq_ring_size;
+        _st_uring_data->sq_ring_size = _st_uring_data->cq_ring_size = size;
+    }
+
+    _st_uring_data->sq_ring = mmap(NULL, _st_uring_data->sq_ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, _st_uring_data->ring_fd, IORING_OFF_SQ_RING);
+    if (_st_uring_data->sq_ring == MAP_FAILED) {
+        _st_uring_data->sq_ring = NULL;
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        _st_uring_data->cq_ring = _st_uring_data->sq_ring;
+    } else {
+        _st_uring_data->cq_ring = mmap(NULL, _st_uring_data->cq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, _st_uring_data->ring_fd, IORING_OFF_CQ_RING);
+        if (_st_uring_data->cq_ring == MAP_FAILED) {
+            _st_uring_data->cq_ring = NULL;
+            err = errno;
+            rv = -1;
+            goto cleanup_uring;
+        }
+    }
+
+    _st_uring_data->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    _st_uring_data->sqes = (struct io_uring_sqe *)mmap(NULL, _st_uring_data->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, _st_uring_data->ring_fd, IORING_OFF_SQES);
+    if (_st_uring_data->sqes == MAP_FAILED) {
+        _st_uring_data->sqes = NULL;
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+
+    _st_uring_data->sq_khead = (unsigned *)((char *)_st_uring_data->sq_ring + p.sq_off.head);
+    _st_uring_data->sq_ktail = (unsigned *)((char *)_st_uring_data->sq_ring + p.sq_off.tail);
+    _st_uring_data->sq_kmask = (unsigned *)((char *)_st_uring_data->sq_ring + p.sq_off.ring_mask);
+    _st_uring_data->sq_array = (unsigned *)((char *)_st_uring_data->sq_ring + p.sq_off.array);
+    _st_uring_data->sq_entries = p.sq_entries;
+    _st_uring_data->cq_khead = (unsigned *)((char *)_st_uring_data->cq_ring + p.cq_off.head);
+    _st_uring_data->cq_ktail = (unsigned *)((char *)_st_uring_data->cq_ring + p.cq_off.tail);
+    _st_uring_data->cq_kmask = (unsigned *)((char *)_st_uring_data->cq_ring + p.cq_off.ring_mask);
+    _st_uring_data->cqes = (struct io_uring_cqe *)((char *)_st_uring_data->cq_ring + p.cq_off.cqes);
+
+    /* Allocate file descriptor data array */
+    fdlim = st_getfdlimit();
+    _st_uring_data->fd_data_size = (fdlim > 0 && fdlim < ST_URING_ENTRIES) ? fdlim : ST_URING_ENTRIES;
+    _st_uring_data->fd_data = (_uring_fd_data_t *)calloc(_st_uring_data->fd_data_size, sizeof(_uring_fd_data_t));
+    if (!_st_uring_data->fd_data) {
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+
+    /* Allocate the fired list */
+    _st_uring_data->fired_size = _st_uring_data->fd_data_size;
+    _st_uring_data->fired = (int *)malloc(_st_uring_data->fired_size * sizeof(int));
+    if (!_st_uring_data->fired) {
+        err = errno;
+        rv = -1;
+    }
+
+ cleanup_uring:
+    if (rv < 0) {
+        if (_st_uring_data->sqes)
+            munmap(_st_uring_data->sqes, _st_uring_data->sqes_size);
+        if (_st_uring_data->cq_ring && _st_uring_data->cq_ring != _st_uring_data->sq_ring)
+            munmap(_st_uring_data->cq_ring, _st_uring_data->cq_ring_size);
+        if (_st_uring_data->sq_ring)
+            munmap(_st_uring_data->sq_ring, _st_uring_data->sq_ring_size);
+        if (_st_uring_data->ring_fd >= 0)
+            close(_st_uring_data->ring_fd);
+        free(_st_uring_data->fd_data);
+        free(_st_uring_data->fired);
+        free(_st_uring_data);
+        _st_uring_data = NULL;
+        errno = err;
+    }
+
+    return rv;
+}
+
+ST_HIDDEN int _st_uring_fd_data_expand(int maxfd)
+{
+    _uring_fd_data_t *ptr;
+    int n = _st_uring_data->fd_data_size;
+
+    while (maxfd >= n)
+        n <<= 1;
+
+    ptr = (_uring_fd_data_t *)realloc(_st_uring_data->fd_data, n * sizeof(_uring_fd_data_t));
+    if (!ptr)
+        return -1;
+
+    memset(ptr + _st_uring_data->fd_data_size, 0, (n - _st_uring_data->fd_data_size) * sizeof(_uring_fd_data_t));
+
+    _st_uring_data->fd_data = ptr;
+    _st_uring_data->fd_data_size = n;
+
+    return 0;
+}
+
+ST_HIDDEN struct io_uring_sqe *_st_uring_get_sqe(void)
+{
+    struct io_uring_sqe *sqe;
+    unsigned tail, index;
+
+    /* Submit the queued SQEs if the ring is full, without waiting for completions. */
+    if (_st_uring_sq_pending() >= _st_uring_data->sq_entries) {
+        _st_uring_enter(_st_uring_sq_pending(), 0, 0, NULL, 0);
+        if (_st_uring_sq_pending() >= _st_uring_data->sq_entries) {
+            errno = EAGAIN;
+            return NULL;
+        }
+    }
+
+    tail = *_st_uring_data->sq_ktail;
+    index = tail & *_st_uring_data->sq_kmask;
+    sqe = &_st_uring_data->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    _st_uring_data->sq_array[index] = index;
+
+    /* The kernel only reads the tail in io_uring_enter, so it's safe to publish it before filling the SQE. */
+    __atomic_store_n(_st_uring_data->sq_ktail, tail + 1, __ATOMIC_RELEASE);
+
+    return sqe;
+}
+
+/*
+ * Arm the fd by a poll SQE for the events, or remove the poll if no events. The previous poll is removed
+ * before arming a new one, and its completion is dropped because of the stale generation.
+ */
+ST_HIDDEN int _st_uring_poll_arm(int fd, int events)
+{
+    struct io_uring_sqe *sqe;
+
+    if (_ST_URING_ARMED(fd)) {
+        if ((sqe = _st_uring_get_sqe()) == NULL)
+            return -1;
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = _ST_URING_USER_DATA(fd);
+        sqe->user_data = ST_URING_REMOVE_TAG;
+        _ST_URING_ARMED(fd) = 0;
+        _ST_URING_GEN(fd)++;
+    }
+
+    if (!events)
+        return 0;
+
+    if ((sqe = _st_uring_get_sqe()) == NULL)
+        return -1;
+    _ST_URING_GEN(fd)++;
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = fd;
+    sqe->poll32_events = events;
+    sqe->user_data = _ST_URING_USER_DATA(fd);
+    _ST_URING_ARMED(fd) = events;
+
+    return 0;
+}
+
+ST_HIDDEN void _st_uring_pollset_del(struct pollfd *pds, int npds)
+{
+    struct pollfd *pd;
+    struct pollfd *epd = pds + npds;
+    int events;
+
+    for (pd = pds; pd < epd; pd++) {
+        if (pd->events & POLLIN)
+            _ST_URING_READ_CNT(pd->fd)--;
+        if (pd->events & POLLOUT)
+            _ST_URING_WRITE_CNT(pd->fd)--;
+        if (pd->events & POLLPRI)
+            _ST_URING_EXCEP_CNT(pd->fd)--;
+
+        events = _ST_URING_EVENTS(pd->fd);
+        /*
+         * Only remove the poll when no events, because a poll for more events than we want is OK, which is
+         * armed again for the right events after it fires. Like epoll, the fired descriptors are handled in
+         * the dispatch, whose poll is already consumed.
+         */
+        if (!events && _ST_URING_ARMED(pd->fd) && _ST_URING_REVENTS(pd->fd) == 0) {
+            _st_uring_poll_arm(pd->fd, 0);
+        }
+    }
+}
+
+ST_HIDDEN int _st_uring_pollset_add(struct pollfd *pds, int npds)
+{
+    int i, fd;
+    int events;
+
+    /* Do as many checks as possible up front */
+    for (i = 0; i < npds; i++) {
+        fd = pds[i].fd;
+        if (fd < 0 || !pds[i].events ||
+            (pds[i].events & ~(POLLIN | POLLOUT | POLLPRI))) {
+            errno = EINVAL;
+            return -1;
+        }
+        if (fd >= _st_uring_data->fd_data_size && _st_uring_fd_data_expand(fd) < 0)
+            return -1;
+    }
+
+    for (i = 0; i < npds; i++) {
+        fd = pds[i].fd;
+
+        if (pds[i].events & POLLIN)
+            _ST_URING_READ_CNT(fd)++;
+        if (pds[i].events & POLLOUT)
+            _ST_URING_WRITE_CNT(fd)++;
+        if (pds[i].events & POLLPRI)
+            _ST_URING_EXCEP_CNT(fd)++;
+
+        events = _ST_URING_EVENTS(fd);
+        if ((events & ~_ST_URING_ARMED(fd)) && _st_uring_poll_arm(fd, events) < 0)
+            break;
+    }
+
+    if (i < npds) {
+        /* Error */
+        int err = errno;
+        /* Unroll the state */
+        _st_uring_pollset_del(pds, i + 1);
+        errno = err;
+        return -1;
+    }
+
+    return 0;
+}
+
+ST_HIDDEN void _st_uring_fired_expand(void)
+{
+    int *ptr;
+    int n = _st_uring_data->fired_size << 1;
+
+    ptr = (int *)realloc(_st_uring_data->fired, n * sizeof(int));
+    if (ptr) {
+        _st_uring_data->fired = ptr;
+        _st_uring_data->fired_size = n;
+    }
+}
+
+ST_HIDDEN void _st_uring_dispatch(void)
+{
+    st_utime_t min_timeout;
+    _st_clist_t *q;
+    _st_pollq_t *pq;
+    struct pollfd *pds, *epds;
+    struct io_uring_getevents_arg arg;
+    struct __kernel_timespec ts;
+    struct io_uring_cqe *cqe;
+    unsigned head, tail, min_complete;
+    int timeout, i, osfd, notify;
+    int events;
+    short revents;
+
+    #if defined(DEBUG) && defined(DEBUG_STATS)
+    ++_st_stat_epoll;
+    #endif
+
+    if (_ST_SLEEPQ == NULL) {
+        timeout = -1;
+    } else {
+        min_timeout = (_ST_SLEEPQ->due <= _ST_LAST_CLOCK) ? 0 : (_ST_SLEEPQ->due - _ST_LAST_CLOCK);
+        timeout = (int) (min_timeout / 1000);
+
+        // At least wait 1ms when <1ms, to avoid io_uring_enter spin loop.
+        if (timeout == 0) {
+            #if defined(DEBUG) && defined(DEBUG_STATS)
+            ++_st_stat_epoll_zero;
+            #endif
+
+            if (min_timeout > 0) {
+                #if defined(DEBUG) && defined(DEBUG_STATS)
+                ++_st_stat_epoll_shake;
+                #endif
+
+                timeout = 1;
+            }
+        }
+    }
+
+    /* Submit the queued SQEs and wait for completions, by one syscall */
+    memset(&arg, 0, sizeof(arg));
+    arg.sigmask_sz = _NSIG / 8;
+    if (timeout >= 0) {
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (timeout % 1000) * 1000000LL;
+        arg.ts = (__u64)(unsigned long)&ts;
+    }
+    min_complete = timeout ? 1 : 0;
+    _st_uring_enter(_st_uring_sq_pending(), min_complete, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+    /* Reap the completions in batch */
+    _st_uring_data->fired_cnt = 0;
+    head = *_st_uring_data->cq_khead;
+    tail = __atomic_load_n(_st_uring_data->cq_ktail, __ATOMIC_ACQUIRE);
+    for (; head != tail; head++) {
+        cqe = &_st_uring_data->cqes[head & *_st_uring_data->cq_kmask];
+        if (cqe->user_data == ST_URING_REMOVE_TAG)
+            continue;
+
+        /* Ignore the completions of the removed polls */
+        osfd = (int)(__u32)cqe->user_data;
+        if (osfd >= _st_uring_data->fd_data_size || !_ST_URING_ARMED(osfd) ||
+            (unsigned int)(cqe->user_data >> 32) != _ST_URING_GEN(osfd))
+            continue;
+
+        _ST_URING_ARMED(osfd) = 0;
+        /* Also set I/O bits on error, for example, the fd is closed by others */
+        _ST_URING_REVENTS(osfd) = (cqe->res < 0) ? POLLERR : cqe->res;
+        if (_ST_URING_REVENTS(osfd) & (POLLERR | POLLHUP))
+            _ST_URING_REVENTS(osfd) |= _ST_URING_EVENTS(osfd);
+        /* The fired fd must have the events, because empty revents never completes a poll */
+        if (!_ST_URING_REVENTS(osfd))
+            _ST_URING_REVENTS(osfd) = _ST_URING_EVENTS(osfd);
+
+        if (_st_uring_data->fired_cnt >= _st_uring_data->fired_size)
+            _st_uring_fired_expand();
+        if (_st_uring_data->fired_cnt < _st_uring_data->fired_size)
+            _st_uring_data->fired[_st_uring_data->fired_cnt++] = osfd;
+    }
+    __atomic_store_n(_st_uring_data->cq_khead, head, __ATOMIC_RELEASE);
+
+    #if defined(DEBUG) && defined(DEBUG_STATS)
+    if (_st_uring_data->fired_cnt <= 0) {
+        ++_st_stat_epoll_spin;
+    }
+    #endif
+
+    if (_st_uring_data->fired_cnt > 0) {
+        for (q = _ST_IOQ.next; q != &_ST_IOQ; q = q->next) {
+            pq = _ST_POLLQUEUE_PTR(q);
+            notify = 0;
+            epds = pq->pds + pq->npds;
+
+            for (pds = pq->pds; pds < epds; pds++) {
+                if (_ST_URING_REVENTS(pds->fd) == 0) {
+                    pds->revents = 0;
+                    continue;
+                }
+                osfd = pds->fd;
+                events = pds->events;
+                revents = 0;
+                if ((events & POLLIN) && (_ST_URING_REVENTS(osfd) & POLLIN))
+                    revents |= POLLIN;
+                if ((events & POLLOUT) && (_ST_URING_REVENTS(osfd) & POLLOUT))
+                    revents |= POLLOUT;
+                if ((events & POLLPRI) && (_ST_URING_REVENTS(osfd) & POLLPRI))
+                    revents |= POLLPRI;
+                if (_ST_URING_REVENTS(osfd) & POLLERR)
+                    revents |= POLLERR;
+                if (_ST_URING_REVENTS(osfd) & POLLHUP)
+                    revents |= POLLHUP;
+
+                pds->revents = revents;
+                if (revents) {
+                    notify = 1;
+                }
+            }
+            if (notify) {
+                ST_REMOVE_LINK(&pq->links);
+                pq->on_ioq = 0;
+                /*
+                 * Here we will only remove polls of descriptors that
+                 * didn't fire (see comments in _st_uring_pollset_del()).
+                 */
+                _st_uring_pollset_del(pq->pds, pq->npds);
+
+                if (pq->thread->flags & _ST_FL_ON_SLEEPQ)
+                    _ST_DEL_SLEEPQ(pq->thread);
+                pq->thread->state = _ST_ST_RUNNABLE;
+                _ST_ADD_RUNQ(pq->thread);
+            }
+        }
+
+        for (i = 0; i < _st_uring_data->fired_cnt; i++) {
+            /* Arm the descriptors that fired again, which are submitted by next dispatch */
+            osfd = _st_uring_data->fired[i];
+            _ST_URING_REVENTS(osfd) = 0;
+            events = _ST_URING_EVENTS(osfd);
+            if (events) {
+                _st_uring_poll_arm(osfd, events);
+            }
+        }
+    }
+}
+
+ST_HIDDEN int _st_uring_fd_new(int osfd)
+{
+    if (osfd >= _st_uring_data->fd_data_size && _st_uring_fd_data_expand(osfd) < 0)
+        return -1;
+
+    return 0;
+}
+
+ST_HIDDEN int _st_uring_fd_close(int osfd)
+{
+    if (_ST_URING_READ_CNT(osfd) || _ST_URING_WRITE_CNT(osfd) || _ST_URING_EXCEP_CNT(osfd)) {
+        errno = EBUSY;
+        return -1;
+    }
+
+    /*
+     * The poll holds a reference of the file, so we must remove it before close, or the socket is not
+     * released until next dispatch.
+     */
+    if (_ST_URING_ARMED(osfd)) {
+        _st_uring_poll_arm(osfd, 0);
+    }
+    if (_st_uring_sq_pending()) {
+        _st_uring_enter(_st_uring_sq_pending(), 0, 0, NULL, 0);
+    }
+
+    return 0;
+}
+
+ST_HIDDEN int _st_uring_fd_getlimit(void)
+{
+    /* zero means no specific limit */
+    return 0;
+}
+
+/*
+ * Check if io_uring is supported, which might be disabled by sysctl or seccomp. We require the kernel to
+ * wait with timeout by IORING_ENTER_EXT_ARG, and never drop completions, that is linux 5.11+.
+ */
+ST_HIDDEN int _st_uring_is_supported(void)
+{
+    struct io_uring_params p;
+    int fd;
+
+    memset(&p, 0, sizeof(p));
+    if ((fd = _st_uring_setup(2, &p)) < 0)
+        return 0;
+    close(fd);
+
+    return (p.features & IORING_FEAT_EXT_ARG) && (p.features & IORING_FEAT_NODROP);
+}
+
+ST_HIDDEN void _st_uring_destroy(void)
+{
+    munmap(_st_uring_data->sqes, _st_uring_data->sqes_size);
+    if (_st_uring_data->cq_ring != _st_uring_data->sq_ring)
+        munmap(_st_uring_data->cq_ring, _st_uring_data->cq_ring_size);
+    munmap(_st_uring_data->sq_ring, _st_uring_data->sq_ring_size);
+    if (_st_uring_data->ring_fd >= 0) {
+        close(_st_uring_data->ring_fd);
+    }
+    free(_st_uring_data->fd_data);
+    free(_st_uring_data->fired);
+    free(_st_uring_data);
+    _st_uring_data = NULL;
+}
+
+static _st_eventsys_t _st_uring_eventsys = {
+    "io_uring",
+    ST_EVENTSYS_ALT,
+    _st_uring_init,
+    _st_uring_dispatch,
+    _st_uring_pollset_add,
+    _st_uring_pollset_del,
+    _st_uring_fd_new,
+    _st_uring_fd_close,
+    _st_uring_fd_getlimit,
+    _st_uring_destroy
+};
+#endif  /* MD_HAVE_IO_URING */
+
+
 /*****************************************
  * Public functions
  */
@@ -1249,6 +1855,13 @@ int st_set_eventsys(int eventsys)
     }
 
     if (eventsys == ST_EVENTSYS_ALT) {
+#if defined (MD_HAVE_IO_URING)
+        /* Prefer io_uring if enabled at configure time, and fallback to epoll if not supported. */
+        if (_st_uring_is_supported()) {
+            _st_eventsys = &_st_uring_eventsys;
+            return 0;
+        }
+#endif
 #if defined (MD_HAVE_KQUEUE)
         _st_eventsys = &_st_kq_eventsys;
         return 0;
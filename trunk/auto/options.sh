@@ -117,6 +117,7 @@ SRS_EXTRA_FLAGS=
 # Performance optimize.
 SRS_NASM=YES
 SRS_SRTP_ASM=YES
+SRS_IO_URING=NO
 SRS_DEBUG=NO
 SRS_DEBUG_STATS=NO
 
@@ -193,6 +194,7 @@ Performance:                @see https://ossrs.net/lts/zh-cn/docs/v5/doc/perform
   --sanitizer-log=on|off    Whether hijack the log for libasan(asan). Default: $(value2switch $SRS_SANITIZER_LOG)
   --nasm=on|off             Whether build FFMPEG for RTC with nasm. Default: $(value2switch $SRS_NASM)
   --srtp-nasm=on|off        Whether build SRTP with ASM(openssl-asm), requires RTC and openssl-1.0.*. Default: $(value2switch $SRS_SRTP_ASM)
+  --io-uring=on|off         Whether use io_uring for ST event system, fallback to epoll if not supported. Default: $(value2switch $SRS_IO_URING)
 
 Toolchain options:
   --static=on|off           Whether add '-static' to link options. Default: $(value2switch $SRS_STATIC)
@@ -307,6 +309,7 @@ function parse_user_option() {
         --without-srtp-nasm)            SRS_SRTP_ASM=NO             ;;
         --with-srtp-nasm)               SRS_SRTP_ASM=YES            ;;
         --srtp-nasm)                    SRS_SRTP_ASM=$(switch2value $value) ;;
+        --io-uring)                     SRS_IO_URING=$(switch2value $value) ;;
 
         --without-nasm)                 SRS_NASM=NO                 ;;
         --with-nasm)                    SRS_NASM=YES                ;;
@@ -568,6 +571,11 @@ function apply_auto_options() {
         echo "Force single thread for cygwin64"
         SRS_SINGLE_THREAD=YES
     fi
+    # The io_uring is only available for linux.
+    if [[ $SRS_IO_URING == YES && $OS_IS_LINUX != YES ]]; then
+        echo "Disable io_uring for non-linux"
+        SRS_IO_URING=NO
+    fi
 
     # parse the jobs for make
     if [[ ! -z SRS_JOBS ]]; then
@@ -639,6 +647,7 @@ function regenerate_options() {
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --ffmpeg-opus=$(value2switch $SRS_FFMPEG_OPUS)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --nasm=$(value2switch $SRS_NASM)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --srtp-nasm=$(value2switch $SRS_SRTP_ASM)"
+    SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --io-uring=$(value2switch $SRS_IO_URING)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --clean=$(value2switch $SRS_CLEAN)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --gperf=$(value2switch $SRS_GPERF)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --gmc=$(value2switch $SRS_GPERF_MC)"
@@ -0,0 +1,6 @@
+LIBAVCODEC_MAJOR {
+    global:
+        av*;
+    local:
+        *;
+};
@@ -0,0 +1 @@
+#include "libavutil/reverse.c"
@@ -0,0 +1,7 @@
+LIBSWRESAMPLE_MAJOR {
+    global:
+        swr_*;
+        swresample_*;
+    local:
+        *;
+};
@@ -0,0 +1,93 @@
+// auto generated by configure
+#ifndef SRS_AUTO_HEADER_HPP
+#define SRS_AUTO_HEADER_HPP
+
+#define SRS_PACKAGER ""
+#define SRS_BUILD_TS "1792299683"
+#define SRS_BUILD_DATE "2026-10-18 05:01:23"
+#define SRS_UNAME "Linux vm 6.18.44-fc-v139 #1 SMP PREEMPT_DYNAMIC @0 x86_64 GNU/Linux"
+#define SRS_USER_CONFIGURE "--utest=on --sys-ssl=on --sanitizer=off --srt=off --nasm=off"
+#define SRS_CONFIGURE "--prefix=/usr/local/srs --config=conf/srs.conf --osx=off --hls=on --hds=off --dvr=on --ssl=on --https=on --ssl-1-0=off --ssl-local=off --sys-ssl=on --transcode=on --ingest=on --stat=on --http-callback=on --http-server=on --stream-converter=on --http-api=on --utest=on --cherrypy=off --srt=off --rtc=on --h265=off --gb28181=off --simulator=off --cxx11=on --cxx14=off --backtrace=on --ffmpeg-fit=on --ffmpeg-opus=off --nasm=off --srtp-nasm=off --clean=on --gperf=off --gmc=off --gmd=off --gmp=off --gcp=off --gprof=off --static=off --shared-st=off --shared-srt=off --shared-ffmpeg=off --log-verbose=off --log-info=off --log-trace=on --log-level_v2=on --gcov=off --apm=off --debug=off --debug-stats=off --cross-build=off --sanitizer=on --sanitizer-static=off --sanitizer-log=off --cygwin64=off --single-thread=off --generic-linux=off --cc=gcc --cxx=g++ --ar=ar --ld=ld --randlib=randlib"
+
+#undef SRS_HDS
+#define SRS_HDS_BOOL false
+#undef SRS_SRT
+#define SRS_SRT_BOOL false
+#define SRS_CXX11
+#define SRS_CXX11_BOOL true
+#undef SRS_CXX14
+#define SRS_CXX14_BOOL false
+#define SRS_BACKTRACE
+#define SRS_BACKTRACE_BOOL true
+#define SRS_RTC
+#define SRS_RTC_BOOL true
+#define SRS_FFMPEG_FIT
+#define SRS_FFMPEG_FIT_BOOL true
+#undef SRS_FFMPEG_OPUS
+#define SRS_FFMPEG_OPUS_BOOL false
+#undef SRS_H265
+#define SRS_H265_BOOL false
+#undef SRS_SIMULATOR
+#define SRS_SIMULATOR_BOOL false
+#define SRS_HTTPS
+#define SRS_HTTPS_BOOL true
+#undef SRS_GB28181
+#define SRS_GB28181_BOOL false
+#undef SRS_APM
+#define SRS_APM_BOOL false
+#define SRS_UTEST
+#define SRS_UTEST_BOOL true
+#define SRS_FFMPEG_STUB
+#define SRS_FFMPEG_STUB_BOOL true
+#undef SRS_GPERF
+#define SRS_GPERF_BOOL false
+#undef SRS_GPERF_MC
+#define SRS_GPERF_MC_BOOL false
+#undef SRS_GPERF_MD
+#define SRS_GPERF_MD_BOOL false
+#undef SRS_GPERF_MP
+#define SRS_GPERF_MP_BOOL false
+#undef SRS_GPERF_CP
+#define SRS_GPERF_CP_BOOL false
+#define SRS_SANITIZER
+#define SRS_SANITIZER_BOOL true
+#define SRS_SANITIZER_LOG
+#define SRS_SANITIZER_LOG_BOOL true
+#undef SRS_VERBOSE
+#define SRS_VERBOSE_BOOL false
+#undef SRS_INFO
+#define SRS_INFO_BOOL false
+#define SRS_TRACE
+#define SRS_TRACE_BOOL true
+#undef SRS_SINGLE_THREAD
+#define SRS_SINGLE_THREAD_BOOL false
+#define SRS_LOG_LEVEL_V2
+#define SRS_LOG_LEVEL_V2_BOOL true
+#undef SRS_CROSSBUILD
+#define SRS_CROSSBUILD_BOOL false
+#undef SRS_CYGWIN64
+#define SRS_CYGWIN64_BOOL false
+#undef SRS_OSX
+#define SRS_OSX_BOOL false
+#undef SRS_DEBUG
+#define SRS_DEBUG_BOOL false
+#undef SRS_DEBUG_STATS
+#define SRS_DEBUG_STATS_BOOL false
+
+#define SRS_PREFIX "/usr/local/srs"
+#define SRS_DEFAULT_CONFIG "conf/srs.conf"
+
+#define RTMP_SIG_SRS_AUTHORS "\
+Winlin<winlin@vip.126.com> \
+ZhaoWenjie<zhaowenjie@tal.com> \
+ShiWei<shiwei05@kuaishou.com> \
+XiaoZhihong<hondaxiao@tencent.com> \
+WuPengqiang<pengqiang.wpq@alibaba-inc.com> \
+XiaLixin<xialixin@kanzhun.com> \
+LiPeng<mozhan.lp@alibaba-inc.com> \
+ChenGuanghua<jinxue.cgh@alibaba-inc.com> \
+ChenHaibo<nmgchenhaibo@foxmail.com> \
+"
+
+#endif
+
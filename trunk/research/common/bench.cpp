@@ -0,0 +1,50 @@
+//
+// Copyright (c) 2013-2023 The SRS Authors
+//
+// SPDX-License-Identifier: MIT or MulanPSL-2.0
+//
+
+#include <bench.hpp>
+
+#include <sys/time.h>
+
+#include <srs_kernel_error.hpp>
+#include <srs_protocol_log.hpp>
+#include <srs_app_config.hpp>
+#include <srs_app_server.hpp>
+#include <srs_app_threads.hpp>
+
+// The global objects, which are defined by the main of SRS, see srs_main_server.cpp.
+ISrsLog* _srs_log = NULL;
+ISrsContext* _srs_context = NULL;
+SrsConfig* _srs_config = NULL;
+SrsServer* _srs_server = NULL;
+bool _srs_in_docker = false;
+bool _srs_config_by_env = false;
+const char* _srs_binary = NULL;
+
+srs_error_t srs_bench_initialize()
+{
+    srs_error_t err = srs_success;
+
+    if ((err = srs_global_initialize()) != srs_success) {
+        return srs_error_wrap(err, "init global");
+    }
+
+    // Never write log, which is not the cost to benchmark.
+    srs_freep(_srs_log);
+    _srs_log = new SrsConsoleLog(SrsLogLevelDisabled, false);
+
+    if ((err = SrsThreadPool::setup_thread_locals()) != srs_success) {
+        return srs_error_wrap(err, "init thread");
+    }
+
+    return err;
+}
+
+int64_t srs_bench_now_us()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
@@ -0,0 +1,20 @@
+//
+// Copyright (c) 2013-2023 The SRS Authors
+//
+// SPDX-License-Identifier: MIT or MulanPSL-2.0
+//
+
+#ifndef SRS_RESEARCH_BENCH_HPP
+#define SRS_RESEARCH_BENCH_HPP
+
+#include <srs_core.hpp>
+
+// The helpers for the benchmarks in research, which link the objects of SRS, see bench.mk.
+
+// Initialize the global objects of SRS like the utest, and disable the log.
+extern srs_error_t srs_bench_initialize();
+
+// Get the wall clock in us, for the elapsed time of benchmark.
+extern int64_t srs_bench_now_us();
+
+#endif
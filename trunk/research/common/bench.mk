@@ -0,0 +1,35 @@
+# The common Makefile of the benchmarks in research, which links the bench.cpp with the objects and libraries of
+# SRS server, except the main, so please build SRS first:
+#       (cd ../.. && ./configure && make)
+#       make && ./bench
+# Note that SRS is built with -O0 and the address sanitizer by default, so for the performance numbers, please
+# configure SRS by --sanitizer-log=off --extra-flags=-O2, then remove the -fsanitize=address and -static-libasan
+# from objs/Makefile, and make again.
+#
+# Usage, in the Makefile of benchmark:
+#       include ../common/bench.mk
+
+.PHONY: default clean
+
+default: bench
+
+SRS_HOME = ../..
+SRS_MAKEFILE = $(SRS_HOME)/objs/Makefile
+
+# The objects, libraries and link options of SRS server, from the rule of ./objs/srs in objs/Makefile.
+SRS_CXXFLAGS = $(shell sed -n 's/^CXXFLAGS = //p' $(SRS_MAKEFILE) 2>/dev/null)
+SRS_OBJS = $(patsubst ./%,$(SRS_HOME)/%,$(filter-out %/srs_main_server.o,$(shell sed -n 's/^\.\/objs\/srs: //p' $(SRS_MAKEFILE) 2>/dev/null)))
+SRS_LIBS = $(patsubst ./%,$(SRS_HOME)/%,$(shell sed -n '/^\.\/objs\/srs: /{n;s/.*-o \.\/objs\/srs //;s/[^ ]*\.o//g;p}' $(SRS_MAKEFILE) 2>/dev/null))
+SRS_INCS = -I$(SRS_HOME)/src/core -I$(SRS_HOME)/src/kernel -I$(SRS_HOME)/src/protocol -I$(SRS_HOME)/src/app \
+	-I$(SRS_HOME)/objs -I$(SRS_HOME)/objs/st -I$(SRS_HOME)/objs/srtp2/include -I$(SRS_HOME)/objs/ffmpeg/include \
+	-I../common
+
+bench: bench.cpp ../common/bench.cpp ../common/bench.hpp $(SRS_MAKEFILE) $(SRS_OBJS)
+	@echo "Build $@ with the objects of SRS"
+	@g++ $(SRS_CXXFLAGS) $(SRS_INCS) bench.cpp ../common/bench.cpp $(SRS_OBJS) $(SRS_LIBS) -o $@
+
+$(SRS_MAKEFILE):
+	@echo "Please build SRS first, by ./configure && make" && exit 1
+
+clean:
+	rm -f bench
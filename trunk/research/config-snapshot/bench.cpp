@@ -0,0 +1,122 @@
+/*
+# Compare the cost of config getter, which walks the directive tree and getenv, to the vhost snapshot lookup
+# by hash, see SrsVhostSnapshots.
+make && ./bench 500 1000000
+# The arguments are: vhosts, lookups.
+
+The getter is SrsConfig::get_reduce_sequence_header, which gets the env by srs_getenv then finds the vhost by
+get_vhost, and the publish and reduce_sequence_header directives. The snapshot is SrsConfig::get_vhost_snapshot.
+The vhosts are looked up randomly, and a few of them are not in config, which use the default vhost.
+*/
+#include <bench.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+using namespace std;
+
+#include <srs_kernel_error.hpp>
+#include <srs_kernel_file.hpp>
+#include <srs_app_config.hpp>
+
+// Write the config with vhosts to a temporary file, each vhost has some directives.
+srs_error_t create_config(int nn_vhosts, string filename, vector<string>& names)
+{
+    srs_error_t err = srs_success;
+
+    string conf = "listen 1935;\n";
+    for (int i = 0; i < nn_vhosts; i++) {
+        char name[64];
+        snprintf(name, sizeof(name), "vhost%d.ossrs.net", i);
+        names.push_back(name);
+
+        conf += string("vhost ") + name + " {\n";
+        conf += "    play { gop_cache on; }\n";
+        conf += "    hls { enabled on; }\n";
+        conf += string("    publish { reduce_sequence_header ") + (i % 2 ? "on" : "off") + "; }\n";
+        conf += "}\n";
+    }
+    conf += "vhost __defaultVhost__ {\n}\n";
+
+    SrsFileWriter writer;
+    if ((err = writer.open(filename)) != srs_success) {
+        return srs_error_wrap(err, "open %s", filename.c_str());
+    }
+    if ((err = writer.write((void*)conf.data(), conf.length(), NULL)) != srs_success) {
+        return srs_error_wrap(err, "write %s", filename.c_str());
+    }
+
+    return err;
+}
+
+int main(int argc, char** argv)
+{
+    srs_error_t err = srs_success;
+
+    int nn_vhosts = argc > 1 ? atoi(argv[1]) : 500;
+    int lookups = argc > 2 ? atoi(argv[2]) : 1000000;
+    if (nn_vhosts <= 0 || lookups <= 0) {
+        printf("Usage: %s [vhosts] [lookups]\n", argv[0]);
+        exit(-1);
+    }
+
+    if ((err = srs_bench_initialize()) != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+
+    // Parse the config from file, which is removed after parsed.
+    vector<string> names;
+    string filename = "/tmp/srs-bench-config-snapshot.conf";
+    SrsConfig conf;
+    if ((err = create_config(nn_vhosts, filename, names)) == srs_success) {
+        err = conf.parse_file(filename.c_str());
+    }
+    ::unlink(filename.c_str());
+    if (err != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+    names.push_back("not.exists.ossrs.net");
+
+    // The random vhosts to lookup.
+    vector<string> keys;
+    srand(0);
+    for (int i = 0; i < 4096; i++) {
+        keys.push_back(names.at(rand() % names.size()));
+    }
+
+    printf("vhosts=%d, lookups=%d\n", nn_vhosts, lookups);
+
+    // The snapshots are built by the first lookup.
+    int64_t starttime = srs_bench_now_us();
+    conf.get_vhost_snapshot(names.at(0));
+    int64_t build = srs_bench_now_us() - starttime;
+    printf("build:    %.1fms\n", build / 1000.0);
+
+    int v0 = 0;
+    starttime = srs_bench_now_us();
+    for (int i = 0; i < lookups; i++) {
+        v0 += conf.get_reduce_sequence_header(keys[i & 4095]);
+    }
+    int64_t d0 = srs_bench_now_us() - starttime;
+    printf("getter:   %.1fms, %.1fns/op\n", d0 / 1000.0, d0 * 1000.0 / lookups);
+
+    int v1 = 0;
+    starttime = srs_bench_now_us();
+    for (int i = 0; i < lookups; i++) {
+        v1 += conf.get_vhost_snapshot(keys[i & 4095])->reduce_sequence_header;
+    }
+    int64_t d1 = srs_bench_now_us() - starttime;
+    printf("snapshot: %.1fms, %.1fns/op, speedup %.1fx\n", d1 / 1000.0, d1 * 1000.0 / lookups, (double)d0 / d1);
+
+    if (v0 != v1) {
+        printf("Failed, getter %d != snapshot %d\n", v0, v1);
+        return -1;
+    }
+
+    return 0;
+}
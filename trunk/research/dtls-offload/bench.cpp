@@ -0,0 +1,262 @@
+/*
+# Compare the stall of media thread in a join storm, when DTLS handshakes run inline or by worker threads, see
+# SrsAsyncDtlsManager.
+make && ./bench 2000 0 && ./bench 2000 2
+# The arguments are: joins, dtls threads. Set dtls threads to 0 to do handshakes in media thread.
+
+All sessions join at once, like a class of students pressing play. Each session is a pair of DTLS 1.2 SSL with
+ECDSA P-256 certificate, connected by memory BIOs, and the flights are passed as messages like the UDP packets.
+The clients, which are the browsers, run in their own thread. The media thread ticks every 1ms to forward RTP,
+and handles the flights from clients, by SSL_do_handshake inline or by posting them to the workers. We print the
+join rate, and the stall of media thread, that is the max and p99 delay of its ticks.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/x509.h>
+
+int64_t now_us()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+// The blocking queue of flights, for the client thread and workers.
+struct Session;
+struct Queue
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    deque<Session*> items;
+    Queue() {
+        pthread_mutex_init(&lock, NULL);
+        pthread_cond_init(&cond, NULL);
+    }
+    void push(Session* s) {
+        pthread_mutex_lock(&lock);
+        items.push_back(s);
+        pthread_cond_signal(&cond);
+        pthread_mutex_unlock(&lock);
+    }
+    Session* pop(bool wait) {
+        pthread_mutex_lock(&lock);
+        while (wait && items.empty()) {
+            pthread_cond_wait(&cond, &lock);
+        }
+        Session* s = NULL;
+        if (!items.empty()) {
+            s = items.front();
+            items.pop_front();
+        }
+        pthread_mutex_unlock(&lock);
+        return s;
+    }
+};
+
+// The flights to client, from server, and the handshakes done by workers.
+Queue to_client, to_server, to_worker, from_worker;
+
+struct Session
+{
+    SSL* ssl[2];
+    BIO* in[2];
+    BIO* out[2];
+    // The flight to deliver, from peer.
+    string flight;
+    bool done[2];
+    // Whether the join is counted by media thread.
+    bool joined;
+};
+
+// Feed the flight to the SSL, do handshake, and return the flight to peer.
+void handshake(Session* s, int i)
+{
+    if (!s->flight.empty()) {
+        BIO_reset(s->in[i]);
+        BIO_write(s->in[i], s->flight.data(), (int)s->flight.size());
+    }
+    BIO_reset(s->out[i]);
+
+    int r0 = SSL_do_handshake(s->ssl[i]);
+    int r1 = SSL_get_error(s->ssl[i], r0);
+    if (r0 < 0 && r1 != SSL_ERROR_WANT_READ && r1 != SSL_ERROR_WANT_WRITE) {
+        printf("Handshake failed, side=%d, r0=%d, r1=%d\n", i, r0, r1);
+        exit(-1);
+    }
+    s->done[i] = (r0 == 1);
+
+    char* data = NULL;
+    int size = (int)BIO_get_mem_data(s->out[i], &data);
+    s->flight.assign(data, size);
+}
+
+void* client_thread(void* /*arg*/)
+{
+    while (true) {
+        Session* s = to_client.pop(true);
+        handshake(s, 1);
+        if (!s->flight.empty()) {
+            to_server.push(s);
+        }
+    }
+    return NULL;
+}
+
+void* worker_thread(void* /*arg*/)
+{
+    while (true) {
+        Session* s = to_worker.pop(true);
+        handshake(s, 0);
+        from_worker.push(s);
+    }
+    return NULL;
+}
+
+int verify_callback(int /*preverify_ok*/, X509_STORE_CTX* /*ctx*/)
+{
+    return 1;
+}
+
+// The flights are never lost, so disable the ARQ, or the retransmitted flights confuse the peer in the storm.
+unsigned int timer_callback(SSL* /*ssl*/, unsigned int /*previous_us*/)
+{
+    return 3600 * 1000000U;
+}
+
+SSL_CTX* build_ctx(bool server, X509* cert, EVP_PKEY* pkey)
+{
+    SSL_CTX* ctx = SSL_CTX_new(server ? DTLS_server_method() : DTLS_client_method());
+    SSL_CTX_set1_curves_list(ctx, "P-521:P-384:P-256");
+    SSL_CTX_use_certificate(ctx, cert);
+    SSL_CTX_use_PrivateKey(ctx, pkey);
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_CLIENT_ONCE, verify_callback);
+    SSL_CTX_set_read_ahead(ctx, 1);
+    SSL_CTX_set_tlsext_use_srtp(ctx, "SRTP_AES128_CM_SHA1_80");
+    return ctx;
+}
+
+int main(int argc, char** argv)
+{
+    int nn_joins = argc > 1 ? atoi(argv[1]) : 2000;
+    int nn_workers = argc > 2 ? atoi(argv[2]) : 0;
+    if (nn_joins <= 0 || nn_workers < 0) {
+        printf("Usage: %s [joins] [dtls threads]\n", argv[0]);
+        exit(-1);
+    }
+
+    // The ECDSA certificate, see SrsDtlsCertificate.
+    EVP_PKEY* pkey = EVP_EC_gen("prime256v1");
+    X509* cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_get_notBefore(cert), 0);
+    X509_gmtime_adj(X509_get_notAfter(cert), 365 * 24 * 3600);
+    X509_NAME_add_entry_by_txt(X509_get_subject_name(cert), "CN", MBSTRING_ASC, (const unsigned char*)"ossrs.net", -1, -1, 0);
+    X509_set_issuer_name(cert, X509_get_subject_name(cert));
+    X509_set_pubkey(cert, pkey);
+    X509_sign(cert, pkey, EVP_sha256());
+
+    SSL_CTX* sctx = build_ctx(true, cert, pkey);
+    SSL_CTX* cctx = build_ctx(false, cert, pkey);
+
+    vector<Session*> sessions;
+    for (int i = 0; i < nn_joins; i++) {
+        Session* s = new Session();
+        for (int j = 0; j < 2; j++) {
+            s->ssl[j] = SSL_new(j == 0 ? sctx : cctx);
+            s->in[j] = BIO_new(BIO_s_mem());
+            s->out[j] = BIO_new(BIO_s_mem());
+            SSL_set_bio(s->ssl[j], s->in[j], s->out[j]);
+            SSL_set_options(s->ssl[j], SSL_OP_NO_QUERY_MTU);
+            SSL_set_mtu(s->ssl[j], 1200);
+            DTLS_set_timer_cb(s->ssl[j], timer_callback);
+            s->done[j] = false;
+        }
+        SSL_set_accept_state(s->ssl[0]);
+        SSL_set_connect_state(s->ssl[1]);
+        s->joined = false;
+        sessions.push_back(s);
+    }
+
+    pthread_t trd;
+    pthread_create(&trd, NULL, client_thread, NULL);
+    for (int i = 0; i < nn_workers; i++) {
+        pthread_create(&trd, NULL, worker_thread, NULL);
+    }
+
+    printf("joins=%d, dtls threads=%d, mode=%s\n", nn_joins, nn_workers, nn_workers ? "offload" : "inline");
+
+    // All clients send ClientHello at once.
+    for (int i = 0; i < nn_joins; i++) {
+        to_client.push(sessions[i]);
+    }
+
+    // The media thread, which ticks every 1ms, and handles flights between ticks.
+    vector<int64_t> delays;
+    int nn_done = 0;
+    int64_t starttime = now_us();
+    int64_t tick = starttime;
+    while (nn_done < nn_joins) {
+        int64_t now = now_us();
+        if (now >= tick) {
+            delays.push_back(now - tick);
+            tick = now + 1000;
+        }
+
+        Session* s = NULL;
+        while ((s = from_worker.pop(false)) != NULL) {
+            if (s->done[0] && !s->joined) {
+                s->joined = true;
+                nn_done++;
+            }
+            if (!s->flight.empty()) {
+                to_client.push(s);
+            }
+        }
+
+        // Handle the flights until next tick, like the UDP listener coroutine.
+        while (now_us() < tick && (s = to_server.pop(false)) != NULL) {
+            if (nn_workers) {
+                to_worker.push(s);
+                continue;
+            }
+
+            handshake(s, 0);
+            if (s->done[0] && !s->joined) {
+                s->joined = true;
+                nn_done++;
+            }
+            if (!s->flight.empty()) {
+                to_client.push(s);
+            }
+        }
+
+        if (now_us() < tick) {
+            usleep(100);
+        }
+    }
+    int64_t duration = now_us() - starttime;
+
+    sort(delays.begin(), delays.end());
+    int64_t p99 = delays.empty() ? 0 : delays[(delays.size() - 1) * 99 / 100];
+    int64_t pmax = delays.empty() ? 0 : delays.back();
+
+    printf("%s: %.1fms, %.0f joins/s, ticks=%d, stall p99 %.2fms, max %.2fms\n", nn_workers ? "offload" : "inline",
+        duration / 1000.0, nn_joins * 1000000.0 / duration, (int)delays.size(), p99 / 1000.0, pmax / 1000.0);
+
+    return 0;
+}
+
@@ -0,0 +1,259 @@
+/*
+# Compare the throughput of HTTPS-FLV fan-out, encrypted by OpenSSL or by kernel(kTLS), see SrsSslConnection.
+make && ./bench 8 64
+# The arguments are: players, MB per player.
+
+The server does the TLS1.2 handshake with AES128-GCM by OpenSSL, then sends the FLV tags to each player one by
+one, which is the same as the player coroutines of SRS. For kTLS, the key is derived like srs_ssl_server_write_key,
+then setup by TCP_ULP and TLS_TX, and the server writes plaintext to socket. We measure the CPU time of server
+thread, because the players in other threads decrypt the data. It requires the tls module of kernel, for example,
+by "modprobe tls", or only the OpenSSL result is printed.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <linux/tls.h>
+
+#include <openssl/ssl.h>
+#include <openssl/hmac.h>
+
+#include <string>
+#include <vector>
+using namespace std;
+
+#define TAG_SIZE (64 * 1024)
+#define CERT_FILE "../../conf/server.crt"
+#define KEY_FILE "../../conf/server.key"
+
+int64_t now_us()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+int64_t cpu_us()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+// See srs_ssl_server_write_key.
+bool server_write_key(SSL* ssl, string& key, string& salt)
+{
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+    const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+
+    uint8_t master[SSL_MAX_MASTER_KEY_LENGTH];
+    int nn_master = (int)SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+
+    uint8_t seed[13 + SSL3_RANDOM_SIZE * 2];
+    memcpy(seed, "key expansion", 13);
+    SSL_get_server_random(ssl, seed + 13, SSL3_RANDOM_SIZE);
+    SSL_get_client_random(ssl, seed + 13 + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+    int nn_key = 16, nn_salt = 4, nn_block = nn_key * 2 + nn_salt * 2;
+    uint8_t block[128], a[EVP_MAX_MD_SIZE + sizeof(seed)], out[EVP_MAX_MD_SIZE];
+    unsigned int nn_a = 0, nn_out = 0;
+    HMAC(md, master, nn_master, seed, sizeof(seed), a, &nn_a);
+    for (int pos = 0; pos < nn_block; pos += nn_out) {
+        memcpy(a + nn_a, seed, sizeof(seed));
+        HMAC(md, master, nn_master, a, nn_a + sizeof(seed), out, &nn_out);
+        memcpy(block + pos, out, min((int)nn_out, nn_block - pos));
+        HMAC(md, master, nn_master, a, nn_a, out, &nn_a);
+        memcpy(a, out, nn_a);
+    }
+
+    key = string((char*)block + nn_key, nn_key);
+    salt = string((char*)block + nn_key * 2 + nn_salt, nn_salt);
+    return true;
+}
+
+bool enable_ktls(SSL* ssl, int fd)
+{
+    string key, salt;
+    server_write_key(ssl, key, salt);
+
+    tls12_crypto_info_aes_gcm_128 info;
+    memset(&info, 0, sizeof(info));
+    info.info.version = TLS_1_2_VERSION;
+    info.info.cipher_type = TLS_CIPHER_AES_GCM_128;
+    memcpy(info.key, key.data(), key.length());
+    memcpy(info.salt, salt.data(), salt.length());
+    info.rec_seq[7] = info.iv[7] = 1;
+
+    if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) < 0) {
+        printf("kTLS: TCP_ULP failed, errno=%d, %s\n", errno, strerror(errno));
+        return false;
+    }
+    if (setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info)) < 0) {
+        printf("kTLS: TLS_TX failed, errno=%d, %s\n", errno, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+struct Player
+{
+    int port;
+    int64_t size;
+    int64_t nread;
+};
+
+void* player_cycle(void* arg)
+{
+    Player* p = (Player*)arg;
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(p->port);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        printf("connect failed, errno=%d\n", errno);
+        exit(-1);
+    }
+
+    SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+    SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION);
+    SSL_CTX_set_cipher_list(ctx, "ECDHE-RSA-AES128-GCM-SHA256");
+    SSL* ssl = SSL_new(ctx);
+    SSL_set_fd(ssl, fd);
+    if (SSL_connect(ssl) != 1) {
+        printf("SSL_connect failed\n");
+        exit(-1);
+    }
+
+    char buf[16 * 1024];
+    while (p->nread < p->size) {
+        int nn = SSL_read(ssl, buf, sizeof(buf));
+        if (nn <= 0) {
+            break;
+        }
+        p->nread += nn;
+    }
+
+    SSL_free(ssl);
+    SSL_CTX_free(ctx);
+    close(fd);
+    return NULL;
+}
+
+// Fan-out to players, by OpenSSL if not ktls, return false if kTLS is not supported.
+bool fanout(bool ktls, int nn_players, int64_t size)
+{
+    int lfd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    bind(lfd, (sockaddr*)&addr, sizeof(addr));
+    listen(lfd, 1024);
+    socklen_t addrlen = sizeof(addr);
+    getsockname(lfd, (sockaddr*)&addr, &addrlen);
+
+    SSL_CTX* ctx = SSL_CTX_new(TLS_server_method());
+    SSL_CTX_set_max_proto_version(ctx, TLS1_2_VERSION);
+    if (SSL_CTX_use_certificate_file(ctx, CERT_FILE, SSL_FILETYPE_PEM) != 1
+        || SSL_CTX_use_PrivateKey_file(ctx, KEY_FILE, SSL_FILETYPE_PEM) != 1) {
+        printf("Failed to load %s and %s\n", CERT_FILE, KEY_FILE);
+        exit(-1);
+    }
+
+    vector<Player> players(nn_players);
+    vector<pthread_t> trds(nn_players);
+    for (int i = 0; i < nn_players; i++) {
+        players[i].port = ntohs(addr.sin_port);
+        players[i].size = size;
+        players[i].nread = 0;
+        pthread_create(&trds[i], NULL, player_cycle, &players[i]);
+    }
+
+    vector<int> fds;
+    vector<SSL*> ssls;
+    bool ok = true;
+    for (int i = 0; i < nn_players; i++) {
+        int fd = accept(lfd, NULL, NULL);
+        SSL* ssl = SSL_new(ctx);
+        SSL_set_fd(ssl, fd);
+        if (SSL_accept(ssl) != 1) {
+            printf("SSL_accept failed\n");
+            exit(-1);
+        }
+        if (ktls && ok) {
+            ok = enable_ktls(ssl, fd);
+        }
+        fds.push_back(fd);
+        ssls.push_back(ssl);
+    }
+
+    char* tag = new char[TAG_SIZE];
+    for (int i = 0; i < TAG_SIZE; i++) {
+        tag[i] = (char)rand();
+    }
+
+    // If kTLS is not supported, send by OpenSSL to finish the players.
+    int64_t starttime = now_us();
+    int64_t startcpu = cpu_us();
+    for (int64_t sent = 0; sent < size; sent += TAG_SIZE) {
+        for (int i = 0; i < nn_players; i++) {
+            for (char* p = tag; p < tag + TAG_SIZE;) {
+                int nn = (ktls && ok) ? (int)write(fds[i], p, tag + TAG_SIZE - p) : SSL_write(ssls[i], p, tag + TAG_SIZE - p);
+                if (nn <= 0) {
+                    printf("write failed, errno=%d\n", errno);
+                    exit(-1);
+                }
+                p += nn;
+            }
+        }
+    }
+    int64_t cpu = cpu_us() - startcpu;
+    int64_t duration = now_us() - starttime;
+
+    for (int i = 0; i < nn_players; i++) {
+        pthread_join(trds[i], NULL);
+        SSL_free(ssls[i]);
+        close(fds[i]);
+    }
+    SSL_CTX_free(ctx);
+    close(lfd);
+    delete[] tag;
+
+    if (ok) {
+        double mbytes = (double)size * nn_players / 1024 / 1024;
+        printf("%-8s players=%d, %.0fMB, duration=%.1fms, %.1fMB/s, server cpu %.1fms, %.2fms/MB\n",
+            ktls ? "kTLS:" : "OpenSSL:", nn_players, mbytes, duration / 1000.0, mbytes * 1000000 / duration,
+            cpu / 1000.0, cpu / 1000.0 / mbytes);
+    }
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    int nn_players = argc > 1 ? atoi(argv[1]) : 8;
+    int mbytes = argc > 2 ? atoi(argv[2]) : 64;
+    if (nn_players <= 0 || mbytes <= 0) {
+        printf("Usage: %s [players] [MB per player]\n", argv[0]);
+        exit(-1);
+    }
+
+    int64_t size = (int64_t)mbytes * 1024 * 1024;
+    fanout(false, nn_players, size);
+    if (!fanout(true, nn_players, size)) {
+        printf("kTLS: not supported, please try modprobe tls\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+/*
+# Compare the message queue of fast vector and ring, see SrsMessageQueue and SrsMessageRing.
+make && ./bench 30 10000
+# The arguments are: queue seconds, rounds.
+
+The stream is 25fps video and 43fps audio, the GOP is 1s. For a slow consumer, the queue is full of the messages in
+queue seconds, and the consumer dumps 128 messages for each 128 new messages, so the fast vector moves the left
+messages by erase. The dumped messages are pushed back, so only the cost of queue is measured. For shrink, the queue
+is filled, dumped once and then shrunk to the last GOP, the fast vector scans all messages to find the sequence
+headers and keyframes, while the ring gets them by the index. The fast vector is the removed SrsFastVector, and the
+ring is SrsMessageRing.
+*/
+#include <bench.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <srs_kernel_error.hpp>
+#include <srs_kernel_flv.hpp>
+#include <srs_kernel_codec.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_app_source.hpp>
+
+// The fast vector with the shrink of SrsMessageQueue, which is removed by SrsMessageRing. Never inline it, like the
+// ring which is in other file.
+class FastVector
+{
+public:
+    SrsSharedPtrMessage** msgs;
+    int count;
+    FastVector(int capacity) : count(0) {
+        msgs = new SrsSharedPtrMessage*[capacity];
+    }
+    virtual ~FastVector() {
+        for (int i = 0; i < count; i++) {
+            srs_freep(msgs[i]);
+        }
+        delete[] msgs;
+    }
+    __attribute__((noinline)) void push_back(SrsSharedPtrMessage* msg) {
+        msgs[count++] = msg;
+    }
+    __attribute__((noinline)) int dump(SrsSharedPtrMessage** pmsgs, int max) {
+        int n = srs_min(max, count);
+        memcpy(pmsgs, msgs, n * sizeof(SrsSharedPtrMessage*));
+        memmove(msgs, msgs + n, (count - n) * sizeof(SrsSharedPtrMessage*));
+        count -= n;
+        return n;
+    }
+    // Scan for the sequence headers and the last keyframe, free others before the last keyframe.
+    __attribute__((noinline)) void shrink() {
+        SrsSharedPtrMessage* video_sh = NULL;
+        SrsSharedPtrMessage* audio_sh = NULL;
+        int last = -1;
+        for (int i = 0; i < count; i++) {
+            SrsSharedPtrMessage* msg = msgs[i];
+            if (msg->is_video() && SrsFlvVideo::sh(msg->payload, msg->size)) {
+                video_sh = msg;
+            } else if (msg->is_audio() && SrsFlvAudio::sh(msg->payload, msg->size)) {
+                audio_sh = msg;
+            } else if (msg->is_video() && SrsFlvVideo::keyframe(msg->payload, msg->size)) {
+                last = i;
+            }
+        }
+        for (int i = 0; i < last; i++) {
+            if (msgs[i] != video_sh && msgs[i] != audio_sh) {
+                srs_freep(msgs[i]);
+            }
+        }
+        int n = 0;
+        if (video_sh) msgs[n++] = video_sh;
+        if (audio_sh) msgs[n++] = audio_sh;
+        for (int i = last; last >= 0 && i < count; i++) {
+            msgs[n++] = msgs[i];
+        }
+        count = n;
+    }
+};
+
+SrsSharedPtrMessage* create_message(bool video, uint32_t timestamp, uint8_t b0, uint8_t b1)
+{
+    SrsMessageHeader h;
+    if (video) {
+        h.initialize_video(16, timestamp, 1);
+    } else {
+        h.initialize_audio(16, timestamp, 1);
+    }
+
+    char* payload = new char[16];
+    memset(payload, 0, 16);
+    payload[0] = (char)b0;
+    payload[1] = (char)b1;
+
+    SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+    srs_error_t err = msg->create(&h, payload, 16);
+    srs_freep(err);
+    return msg;
+}
+
+int main(int argc, char** argv)
+{
+    srs_error_t err = srs_success;
+
+    int seconds = argc > 1 ? atoi(argv[1]) : 30;
+    int rounds = argc > 2 ? atoi(argv[2]) : 10000;
+    if (seconds <= 0 || rounds <= 0) {
+        printf("Usage: %s [seconds] [rounds]\n", argv[0]);
+        exit(-1);
+    }
+
+    if ((err = srs_bench_initialize()) != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+
+    // The messages of queue seconds, video and audio are interleaved, starts with the sequence headers.
+    int nn_msgs = seconds * (25 + 43) + 2;
+    SrsSharedPtrMessage** stream = new SrsSharedPtrMessage*[nn_msgs];
+    stream[0] = create_message(true, 0, 0x17, 0);
+    stream[1] = create_message(false, 0, 0xaf, 0);
+    for (int i = 0, v = 0; i < nn_msgs - 2; i++) {
+        bool video = (i % 68) < 25;
+        uint8_t b0 = video ? ((v++ % 25) == 0 ? 0x17 : 0x27) : 0xaf;
+        stream[i + 2] = create_message(video, i * 1000 / (25 + 43), b0, 1);
+    }
+
+    SrsSharedPtrMessage** pmsgs = new SrsSharedPtrMessage*[128];
+    printf("seconds=%d, messages=%d, rounds=%d\n", seconds, nn_msgs, rounds);
+
+    // The slow consumer, the queue is always full.
+    if (true) {
+        FastVector q0(nn_msgs + 128);
+        SrsMessageRing q1;
+        for (int i = 0; i < nn_msgs; i++) {
+            q0.push_back(stream[i]->copy());
+            q1.push_back(stream[i]->copy());
+        }
+
+        int64_t v0 = 0;
+        int64_t starttime = srs_bench_now_us();
+        for (int r = 0; r < rounds; r++) {
+            int n = q0.dump(pmsgs, 128);
+            for (int i = 0; i < n; i++) q0.push_back(pmsgs[i]);
+            v0 += n;
+        }
+        int64_t d0 = srs_bench_now_us() - starttime;
+
+        int64_t v1 = 0;
+        starttime = srs_bench_now_us();
+        for (int r = 0; r < rounds; r++) {
+            int n = q1.pop_front(pmsgs, 128);
+            for (int i = 0; i < n; i++) q1.push_back(pmsgs[i]);
+            v1 += n;
+        }
+        int64_t d1 = srs_bench_now_us() - starttime;
+
+        printf("dump:   fast vector %.1fms, %.2fus/dump; ring %.1fms, %.2fus/dump\n",
+            d0 / 1000.0, (double)d0 / rounds, d1 / 1000.0, (double)d1 / rounds);
+        if (v0 != v1) {
+            printf("Failed, vector %lld != ring %lld\n", (long long)v0, (long long)v1);
+            return -1;
+        }
+    }
+
+    // Each round, fill the queue, then dump 128 messages and shrink to the last GOP, which is measured.
+    int64_t d0 = 0, v0 = 0;
+    for (int r = 0; r < rounds; r++) {
+        FastVector q(nn_msgs);
+        for (int i = 0; i < nn_msgs; i++) q.push_back(stream[i]->copy());
+
+        int64_t starttime = srs_bench_now_us();
+        int n = q.dump(pmsgs, 128);
+        q.shrink();
+        d0 += srs_bench_now_us() - starttime;
+
+        for (int i = 0; i < n; i++) {
+            srs_freep(pmsgs[i]);
+        }
+        v0 += n + q.count;
+    }
+
+    int64_t d1 = 0, v1 = 0;
+    for (int r = 0; r < rounds; r++) {
+        SrsMessageRing q;
+        for (int i = 0; i < nn_msgs; i++) q.push_back(stream[i]->copy());
+
+        int64_t starttime = srs_bench_now_us();
+        int n = q.pop_front(pmsgs, 128);
+        if (q.nn_keyframes() > 0) q.drop_front(q.keyframe(q.nn_keyframes() - 1));
+        d1 += srs_bench_now_us() - starttime;
+
+        for (int i = 0; i < n; i++) {
+            srs_freep(pmsgs[i]);
+        }
+        v1 += n + q.size();
+    }
+
+    printf("shrink: fast vector %.1fms, %.2fus/round; ring %.1fms, %.2fus/round\n",
+        d0 / 1000.0, (double)d0 / rounds, d1 / 1000.0, (double)d1 / rounds);
+    if (v0 != v1) {
+        printf("Failed, vector %lld != ring %lld\n", (long long)v0, (long long)v1);
+        return -1;
+    }
+
+    for (int i = 0; i < nn_msgs; i++) {
+        srs_freep(stream[i]);
+    }
+    delete[] stream;
+    delete[] pmsgs;
+
+    return 0;
+}
@@ -0,0 +1,95 @@
+/*
+# Compare the malloc and free of RTP objects, to the slab pool, see SrsRtpObjectPool and SrsRtpBufferPool.
+make && ./bench 1000000 64
+# The arguments are: packets, inflight packets.
+
+For each RTP packet, we allocate a SrsRtpPacket, a SrsRtpRawPayload and a 1500 bytes buffer by SrsRtpPacket::wrap.
+The packets are kept in a window of inflight packets, then freed, like the NACK ring. Because the pools are enabled
+at compile time, the malloc version creates the same objects by the global new, which bypasses the operator new of
+class, and the buffer by a SrsSharedPtrMessage like the wrap before the pool.
+*/
+#include <bench.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+using namespace std;
+
+#include <srs_kernel_error.hpp>
+#include <srs_kernel_flv.hpp>
+#include <srs_kernel_rtc_rtp.hpp>
+
+// The RTP objects without pool, the payload and buffer are not attached to the packet, which recycles them to pool.
+struct MallocPacket
+{
+    SrsRtpPacket* pkt;
+    SrsRtpRawPayload* payload;
+    SrsSharedPtrMessage* buffer;
+};
+
+int main(int argc, char** argv)
+{
+    srs_error_t err = srs_success;
+
+    int nn_packets = argc > 1 ? atoi(argv[1]) : 1000000;
+    int inflight = argc > 2 ? atoi(argv[2]) : 64;
+    if (nn_packets <= 0 || inflight <= 0) {
+        printf("Usage: %s [packets] [inflight]\n", argv[0]);
+        exit(-1);
+    }
+
+    if ((err = srs_bench_initialize()) != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+
+    printf("packets=%d, inflight=%d\n", nn_packets, inflight);
+
+    vector<MallocPacket> window0(inflight);
+    for (int i = 0; i < inflight; i++) {
+        window0[i].pkt = NULL;
+    }
+
+    int64_t starttime = srs_bench_now_us();
+    for (int i = 0; i < nn_packets; i++) {
+        MallocPacket& slot = window0[i % inflight];
+        if (slot.pkt) {
+            ::delete slot.pkt;
+            ::delete slot.payload;
+            srs_freep(slot.buffer);
+        }
+        slot.pkt = ::new SrsRtpPacket();
+        slot.payload = ::new SrsRtpRawPayload();
+        slot.buffer = new SrsSharedPtrMessage();
+        slot.buffer->wrap(new char[kRtpPacketSize], kRtpPacketSize);
+        slot.buffer->payload[0] = (char)i;
+    }
+    for (int i = 0; i < inflight; i++) {
+        MallocPacket& slot = window0[i];
+        ::delete slot.pkt;
+        ::delete slot.payload;
+        srs_freep(slot.buffer);
+    }
+    int64_t d0 = srs_bench_now_us() - starttime;
+
+    vector<SrsRtpPacket*> window1(inflight, (SrsRtpPacket*)NULL);
+
+    starttime = srs_bench_now_us();
+    for (int i = 0; i < nn_packets; i++) {
+        SrsRtpPacket*& slot = window1[i % inflight];
+        srs_freep(slot);
+        slot = new SrsRtpPacket();
+        slot->wrap(kRtpPacketSize)[0] = (char)i;
+        slot->set_payload(new SrsRtpRawPayload(), SrsRtspPacketPayloadTypeRaw);
+    }
+    for (int i = 0; i < inflight; i++) {
+        srs_freep(window1[i]);
+    }
+    int64_t d1 = srs_bench_now_us() - starttime;
+
+    printf("malloc: %.1fms, %.1fns/packet\n", d0 / 1000.0, d0 * 1000.0 / nn_packets);
+    printf("pool:   %.1fms, %.1fns/packet, speedup %.1fx\n", d1 / 1000.0, d1 * 1000.0 / nn_packets, (double)d0 / d1);
+
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+# Compare the throughput of SRTP protect, in place or offloaded to crypto threads, see SrsAsyncSRTPManager.
+make && ./bench 400000 2 32 8
+# The arguments are: packets, workers, batch, sessions.
+
+The packets of a session are ciphered by batch, and each session has at most one batch in flight, which is
+the same as the player coroutine of SRS. The order of packets are verified for each SSRC.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+
+#include <srtp2/srtp.h>
+
+#define PACKET_SIZE 1200
+#define BUFFER_SIZE 1500
+
+int64_t now_us()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+// The lock-free queue for single producer and single consumer, see SrsThreadSpscQueue.
+template<typename T>
+class SpscQueue
+{
+private:
+    uint32_t capacity_;
+    T* items_;
+    uint32_t head_;
+    uint32_t tail_;
+public:
+    SpscQueue(int capacity) {
+        capacity_ = 1;
+        while ((int)capacity_ < capacity) capacity_ <<= 1;
+        items_ = new T[capacity_];
+        head_ = tail_ = 0;
+    }
+    ~SpscQueue() {
+        delete[] items_;
+    }
+    bool push(const T& v) {
+        uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+        if (tail - __atomic_load_n(&head_, __ATOMIC_ACQUIRE) >= capacity_) return false;
+        items_[tail & (capacity_ - 1)] = v;
+        __atomic_store_n(&tail_, tail + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+    bool pop(T* pv) {
+        uint32_t head = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+        if (head == __atomic_load_n(&tail_, __ATOMIC_ACQUIRE)) return false;
+        *pv = items_[head & (capacity_ - 1)];
+        __atomic_store_n(&head_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+};
+
+struct Session
+{
+    uint32_t ssrc;
+    srtp_t ctx;
+    // The buffers of batch, and the size of packets.
+    char* bufs;
+    int sizes[256];
+    int nn;
+    // The next sequence to build, and the next sequence to send, to verify the order.
+    uint16_t build_seq;
+    uint16_t send_seq;
+    bool in_flight;
+};
+
+struct Worker
+{
+    SpscQueue<Session*>* tasks;
+    SpscQueue<Session*>* dones;
+    pthread_t trd;
+    bool quit;
+};
+
+int nn_errors = 0;
+
+void build_batch(Session* s, int batch)
+{
+    for (int i = 0; i < batch; i++) {
+        char* p = s->bufs + i * BUFFER_SIZE;
+        memset(p, 0, PACKET_SIZE);
+        p[0] = (char)0x80;
+        p[1] = 96;
+        *(uint16_t*)(p + 2) = htons(s->build_seq++);
+        *(uint32_t*)(p + 4) = htonl(s->build_seq * 90);
+        *(uint32_t*)(p + 8) = htonl(s->ssrc);
+        s->sizes[i] = PACKET_SIZE;
+    }
+    s->nn = batch;
+}
+
+void protect_batch(Session* s)
+{
+    for (int i = 0; i < s->nn; i++) {
+        if (srtp_protect(s->ctx, s->bufs + i * BUFFER_SIZE, &s->sizes[i]) != srtp_err_status_ok) {
+            __atomic_add_fetch(&nn_errors, 1, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+// Send the ciphered batch, verify the order of packets.
+void send_batch(Session* s)
+{
+    for (int i = 0; i < s->nn; i++) {
+        char* p = s->bufs + i * BUFFER_SIZE;
+        uint16_t seq = ntohs(*(uint16_t*)(p + 2));
+        if (seq != s->send_seq || s->sizes[i] != PACKET_SIZE + 10) {
+            nn_errors++;
+        }
+        s->send_seq = seq + 1;
+    }
+}
+
+void* worker_cycle(void* arg)
+{
+    Worker* w = (Worker*)arg;
+    while (!__atomic_load_n(&w->quit, __ATOMIC_ACQUIRE)) {
+        Session* s = NULL;
+        if (!w->tasks->pop(&s)) {
+            sched_yield();
+            continue;
+        }
+        protect_batch(s);
+        w->dones->push(s);
+    }
+    return NULL;
+}
+
+void create_sessions(Session* sessions, int nn_sessions)
+{
+    for (int i = 0; i < nn_sessions; i++) {
+        Session* s = &sessions[i];
+        memset(s, 0, sizeof(Session));
+        s->ssrc = 1000 + i;
+        s->bufs = new char[256 * BUFFER_SIZE];
+
+        uint8_t key[30];
+        for (int j = 0; j < 30; j++) key[j] = (uint8_t)(i + j);
+
+        srtp_policy_t policy;
+        memset(&policy, 0, sizeof(policy));
+        srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
+        srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+        policy.ssrc.type = ssrc_any_outbound;
+        policy.window_size = 8192;
+        policy.allow_repeat_tx = 1;
+        policy.key = key;
+        if (srtp_create(&s->ctx, &policy) != srtp_err_status_ok) {
+            printf("srtp create failed\n");
+            exit(-1);
+        }
+    }
+}
+
+void free_sessions(Session* sessions, int nn_sessions)
+{
+    for (int i = 0; i < nn_sessions; i++) {
+        srtp_dealloc(sessions[i].ctx);
+        delete[] sessions[i].bufs;
+    }
+}
+
+double bench_inline(int packets, int batch, int nn_sessions)
+{
+    Session* sessions = new Session[nn_sessions];
+    create_sessions(sessions, nn_sessions);
+
+    int64_t starttime = now_us();
+    for (int sent = 0; sent < packets;) {
+        for (int i = 0; i < nn_sessions && sent < packets; i++) {
+            Session* s = &sessions[i];
+            build_batch(s, batch);
+            protect_batch(s);
+            send_batch(s);
+            sent += s->nn;
+        }
+    }
+    int64_t duration = now_us() - starttime;
+
+    free_sessions(sessions, nn_sessions);
+    delete[] sessions;
+    return duration;
+}
+
+double bench_offload(int packets, int batch, int nn_sessions, int nn_workers)
+{
+    Session* sessions = new Session[nn_sessions];
+    create_sessions(sessions, nn_sessions);
+
+    Worker* workers = new Worker[nn_workers];
+    for (int i = 0; i < nn_workers; i++) {
+        Worker* w = &workers[i];
+        w->tasks = new SpscQueue<Session*>(nn_sessions);
+        w->dones = new SpscQueue<Session*>(nn_sessions);
+        w->quit = false;
+        pthread_create(&w->trd, NULL, worker_cycle, w);
+    }
+
+    int64_t starttime = now_us();
+    int posted = 0, sent = 0;
+    while (sent < packets) {
+        // Post a batch for each idle session, the session always uses the same worker.
+        for (int i = 0; i < nn_sessions && posted < packets; i++) {
+            Session* s = &sessions[i];
+            if (s->in_flight) continue;
+
+            build_batch(s, batch);
+            s->in_flight = true;
+            workers[i % nn_workers].tasks->push(s);
+            posted += s->nn;
+        }
+
+        // Collect the done batches and send them.
+        bool has_done = false;
+        for (int i = 0; i < nn_workers; i++) {
+            Session* s = NULL;
+            while (workers[i].dones->pop(&s)) {
+                send_batch(s);
+                sent += s->nn;
+                s->in_flight = false;
+                has_done = true;
+            }
+        }
+        if (!has_done) {
+            sched_yield();
+        }
+    }
+    int64_t duration = now_us() - starttime;
+
+    for (int i = 0; i < nn_workers; i++) {
+        __atomic_store_n(&workers[i].quit, true, __ATOMIC_RELEASE);
+        pthread_join(workers[i].trd, NULL);
+        delete workers[i].tasks;
+        delete workers[i].dones;
+    }
+    delete[] workers;
+
+    free_sessions(sessions, nn_sessions);
+    delete[] sessions;
+    return duration;
+}
+
+int main(int argc, char** argv)
+{
+    int packets = argc > 1 ? atoi(argv[1]) : 400000;
+    int workers = argc > 2 ? atoi(argv[2]) : 2;
+    int batch = argc > 3 ? atoi(argv[3]) : 32;
+    int sessions = argc > 4 ? atoi(argv[4]) : 8;
+    if (packets <= 0 || workers <= 0 || batch <= 0 || batch > 256 || sessions <= 0) {
+        printf("Usage: %s [packets] [workers] [batch<=256] [sessions]\n", argv[0]);
+        exit(-1);
+    }
+
+    if (srtp_init() != srtp_err_status_ok) {
+        printf("srtp init failed\n");
+        exit(-1);
+    }
+
+    printf("packets=%d, size=%d, workers=%d, batch=%d, sessions=%d\n", packets, PACKET_SIZE, workers, batch, sessions);
+
+    double d0 = bench_inline(packets, batch, sessions);
+    printf("inline:  %.1fms, %.0f pps, %.1f Mbps\n", d0 / 1000, packets * 1e6 / d0, packets * PACKET_SIZE * 8 / d0);
+
+    double d1 = bench_offload(packets, batch, sessions, workers);
+    printf("offload: %.1fms, %.0f pps, %.1f Mbps, speedup %.2fx\n", d1 / 1000, packets * 1e6 / d1, packets * PACKET_SIZE * 8 / d1, d0 / d1);
+
+    if (nn_errors) {
+        printf("Failed, %d packets are out of order or not ciphered\n", nn_errors);
+        return -1;
+    }
+
+    return 0;
+}
+
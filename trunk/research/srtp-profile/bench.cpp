@@ -0,0 +1,103 @@
+/*
+# Compare the throughput of SRTP protect_rtp for each profile, see SrsSrtpProfile.
+make && ./bench 400000 1200
+# The arguments are: packets, size.
+
+The GCM profiles require libsrtp built with openssl, please configure SRS with --srtp-nasm=on, or they are
+reported as not supported.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+
+#include <srtp2/srtp.h>
+
+int64_t now_us()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+struct Profile
+{
+    const char* name;
+    void (*set_policy)(srtp_crypto_policy_t* p);
+};
+
+void bench_profile(Profile* profile, int packets, int size)
+{
+    uint8_t key[64];
+    for (int i = 0; i < (int)sizeof(key); i++) key[i] = (uint8_t)i;
+
+    srtp_policy_t policy;
+    memset(&policy, 0, sizeof(policy));
+    profile->set_policy(&policy.rtp);
+    profile->set_policy(&policy.rtcp);
+    policy.ssrc.type = ssrc_any_outbound;
+    policy.window_size = 8192;
+    policy.allow_repeat_tx = 1;
+    policy.key = key;
+
+    srtp_t ctx = NULL;
+    if (srtp_create(&ctx, &policy) != srtp_err_status_ok) {
+        printf("%-24s not supported\n", profile->name);
+        return;
+    }
+
+    char buf[1500];
+    int64_t starttime = now_us();
+    int nn_errors = 0, nn_cipher = 0;
+    for (int i = 0; i < packets; i++) {
+        memset(buf, 0, 12);
+        buf[0] = (char)0x80;
+        buf[1] = 96;
+        *(uint16_t*)(buf + 2) = htons((uint16_t)i);
+        *(uint32_t*)(buf + 4) = htonl(i * 90);
+        *(uint32_t*)(buf + 8) = htonl(100);
+
+        nn_cipher = size;
+        if (srtp_protect(ctx, buf, &nn_cipher) != srtp_err_status_ok) {
+            nn_errors++;
+        }
+    }
+    double duration = (double)(now_us() - starttime);
+
+    printf("%-24s %.1fms, %.0f pps, %.1f Mbps, cipher=%dB, errors=%d\n", profile->name, duration / 1000,
+        packets * 1e6 / duration, (double)packets * size * 8 / duration, nn_cipher, nn_errors);
+
+    srtp_dealloc(ctx);
+}
+
+int main(int argc, char** argv)
+{
+    int packets = argc > 1 ? atoi(argv[1]) : 400000;
+    int size = argc > 2 ? atoi(argv[2]) : 1200;
+    if (packets <= 0 || size < 12 || size > 1400) {
+        printf("Usage: %s [packets] [size<=1400]\n", argv[0]);
+        exit(-1);
+    }
+
+    if (srtp_init() != srtp_err_status_ok) {
+        printf("srtp init failed\n");
+        exit(-1);
+    }
+
+    printf("packets=%d, size=%d\n", packets, size);
+
+    Profile profiles[] = {
+        // The srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80 is a macro of it.
+        {"AES_CM_128_HMAC_SHA1_80", srtp_crypto_policy_set_rtp_default},
+        {"AEAD_AES_128_GCM", srtp_crypto_policy_set_aes_gcm_128_16_auth},
+        {"AEAD_AES_256_GCM", srtp_crypto_policy_set_aes_gcm_256_16_auth},
+    };
+    for (int i = 0; i < (int)(sizeof(profiles) / sizeof(Profile)); i++) {
+        bench_profile(&profiles[i], packets, size);
+    }
+
+    return 0;
+}
+
@@ -0,0 +1,124 @@
+/*
+# Compare the event system of ST, epoll and io_uring, at connection scale, see _st_uring_eventsys.
+make && ulimit -n 65535 && ./bench-epoll 10000 100 10 && ./bench 10000 100 10
+# The arguments are: connections, active connections, seconds.
+
+Each connection is a pair of unix stream sockets, and the server coroutine echoes what it reads. The active
+clients ping-pong 64 bytes, while the idle ones never write, so their server coroutines wait in st_read, like
+the players which are waiting for the stream. The bench-epoll is linked with ST without io_uring, which uses
+epoll_ctl to add and delete the fd for each wait, while the bench is linked with ST built with io_uring, which
+submits the polls in batch together with waiting for completions. We print the RTTs per second and the CPU time
+per RTT, by getrusage.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+
+#include "st.h"
+
+#define PAYLOAD 64
+
+int64_t nn_rtts = 0;
+
+int64_t now_us()
+{
+    timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+int64_t cpu_us()
+{
+    rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec * 1000000LL + ru.ru_utime.tv_usec + ru.ru_stime.tv_sec * 1000000LL + ru.ru_stime.tv_usec;
+}
+
+void* server(void* arg)
+{
+    st_netfd_t stfd = (st_netfd_t)arg;
+    char buf[PAYLOAD];
+    for (;;) {
+        ssize_t nn = st_read(stfd, buf, sizeof(buf), ST_UTIME_NO_TIMEOUT);
+        if (nn <= 0 || st_write(stfd, buf, nn, ST_UTIME_NO_TIMEOUT) != nn) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+void* client(void* arg)
+{
+    st_netfd_t stfd = (st_netfd_t)arg;
+    char buf[PAYLOAD] = {0};
+    for (;;) {
+        if (st_write(stfd, buf, sizeof(buf), ST_UTIME_NO_TIMEOUT) != (ssize_t)sizeof(buf)) {
+            break;
+        }
+        if (st_read_fully(stfd, buf, sizeof(buf), ST_UTIME_NO_TIMEOUT) != (ssize_t)sizeof(buf)) {
+            break;
+        }
+        nn_rtts++;
+    }
+    return NULL;
+}
+
+int main(int argc, char** argv)
+{
+    int nn_conns = argc > 1 ? atoi(argv[1]) : 10000;
+    int nn_active = argc > 2 ? atoi(argv[2]) : 100;
+    int seconds = argc > 3 ? atoi(argv[3]) : 10;
+    if (nn_conns <= 0 || nn_active < 0 || nn_active > nn_conns || seconds <= 0) {
+        printf("Usage: %s [connections] [active] [seconds]\n", argv[0]);
+        exit(-1);
+    }
+
+    if (st_set_eventsys(ST_EVENTSYS_ALT) == -1 || st_init() != 0) {
+        printf("Init ST failed\n");
+        exit(-1);
+    }
+
+    for (int i = 0; i < nn_conns; i++) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            printf("Create socketpair failed, i=%d, please check ulimit -n\n", i);
+            exit(-1);
+        }
+
+        st_netfd_t sfd = st_netfd_open_socket(fds[0]);
+        st_netfd_t cfd = st_netfd_open_socket(fds[1]);
+        if (!sfd || !cfd || !st_thread_create(server, sfd, 0, 32 * 1024)) {
+            printf("Create server failed, i=%d\n", i);
+            exit(-1);
+        }
+        if (i < nn_active && !st_thread_create(client, cfd, 0, 32 * 1024)) {
+            printf("Create client failed, i=%d\n", i);
+            exit(-1);
+        }
+    }
+
+    // Let the idle servers wait in st_read.
+    st_usleep(100 * 1000);
+
+    printf("eventsys=%s, connections=%d, active=%d, seconds=%d\n", st_get_eventsys_name(), nn_conns, nn_active, seconds);
+
+    int64_t starttime = now_us();
+    int64_t startcpu = cpu_us();
+    nn_rtts = 0;
+
+    st_usleep(seconds * 1000 * 1000LL);
+
+    int64_t duration = now_us() - starttime;
+    int64_t cpu = cpu_us() - startcpu;
+    int64_t rtts = nn_rtts;
+
+    printf("%s: rtts=%lld, %.0f rtts/s, cpu %.1f%%, %.2fus/rtt\n", st_get_eventsys_name(), (long long)rtts,
+        rtts * 1000000.0 / duration, cpu * 100.0 / duration, rtts ? (double)cpu / rtts : 0);
+
+    return 0;
+}
+
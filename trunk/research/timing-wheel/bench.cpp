@@ -0,0 +1,167 @@
+/*
+# Compare the timer overhead per session, of the shared fast timers and the timing wheel, see SrsTimingWheel.
+make && ./bench 5000 100
+# The arguments are: sessions, seconds.
+
+Each session has 3 timers like the RTC publisher: NACK for 20ms, TWCC for 100ms and RTCP for 1s. The fast
+timers are the removed SrsFastTimer, which loop over the vector of handlers, and unsubscribe by find and erase.
+The wheel is SrsTimingWheel, which expires the timers of a tick in batch, and add or cancel a timer in O(1). We
+simulate the ticks without sleep, then churn the sessions, that is, remove and add back all sessions, which is
+the cost of session join and leave.
+*/
+#include <bench.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include <srs_kernel_error.hpp>
+#include <srs_app_hourglass.hpp>
+
+int64_t nn_calls = 0;
+
+// Never inline the handler, like the RTC handlers which are in other files.
+class MockTimer : public ISrsFastTimer
+{
+public:
+    __attribute__((noinline)) virtual srs_error_t on_timer(srs_utime_t /*interval*/) {
+        nn_calls++;
+        return srs_success;
+    }
+};
+
+// The shared fast timer, which is removed by SrsTimingWheel.
+class FastTimer
+{
+public:
+    srs_utime_t interval_;
+    vector<ISrsFastTimer*> handlers_;
+    FastTimer(srs_utime_t interval) : interval_(interval) {}
+    void subscribe(ISrsFastTimer* timer) {
+        if (std::find(handlers_.begin(), handlers_.end(), timer) == handlers_.end()) {
+            handlers_.push_back(timer);
+        }
+    }
+    void unsubscribe(ISrsFastTimer* timer) {
+        vector<ISrsFastTimer*>::iterator it = std::find(handlers_.begin(), handlers_.end(), timer);
+        if (it != handlers_.end()) {
+            handlers_.erase(it);
+        }
+    }
+    void cycle() {
+        for (int i = 0; i < (int)handlers_.size(); i++) {
+            srs_error_t err = handlers_.at(i)->on_timer(interval_);
+            srs_freep(err);
+        }
+    }
+};
+
+struct Session
+{
+    MockTimer nack, twcc, rtcp;
+    SrsWheelTimer* wnack;
+    SrsWheelTimer* wtwcc;
+    SrsWheelTimer* wrtcp;
+};
+
+int main(int argc, char** argv)
+{
+    srs_error_t err = srs_success;
+
+    int nn_sessions = argc > 1 ? atoi(argv[1]) : 5000;
+    int seconds = argc > 2 ? atoi(argv[2]) : 100;
+    if (nn_sessions <= 0 || seconds <= 0) {
+        printf("Usage: %s [sessions] [seconds]\n", argv[0]);
+        exit(-1);
+    }
+
+    if ((err = srs_bench_initialize()) != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+
+    srs_utime_t resolution = 20 * SRS_UTIME_MILLISECONDS;
+    int ticks = seconds * SRS_UTIME_SECONDS / resolution;
+    printf("sessions=%d, timers=%d, seconds=%d, ticks=%d\n", nn_sessions, nn_sessions * 3, seconds, ticks);
+
+    Session* sessions = new Session[nn_sessions];
+
+    // The shared fast timers, each is a coroutine.
+    FastTimer t20ms(20 * SRS_UTIME_MILLISECONDS), t100ms(100 * SRS_UTIME_MILLISECONDS), t1s(1 * SRS_UTIME_SECONDS);
+    for (int i = 0; i < nn_sessions; i++) {
+        t20ms.subscribe(&sessions[i].nack);
+        t100ms.subscribe(&sessions[i].twcc);
+        t1s.subscribe(&sessions[i].rtcp);
+    }
+
+    nn_calls = 0;
+    int64_t starttime = srs_bench_now_us();
+    for (int i = 0; i < ticks; i++) {
+        t20ms.cycle();
+        if ((i % 5) == 0) t100ms.cycle();
+        if ((i % 50) == 0) t1s.cycle();
+    }
+    int64_t d0 = srs_bench_now_us() - starttime;
+    int64_t calls0 = nn_calls;
+
+    starttime = srs_bench_now_us();
+    for (int i = 0; i < nn_sessions; i++) {
+        t20ms.unsubscribe(&sessions[i].nack);
+        t100ms.unsubscribe(&sessions[i].twcc);
+        t1s.unsubscribe(&sessions[i].rtcp);
+    }
+    for (int i = 0; i < nn_sessions; i++) {
+        t20ms.subscribe(&sessions[i].nack);
+        t100ms.subscribe(&sessions[i].twcc);
+        t1s.subscribe(&sessions[i].rtcp);
+    }
+    int64_t c0 = srs_bench_now_us() - starttime;
+
+    // The timing wheel, driven by advance without the coroutine.
+    SrsTimingWheel wheel("bench", resolution);
+    for (int i = 0; i < nn_sessions; i++) {
+        Session* s = &sessions[i];
+        s->wnack = new SrsWheelTimer(&s->nack, 20 * SRS_UTIME_MILLISECONDS);
+        s->wtwcc = new SrsWheelTimer(&s->twcc, 100 * SRS_UTIME_MILLISECONDS);
+        s->wrtcp = new SrsWheelTimer(&s->rtcp, 1 * SRS_UTIME_SECONDS);
+        wheel.add(s->wnack);
+        wheel.add(s->wtwcc);
+        wheel.add(s->wrtcp);
+    }
+
+    nn_calls = 0;
+    starttime = srs_bench_now_us();
+    wheel.advance(ticks);
+    int64_t d1 = srs_bench_now_us() - starttime;
+    int64_t calls1 = nn_calls;
+
+    starttime = srs_bench_now_us();
+    for (int i = 0; i < nn_sessions; i++) {
+        wheel.cancel(sessions[i].wnack);
+        wheel.cancel(sessions[i].wtwcc);
+        wheel.cancel(sessions[i].wrtcp);
+    }
+    for (int i = 0; i < nn_sessions; i++) {
+        wheel.add(sessions[i].wnack);
+        wheel.add(sessions[i].wtwcc);
+        wheel.add(sessions[i].wrtcp);
+    }
+    int64_t c1 = srs_bench_now_us() - starttime;
+
+    printf("fast timer: dispatch %.1fms, %.2fus/session/s, calls=%lld; churn %.1fms, %.2fus/session\n",
+        d0 / 1000.0, (double)d0 / nn_sessions / seconds, (long long)calls0, c0 / 1000.0, (double)c0 / nn_sessions);
+    printf("wheel:      dispatch %.1fms, %.2fus/session/s, calls=%lld; churn %.1fms, %.2fus/session\n",
+        d1 / 1000.0, (double)d1 / nn_sessions / seconds, (long long)calls1, c1 / 1000.0, (double)c1 / nn_sessions);
+
+    for (int i = 0; i < nn_sessions; i++) {
+        srs_freep(sessions[i].wnack);
+        srs_freep(sessions[i].wtwcc);
+        srs_freep(sessions[i].wrtcp);
+    }
+    delete[] sessions;
+
+    return 0;
+}
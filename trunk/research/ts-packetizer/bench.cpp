@@ -0,0 +1,173 @@
+/*
+# Compare the throughput of TS muxing for PES, packet by packet or packets in contiguous buffer, see SrsTsContext::encode_pes.
+make && ./bench 20000 4000 1
+# The arguments are: frames, frame size, whether write to /dev/null, or write nothing if 0.
+
+The packet mode is the legacy SrsTsContext::encode_pes, which creates a SrsTsPacket and a buffer for each TS packet
+and writes packets one by one. The batch mode is SrsTsContext::encode, which encodes the packets to a contiguous
+buffer of SRS_TS_PES_PACKETS packets. The output of both modes is verified by KernelTSTest.CoverContextEncodePackets.
+*/
+#include <bench.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <srs_kernel_error.hpp>
+#include <srs_kernel_io.hpp>
+#include <srs_kernel_ts.hpp>
+#include <srs_kernel_stream.hpp>
+#include <srs_kernel_buffer.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_core_autofree.hpp>
+
+// The writer to /dev/null or nothing.
+class NullWriter : public ISrsStreamWriter
+{
+public:
+    int fd;
+    int64_t nn_writes;
+    int64_t nn_bytes;
+public:
+    NullWriter(bool null) {
+        fd = null? open("/dev/null", O_WRONLY) : -1;
+        nn_writes = nn_bytes = 0;
+    }
+    virtual ~NullWriter() {
+        if (fd >= 0) close(fd);
+    }
+    virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite) {
+        if (fd >= 0 && ::write(fd, buf, size) != (ssize_t)size) {
+            return srs_error_new(ERROR_SYSTEM_FILE_WRITE, "write");
+        }
+        nn_writes++;
+        nn_bytes += size;
+        if (nwrite) *nwrite = size;
+        return srs_success;
+    }
+};
+
+// The legacy SrsTsContext::encode_pes, which creates packet and buffer for each TS packet.
+srs_error_t encode_by_packet(SrsTsContext* ctx, ISrsStreamWriter* writer, SrsTsMessage* msg, int16_t pid, uint8_t& cc)
+{
+    srs_error_t err = srs_success;
+
+    char* start = msg->payload->bytes();
+    char* end = start + msg->payload->length();
+    char* p = start;
+
+    while (p < end) {
+        SrsTsPacket* pkt = NULL;
+        if (p == start) {
+            int64_t pcr = msg->write_pcr? msg->dts : -1;
+            pkt = SrsTsPacket::create_pes_first(ctx, pid, msg->sid, cc++, msg->is_discontinuity, pcr, msg->dts, msg->pts, msg->payload->length());
+        } else {
+            pkt = SrsTsPacket::create_pes_continue(ctx, pid, msg->sid, cc++);
+        }
+        SrsAutoFree(SrsTsPacket, pkt);
+
+        char* buf = new char[SRS_TS_PACKET_SIZE];
+        SrsAutoFreeA(char, buf);
+
+        int nb_buf = pkt->size();
+        int left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - nb_buf);
+        if (SRS_TS_PACKET_SIZE - nb_buf - left > 0) {
+            memset(buf, 0xFF, SRS_TS_PACKET_SIZE);
+            pkt->padding(SRS_TS_PACKET_SIZE - nb_buf - left);
+            nb_buf = pkt->size();
+            left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - nb_buf);
+        }
+        memcpy(buf + nb_buf, p, left);
+        p += left;
+
+        SrsBuffer stream(buf, nb_buf);
+        if ((err = pkt->encode(&stream)) != srs_success) {
+            return srs_error_wrap(err, "encode packet");
+        }
+
+        if ((err = writer->write(buf, SRS_TS_PACKET_SIZE, NULL)) != srs_success) {
+            return srs_error_wrap(err, "write packet");
+        }
+    }
+
+    return err;
+}
+
+// Generate video frames with random size in [size/2, size*3/2], some with PCR and B frames.
+SrsTsMessage** create_frames(int nn_frames, int size)
+{
+    SrsTsMessage** frames = new SrsTsMessage*[nn_frames];
+    char* payload = new char[size * 2];
+
+    srand(0);
+    for (int i = 0; i < nn_frames; i++) {
+        SrsTsMessage* msg = frames[i] = new SrsTsMessage();
+        msg->sid = SrsTsPESStreamIdVideoCommon;
+        msg->dts = i * 3600;
+        msg->pts = (i % 3)? msg->dts + 3600 : msg->dts;
+        msg->write_pcr = (i % 30) == 0;
+
+        int nb_payload = size / 2 + rand() % (size + 1);
+        for (int j = 0; j < nb_payload; j++) payload[j] = (char)rand();
+        msg->payload->append(payload, nb_payload);
+    }
+
+    delete[] payload;
+    return frames;
+}
+
+int main(int argc, char** argv)
+{
+    srs_error_t err = srs_success;
+
+    int nn_frames = argc > 1 ? atoi(argv[1]) : 20000;
+    int size = argc > 2 ? atoi(argv[2]) : 4000;
+    bool null = argc > 3 ? atoi(argv[3]) != 0 : true;
+    if (nn_frames <= 0 || size <= 0) {
+        printf("Usage: %s [frames] [size] [null]\n", argv[0]);
+        exit(-1);
+    }
+
+    if ((err = srs_bench_initialize()) != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+
+    SrsTsMessage** frames = create_frames(nn_frames, size);
+    printf("frames=%d, size=%d, null=%d\n", nn_frames, size, null);
+
+    // The video pid is 0x100, the same as SrsTsContext::encode for AVC.
+    SrsTsContext ctx0;
+    NullWriter w0(null);
+    uint8_t cc = 0;
+    int64_t starttime = srs_bench_now_us();
+    for (int i = 0; i < nn_frames && err == srs_success; i++) {
+        err = encode_by_packet(&ctx0, &w0, frames[i], 0x100, cc);
+    }
+    double d0 = srs_bench_now_us() - starttime;
+
+    SrsTsContext ctx1;
+    NullWriter w1(null);
+    starttime = srs_bench_now_us();
+    for (int i = 0; i < nn_frames && err == srs_success; i++) {
+        err = ctx1.encode(&w1, frames[i], SrsVideoCodecIdAVC, SrsAudioCodecIdAAC);
+    }
+    double d1 = srs_bench_now_us() - starttime;
+
+    if (err != srs_success) {
+        printf("Failed, %s\n", srs_error_desc(err).c_str());
+        exit(-1);
+    }
+
+    printf("packet: %.1fms, %.1f MB/s, %lld writes\n", d0 / 1000, w0.nn_bytes / d0, (long long)w0.nn_writes);
+    printf("batch:  %.1fms, %.1f MB/s, %lld writes, speedup %.2fx\n", d1 / 1000, w1.nn_bytes / d1, (long long)w1.nn_writes, d0 / d1);
+
+    for (int i = 0; i < nn_frames; i++) {
+        srs_freep(frames[i]);
+    }
+    delete[] frames;
+
+    return 0;
+}
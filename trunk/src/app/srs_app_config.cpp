@@ -1284,6 +1284,125 @@ srs_error_t SrsConfDirective::read_token(SrsConfigBuffer* buffer, vector<string>
     return err;
 }
 
+// The FNV-1a hash of vhost name.
+uint32_t srs_vhost_hash(const string& vhost)
+{
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < (int)vhost.length(); i++) {
+        hash ^= (uint8_t)vhost.at(i);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+SrsVhostSnapshot::SrsVhostSnapshot(SrsConfig* conf, string vhost)
+{
+    vhost_ = vhost;
+    hash_ = srs_vhost_hash(vhost);
+    next_ = NULL;
+
+    is_edge = conf->get_vhost_is_edge(vhost);
+    gop_cache = conf->get_gop_cache(vhost);
+    queue_length = conf->get_queue_length(vhost);
+
+    adaptive_drop = conf->get_adaptive_drop(vhost);
+    adaptive_drop_nonref = conf->get_adaptive_drop_nonref(vhost);
+    adaptive_drop_gop = conf->get_adaptive_drop_gop(vhost);
+
+    atc = conf->get_atc(vhost);
+    atc_auto = conf->get_atc_auto(vhost);
+    time_jitter = conf->get_time_jitter(vhost);
+    mix_correct = conf->get_mix_correct(vhost);
+
+    parse_sps = conf->get_parse_sps(vhost);
+    reduce_sequence_header = conf->get_reduce_sequence_header(vhost);
+
+    hls_enabled = conf->get_hls_enabled(vhost);
+    hls_dts_directly = conf->get_vhost_hls_dts_directly(vhost);
+    hls_on_error = conf->get_hls_on_error(vhost);
+
+    rtc_stun_strict_check = conf->get_rtc_stun_strict_check(vhost);
+    rtc_nack_enabled = conf->get_rtc_nack_enabled(vhost);
+    rtc_nack_no_copy = conf->get_rtc_nack_no_copy(vhost);
+    rtc_twcc_enabled = conf->get_rtc_twcc_enabled(vhost);
+    rtc_drop_for_pt = conf->get_rtc_drop_for_pt(vhost);
+}
+
+SrsVhostSnapshot::~SrsVhostSnapshot()
+{
+}
+
+string SrsVhostSnapshot::vhost()
+{
+    return vhost_;
+}
+
+SrsVhostSnapshots::SrsVhostSnapshots(SrsConfig* conf)
+{
+    vector<SrsConfDirective*> vhosts;
+    conf->get_vhosts(vhosts);
+
+    // Keep the load factor no more than 0.5, to make the chain short.
+    int nn_buckets = 16;
+    while (nn_buckets < (int)vhosts.size() * 2) {
+        nn_buckets <<= 1;
+    }
+    buckets_.resize(nn_buckets, NULL);
+
+    for (int i = 0; i < (int)vhosts.size(); i++) {
+        string vhost = vhosts.at(i)->arg0();
+
+        // Ignore the duplicated vhost, the first one is used by get_vhost.
+        uint32_t hash = srs_vhost_hash(vhost);
+        SrsVhostSnapshot** pp = &buckets_[hash & (nn_buckets - 1)];
+        for (; *pp; pp = &(*pp)->next_) {
+            if ((*pp)->hash_ == hash && (*pp)->vhost_ == vhost) break;
+        }
+        if (!*pp) {
+            *pp = new SrsVhostSnapshot(conf, vhost);
+        }
+    }
+
+    // For vhost not exists, the getters use the default vhost, or the default values, so we build it by a
+    // vhost name never matched, which never be inserted to the table.
+    fallback_ = new SrsVhostSnapshot(conf, "");
+}
+
+SrsVhostSnapshots::~SrsVhostSnapshots()
+{
+    for (int i = 0; i < (int)buckets_.size(); i++) {
+        SrsVhostSnapshot* p = buckets_.at(i);
+        while (p) {
+            SrsVhostSnapshot* next = p->next_;
+            srs_freep(p);
+            p = next;
+        }
+    }
+    srs_freep(fallback_);
+}
+
+SrsVhostSnapshot* SrsVhostSnapshots::find(const string& vhost)
+{
+    uint32_t hash = srs_vhost_hash(vhost);
+    for (SrsVhostSnapshot* p = buckets_[hash & (buckets_.size() - 1)]; p; p = p->next_) {
+        if (p->hash_ == hash && p->vhost_ == vhost) {
+            return p;
+        }
+    }
+    return fallback_;
+}
+
+int SrsVhostSnapshots::size()
+{
+    int size = 0;
+    for (int i = 0; i < (int)buckets_.size(); i++) {
+        for (SrsVhostSnapshot* p = buckets_.at(i); p; p = p->next_) {
+            size++;
+        }
+    }
+    return size;
+}
+
 SrsConfig::SrsConfig()
 {
     env_only_ = false;
@@ -1296,11 +1415,14 @@ SrsConfig::SrsConfig()
     root = new SrsConfDirective();
     root->conf_line = 0;
     root->name = "root";
+
+    snapshots_ = NULL;
 }
 
 SrsConfig::~SrsConfig()
 {
     srs_freep(root);
+    srs_freep(snapshots_);
 }
 
 void SrsConfig::subscribe(ISrsReloadHandler* handler)
@@ -1581,6 +1703,10 @@ srs_error_t SrsConfig::reload_conf(SrsConfig* conf)
     
     root = conf->root;
     conf->root = NULL;
+
+    // Rebuild the snapshots before notifying the handlers, which might read the snapshot of vhost.
+    srs_freep(snapshots_);
+    snapshots_ = new SrsVhostSnapshots(this);
     
     // never support reload:
     //      daemon
@@ -1923,6 +2049,10 @@ srs_error_t SrsConfig::parse_options(int argc, char** argv)
         if (root->directives.empty()) root->get_or_create("vhost", "__defaultVhost__");
     }
 
+    // Build the snapshots of vhosts, after the config is transformed and overwritten by env.
+    srs_freep(snapshots_);
+    snapshots_ = new SrsVhostSnapshots(this);
+
     ////////////////////////////////////////////////////////////////////////
     // check log name and level
     ////////////////////////////////////////////////////////////////////////
@@ -2264,7 +2394,7 @@ srs_error_t SrsConfig::check_normal_config()
         SrsConfDirective* conf = root->at(i);
         std::string n = conf->name;
         if (n != "listen" && n != "pid" && n != "chunk_size" && n != "ff_log_dir"
-            && n != "srs_log_tank" && n != "srs_log_level" && n != "srs_log_level_v2" && n != "srs_log_file"
+            && n != "srs_log_tank" && n != "srs_log_level" && n != "srs_log_level_v2" && n != "srs_log_file" && n != "srs_log_async"
             && n != "max_connections" && n != "daemon" && n != "heartbeat" && n != "tencentcloud_apm"
             && n != "http_api" && n != "stats" && n != "vhost" && n != "pithy_print_ms"
             && n != "http_server" && n != "stream_caster" && n != "rtc_server" && n != "srt_server"
@@ -2356,7 +2486,8 @@ srs_error_t SrsConfig::check_normal_config()
             if (n != "enabled" && n != "listen" && n != "dir" && n != "candidate" && n != "ecdsa" && n != "tcp"
                 && n != "encrypt" && n != "reuseport" && n != "merge_nalus" && n != "black_hole" && n != "protocol"
                 && n != "ip_family" && n != "api_as_candidates" && n != "resolve_api_domain"
-                && n != "keep_api_domain" && n != "use_auto_detect_network_ip") {
+                && n != "keep_api_domain" && n != "use_auto_detect_network_ip" && n != "recvmmsg"
+                && n != "sendmmsg" && n != "gso" && n != "crypto_threads" && n != "dtls_threads" && n != "srtp_gcm") {
                 return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal rtc_server.%s", n.c_str());
             }
         }
@@ -2552,7 +2683,8 @@ srs_error_t SrsConfig::check_normal_config()
                     string m = conf->at(j)->name;
                     if (m != "time_jitter" && m != "mix_correct" && m != "atc" && m != "atc_auto" && m != "mw_latency"
                         && m != "gop_cache" && m != "gop_cache_max_frames" && m != "queue_length" && m != "send_min_interval" && m != "reduce_sequence_header"
-                        && m != "mw_msgs") {
+                        && m != "mw_msgs" && m != "adaptive_drop" && m != "adaptive_drop_nonref" && m != "adaptive_drop_gop"
+                        && m != "zerocopy") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.play.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                 }
@@ -2609,12 +2741,13 @@ srs_error_t SrsConfig::check_normal_config()
                         && m != "hls_storage" && m != "hls_mount" && m != "hls_td_ratio" && m != "hls_aof_ratio" && m != "hls_acodec" && m != "hls_vcodec"
                         && m != "hls_m3u8_file" && m != "hls_ts_file" && m != "hls_ts_floor" && m != "hls_cleanup" && m != "hls_nb_notify"
                         && m != "hls_wait_keyframe" && m != "hls_dispose" && m != "hls_keys" && m != "hls_fragments_per_key" && m != "hls_key_file"
-                        && m != "hls_key_file_path" && m != "hls_key_url" && m != "hls_dts_directly" && m != "hls_ctx" && m != "hls_ts_ctx") {
+                        && m != "hls_key_file_path" && m != "hls_key_url" && m != "hls_dts_directly" && m != "hls_ctx" && m != "hls_ts_ctx"
+                        && m != "hls_persist" && m != "hls_ll" && m != "hls_part") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.hls.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                     
                     // TODO: FIXME: remove it in future.
-                    if (m == "hls_storage" || m == "hls_mount") {
+                    if (m == "hls_mount") {
                         srs_warn("HLS RAM is removed in SRS3+");
                     }
                 }
@@ -2669,7 +2802,7 @@ srs_error_t SrsConfig::check_normal_config()
                     if (m != "enabled" && m != "nack" && m != "twcc" && m != "nack_no_copy"
                         && m != "bframe" && m != "aac" && m != "stun_timeout" && m != "stun_strict_check"
                         && m != "dtls_role" && m != "dtls_version" && m != "drop_for_pt" && m != "rtc_to_rtmp"
-                        && m != "pli_for_rtmp" && m != "rtmp_to_rtc" && m != "keep_bframe") {
+                        && m != "pli_for_rtmp" && m != "rtmp_to_rtc" && m != "keep_bframe" && m != "queue_size") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.rtc.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                 }
@@ -2824,6 +2957,9 @@ srs_error_t SrsConfig::parse_buffer(SrsConfigBuffer* buffer)
     srs_freep(root);
     root = new SrsConfDirective();
 
+    // The snapshots are built from the new root when used.
+    srs_freep(snapshots_);
+
     // Parse root tree from buffer.
     if ((err = root->parse(buffer, this)) != srs_success) {
         return srs_error_wrap(err, "root parse");
@@ -3245,6 +3381,25 @@ srs_utime_t SrsConfig::get_threads_interval()
     return v * SRS_UTIME_SECONDS;
 }
 
+int SrsConfig::get_threads_disk_writers()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.threads.disk_writers"); // SRS_THREADS_DISK_WRITERS
+
+    static int DEFAULT = 0;
+
+    SrsConfDirective* conf = root->get("threads");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("disk_writers");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_max(0, ::atoi(conf->arg0().c_str()));
+}
+
 bool SrsConfig::get_circuit_breaker()
 {
     SRS_OVERWRITE_BY_ENV_BOOL2("srs.circuit_breaker.enabled"); // SRS_CIRCUIT_BREAKER_ENABLED
@@ -4304,6 +4459,148 @@ int SrsConfig::get_rtc_server_reuseport2()
     return ::atoi(conf->arg0().c_str());
 }
 
+int SrsConfig::get_rtc_server_recvmmsg()
+{
+    int v = get_rtc_server_recvmmsg2();
+
+#if !defined(__linux__)
+    if (v > 1) {
+        srs_warn("recvmmsg not supported, reset to 0");
+        v = 0;
+    }
+#endif
+
+    return v;
+}
+
+int SrsConfig::get_rtc_server_recvmmsg2()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtc_server.recvmmsg"); // SRS_RTC_SERVER_RECVMMSG
+
+    static int DEFAULT = 0;
+
+    SrsConfDirective* conf = root->get("rtc_server");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("recvmmsg");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
+int SrsConfig::get_rtc_server_sendmmsg()
+{
+    int v = get_rtc_server_sendmmsg2();
+
+#if !defined(__linux__)
+    if (v > 1) {
+        srs_warn("sendmmsg not supported, reset to 0");
+        v = 0;
+    }
+#endif
+
+    return v;
+}
+
+int SrsConfig::get_rtc_server_sendmmsg2()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtc_server.sendmmsg"); // SRS_RTC_SERVER_SENDMMSG
+
+    static int DEFAULT = 0;
+
+    SrsConfDirective* conf = root->get("rtc_server");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("sendmmsg");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
+bool SrsConfig::get_rtc_server_gso()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.rtc_server.gso"); // SRS_RTC_SERVER_GSO
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("rtc_server");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("gso");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
+int SrsConfig::get_rtc_server_crypto_threads()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtc_server.crypto_threads"); // SRS_RTC_SERVER_CRYPTO_THREADS
+
+    static int DEFAULT = 0;
+
+    SrsConfDirective* conf = root->get("rtc_server");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("crypto_threads");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_max(0, ::atoi(conf->arg0().c_str()));
+}
+
+int SrsConfig::get_rtc_server_dtls_threads()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtc_server.dtls_threads"); // SRS_RTC_SERVER_DTLS_THREADS
+
+    static int DEFAULT = 0;
+
+    SrsConfDirective* conf = root->get("rtc_server");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("dtls_threads");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_max(0, ::atoi(conf->arg0().c_str()));
+}
+
+bool SrsConfig::get_rtc_server_srtp_gcm()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL2("srs.rtc_server.srtp_gcm"); // SRS_RTC_SERVER_SRTP_GCM
+
+    static bool DEFAULT = true;
+
+    SrsConfDirective* conf = root->get("rtc_server");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("srtp_gcm");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_TRUE(conf->arg0());
+}
+
 bool SrsConfig::get_rtc_server_merge_nalus()
 {
     SRS_OVERWRITE_BY_ENV_BOOL("srs.rtc_server.merge_nalus"); // SRS_RTC_SERVER_MERGE_NALUS
@@ -4536,6 +4833,26 @@ int SrsConfig::get_rtc_drop_for_pt(string vhost)
     return ::atoi(conf->arg0().c_str());
 }
 
+int SrsConfig::get_rtc_queue_size(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.vhost.rtc.queue_size"); // SRS_VHOST_RTC_QUEUE_SIZE
+
+    static int DEFAULT = 2048;
+
+    SrsConfDirective* conf = get_rtc(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("queue_size");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    int v = ::atoi(conf->arg0().c_str());
+    return v > 0 ? v : DEFAULT;
+}
+
 bool SrsConfig::get_rtc_to_rtmp(string vhost)
 {
     SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.rtc.rtc_to_rtmp"); // SRS_VHOST_RTC_RTC_TO_RTMP
@@ -4664,6 +4981,16 @@ SrsConfDirective* SrsConfig::get_vhost(string vhost, bool try_default_vhost)
     return NULL;
 }
 
+SrsVhostSnapshot* SrsConfig::get_vhost_snapshot(const string& vhost)
+{
+    // Build the snapshots when the config is loaded, or the root is changed.
+    if (!snapshots_) {
+        snapshots_ = new SrsVhostSnapshots(this);
+    }
+
+    return snapshots_->find(vhost);
+}
+
 void SrsConfig::get_vhosts(vector<SrsConfDirective*>& vhosts)
 {
     srs_assert(root);
@@ -4896,6 +5223,102 @@ srs_utime_t SrsConfig::get_queue_length(string vhost)
     return srs_utime_t(::atoi(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
 }
 
+bool SrsConfig::get_adaptive_drop(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.play.adaptive_drop"); // SRS_VHOST_PLAY_ADAPTIVE_DROP
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("adaptive_drop");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
+srs_utime_t SrsConfig::get_adaptive_drop_nonref(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_MILLISECONDS("srs.vhost.play.adaptive_drop_nonref"); // SRS_VHOST_PLAY_ADAPTIVE_DROP_NONREF
+
+    static srs_utime_t DEFAULT = 2 * SRS_UTIME_SECONDS;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("adaptive_drop_nonref");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return (srs_utime_t)(::atoi(conf->arg0().c_str()) * SRS_UTIME_MILLISECONDS);
+}
+
+srs_utime_t SrsConfig::get_adaptive_drop_gop(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_MILLISECONDS("srs.vhost.play.adaptive_drop_gop"); // SRS_VHOST_PLAY_ADAPTIVE_DROP_GOP
+
+    static srs_utime_t DEFAULT = 5 * SRS_UTIME_SECONDS;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("adaptive_drop_gop");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return (srs_utime_t)(::atoi(conf->arg0().c_str()) * SRS_UTIME_MILLISECONDS);
+}
+
+bool SrsConfig::get_play_zerocopy(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.play.zerocopy"); // SRS_VHOST_PLAY_ZEROCOPY
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("zerocopy");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
 bool SrsConfig::get_refer_enabled(string vhost)
 {
     static bool DEFAULT = false;
@@ -6510,6 +6933,21 @@ string SrsConfig::get_log_file()
     return conf->arg0();
 }
 
+bool SrsConfig::get_log_async()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.srs_log_async"); // SRS_SRS_LOG_ASYNC
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.log_async"); // SRS_LOG_ASYNC
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("srs_log_async");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
 bool SrsConfig::get_ff_log_enabled()
 {
     string log = get_ff_log_dir();
@@ -7099,6 +7537,87 @@ bool SrsConfig::get_hls_cleanup(string vhost)
     return SRS_CONF_PERFER_TRUE(conf->arg0());
 }
 
+string SrsConfig::get_hls_storage(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.vhost.hls.hls_storage"); // SRS_VHOST_HLS_HLS_STORAGE
+
+    static string DEFAULT = "disk";
+
+    SrsConfDirective* conf = get_hls(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("hls_storage");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    // Compatible with the ram of SRS2.
+    if (conf->arg0() == "ram") {
+        return "memory";
+    }
+
+    return conf->arg0();
+}
+
+bool SrsConfig::get_hls_persist(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.hls.hls_persist"); // SRS_VHOST_HLS_HLS_PERSIST
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_hls(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("hls_persist");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
+bool SrsConfig::get_hls_ll(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.hls.hls_ll"); // SRS_VHOST_HLS_HLS_LL
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_hls(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("hls_ll");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
+srs_utime_t SrsConfig::get_hls_part(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_FLOAT_SECONDS("srs.vhost.hls.hls_part"); // SRS_VHOST_HLS_HLS_PART
+
+    static srs_utime_t DEFAULT = 1 * SRS_UTIME_SECONDS;
+
+    SrsConfDirective* conf = get_hls(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("hls_part");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_utime_t(::atof(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
+}
+
 srs_utime_t SrsConfig::get_hls_dispose(string vhost)
 {
     SRS_OVERWRITE_BY_ENV_SECONDS("srs.vhost.hls.hls_dispose"); // SRS_VHOST_HLS_HLS_DISPOSE
@@ -8298,6 +8817,25 @@ string SrsConfig::get_https_stream_ssl_cert()
     return conf->arg0();
 }
 
+bool SrsConfig::get_https_stream_ktls()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.http_server.https.ktls"); // SRS_HTTP_SERVER_HTTPS_KTLS
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_https_stream();
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("ktls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PERFER_FALSE(conf->arg0());
+}
+
 bool SrsConfig::get_vhost_http_enabled(string vhost)
 {
     SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.http_static.enabled"); // SRS_VHOST_HTTP_STATIC_ENABLED
@@ -256,6 +256,70 @@ private:
     virtual srs_error_t read_token(srs_internal::SrsConfigBuffer* buffer, std::vector<std::string>& args, int& line_start, SrsDirectiveState& state);
 };
 
+// The immutable snapshot of a vhost, for the hot paths such as source, rtc_conn and hls, which read the
+// config for each sequence header, STUN binding or session. It's built once when config is loaded or
+// reloaded by the getters, so the default values and env overwrites are the same, and read without
+// walking the directive tree or getenv.
+// @remark Never keep the snapshot cross st-thread, for it's free when reload, like the directive.
+class SrsVhostSnapshot
+{
+    friend class SrsVhostSnapshots;
+private:
+    std::string vhost_;
+    uint32_t hash_;
+    SrsVhostSnapshot* next_;
+public:
+    // The vhost section.
+    bool is_edge;
+    bool gop_cache;
+    srs_utime_t queue_length;
+    // The play section.
+    bool adaptive_drop;
+    srs_utime_t adaptive_drop_nonref;
+    srs_utime_t adaptive_drop_gop;
+    bool atc;
+    bool atc_auto;
+    int time_jitter;
+    bool mix_correct;
+    // The publish section.
+    bool parse_sps;
+    bool reduce_sequence_header;
+    // The hls section.
+    bool hls_enabled;
+    bool hls_dts_directly;
+    std::string hls_on_error;
+    // The rtc section.
+    bool rtc_stun_strict_check;
+    bool rtc_nack_enabled;
+    bool rtc_nack_no_copy;
+    bool rtc_twcc_enabled;
+    int rtc_drop_for_pt;
+public:
+    SrsVhostSnapshot(SrsConfig* conf, std::string vhost);
+    virtual ~SrsVhostSnapshot();
+public:
+    std::string vhost();
+};
+
+// The hash table of vhost snapshots, keyed by the vhost name.
+class SrsVhostSnapshots
+{
+private:
+    // The buckets of hash table, the size is power of 2.
+    std::vector<SrsVhostSnapshot*> buckets_;
+    // The snapshot for vhost not in config, which is the default vhost or the default values.
+    SrsVhostSnapshot* fallback_;
+public:
+    // Build the snapshots for all vhosts of conf.
+    SrsVhostSnapshots(SrsConfig* conf);
+    virtual ~SrsVhostSnapshots();
+public:
+    // Find the snapshot of vhost, never NULL.
+    SrsVhostSnapshot* find(const std::string& vhost);
+    // Get the number of vhost snapshots.
+    int size();
+};
+
 // The config service provider.
 // For the config supports reload, so never keep the reference cross st-thread,
 // that is, never save the SrsConfDirective* get by any api of config,
@@ -292,6 +356,8 @@ private:
 protected:
     // The directive root.
     SrsConfDirective* root;
+    // The snapshots of vhosts, built when config is loaded or reloaded.
+    SrsVhostSnapshots* snapshots_;
 // Reload  section
 private:
     // The reload subscribers, when reload, callback all handlers.
@@ -443,6 +509,8 @@ public:
 // Thread pool section.
 public:
     virtual srs_utime_t get_threads_interval();
+    // Get the number of disk writer threads, for HLS, DVR and DASH.
+    virtual int get_threads_disk_writers();
     virtual bool get_circuit_breaker();
     virtual int get_high_threshold();
     virtual int get_high_pulse();
@@ -510,11 +578,25 @@ public:
     virtual bool get_rtc_server_encrypt();
     virtual int get_rtc_server_reuseport();
     virtual bool get_rtc_server_merge_nalus();
+    // The max number of UDP packets to receive by one recvmmsg, disabled if not greater than 1.
+    virtual int get_rtc_server_recvmmsg();
+    // The max number of UDP packets to send by one sendmmsg for each player, disabled if not greater than 1.
+    virtual int get_rtc_server_sendmmsg();
+    // Whether send the batch of packets by UDP GSO, if they are the same size.
+    virtual bool get_rtc_server_gso();
+    // The number of crypto worker threads for SRTP, 0 to protect packets in hybrid thread.
+    virtual int get_rtc_server_crypto_threads();
+    // The number of DTLS worker threads for handshakes, 0 to do handshakes in hybrid thread.
+    virtual int get_rtc_server_dtls_threads();
+    // Whether prefer the AEAD GCM profiles of SRTP, fallback to AES_CM_128_HMAC_SHA1_80 if peer not support.
+    virtual bool get_rtc_server_srtp_gcm();
 public:
     virtual bool get_rtc_server_black_hole();
     virtual std::string get_rtc_server_black_hole_addr();
 private:
     virtual int get_rtc_server_reuseport2();
+    virtual int get_rtc_server_recvmmsg2();
+    virtual int get_rtc_server_sendmmsg2();
 
 public:
     SrsConfDirective* get_rtc(std::string vhost);
@@ -526,6 +608,8 @@ public:
     std::string get_rtc_dtls_role(std::string vhost);
     std::string get_rtc_dtls_version(std::string vhost);
     int get_rtc_drop_for_pt(std::string vhost);
+    // The max number of RTP packets in queue of each player.
+    int get_rtc_queue_size(std::string vhost);
     bool get_rtc_to_rtmp(std::string vhost);
     srs_utime_t get_rtc_pli_for_rtmp(std::string vhost);
     bool get_rtc_nack_enabled(std::string vhost);
@@ -538,6 +622,9 @@ public:
     // @param vhost, the name of vhost to get.
     // @param try_default_vhost whether try default when get specified vhost failed.
     virtual SrsConfDirective* get_vhost(std::string vhost, bool try_default_vhost = true);
+    // Get the snapshot of vhost, the default vhost or default values if not exists, never NULL.
+    // @remark Never keep the snapshot, which is free when reload.
+    virtual SrsVhostSnapshot* get_vhost_snapshot(const std::string& vhost);
     // Get all vhosts in config file.
     virtual void get_vhosts(std::vector<SrsConfDirective*>& vhosts);
     // Whether vhost is enabled
@@ -583,6 +670,14 @@ public:
     // when exceed the queue length, drop packet util I frame.
     // @remark, default 10s.
     virtual srs_utime_t get_queue_length(std::string vhost);
+    // Whether enable the adaptive frame dropping for slow players.
+    virtual bool get_adaptive_drop(std::string vhost);
+    // Get the queue duration to drop the non-reference frames, for slow players.
+    virtual srs_utime_t get_adaptive_drop_nonref(std::string vhost);
+    // Get the queue duration to drop the whole GOP, for slow players.
+    virtual srs_utime_t get_adaptive_drop_gop(std::string vhost);
+    // Whether send the media payloads by MSG_ZEROCOPY, for RTMP and HTTP-FLV players.
+    virtual bool get_play_zerocopy(std::string vhost);
     // Whether the refer hotlink-denial enabled.
     virtual bool get_refer_enabled(std::string vhost);
     // Get the refer hotlink-denial for all type.
@@ -876,6 +971,8 @@ public:
     virtual std::string get_log_level_v2();
     // Get the log file path.
     virtual std::string get_log_file();
+    // Whether write log in background thread.
+    virtual bool get_log_async();
     // Whether ffmpeg log enabled
     virtual bool get_ff_log_enabled();
     // The ffmpeg log dir.
@@ -944,6 +1041,14 @@ public:
     virtual std::string get_hls_vcodec(std::string vhost);
     // Whether cleanup the old ts files.
     virtual bool get_hls_cleanup(std::string vhost);
+    // Get the storage of HLS, disk or memory.
+    virtual std::string get_hls_storage(std::string vhost);
+    // Whether persist the segments to disk asynchronously, for memory storage.
+    virtual bool get_hls_persist(std::string vhost);
+    // Whether enable LL-HLS, the partial segments and blocking playlist reload.
+    virtual bool get_hls_ll(std::string vhost);
+    // Get the target duration in srs_utime_t of LL-HLS partial segment.
+    virtual srs_utime_t get_hls_part(std::string vhost);
     // The timeout in srs_utime_t to dispose the hls.
     virtual srs_utime_t get_hls_dispose(std::string vhost);
     // Whether reap the ts when got keyframe.
@@ -1058,6 +1163,8 @@ public:
     virtual std::string get_https_stream_listen();
     virtual std::string get_https_stream_ssl_key();
     virtual std::string get_https_stream_ssl_cert();
+    // Whether encrypt the HTTPS response by kernel, by kTLS.
+    virtual bool get_https_stream_ktls();
 public:
     // Get whether vhost enabled http stream
     virtual bool get_vhost_http_enabled(std::string vhost);
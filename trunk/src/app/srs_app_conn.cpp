@@ -8,6 +8,12 @@
 
 #include <netinet/tcp.h>
 #include <algorithm>
+#include <openssl/hmac.h>
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#endif
+#endif
 using namespace std;
 
 #include <srs_kernel_log.hpp>
@@ -588,6 +594,31 @@ srs_error_t SrsTcpConnection::writev(const iovec *iov, int iov_size, ssize_t* nw
     return skt->writev(iov, iov_size, nwrite);
 }
 
+bool SrsTcpConnection::sendfile_supported()
+{
+    return skt->sendfile_supported();
+}
+
+srs_error_t SrsTcpConnection::sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite)
+{
+    return skt->sendfile(fd, offset, size, nwrite);
+}
+
+srs_error_t SrsTcpConnection::enable_ktls(const void* crypto_info, int size)
+{
+    return skt->enable_ktls(crypto_info, size);
+}
+
+srs_error_t SrsTcpConnection::enable_zerocopy()
+{
+    return skt->enable_zerocopy();
+}
+
+srs_error_t SrsTcpConnection::writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite)
+{
+    return skt->writev_zerocopy(iov, iov_size, pin, nwrite);
+}
+
 SrsBufferedReadWriter::SrsBufferedReadWriter(ISrsProtocolReadWriter* io)
 {
     io_ = io;
@@ -712,11 +743,141 @@ srs_error_t SrsBufferedReadWriter::writev(const iovec *iov, int iov_size, ssize_
     return io_->writev(iov, iov_size, nwrite);
 }
 
+bool SrsBufferedReadWriter::sendfile_supported()
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(io_);
+    return fw && fw->sendfile_supported();
+}
+
+srs_error_t SrsBufferedReadWriter::sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite)
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(io_);
+    if (!fw) {
+        return srs_error_new(ERROR_SOCKET_WRITE, "sendfile not supported");
+    }
+    return fw->sendfile(fd, offset, size, nwrite);
+}
+
+srs_error_t SrsBufferedReadWriter::enable_ktls(const void* crypto_info, int size)
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(io_);
+    if (!fw) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "kTLS not supported");
+    }
+    return fw->enable_ktls(crypto_info, size);
+}
+
+srs_error_t SrsBufferedReadWriter::enable_zerocopy()
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(io_);
+    if (!fw) {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "MSG_ZEROCOPY not supported");
+    }
+    return fw->enable_zerocopy();
+}
+
+srs_error_t SrsBufferedReadWriter::writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite)
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(io_);
+    if (!fw) {
+        srs_freep(pin);
+        return io_->writev(iov, iov_size, nwrite);
+    }
+    return fw->writev_zerocopy(iov, iov_size, pin, nwrite);
+}
+
+srs_error_t srs_ssl_server_write_key(SSL* ssl, string& key, string& salt)
+{
+    srs_error_t err = srs_success;
+
+#if (OPENSSL_VERSION_NUMBER < 0x10101000L) // v1.1.1
+    return srs_error_new(ERROR_HTTPS_KTLS, "OpenSSL %s not supported", OPENSSL_VERSION_TEXT);
+#else
+    if (SSL_version(ssl) != TLS1_2_VERSION) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "version %s not supported", SSL_get_version(ssl));
+    }
+
+    // Only AES-GCM, the AEAD cipher without MAC key, which is supported by kernel.
+    const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+    int nid = cipher ? SSL_CIPHER_get_cipher_nid(cipher) : NID_undef;
+    if (nid != NID_aes_128_gcm && nid != NID_aes_256_gcm) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "cipher %s not supported", SSL_CIPHER_get_name(cipher));
+    }
+
+    const EVP_MD* md = SSL_CIPHER_get_handshake_digest(cipher);
+    SSL_SESSION* session = SSL_get_session(ssl);
+    if (!md || !session) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "no digest or session");
+    }
+
+    uint8_t master[SSL_MAX_MASTER_KEY_LENGTH];
+    int nn_master = (int)SSL_SESSION_get_master_key(session, master, sizeof(master));
+
+    // The seed is label + server_random + client_random, see RFC5246 section 6.3
+    uint8_t seed[13 + SSL3_RANDOM_SIZE * 2];
+    memcpy(seed, "key expansion", 13);
+    SSL_get_server_random(ssl, seed + 13, SSL3_RANDOM_SIZE);
+    SSL_get_client_random(ssl, seed + 13 + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+    // The key block is client_write_key, server_write_key, client_write_IV and server_write_IV.
+    int nn_key = (nid == NID_aes_128_gcm) ? 16 : 32;
+    int nn_salt = 4;
+    int nn_block = nn_key * 2 + nn_salt * 2;
+
+    // P_hash(secret, seed) = HMAC(secret, A(1) + seed) + HMAC(secret, A(2) + seed) + ..., where A(0) = seed and
+    // A(i) = HMAC(secret, A(i-1)), see RFC5246 section 5.
+    uint8_t block[128];
+    uint8_t a[EVP_MAX_MD_SIZE + sizeof(seed)];
+    uint8_t out[EVP_MAX_MD_SIZE];
+    unsigned int nn_a = 0, nn_out = 0;
+    if (!HMAC(md, master, nn_master, seed, sizeof(seed), a, &nn_a)) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "HMAC A(1)");
+    }
+    for (int pos = 0; pos < nn_block; pos += nn_out) {
+        memcpy(a + nn_a, seed, sizeof(seed));
+        if (!HMAC(md, master, nn_master, a, nn_a + sizeof(seed), out, &nn_out)) {
+            return srs_error_new(ERROR_HTTPS_KTLS, "HMAC P_hash");
+        }
+        memcpy(block + pos, out, srs_min((int)nn_out, nn_block - pos));
+
+        if (!HMAC(md, master, nn_master, a, nn_a, out, &nn_a)) {
+            return srs_error_new(ERROR_HTTPS_KTLS, "HMAC A(i)");
+        }
+        memcpy(a, out, nn_a);
+    }
+
+    key = string((char*)block + nn_key, nn_key);
+    salt = string((char*)block + nn_key * 2 + nn_salt, nn_salt);
+    return err;
+#endif
+}
+
+#if defined(TLS_1_2_VERSION) && defined(TLS_CIPHER_AES_GCM_256)
+// Fill the crypto info of kernel, for tls12_crypto_info_aes_gcm_128 or tls12_crypto_info_aes_gcm_256.
+template<typename T>
+void srs_ktls_crypto_info(T* info, int cipher_type, string& key, string& salt, uint64_t seq)
+{
+    memset(info, 0, sizeof(T));
+    info->info.version = TLS_1_2_VERSION;
+    info->info.cipher_type = cipher_type;
+
+    srs_assert(key.length() == sizeof(info->key) && salt.length() == sizeof(info->salt));
+    memcpy(info->key, key.data(), key.length());
+    memcpy(info->salt, salt.data(), salt.length());
+
+    // The explicit nonce is the sequence number, like OpenSSL does for kTLS.
+    for (int i = 0; i < 8; i++) {
+        info->rec_seq[i] = info->iv[i] = (uint8_t)(seq >> (56 - 8 * i));
+    }
+}
+#endif
+
 SrsSslConnection::SrsSslConnection(ISrsProtocolReadWriter* c)
 {
     transport = c;
     ssl_ctx = NULL;
     ssl = NULL;
+    ktls_ = false;
 }
 
 SrsSslConnection::~SrsSslConnection()
@@ -878,6 +1039,52 @@ srs_error_t SrsSslConnection::handshake(string key_file, string crt_file)
 }
 #pragma GCC diagnostic pop
 
+srs_error_t SrsSslConnection::setup_ktls()
+{
+    srs_error_t err = srs_success;
+
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(transport);
+    if (!fw) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "transport not supported");
+    }
+
+    string key, salt;
+    if ((err = srs_ssl_server_write_key(ssl, key, salt)) != srs_success) {
+        return srs_error_wrap(err, "server write key");
+    }
+
+#if defined(TLS_1_2_VERSION) && defined(TLS_CIPHER_AES_GCM_256)
+    // The server has sent the Finished by sequence 0 after ChangeCipherSpec, so kernel starts from sequence 1.
+    if (key.length() == TLS_CIPHER_AES_GCM_128_KEY_SIZE) {
+        tls12_crypto_info_aes_gcm_128 info;
+        srs_ktls_crypto_info(&info, TLS_CIPHER_AES_GCM_128, key, salt, 1);
+        err = fw->enable_ktls(&info, sizeof(info));
+    } else {
+        tls12_crypto_info_aes_gcm_256 info;
+        srs_ktls_crypto_info(&info, TLS_CIPHER_AES_GCM_256, key, salt, 1);
+        err = fw->enable_ktls(&info, sizeof(info));
+    }
+    if (err != srs_success) {
+        return srs_error_wrap(err, "enable ktls");
+    }
+#else
+    return srs_error_new(ERROR_HTTPS_KTLS, "kTLS not supported");
+#endif
+
+    // Kernel never writes the response of renegotiation, which is encrypted by OpenSSL.
+#ifdef SSL_OP_NO_RENEGOTIATION
+    SSL_set_options(ssl, SSL_OP_NO_RENEGOTIATION);
+#endif
+
+    ktls_ = true;
+    return err;
+}
+
+bool SrsSslConnection::ktls_enabled()
+{
+    return ktls_;
+}
+
 void SrsSslConnection::set_recv_timeout(srs_utime_t tm)
 {
     transport->set_recv_timeout(tm);
@@ -963,6 +1170,11 @@ srs_error_t SrsSslConnection::write(void* plaintext, size_t nn_plaintext, ssize_
 {
     srs_error_t err = srs_success;
 
+    // Write plaintext to transport, the kernel encrypts it.
+    if (ktls_) {
+        return transport->write(plaintext, nn_plaintext, nwrite);
+    }
+
     for (char* p = (char*)plaintext; p < (char*)plaintext + nn_plaintext;) {
         int left = (int)nn_plaintext - (p - (char*)plaintext);
         int r0 = SSL_write(ssl, (const void*)p, left);
@@ -994,6 +1206,10 @@ srs_error_t SrsSslConnection::writev(const iovec *iov, int iov_size, ssize_t* nw
 {
     srs_error_t err = srs_success;
 
+    if (ktls_) {
+        return transport->writev(iov, iov_size, nwrite);
+    }
+
     for (int i = 0; i < iov_size; i++) {
         const iovec* p = iov + i;
         if ((err = write((void*)p->iov_base, (size_t)p->iov_len, nwrite)) != srs_success) {
@@ -1004,3 +1220,36 @@ srs_error_t SrsSslConnection::writev(const iovec *iov, int iov_size, ssize_t* nw
     return err;
 }
 
+bool SrsSslConnection::sendfile_supported()
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(transport);
+    return ktls_ && fw && fw->sendfile_supported();
+}
+
+srs_error_t SrsSslConnection::sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite)
+{
+    // Only the plaintext of file is able to send by kTLS.
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(transport);
+    if (!ktls_ || !fw) {
+        return srs_error_new(ERROR_HTTPS_WRITE, "sendfile requires kTLS");
+    }
+    return fw->sendfile(fd, offset, size, nwrite);
+}
+
+srs_error_t SrsSslConnection::enable_ktls(const void* crypto_info, int size)
+{
+    return srs_error_new(ERROR_HTTPS_KTLS, "use setup_ktls instead");
+}
+
+srs_error_t SrsSslConnection::enable_zerocopy()
+{
+    // The data is encrypted by OpenSSL, or by kernel which rejects MSG_ZEROCOPY for kTLS.
+    return srs_error_new(ERROR_SOCKET_ZEROCOPY, "MSG_ZEROCOPY not supported for SSL");
+}
+
+srs_error_t SrsSslConnection::writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite)
+{
+    srs_freep(pin);
+    return writev(iov, iov_size, nwrite);
+}
+
@@ -233,7 +233,7 @@ public:
 // The basic connection of SRS, for TCP based protocols,
 // all connections accept from listener must extends from this base class,
 // server will add the connection to manager, and delete it when remove.
-class SrsTcpConnection : public ISrsProtocolReadWriter
+class SrsTcpConnection : public ISrsProtocolReadWriter, public ISrsProtocolFileWriter
 {
 private:
     // The underlayer st fd handler.
@@ -260,11 +260,18 @@ public:
     virtual srs_utime_t get_send_timeout();
     virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
     virtual srs_error_t writev(const iovec *iov, int iov_size, ssize_t* nwrite);
+// Interface ISrsProtocolFileWriter
+public:
+    virtual bool sendfile_supported();
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite);
+    virtual srs_error_t enable_ktls(const void* crypto_info, int size);
+    virtual srs_error_t enable_zerocopy();
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite);
 };
 
 // With a small fast read buffer, to support peek for protocol detecting. Note that directly write to io without any
 // cache or buffer.
-class SrsBufferedReadWriter : public ISrsProtocolReadWriter
+class SrsBufferedReadWriter : public ISrsProtocolReadWriter, public ISrsProtocolFileWriter
 {
 private:
     // The under-layer transport.
@@ -294,10 +301,22 @@ public:
     virtual srs_utime_t get_send_timeout();
     virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
     virtual srs_error_t writev(const iovec *iov, int iov_size, ssize_t* nwrite);
+// Interface ISrsProtocolFileWriter
+public:
+    virtual bool sendfile_supported();
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite);
+    virtual srs_error_t enable_ktls(const void* crypto_info, int size);
+    virtual srs_error_t enable_zerocopy();
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite);
 };
 
+// Derive the key and salt, that is the implicit part of nonce, for server to write TLS1.2 AES-GCM records. The key
+// block is generated by the PRF of RFC5246 section 5, and partitioned by section 6.3, see also RFC5288.
+// @remark The ssl must be in server mode, and done the handshake.
+extern srs_error_t srs_ssl_server_write_key(SSL* ssl, std::string& key, std::string& salt);
+
 // The SSL connection over TCP transport, in server mode.
-class SrsSslConnection : public ISrsProtocolReadWriter
+class SrsSslConnection : public ISrsProtocolReadWriter, public ISrsProtocolFileWriter
 {
 private:
     // The under-layer plaintext transport.
@@ -307,11 +326,17 @@ private:
     SSL* ssl;
     BIO* bio_in;
     BIO* bio_out;
+    // Whether kernel encrypts the sent data, then we write plaintext to transport directly.
+    bool ktls_;
 public:
     SrsSslConnection(ISrsProtocolReadWriter* c);
     virtual ~SrsSslConnection();
 public:
     virtual srs_error_t handshake(std::string key_file, std::string crt_file);
+    // Offload the encryption of sent data to kernel by kTLS, after handshake. Note that the received data is still
+    // decrypted by OpenSSL. User should ignore the error, and it falls back to encrypt by OpenSSL.
+    virtual srs_error_t setup_ktls();
+    virtual bool ktls_enabled();
 // Interface ISrsProtocolReadWriter
 public:
     virtual void set_recv_timeout(srs_utime_t tm);
@@ -324,6 +349,13 @@ public:
     virtual srs_utime_t get_send_timeout();
     virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
     virtual srs_error_t writev(const iovec *iov, int iov_size, ssize_t* nwrite);
+// Interface ISrsProtocolFileWriter
+public:
+    virtual bool sendfile_supported();
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite);
+    virtual srs_error_t enable_ktls(const void* crypto_info, int size);
+    virtual srs_error_t enable_zerocopy();
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite);
 };
 
 #endif
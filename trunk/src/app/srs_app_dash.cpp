@@ -13,6 +13,7 @@
 #include <srs_kernel_codec.hpp>
 #include <srs_kernel_utility.hpp>
 #include <srs_app_utility.hpp>
+#include <srs_app_threads.hpp>
 #include <srs_kernel_file.hpp>
 #include <srs_core_autofree.hpp>
 #include <srs_kernel_mp4.hpp>
@@ -37,7 +38,7 @@ string srs_time_to_utc_format_str(srs_utime_t u)
 
 SrsInitMp4::SrsInitMp4()
 {
-    fw = new SrsFileWriter();
+    fw = new SrsAsyncFileWriter();
     init = new SrsMp4M2tsInitEncoder();
 }
 
@@ -63,13 +64,16 @@ srs_error_t SrsInitMp4::write(SrsFormat* format, bool video, int tid)
     if ((err = init->write(format, video, tid)) != srs_success) {
         return srs_error_wrap(err, "write init");
     }
+
+    // Close the file before rename it, to make sure all bytes are written.
+    fw->close();
     
     return err;
 }
 
 SrsFragmentedMp4::SrsFragmentedMp4()
 {
-    fw = new SrsFileWriter();
+    fw = new SrsAsyncFileWriter();
     enc = new SrsMp4M2tsSegmentEncoder();
 }
 
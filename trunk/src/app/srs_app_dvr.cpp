@@ -25,6 +25,7 @@ using namespace std;
 #include <srs_app_utility.hpp>
 #include <srs_kernel_mp4.hpp>
 #include <srs_app_fragment.hpp>
+#include <srs_app_threads.hpp>
 
 #define SRS_FWRITE_CACHE_SIZE 65536
 
@@ -36,7 +37,7 @@ SrsDvrSegmenter::SrsDvrSegmenter()
     wait_keyframe = true;
     
     fragment = new SrsFragment();
-    fs = new SrsFileWriter();
+    fs = new SrsAsyncFileWriter();
     jitter_algorithm = SrsRtmpJitterAlgorithmOFF;
     
     _srs_config->subscribe(this);
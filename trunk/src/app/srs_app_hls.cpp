@@ -33,7 +33,9 @@ using namespace std;
 #include <srs_kernel_ts.hpp>
 #include <srs_app_utility.hpp>
 #include <srs_app_http_hooks.hpp>
+#include <srs_app_threads.hpp>
 #include <srs_protocol_format.hpp>
+#include <srs_kernel_stream.hpp>
 #include <openssl/rand.h>
 
 // drop the segment when duration of ts too small.
@@ -44,17 +46,368 @@ using namespace std;
 #define SRS_HLS_FLOOR_REAP_PERCENT 0.3
 // reset the piece id when deviation overflow this.
 #define SRS_JUMP_WHEN_PIECE_DEVIATION 20
+// For LL-HLS, only the last segments list the parts in m3u8.
+#define SRS_HLS_LL_SEGMENTS_WITH_PARTS 2
+
+SrsHlsMemoryBuffer::SrsHlsMemoryPayload::SrsHlsMemoryPayload()
+{
+    data = new SrsSimpleStream();
+    shared_count = 0;
+}
+
+SrsHlsMemoryBuffer::SrsHlsMemoryPayload::~SrsHlsMemoryPayload()
+{
+    srs_freep(data);
+}
+
+SrsHlsMemoryBuffer::SrsHlsMemoryBuffer()
+{
+    ptr = new SrsHlsMemoryPayload();
+}
+
+SrsHlsMemoryBuffer::~SrsHlsMemoryBuffer()
+{
+    if (ptr->shared_count == 0) {
+        srs_freep(ptr);
+    } else {
+        ptr->shared_count--;
+    }
+}
+
+void SrsHlsMemoryBuffer::append(const char* bytes, int size)
+{
+    if (size > 0) {
+        ptr->data->append(bytes, size);
+    }
+}
+
+char* SrsHlsMemoryBuffer::bytes()
+{
+    return ptr->data->bytes();
+}
+
+int SrsHlsMemoryBuffer::length()
+{
+    return ptr->data->length();
+}
+
+SrsHlsMemoryBuffer* SrsHlsMemoryBuffer::copy()
+{
+    SrsHlsMemoryBuffer* copy = new SrsHlsMemoryBuffer();
+
+    srs_freep(copy->ptr);
+    copy->ptr = ptr;
+    ptr->shared_count++;
+
+    return copy;
+}
+
+bool SrsHlsMemoryBuffer::shares(SrsHlsMemoryBuffer* other)
+{
+    return other && other->ptr == ptr;
+}
+
+SrsHlsMemoryWriter::SrsHlsMemoryWriter()
+{
+    buffer_ = NULL;
+}
+
+SrsHlsMemoryWriter::~SrsHlsMemoryWriter()
+{
+    srs_freep(buffer_);
+}
+
+SrsHlsMemoryBuffer* SrsHlsMemoryWriter::buffer()
+{
+    return buffer_;
+}
+
+srs_error_t SrsHlsMemoryWriter::open(string p)
+{
+    srs_freep(buffer_);
+    buffer_ = new SrsHlsMemoryBuffer();
+    return srs_success;
+}
+
+void SrsHlsMemoryWriter::close()
+{
+    srs_freep(buffer_);
+}
+
+bool SrsHlsMemoryWriter::is_open()
+{
+    return buffer_ != NULL;
+}
+
+int64_t SrsHlsMemoryWriter::tellg()
+{
+    return buffer_ ? buffer_->length() : 0;
+}
+
+srs_error_t SrsHlsMemoryWriter::write(void* buf, size_t count, ssize_t* pnwrite)
+{
+    srs_assert(buffer_);
+
+    buffer_->append((const char*)buf, (int)count);
+
+    if (pnwrite) {
+        *pnwrite = count;
+    }
+
+    return srs_success;
+}
+
+srs_error_t SrsHlsMemoryWriter::writev(const iovec* iov, int iovcnt, ssize_t* pnwrite)
+{
+    srs_assert(buffer_);
+
+    ssize_t nwrite = 0;
+    for (int i = 0; i < iovcnt; i++) {
+        const iovec* piov = iov + i;
+        buffer_->append((const char*)piov->iov_base, (int)piov->iov_len);
+        nwrite += piov->iov_len;
+    }
+
+    if (pnwrite) {
+        *pnwrite = nwrite;
+    }
+
+    return srs_success;
+}
+
+srs_error_t SrsHlsMemoryWriter::lseek(off_t offset, int whence, off_t* seeked)
+{
+    // The memory writer is append only.
+    return srs_error_new(ERROR_SYSTEM_FILE_SEEK, "seek memory writer");
+}
+
+SrsHlsMemoryPlaylist::SrsHlsMemoryPlaylist()
+{
+    msn = 0;
+    part = -1;
+    timeout = 0;
+}
+
+SrsHlsMemoryPlaylist::~SrsHlsMemoryPlaylist()
+{
+}
+
+SrsHlsMemoryStore* _srs_hls_memory = NULL;
+
+SrsHlsMemoryStore::SrsHlsMemoryStore()
+{
+    cond_ = srs_cond_new();
+}
+
+SrsHlsMemoryStore::~SrsHlsMemoryStore()
+{
+    std::map<std::string, SrsHlsMemoryBuffer*>::iterator it;
+    for (it = files_.begin(); it != files_.end(); ++it) {
+        SrsHlsMemoryBuffer* buffer = it->second;
+        srs_freep(buffer);
+    }
+    files_.clear();
+
+    std::map<std::string, SrsHlsMemoryPlaylist*>::iterator it2;
+    for (it2 = playlists_.begin(); it2 != playlists_.end(); ++it2) {
+        SrsHlsMemoryPlaylist* playlist = it2->second;
+        srs_freep(playlist);
+    }
+    playlists_.clear();
+
+    srs_cond_destroy(cond_);
+}
+
+void SrsHlsMemoryStore::set(string path, SrsHlsMemoryBuffer* buffer)
+{
+    std::map<std::string, SrsHlsMemoryBuffer*>::iterator it = files_.find(path);
+    if (it != files_.end()) {
+        SrsHlsMemoryBuffer* previous = it->second;
+        srs_freep(previous);
+    }
+
+    files_[path] = buffer->copy();
+}
+
+void SrsHlsMemoryStore::remove(string path, SrsHlsMemoryBuffer* buffer)
+{
+    std::map<std::string, SrsHlsMemoryBuffer*>::iterator it = files_.find(path);
+    if (it == files_.end()) {
+        return;
+    }
+
+    SrsHlsMemoryBuffer* file = it->second;
+    if (buffer && !file->shares(buffer)) {
+        return;
+    }
+
+    files_.erase(it);
+    srs_freep(file);
+}
+
+SrsHlsMemoryBuffer* SrsHlsMemoryStore::fetch(string path)
+{
+    std::map<std::string, SrsHlsMemoryBuffer*>::iterator it = files_.find(path);
+    if (it == files_.end()) {
+        return NULL;
+    }
+
+    return it->second->copy();
+}
+
+bool SrsHlsMemoryStore::exists(string path)
+{
+    return files_.find(path) != files_.end();
+}
+
+bool SrsHlsMemoryStore::empty()
+{
+    return files_.empty();
+}
+
+void SrsHlsMemoryStore::update_playlist(string path, SrsHlsMemoryBuffer* buffer, int64_t msn, int part, string hint, srs_utime_t timeout)
+{
+    set(path, buffer);
+
+    SrsHlsMemoryPlaylist* playlist = NULL;
+    std::map<std::string, SrsHlsMemoryPlaylist*>::iterator it = playlists_.find(path);
+    if (it != playlists_.end()) {
+        playlist = it->second;
+    } else {
+        playlist = playlists_[path] = new SrsHlsMemoryPlaylist();
+    }
+
+    playlist->msn = msn;
+    playlist->part = part;
+    playlist->timeout = timeout;
+
+    if (playlist->hint != hint) {
+        hints_.erase(playlist->hint);
+        playlist->hint = hint;
+        if (!hint.empty()) {
+            hints_[hint] = path;
+        }
+    }
+
+    srs_cond_broadcast(cond_);
+}
+
+void SrsHlsMemoryStore::remove_playlist(string path)
+{
+    remove(path);
+
+    std::map<std::string, SrsHlsMemoryPlaylist*>::iterator it = playlists_.find(path);
+    if (it == playlists_.end()) {
+        return;
+    }
+
+    // The blocking requests always find the playlist again when wakeup, so it's safe to free it.
+    SrsHlsMemoryPlaylist* playlist = it->second;
+    playlists_.erase(it);
+    hints_.erase(playlist->hint);
+    srs_freep(playlist);
+
+    srs_cond_broadcast(cond_);
+}
+
+srs_error_t SrsHlsMemoryStore::wait_playlist(string path, int64_t msn, int part)
+{
+    srs_utime_t starttime = srs_update_system_time();
+
+    while (true) {
+        // Find the playlist for each loop, because it might be removed.
+        std::map<std::string, SrsHlsMemoryPlaylist*>::iterator it = playlists_.find(path);
+        if (it == playlists_.end()) {
+            return srs_success;
+        }
+
+        SrsHlsMemoryPlaylist* playlist = it->second;
+        if (msn > playlist->msn + 2) {
+            return srs_error_new(ERROR_HLS_BLOCKING_INVALID, "msn=%" PRId64 " exceed %" PRId64, msn, playlist->msn);
+        }
+
+        // The segment msn is completed, or the part of segment is ready.
+        if (playlist->msn > msn || (part >= 0 && playlist->msn == msn && playlist->part >= part)) {
+            return srs_success;
+        }
+
+        srs_utime_t left = playlist->timeout - (srs_update_system_time() - starttime);
+        if (left <= 0) {
+            return srs_error_new(ERROR_HLS_BLOCKING_TIMEOUT, "msn=%" PRId64 ", part=%d, timeout=%dms",
+                msn, part, srsu2msi(playlist->timeout));
+        }
+
+        srs_cond_timedwait(cond_, left);
+    }
+
+    return srs_success;
+}
+
+srs_error_t SrsHlsMemoryStore::wait_hint(string path)
+{
+    srs_utime_t starttime = srs_update_system_time();
+
+    while (!exists(path)) {
+        std::map<std::string, std::string>::iterator it = hints_.find(path);
+        if (it == hints_.end()) {
+            return srs_success;
+        }
+
+        std::map<std::string, SrsHlsMemoryPlaylist*>::iterator it2 = playlists_.find(it->second);
+        if (it2 == playlists_.end()) {
+            return srs_success;
+        }
+
+        SrsHlsMemoryPlaylist* playlist = it2->second;
+        srs_utime_t left = playlist->timeout - (srs_update_system_time() - starttime);
+        if (left <= 0) {
+            return srs_error_new(ERROR_HLS_BLOCKING_TIMEOUT, "hint %s timeout=%dms", path.c_str(), srsu2msi(playlist->timeout));
+        }
+
+        srs_cond_timedwait(cond_, left);
+    }
+
+    return srs_success;
+}
+
+SrsHlsPart::SrsHlsPart()
+{
+    index = 0;
+    duration = 0;
+    independent = false;
+    buffer = NULL;
+}
+
+SrsHlsPart::~SrsHlsPart()
+{
+    if (buffer) {
+        _srs_hls_memory->remove(path, buffer);
+        srs_freep(buffer);
+    }
+}
 
 SrsHlsSegment::SrsHlsSegment(SrsTsContext* c, SrsAudioCodecId ac, SrsVideoCodecId vc, SrsFileWriter* w)
 {
     sequence_no = 0;
     writer = w;
     tscw = new SrsTsContextWriter(writer, c, ac, vc);
+    buffer = NULL;
+    persisted = false;
+    part_start_dts = part_last_dts = -1;
+    part_offset = 0;
+    part_independent = false;
 }
 
 SrsHlsSegment::~SrsHlsSegment()
 {
     srs_freep(tscw);
+    free_parts();
+
+    // Remove the segment from memory, if it's still in the store.
+    if (buffer) {
+        _srs_hls_memory->remove(fullpath(), buffer);
+        srs_freep(buffer);
+    }
 }
 
 void SrsHlsSegment::config_cipher(unsigned char* key,unsigned char* iv)
@@ -73,9 +426,106 @@ srs_error_t SrsHlsSegment::rename()
         uri = srs_string_replace(uri, "[duration]", ss.str());
     }
 
+    // For segment in memory, there is no tmp file, so we publish the bytes to store.
+    if (buffer) {
+        std::stringstream ss;
+        ss << srsu2msi(duration());
+        set_path(srs_string_replace(fullpath(), "[duration]", ss.str()));
+
+        _srs_hls_memory->set(fullpath(), buffer);
+        return srs_success;
+    }
+
     return SrsFragment::rename();
 }
 
+void SrsHlsSegment::free_parts()
+{
+    std::vector<SrsHlsPart*>::iterator it;
+    for (it = parts.begin(); it != parts.end(); ++it) {
+        SrsHlsPart* part = *it;
+        srs_freep(part);
+    }
+    parts.clear();
+}
+
+string SrsHlsSegment::part_name(string name, int index)
+{
+    // For example, livestream-5.ts to livestream-5.0.ts
+    size_t pos = name.rfind(".ts");
+    if (pos == string::npos) {
+        return name + "." + srs_int2str(index);
+    }
+
+    return name.substr(0, pos) + "." + srs_int2str(index) + name.substr(pos);
+}
+
+srs_error_t SrsHlsSegment::unlink_file()
+{
+    if (buffer) {
+        _srs_hls_memory->remove(fullpath(), buffer);
+
+        // Only unlink the file when it's persisted to disk.
+        if (!persisted) {
+            return srs_success;
+        }
+    }
+
+    return SrsFragment::unlink_file();
+}
+
+srs_error_t SrsHlsSegment::unlink_tmpfile()
+{
+    // Never write tmp file for segment in memory.
+    if (buffer) {
+        return srs_success;
+    }
+
+    return SrsFragment::unlink_tmpfile();
+}
+
+SrsHlsAsyncPersist::SrsHlsAsyncPersist(string p, SrsHlsMemoryBuffer* b)
+{
+    path = p;
+    buffer = b->copy();
+}
+
+SrsHlsAsyncPersist::~SrsHlsAsyncPersist()
+{
+    srs_freep(buffer);
+}
+
+srs_error_t SrsHlsAsyncPersist::call()
+{
+    srs_error_t err = srs_success;
+
+    // Write to a temp file then rename it, so the HTTP server never reads a partial file.
+    string tmp_file = path + ".tmp";
+
+    SrsFileWriter fw;
+    if ((err = fw.open(tmp_file)) != srs_success) {
+        return srs_error_wrap(err, "open file %s", tmp_file.c_str());
+    }
+
+    err = fw.write(buffer->bytes(), buffer->length(), NULL);
+    fw.close();
+
+    if (err != srs_success) {
+        return srs_error_wrap(err, "write %s", tmp_file.c_str());
+    }
+
+    if (::rename(tmp_file.c_str(), path.c_str()) < 0) {
+        return srs_error_new(ERROR_HLS_WRITE_FAILED, "rename %s to %s", tmp_file.c_str(), path.c_str());
+    }
+
+    return err;
+}
+
+string SrsHlsAsyncPersist::to_string()
+{
+    return "hls_persist: " + path;
+}
+
 SrsDvrAsyncCallOnHls::SrsDvrAsyncCallOnHls(SrsContextId c, SrsRequest* r, string p, string t, string m, string mu, int s, srs_utime_t d)
 {
     req = r->copy();
@@ -199,6 +649,10 @@ SrsHlsMuxer::SrsHlsMuxer()
     current = NULL;
     hls_keys = false;
     hls_fragments_per_key = 0;
+    hls_memory = false;
+    hls_persist = false;
+    hls_ll = false;
+    hls_part = 0;
     async = new SrsAsyncCallWorker();
     context = new SrsTsContext();
     segments = new SrsFragmentWindow();
@@ -211,6 +665,10 @@ SrsHlsMuxer::SrsHlsMuxer()
 
 SrsHlsMuxer::~SrsHlsMuxer()
 {
+    if (hls_memory) {
+        _srs_hls_memory->remove_playlist(m3u8);
+    }
+
     srs_freep(segments);
     srs_freep(current);
     srs_freep(req);
@@ -233,7 +691,11 @@ void SrsHlsMuxer::dispose()
         srs_freep(current);
     }
     
-    if (unlink(m3u8.c_str()) < 0) {
+    if (hls_memory) {
+        _srs_hls_memory->remove_playlist(m3u8);
+    }
+
+    if ((!hls_memory || hls_persist) && unlink(m3u8.c_str()) < 0) {
         srs_warn("dispose unlink path failed. file=%s", m3u8.c_str());
     }
     
@@ -351,6 +813,22 @@ srs_error_t SrsHlsMuxer::update_config(SrsRequest* r, string entry_prefix,
     hls_key_file = key_file;
     hls_key_file_path = key_file_path;
     hls_key_url = key_url;
+
+    // The memory storage does not support encryption, because the key is always written to disk.
+    hls_memory = _srs_config->get_hls_storage(r->vhost) == "memory";
+    hls_persist = _srs_config->get_hls_persist(r->vhost);
+    if (hls_memory && hls_keys) {
+        srs_warn("hls: ignore storage memory for hls_keys");
+        hls_memory = false;
+    }
+
+    // The partial segments are only kept in memory.
+    hls_ll = _srs_config->get_hls_ll(r->vhost);
+    hls_part = _srs_config->get_hls_part(r->vhost);
+    if (hls_ll && !hls_memory) {
+        srs_warn("hls: ignore hls_ll for storage disk");
+        hls_ll = false;
+    }
    
     // generate the m3u8 dir and path.
     m3u8_url = srs_path_build_stream(m3u8_file, req->vhost, req->app, req->stream);
@@ -361,7 +839,7 @@ srs_error_t SrsHlsMuxer::update_config(SrsRequest* r, string entry_prefix,
     
     // create m3u8 dir once.
     m3u8_dir = srs_path_dirname(m3u8);
-    if ((err = srs_create_dir_recursively(m3u8_dir)) != srs_success) {
+    if ((!hls_memory || hls_persist) && (err = srs_create_dir_recursively(m3u8_dir)) != srs_success) {
         return srs_error_wrap(err, "create dir");
     }
 
@@ -374,10 +852,13 @@ srs_error_t SrsHlsMuxer::update_config(SrsRequest* r, string entry_prefix,
         }
     }
 
-    if(hls_keys) {
+    srs_freep(writer);
+    if (hls_memory) {
+        writer = new SrsHlsMemoryWriter();
+    } else if(hls_keys) {
         writer = new SrsEncFileWriter();
     } else {
-        writer = new SrsFileWriter();
+        writer = new SrsAsyncFileWriter();
     }
 
     return err;
@@ -504,7 +985,7 @@ srs_error_t SrsHlsMuxer::segment_open()
     current->uri += ts_url;
     
     // create dir recursively for hls.
-    if ((err = current->create_dir()) != srs_success) {
+    if ((!hls_memory || hls_persist) && (err = current->create_dir()) != srs_success) {
         return srs_error_wrap(err, "create dir");
     }
     
@@ -514,6 +995,12 @@ srs_error_t SrsHlsMuxer::segment_open()
         return srs_error_wrap(err, "open hls muxer");
     }
 
+    // For memory storage, the segment references the bytes written by muxer.
+    if (hls_memory) {
+        SrsHlsMemoryWriter* mw = dynamic_cast<SrsHlsMemoryWriter*>(writer);
+        current->buffer = mw->buffer()->copy();
+    }
+
     // reset the context for a new ts start.
     context->reset();
     
@@ -586,6 +1073,11 @@ srs_error_t SrsHlsMuxer::flush_audio(SrsTsMessageCache* cache)
         return err;
     }
     
+    // Reap the part before writing the frame, so the next part starts with it.
+    if ((err = reap_part(cache->audio->pts / 90, pure_audio())) != srs_success) {
+        return srs_error_wrap(err, "hls: reap part");
+    }
+
     // update the duration of segment.
     current->append(cache->audio->pts / 90);
     
@@ -615,6 +1107,11 @@ srs_error_t SrsHlsMuxer::flush_video(SrsTsMessageCache* cache)
     
     srs_assert(current);
     
+    // Reap the part before writing the frame, so the next part starts with it.
+    if ((err = reap_part(cache->video->dts / 90, cache->video->write_pcr)) != srs_success) {
+        return srs_error_wrap(err, "hls: reap part");
+    }
+
     // update the duration of segment.
     current->append(cache->video->dts / 90);
 
@@ -662,10 +1159,23 @@ srs_error_t SrsHlsMuxer::do_segment_close()
     bool matchMinDuration = current->duration() >= SRS_HLS_SEGMENT_MIN_DURATION;
     bool matchMaxDuration = current->duration() <= max_td * 2 * 1000;
     if (matchMinDuration && matchMaxDuration) {
+        // Reap the last part of segment, which ends at the end of segment.
+        if (hls_ll && (err = do_reap_part(srsu2ms(current->get_start_dts() + current->duration()), false)) != srs_success) {
+            return srs_error_wrap(err, "reap part");
+        }
+
         // rename from tmp to real path
         if ((err = current->rename()) != srs_success) {
             return srs_error_wrap(err, "rename");
         }
+
+        // Persist the segment in memory to disk, in the async worker.
+        if (current->buffer && hls_persist) {
+            if ((err = async->execute(new SrsHlsAsyncPersist(current->fullpath(), current->buffer))) != srs_success) {
+                return srs_error_wrap(err, "segment persist");
+            }
+            current->persisted = true;
+        }
         
         // use async to call the http hooks, for it will cause thread switch.
         if ((err = async->execute(new SrsDvrAsyncCallOnHls(_srs_context->get_id(), req, current->fullpath(),
@@ -698,6 +1208,12 @@ srs_error_t SrsHlsMuxer::do_segment_close()
     
     // shrink the segments.
     segments->shrink(hls_window);
+
+    // Only the last segments list the parts, free the parts of others.
+    for (int i = 0; hls_ll && i < segments->size() - SRS_HLS_LL_SEGMENTS_WITH_PARTS; i++) {
+        SrsHlsSegment* segment = dynamic_cast<SrsHlsSegment*>(segments->at(i));
+        segment->free_parts();
+    }
     
     // refresh the m3u8, donot contains the removed ts
     err = refresh_m3u8();
@@ -713,6 +1229,79 @@ srs_error_t SrsHlsMuxer::do_segment_close()
     return err;
 }
 
+srs_error_t SrsHlsMuxer::reap_part(int64_t dts, bool keyframe)
+{
+    srs_error_t err = srs_success;
+
+    if (!hls_ll || !current || !current->buffer) {
+        return err;
+    }
+
+    // The first frame of part.
+    if (current->part_start_dts < 0) {
+        current->part_start_dts = current->part_last_dts = dts;
+        current->part_independent = keyframe;
+        return err;
+    }
+
+    // Ignore the frame which is not newer, for audio might be flushed later than video.
+    if (dts <= current->part_last_dts) {
+        return err;
+    }
+
+    // Reap the part when it's going to exceed the target duration by the next frame.
+    srs_utime_t duration = (dts - current->part_start_dts) * SRS_UTIME_MILLISECONDS;
+    srs_utime_t interval = (dts - current->part_last_dts) * SRS_UTIME_MILLISECONDS;
+    current->part_last_dts = dts;
+    if (duration + interval <= hls_part) {
+        return err;
+    }
+
+    if ((err = do_reap_part(dts, keyframe)) != srs_success) {
+        return srs_error_wrap(err, "reap part");
+    }
+
+    // Refresh the m3u8 for the new part, and wakeup the blocking requests.
+    if ((err = refresh_m3u8()) != srs_success) {
+        return srs_error_wrap(err, "refresh m3u8");
+    }
+
+    return err;
+}
+
+srs_error_t SrsHlsMuxer::do_reap_part(int64_t dts, bool keyframe)
+{
+    srs_error_t err = srs_success;
+
+    int size = current->buffer->length() - current->part_offset;
+    if (current->part_start_dts < 0 || size <= 0) {
+        return err;
+    }
+
+    SrsHlsPart* part = new SrsHlsPart();
+    part->index = (int)current->parts.size();
+    part->duration = srs_max(0, dts - current->part_start_dts) * SRS_UTIME_MILLISECONDS;
+    part->independent = current->part_independent;
+    part->uri = SrsHlsSegment::part_name(current->uri, part->index);
+    part->path = SrsHlsSegment::part_name(current->fullpath(), part->index);
+
+    // Copy the bytes of part, because the buffer of segment might be reallocated when writing.
+    part->buffer = new SrsHlsMemoryBuffer();
+    part->buffer->append(current->buffer->bytes() + current->part_offset, size);
+    _srs_hls_memory->set(part->path, part->buffer);
+    current->parts.push_back(part);
+
+    // Start a new part from this frame.
+    current->part_start_dts = current->part_last_dts = dts;
+    current->part_offset = current->buffer->length();
+    current->part_independent = keyframe;
+
+    // Write PAT and PMT for the new part, so that player could start from any independent part.
+    context->reset();
+
+    return err;
+}
+
 srs_error_t SrsHlsMuxer::write_hls_key()
 {
     srs_error_t err = srs_success;
@@ -757,6 +1346,10 @@ srs_error_t SrsHlsMuxer::refresh_m3u8()
     if (segments->empty()) {
         return err;
     }
+
+    if (hls_memory) {
+        return refresh_m3u8_memory();
+    }
     
     std::string temp_m3u8 = m3u8 + ".temp";
     if ((err = _refresh_m3u8(temp_m3u8)) == srs_success) {
@@ -775,6 +1368,44 @@ srs_error_t SrsHlsMuxer::refresh_m3u8()
     return err;
 }
 
+srs_error_t SrsHlsMuxer::refresh_m3u8_memory()
+{
+    srs_error_t err = srs_success;
+
+    string content;
+    if ((err = generate_m3u8(content)) != srs_success) {
+        return srs_error_wrap(err, "hls: generate m3u8");
+    }
+
+    // Always create a new buffer, because the previous one might be reading by HTTP clients.
+    SrsHlsMemoryBuffer* buffer = new SrsHlsMemoryBuffer();
+    SrsAutoFree(SrsHlsMemoryBuffer, buffer);
+    buffer->append(content.data(), (int)content.length());
+
+    if (!hls_ll) {
+        _srs_hls_memory->set(m3u8, buffer);
+    } else {
+        // The position of playlist is the writing segment and its last part, and the hint is the next part.
+        int64_t msn = _sequence_no;
+        int part = -1;
+        string hint;
+        if (current && current->buffer) {
+            msn = current->sequence_no;
+            part = (int)current->parts.size() - 1;
+            hint = SrsHlsSegment::part_name(current->fullpath(), part + 1);
+        }
+
+        // Hold the blocking request for at most 3 times of target duration.
+        _srs_hls_memory->update_playlist(m3u8, buffer, msn, part, hint, 3 * max_td);
+    }
+
+    if (hls_persist && (err = async->execute(new SrsHlsAsyncPersist(m3u8, buffer))) != srs_success) {
+        return srs_error_wrap(err, "hls: persist m3u8");
+    }
+
+    return err;
+}
+
 srs_error_t SrsHlsMuxer::_refresh_m3u8(string m3u8_file)
 {
     srs_error_t err = srs_success;
@@ -788,12 +1419,47 @@ srs_error_t SrsHlsMuxer::_refresh_m3u8(string m3u8_file)
     if ((err = writer.open(m3u8_file)) != srs_success) {
         return srs_error_wrap(err, "hls: open m3u8 file %s", m3u8_file.c_str());
     }
+
+    std::string content;
+    if ((err = generate_m3u8(content)) != srs_success) {
+        return srs_error_wrap(err, "hls: generate m3u8");
+    }
+
+    // write m3u8 to writer.
+    if ((err = writer.write((char*)content.c_str(), (int)content.length(), NULL)) != srs_success) {
+        return srs_error_wrap(err, "hls: write m3u8");
+    }
+    
+    return err;
+}
+
+// Write the EXT-X-PART of segment to m3u8, for LL-HLS.
+void srs_hls_write_parts(std::stringstream& ss, SrsHlsSegment* segment)
+{
+    for (int i = 0; i < (int)segment->parts.size(); i++) {
+        SrsHlsPart* part = segment->parts.at(i);
+
+        // #EXT-X-PART:DURATION=1.000,URI="livestream-5.0.ts",INDEPENDENT=YES\n
+        ss << "#EXT-X-PART:DURATION=" << srsu2msi(part->duration) / 1000.0 << ",URI=\"" << part->uri << "\"";
+        if (part->independent) {
+            ss << ",INDEPENDENT=YES";
+        }
+        ss << SRS_CONSTS_LF;
+    }
+}
+
+srs_error_t SrsHlsMuxer::generate_m3u8(string& content)
+{
+    srs_error_t err = srs_success;
     
     // #EXTM3U\n
     // #EXT-X-VERSION:3\n
     std::stringstream ss;
+    ss.precision(3);
+    ss.setf(std::ios::fixed, std::ios::floatfield);
     ss << "#EXTM3U" << SRS_CONSTS_LF;
-    ss << "#EXT-X-VERSION:3" << SRS_CONSTS_LF;
+    // The EXT-X-PART-INF requires version 6 or above.
+    ss << "#EXT-X-VERSION:" << (hls_ll ? 6 : 3) << SRS_CONSTS_LF;
     
     // #EXT-X-MEDIA-SEQUENCE:4294967295\n
     SrsHlsSegment* first = dynamic_cast<SrsHlsSegment*>(segments->first());
@@ -817,6 +1483,13 @@ srs_error_t SrsHlsMuxer::_refresh_m3u8(string m3u8_file)
     int target_duration = (int)ceil(srsu2msi(srs_max(max_duration, max_td)) / 1000.0);
     
     ss << "#EXT-X-TARGETDURATION:" << target_duration << SRS_CONSTS_LF;
+
+    // #EXT-X-SERVER-CONTROL:CAN-BLOCK-RELOAD=YES,PART-HOLD-BACK=3.000\n
+    // #EXT-X-PART-INF:PART-TARGET=1.000\n
+    if (hls_ll) {
+        ss << "#EXT-X-SERVER-CONTROL:CAN-BLOCK-RELOAD=YES,PART-HOLD-BACK=" << 3 * srsu2msi(hls_part) / 1000.0 << SRS_CONSTS_LF;
+        ss << "#EXT-X-PART-INF:PART-TARGET=" << srsu2msi(hls_part) / 1000.0 << SRS_CONSTS_LF;
+    }
     
     // write all segments
     for (int i = 0; i < segments->size(); i++) {
@@ -844,9 +1517,9 @@ srs_error_t SrsHlsMuxer::_refresh_m3u8(string m3u8_file)
             ss << "#EXT-X-KEY:METHOD=AES-128,URI=" << "\"" << key_path << "\",IV=0x" << hexiv << SRS_CONSTS_LF;
         }
         
+        srs_hls_write_parts(ss, segment);
+
         // "#EXTINF:4294967295.208,\n"
-        ss.precision(3);
-        ss.setf(std::ios::fixed, std::ios::floatfield);
         ss << "#EXTINF:" << srsu2msi(segment->duration()) / 1000.0 << ", no desc" << SRS_CONSTS_LF;
         
         // {file name}\n
@@ -859,13 +1532,22 @@ srs_error_t SrsHlsMuxer::_refresh_m3u8(string m3u8_file)
         //ss << segment->uri << SRS_CONSTS_LF;
         ss << seg_uri << SRS_CONSTS_LF;
     }
-    
-    // write m3u8 to writer.
-    std::string m3u8 = ss.str();
-    if ((err = writer.write((char*)m3u8.c_str(), (int)m3u8.length(), NULL)) != srs_success) {
-        return srs_error_wrap(err, "hls: write m3u8");
+
+    // The parts of writing segment, and the next part as preload hint.
+    if (hls_ll && current && current->buffer) {
+        if (current->is_sequence_header()) {
+            ss << "#EXT-X-DISCONTINUITY" << SRS_CONSTS_LF;
+        }
+
+        srs_hls_write_parts(ss, current);
+
+        // #EXT-X-PRELOAD-HINT:TYPE=PART,URI="livestream-5.1.ts"\n
+        string hint = SrsHlsSegment::part_name(current->uri, (int)current->parts.size());
+        ss << "#EXT-X-PRELOAD-HINT:TYPE=PART,URI=\"" << hint << "\"" << SRS_CONSTS_LF;
     }
     
+    content = ss.str();
+    
     return err;
 }
 
@@ -1229,7 +1911,7 @@ srs_error_t SrsHls::on_publish()
         return err;
     }
     
-    if (!_srs_config->get_hls_enabled(req->vhost)) {
+    if (!_srs_config->get_vhost_snapshot(req->vhost)->hls_enabled) {
         return err;
     }
     
@@ -1239,7 +1921,7 @@ srs_error_t SrsHls::on_publish()
 
     // If enabled, directly turn FLV timestamp to TS DTS.
     // @remark It'll be reloaded automatically, because the origin hub will republish while reloading.
-    hls_dts_directly = _srs_config->get_vhost_hls_dts_directly(req->vhost);
+    hls_dts_directly = _srs_config->get_vhost_snapshot(req->vhost)->hls_dts_directly;
     
     // if enabled, open the muxer.
     enabled = true;
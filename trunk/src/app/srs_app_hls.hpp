@@ -11,9 +11,11 @@
 
 #include <string>
 #include <vector>
+#include <map>
 
 #include <srs_kernel_codec.hpp>
 #include <srs_kernel_file.hpp>
+#include <srs_protocol_st.hpp>
 #include <srs_app_async_call.hpp>
 #include <srs_app_fragment.hpp>
 
@@ -33,6 +35,135 @@ class SrsTsMessageCache;
 class SrsHlsSegment;
 class SrsTsContext;
 
+// The bytes of HLS file in memory, for hls_storage memory. The bytes are shared by the segment in window,
+// the HTTP readers and the async persistence, and freed when the last reference is freed.
+// Create the first object by constructor, and use copy to get a new reference.
+class SrsHlsMemoryBuffer
+{
+private:
+    class SrsHlsMemoryPayload
+    {
+    public:
+        // The actual shared bytes.
+        SrsSimpleStream* data;
+        // The reference count.
+        int shared_count;
+    public:
+        SrsHlsMemoryPayload();
+        virtual ~SrsHlsMemoryPayload();
+    };
+    SrsHlsMemoryPayload* ptr;
+public:
+    SrsHlsMemoryBuffer();
+    virtual ~SrsHlsMemoryBuffer();
+public:
+    virtual void append(const char* bytes, int size);
+    virtual char* bytes();
+    virtual int length();
+    // Create a new reference of the same bytes, user should free it.
+    virtual SrsHlsMemoryBuffer* copy();
+    // Whether the other object references the same bytes.
+    virtual bool shares(SrsHlsMemoryBuffer* other);
+};
+
+// Write the ts to memory buffer, instead of file.
+class SrsHlsMemoryWriter : public SrsFileWriter
+{
+private:
+    SrsHlsMemoryBuffer* buffer_;
+public:
+    SrsHlsMemoryWriter();
+    virtual ~SrsHlsMemoryWriter();
+public:
+    // Get the buffer of current opened segment, NULL if not opened.
+    virtual SrsHlsMemoryBuffer* buffer();
+public:
+    // Create a new buffer, the path is ignored.
+    virtual srs_error_t open(std::string p);
+    virtual void close();
+public:
+    virtual bool is_open();
+    virtual int64_t tellg();
+public:
+    virtual srs_error_t write(void* buf, size_t count, ssize_t* pnwrite);
+    virtual srs_error_t writev(const iovec* iov, int iovcnt, ssize_t* pnwrite);
+    virtual srs_error_t lseek(off_t offset, int whence, off_t* seeked);
+};
+
+// The latest position of LL-HLS playlist in memory, for blocking playlist reload.
+class SrsHlsMemoryPlaylist
+{
+public:
+    // The media sequence number of the writing segment.
+    int64_t msn;
+    // The index of the last part of writing segment, -1 if no part.
+    int part;
+    // The path of part in EXT-X-PRELOAD-HINT.
+    std::string hint;
+    // The max duration to hold the blocking request.
+    srs_utime_t timeout;
+public:
+    SrsHlsMemoryPlaylist();
+    virtual ~SrsHlsMemoryPlaylist();
+};
+
+// The HLS files in memory of all streams, indexed by the path of file, which is the same path for
+// hls_storage disk, so the HTTP server could serve the file from memory by its path.
+class SrsHlsMemoryStore
+{
+private:
+    std::map<std::string, SrsHlsMemoryBuffer*> files_;
+    // The LL-HLS playlists, indexed by path of m3u8.
+    std::map<std::string, SrsHlsMemoryPlaylist*> playlists_;
+    // The preload hint parts, map the path of part to the path of m3u8.
+    std::map<std::string, std::string> hints_;
+    // Signal the blocking requests when playlist updated.
+    srs_cond_t cond_;
+public:
+    SrsHlsMemoryStore();
+    virtual ~SrsHlsMemoryStore();
+public:
+    // Set the file to a new reference of buffer, free the previous one if exists.
+    virtual void set(std::string path, SrsHlsMemoryBuffer* buffer);
+    // Remove the file if it references the same bytes of buffer, or always remove it if buffer is NULL.
+    virtual void remove(std::string path, SrsHlsMemoryBuffer* buffer = NULL);
+    // Fetch a new reference of file, NULL if not exists. User should free it.
+    virtual SrsHlsMemoryBuffer* fetch(std::string path);
+    virtual bool exists(std::string path);
+    virtual bool empty();
+// For LL-HLS.
+public:
+    // Set the playlist and its latest position, then wakeup the blocking requests.
+    virtual void update_playlist(std::string path, SrsHlsMemoryBuffer* buffer, int64_t msn, int part, std::string hint, srs_utime_t timeout);
+    // Remove the playlist and its hint, then wakeup the blocking requests.
+    virtual void remove_playlist(std::string path);
+    // Hold the blocking playlist reload, until the playlist contains the part of segment msn, or the segment msn
+    // if part is -1. Ignore if not a LL-HLS playlist.
+    virtual srs_error_t wait_playlist(std::string path, int64_t msn, int part);
+    // Hold the request of preload hint part until it's ready. Ignore if not a hint.
+    virtual srs_error_t wait_hint(std::string path);
+};
+
+extern SrsHlsMemoryStore* _srs_hls_memory;
+
+// The partial segment of LL-HLS, see EXT-X-PART.
+class SrsHlsPart
+{
+public:
+    // The index of part in segment.
+    int index;
+    // The uri in m3u8 and the path in memory store.
+    std::string uri;
+    std::string path;
+    srs_utime_t duration;
+    // Whether the part starts with a keyframe.
+    bool independent;
+    SrsHlsMemoryBuffer* buffer;
+public:
+    SrsHlsPart();
+    virtual ~SrsHlsPart();
+};
+
 // The wrapper of m3u8 segment from specification:
 //
 // 3.3.2.  EXTINF
@@ -52,6 +183,17 @@ public:
     unsigned char iv[16];
     // The full key path.
     std::string keypath;
+    // The bytes of segment for hls_storage memory, NULL for disk.
+    SrsHlsMemoryBuffer* buffer;
+    // Whether the segment in memory is persisted to disk.
+    bool persisted;
+    // The partial segments of LL-HLS.
+    std::vector<SrsHlsPart*> parts;
+    // The start and last DTS in ms, and the start offset in buffer of the writing part, -1 if no frame.
+    int64_t part_start_dts;
+    int64_t part_last_dts;
+    int part_offset;
+    bool part_independent;
 public:
     SrsHlsSegment(SrsTsContext* c, SrsAudioCodecId ac, SrsVideoCodecId vc, SrsFileWriter* w);
     virtual ~SrsHlsSegment();
@@ -59,6 +201,28 @@ public:
     void config_cipher(unsigned char* key,unsigned char* iv);
     // replace the placeholder
     virtual srs_error_t rename();
+    // Free the parts, when segment is too old to list parts in m3u8.
+    virtual void free_parts();
+    // Build the uri or path of part by the uri or path of segment.
+    static std::string part_name(std::string name, int index);
+// Override SrsFragment, for the segment in memory.
+public:
+    virtual srs_error_t unlink_file();
+    virtual srs_error_t unlink_tmpfile();
+};
+
+// The hls async call: persist the file in memory to disk.
+class SrsHlsAsyncPersist : public ISrsAsyncCallTask
+{
+private:
+    std::string path;
+    SrsHlsMemoryBuffer* buffer;
+public:
+    SrsHlsAsyncPersist(std::string p, SrsHlsMemoryBuffer* b);
+    virtual ~SrsHlsAsyncPersist();
+public:
+    virtual srs_error_t call();
+    virtual std::string to_string();
 };
 
 // The hls async call: on_hls
@@ -144,6 +308,14 @@ private:
     unsigned char iv[16];
     // The underlayer file writer.
     SrsFileWriter* writer;
+private:
+    // Whether keep the m3u8 and ts in memory, see hls_storage.
+    bool hls_memory;
+    // Whether persist the m3u8 and ts in memory to disk.
+    bool hls_persist;
+    // Whether enable LL-HLS, and the target duration of part.
+    bool hls_ll;
+    srs_utime_t hls_part;
 private:
     int _sequence_no;
     srs_utime_t max_td;
@@ -208,9 +380,14 @@ public:
     virtual srs_error_t segment_close();
 private:
     virtual srs_error_t do_segment_close();
+    // Reap the LL-HLS part before writing a frame with dts in ms, if it's long enough.
+    virtual srs_error_t reap_part(int64_t dts, bool keyframe);
+    virtual srs_error_t do_reap_part(int64_t dts, bool keyframe);
     virtual srs_error_t write_hls_key();
     virtual srs_error_t refresh_m3u8();
+    virtual srs_error_t refresh_m3u8_memory();
     virtual srs_error_t _refresh_m3u8(std::string m3u8_file);
+    virtual srs_error_t generate_m3u8(std::string& content);
 };
 
 // The hls stream cache,
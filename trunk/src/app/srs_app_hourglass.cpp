@@ -6,6 +6,7 @@
 
 #include <srs_app_hourglass.hpp>
 
+#include <string.h>
 #include <algorithm>
 using namespace std;
 
@@ -14,6 +15,7 @@ using namespace std;
 #include <srs_kernel_utility.hpp>
 
 #include <srs_protocol_kbps.hpp>
+#include <srs_app_hybrid.hpp>
 
 SrsPps* _srs_pps_timer = NULL;
 SrsPps* _srs_pps_conn = NULL;
@@ -37,161 +39,380 @@ ISrsHourGlass::~ISrsHourGlass()
 {
 }
 
-SrsHourGlass::SrsHourGlass(string label, ISrsHourGlass* h, srs_utime_t resolution)
+ISrsFastTimer::ISrsFastTimer()
 {
-    label_ = label;
-    handler = h;
-    _resolution = resolution;
-    total_elapse = 0;
-    trd = new SrsSTCoroutine("timer-" + label, this, _srs_context->get_id());
 }
 
-SrsHourGlass::~SrsHourGlass()
+ISrsFastTimer::~ISrsFastTimer()
 {
-    srs_freep(trd);
 }
 
-srs_error_t SrsHourGlass::start()
+SrsWheelTimer::SrsWheelTimer(ISrsFastTimer* handler, srs_utime_t interval)
 {
-    srs_error_t err = srs_success;
+    handler_ = handler;
+    interval_ = interval;
+    wheel_ = NULL;
+    bucket_ = NULL;
+    index_ = -1;
+}
 
-    if ((err = trd->start()) != srs_success) {
-        return srs_error_wrap(err, "start timer");
+SrsWheelTimer::~SrsWheelTimer()
+{
+    cancel();
+}
+
+srs_utime_t SrsWheelTimer::interval()
+{
+    return interval_;
+}
+
+bool SrsWheelTimer::active()
+{
+    return wheel_ != NULL;
+}
+
+void SrsWheelTimer::cancel()
+{
+    if (wheel_) {
+        wheel_->cancel(this);
     }
+}
 
-    return err;
+SrsWheelBucket::SrsWheelBucket(srs_utime_t interval, uint64_t ticks, uint64_t expire)
+{
+    interval_ = interval;
+    ticks_ = ticks;
+    expire_ = expire;
+    next_ = NULL;
 }
 
-void SrsHourGlass::stop()
+SrsWheelBucket::~SrsWheelBucket()
 {
-    trd->stop();
 }
 
-srs_error_t SrsHourGlass::tick(srs_utime_t interval)
+SrsTimingWheel::SrsTimingWheel(string label, srs_utime_t resolution)
 {
-    return tick(0, interval);
+    resolution_ = resolution;
+    current_ = 0;
+    size_ = 0;
+    memset(slots_, 0, sizeof(slots_));
+    calling_ = NULL;
+    canceled_ = false;
+    trd_ = new SrsSTCoroutine(label, this, _srs_context->get_id());
 }
 
-srs_error_t SrsHourGlass::tick(int event, srs_utime_t interval)
+SrsTimingWheel::~SrsTimingWheel()
+{
+    srs_freep(trd_);
+
+    // Detach all timers, which might be free after the wheel.
+    map<pair<srs_utime_t, uint64_t>, SrsWheelBucket*>::iterator it;
+    for (it = buckets_.begin(); it != buckets_.end(); ++it) {
+        SrsWheelBucket* bucket = it->second;
+        while (!bucket->timers_.empty()) {
+            cancel(bucket->timers_.back());
+        }
+        srs_freep(bucket);
+    }
+}
+
+srs_error_t SrsTimingWheel::start()
 {
     srs_error_t err = srs_success;
-    
-    if (_resolution > 0 && (interval % _resolution) != 0) {
-        return srs_error_new(ERROR_SYSTEM_HOURGLASS_RESOLUTION,
-            "invalid interval=%dms, resolution=%dms", srsu2msi(interval), srsu2msi(_resolution));
+
+    if ((err = trd_->start()) != srs_success) {
+        return srs_error_wrap(err, "start timer");
     }
-    
-    ticks[event] = interval;
-    
+
     return err;
 }
 
-void SrsHourGlass::untick(int event)
+void SrsTimingWheel::add(SrsWheelTimer* timer)
 {
-    map<int, srs_utime_t>::iterator it = ticks.find(event);
-    if (it != ticks.end()) {
-        ticks.erase(it);
+    cancel(timer);
+
+    // At least one tick, round up to ticks, and limit to the max ticks of wheel.
+    uint64_t max = (uint64_t)1 << (SRS_WHEEL_L0_BITS + (SRS_WHEEL_LEVELS - 1) * SRS_WHEEL_LN_BITS);
+    uint64_t ticks = srs_max(1, (timer->interval_ + resolution_ - 1) / resolution_);
+    ticks = srs_min(ticks, max);
+    uint64_t expire = current_ + ticks - 1;
+
+    // The bucket of the same interval and phase always expires at the same tick as the timer.
+    SrsWheelBucket* bucket = NULL;
+    pair<srs_utime_t, uint64_t> key = make_pair(timer->interval_, expire % ticks);
+    map<pair<srs_utime_t, uint64_t>, SrsWheelBucket*>::iterator it = buckets_.find(key);
+    if (it != buckets_.end()) {
+        bucket = it->second;
+    } else {
+        bucket = new SrsWheelBucket(timer->interval_, ticks, expire);
+        buckets_[key] = bucket;
+        link(bucket);
     }
+
+    // Append to the bucket, so the timer added by handler is not called in current tick.
+    timer->index_ = (int)bucket->timers_.size();
+    bucket->timers_.push_back(timer);
+    bucket->handlers_.push_back(timer->handler_);
+    timer->bucket_ = bucket;
+    timer->wheel_ = this;
+
+    size_++;
 }
 
-srs_error_t SrsHourGlass::cycle()
+void SrsTimingWheel::cancel(SrsWheelTimer* timer)
 {
-    srs_error_t err = srs_success;
+    if (timer->wheel_ != this) {
+        return;
+    }
 
-    while (true) {
-        if ((err = trd->pull()) != srs_success) {
-            return srs_error_wrap(err, "quit");
+    // Never move the timers of the calling bucket, or replace the timer by the last one.
+    SrsWheelBucket* bucket = timer->bucket_;
+    if (bucket == calling_) {
+        bucket->handlers_[timer->index_] = NULL;
+        canceled_ = true;
+    } else {
+        SrsWheelTimer* last = bucket->timers_.back();
+        last->index_ = timer->index_;
+        bucket->timers_[timer->index_] = last;
+        bucket->handlers_[timer->index_] = bucket->handlers_.back();
+        bucket->timers_.pop_back();
+        bucket->handlers_.pop_back();
+    }
+    timer->bucket_ = NULL;
+    timer->index_ = -1;
+    timer->wheel_ = NULL;
+
+    size_--;
+}
+
+int SrsTimingWheel::size()
+{
+    return size_;
+}
+
+srs_utime_t SrsTimingWheel::resolution()
+{
+    return resolution_;
+}
+
+void SrsTimingWheel::advance(int ticks)
+{
+    for (int i = 0; i < ticks; i++) {
+        expire();
+    }
+}
+
+void SrsTimingWheel::expire()
+{
+    // Cascade the upper levels when lower level wraps.
+    int index = (int)(current_ & (SRS_WHEEL_L0_SIZE - 1));
+    if (!index && !cascade(1) && !cascade(2)) {
+        cascade(3);
+    }
+
+    // Re-arm the buckets of current tick before calling any handler, so the timers added by handler never join a
+    // bucket of current tick. The empty bucket is free here, because the handler might cancel any timer.
+    SrsWheelBucket* list = slots_[index];
+    slots_[index] = NULL;
+
+    uint64_t tick = current_++;
+    expired_.clear();
+    while (list) {
+        SrsWheelBucket* bucket = list;
+        list = bucket->next_;
+
+        if (bucket->timers_.empty()) {
+            buckets_.erase(make_pair(bucket->interval_, bucket->expire_ % bucket->ticks_));
+            srs_freep(bucket);
+            continue;
         }
-    
-        map<int, srs_utime_t>::iterator it;
-        for (it = ticks.begin(); it != ticks.end(); ++it) {
-            int event = it->first;
-            srs_utime_t interval = it->second;
 
-            if (interval == 0 || (total_elapse % interval) == 0) {
-                ++_srs_pps_timer->sugar;
+        bucket->expire_ = tick + bucket->ticks_;
+        link(bucket);
+        expired_.push_back(bucket);
+    }
+
+    // Call the timers in place, the latest first, and the timers appended by handlers are not called. The handler
+    // might cancel any timer or free the timer itself, which is set to NULL.
+    for (int i = 0; i < (int)expired_.size(); i++) {
+        SrsWheelBucket* bucket = expired_[i];
+        vector<ISrsFastTimer*>& handlers = bucket->handlers_;
+
+        calling_ = bucket;
+        canceled_ = false;
 
-                if ((err = handler->notify(event, interval, total_elapse)) != srs_success) {
-                    return srs_error_wrap(err, "notify");
+        for (int j = (int)handlers.size() - 1; j >= 0; j--) {
+            ISrsFastTimer* handler = handlers[j];
+            if (!handler) {
+                continue;
+            }
+
+            srs_error_t err = handler->on_timer(bucket->interval_);
+            if (err != srs_success) {
+                srs_freep(err); // Ignore any error for shared timer.
+            }
+        }
+
+        calling_ = NULL;
+
+        // Remove the timers canceled by handlers.
+        if (canceled_) {
+            vector<SrsWheelTimer*>& timers = bucket->timers_;
+
+            int n = 0;
+            for (int j = 0; j < (int)handlers.size(); j++) {
+                if (handlers[j]) {
+                    timers[n] = timers[j];
+                    handlers[n] = handlers[j];
+                    timers[n]->index_ = n;
+                    n++;
                 }
             }
+            timers.resize(n);
+            handlers.resize(n);
         }
+    }
+}
 
-        // TODO: FIXME: Maybe we should use wallclock.
-        total_elapse += _resolution;
-        srs_usleep(_resolution);
+int SrsTimingWheel::cascade(int level)
+{
+    int shift = SRS_WHEEL_L0_BITS + (level - 1) * SRS_WHEEL_LN_BITS;
+    int index = (int)((current_ >> shift) & (SRS_WHEEL_LN_SIZE - 1));
+
+    SrsWheelBucket** slot = &slots_[SRS_WHEEL_L0_SIZE + (level - 1) * SRS_WHEEL_LN_SIZE + index];
+    SrsWheelBucket* list = *slot;
+    *slot = NULL;
+
+    while (list) {
+        SrsWheelBucket* bucket = list;
+        list = bucket->next_;
+        link(bucket);
     }
-    
-    return err;
+
+    return index;
 }
 
-ISrsFastTimer::ISrsFastTimer()
+void SrsTimingWheel::link(SrsWheelBucket* bucket)
 {
+    // Never exceed the max ticks of wheel, because the ticks of bucket is limited.
+    uint64_t delta = bucket->expire_ - current_;
+
+    SrsWheelBucket** slot = NULL;
+    if (delta < SRS_WHEEL_L0_SIZE) {
+        slot = &slots_[bucket->expire_ & (SRS_WHEEL_L0_SIZE - 1)];
+    } else {
+        int level = 1;
+        while (delta >= ((uint64_t)1 << (SRS_WHEEL_L0_BITS + level * SRS_WHEEL_LN_BITS))) {
+            level++;
+        }
+        int shift = SRS_WHEEL_L0_BITS + (level - 1) * SRS_WHEEL_LN_BITS;
+        int index = (int)((bucket->expire_ >> shift) & (SRS_WHEEL_LN_SIZE - 1));
+        slot = &slots_[SRS_WHEEL_L0_SIZE + (level - 1) * SRS_WHEEL_LN_SIZE + index];
+    }
+
+    bucket->next_ = *slot;
+    *slot = bucket;
 }
 
-ISrsFastTimer::~ISrsFastTimer()
+srs_error_t SrsTimingWheel::cycle()
 {
+    srs_error_t err = srs_success;
+
+    while (true) {
+        if ((err = trd_->pull()) != srs_success) {
+            return srs_error_wrap(err, "quit");
+        }
+
+        ++_srs_pps_timer->sugar;
+
+        expire();
+
+        // TODO: FIXME: Maybe we should use wallclock.
+        srs_usleep(resolution_);
+    }
+
+    return err;
 }
 
-SrsFastTimer::SrsFastTimer(std::string label, srs_utime_t interval)
+SrsHourGlass::SrsHourGlass(string label, ISrsHourGlass* h, srs_utime_t resolution)
 {
-    interval_ = interval;
-    trd_ = new SrsSTCoroutine(label, this, _srs_context->get_id());
+    label_ = label;
+    handler = h;
+    _resolution = resolution;
+    total_elapse = 0;
+    timer_ = new SrsWheelTimer(this, resolution);
 }
 
-SrsFastTimer::~SrsFastTimer()
+SrsHourGlass::~SrsHourGlass()
 {
-    srs_freep(trd_);
+    srs_freep(timer_);
 }
 
-srs_error_t SrsFastTimer::start()
+srs_error_t SrsHourGlass::start()
 {
     srs_error_t err = srs_success;
 
-    if ((err = trd_->start()) != srs_success) {
-        return srs_error_wrap(err, "start timer");
-    }
+    // The first tick is notified after a resolution, with the elapsed time 0.
+    _srs_hybrid->wheel()->add(timer_);
 
     return err;
 }
 
-void SrsFastTimer::subscribe(ISrsFastTimer* timer)
+void SrsHourGlass::stop()
 {
-    if (std::find(handlers_.begin(), handlers_.end(), timer) == handlers_.end()) {
-        handlers_.push_back(timer);
+    timer_->cancel();
+}
+
+srs_error_t SrsHourGlass::tick(srs_utime_t interval)
+{
+    return tick(0, interval);
+}
+
+srs_error_t SrsHourGlass::tick(int event, srs_utime_t interval)
+{
+    srs_error_t err = srs_success;
+    
+    if (_resolution > 0 && (interval % _resolution) != 0) {
+        return srs_error_new(ERROR_SYSTEM_HOURGLASS_RESOLUTION,
+            "invalid interval=%dms, resolution=%dms", srsu2msi(interval), srsu2msi(_resolution));
     }
+    
+    ticks[event] = interval;
+    
+    return err;
 }
 
-void SrsFastTimer::unsubscribe(ISrsFastTimer* timer)
+void SrsHourGlass::untick(int event)
 {
-    vector<ISrsFastTimer*>::iterator it = std::find(handlers_.begin(), handlers_.end(), timer);
-    if (it != handlers_.end()) {
-        it = handlers_.erase(it);
+    map<int, srs_utime_t>::iterator it = ticks.find(event);
+    if (it != ticks.end()) {
+        ticks.erase(it);
     }
 }
 
-srs_error_t SrsFastTimer::cycle()
+srs_error_t SrsHourGlass::on_timer(srs_utime_t /*resolution*/)
 {
     srs_error_t err = srs_success;
 
-    while (true) {
-        if ((err = trd_->pull()) != srs_success) {
-            return srs_error_wrap(err, "quit");
-        }
-
-        ++_srs_pps_timer->sugar;
+    map<int, srs_utime_t>::iterator it;
+    for (it = ticks.begin(); it != ticks.end(); ++it) {
+        int event = it->first;
+        srs_utime_t interval = it->second;
 
-        for (int i = 0; i < (int)handlers_.size(); i++) {
-            ISrsFastTimer* timer = handlers_.at(i);
+        if (interval == 0 || (total_elapse % interval) == 0) {
+            ++_srs_pps_timer->sugar;
 
-            if ((err = timer->on_timer(interval_)) != srs_success) {
-                srs_freep(err); // Ignore any error for shared timer.
+            // Stop the hourglass like the coroutine quits, and log the error, which is ignored by the wheel.
+            if ((err = handler->notify(event, interval, total_elapse)) != srs_success) {
+                srs_warn("hourglass %s stop, event=%d, err %s", label_.c_str(), event, srs_error_desc(err).c_str());
+                timer_->cancel();
+                return srs_error_wrap(err, "notify");
             }
         }
-
-        srs_usleep(interval_);
     }
 
+    total_elapse += _resolution;
+
     return err;
 }
 
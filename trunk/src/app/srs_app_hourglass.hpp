@@ -28,6 +28,126 @@ public:
     virtual srs_error_t notify(int event, srs_utime_t interval, srs_utime_t tick) = 0;
 };
 
+// The handler for fast timer.
+class ISrsFastTimer
+{
+public:
+    ISrsFastTimer();
+    virtual ~ISrsFastTimer();
+public:
+    // Tick when timer is active.
+    virtual srs_error_t on_timer(srs_utime_t interval) = 0;
+};
+
+class SrsTimingWheel;
+class SrsWheelBucket;
+
+// The periodic timer in timing wheel, which calls the handler for each interval. The timer is in a bucket of
+// wheel, so it's O(1) to cancel it. It's canceled when free.
+//
+// Usage:
+//      SrsWheelTimer* timer = new SrsWheelTimer(handler, 20 * SRS_UTIME_MILLISECONDS);
+//      _srs_hybrid->wheel()->add(timer);
+//      srs_freep(timer); // Or timer->cancel();
+class SrsWheelTimer
+{
+    friend class SrsTimingWheel;
+private:
+    ISrsFastTimer* handler_;
+    srs_utime_t interval_;
+    // The wheel which the timer is added to, NULL if not active.
+    SrsTimingWheel* wheel_;
+    // The bucket which the timer is in, NULL if not active, and the index in bucket.
+    SrsWheelBucket* bucket_;
+    int index_;
+public:
+    SrsWheelTimer(ISrsFastTimer* handler, srs_utime_t interval);
+    virtual ~SrsWheelTimer();
+public:
+    srs_utime_t interval();
+    // Whether timer is added to a wheel.
+    bool active();
+    // Remove the timer from wheel, ignore if not active.
+    void cancel();
+};
+
+// The number of slots for each level of wheel, the first level is for the nearest ticks.
+#define SRS_WHEEL_L0_BITS 8
+#define SRS_WHEEL_LN_BITS 6
+#define SRS_WHEEL_L0_SIZE (1 << SRS_WHEEL_L0_BITS)
+#define SRS_WHEEL_LN_SIZE (1 << SRS_WHEEL_LN_BITS)
+#define SRS_WHEEL_LEVELS 4
+
+// The timers of the same interval and phase, which always expire at the same tick, so the wheel links and re-arms
+// the bucket in slot, rather than each timer. There are only a few buckets, because most timers are of some intervals.
+class SrsWheelBucket
+{
+    friend class SrsTimingWheel;
+private:
+    // The interval of timers, the ticks of interval, and the tick to expire.
+    srs_utime_t interval_;
+    uint64_t ticks_;
+    uint64_t expire_;
+    // The timers in bucket, and the handlers of timers, so the wheel calls the handlers without loading timers.
+    // The handler of canceled timer is set to NULL when calling the bucket, and removed after that, so the timers
+    // never move when calling.
+    std::vector<SrsWheelTimer*> timers_;
+    std::vector<ISrsFastTimer*> handlers_;
+    // The link in the slot of wheel.
+    SrsWheelBucket* next_;
+public:
+    SrsWheelBucket(srs_utime_t interval, uint64_t ticks, uint64_t expire);
+    virtual ~SrsWheelBucket();
+};
+
+// The process-wide hierarchical timing wheel, for the timers of all objects such as the RTC connections.
+// The wheel has 4 levels, 256 slots of ticks for the first level, and 64 slots for others. The timers are
+// grouped in buckets, so a timer is canceled in O(1) and added in O(logN) of buckets, and all timers of a tick
+// are expired in batch by buckets, by only one coroutine. The buckets in upper levels are cascaded to lower
+// levels when the lower level wraps, like the kernel timers.
+// @remark The timer is limited to 2^26 ticks, about 15 days for 20ms resolution.
+class SrsTimingWheel : public ISrsCoroutineHandler
+{
+private:
+    SrsCoroutine* trd_;
+    srs_utime_t resolution_;
+    // The next tick to expire.
+    uint64_t current_;
+    // The number of active timers.
+    int size_;
+    // The slots of all levels, each is a list of buckets.
+    SrsWheelBucket* slots_[SRS_WHEEL_L0_SIZE + (SRS_WHEEL_LEVELS - 1) * SRS_WHEEL_LN_SIZE];
+    // The buckets by the interval and phase, that is the expire%ticks.
+    std::map<std::pair<srs_utime_t, uint64_t>, SrsWheelBucket*> buckets_;
+    // The buckets of current tick, and the bucket which is calling the timers.
+    std::vector<SrsWheelBucket*> expired_;
+    SrsWheelBucket* calling_;
+    // Whether any timer of the calling bucket is canceled.
+    bool canceled_;
+public:
+    SrsTimingWheel(std::string label, srs_utime_t resolution);
+    virtual ~SrsTimingWheel();
+public:
+    srs_error_t start();
+    // Add the timer, which expires after interval, then periodically. Reset it if already active.
+    void add(SrsWheelTimer* timer);
+    // Remove the timer, ignore if not active.
+    void cancel(SrsWheelTimer* timer);
+    // Get the number of active timers.
+    int size();
+    srs_utime_t resolution();
+    // Expire the timers for ticks, which is driven by the coroutine every resolution.
+    void advance(int ticks);
+private:
+    void expire();
+    // Move the buckets in slot of level to lower levels, return the index of slot.
+    int cascade(int level);
+    void link(SrsWheelBucket* bucket);
+// Interface ISrsCoroutineHandler
+private:
+    virtual srs_error_t cycle();
+};
+
 // The hourglass(timer or SrsTimer) for special tasks,
 // while these tasks are attached to some intervals, for example,
 // there are N=3 tasks bellow:
@@ -41,7 +161,7 @@ public:
 //          4. Got notify(event=3, time=7)
 //          5. Got notify(event=1, time=9)
 //          6. Got notify(event=2, time=10)
-// It's a complex and high-performance timer.
+// The hourglass is driven by a timer of the timing wheel, with the resolution.
 //
 // Usage:
 //      SrsHourGlass* hg = new SrsHourGlass("nack", handler, 100 * SRS_UTIME_MILLISECONDS);
@@ -50,13 +170,13 @@ public:
 //      hg->tick(2, 500 * SRS_UTIME_MILLISECONDS);
 //      hg->tick(3, 700 * SRS_UTIME_MILLISECONDS);
 //
-//      // The hg will create a thread for timer.
+//      // The hg will add a timer to the wheel.
 //      hg->start();
-class SrsHourGlass : public ISrsCoroutineHandler
+class SrsHourGlass : public ISrsFastTimer
 {
 private:
     std::string label_;
-    SrsCoroutine* trd;
+    SrsWheelTimer* timer_;
     ISrsHourGlass* handler;
     srs_utime_t _resolution;
     // The ticks:
@@ -83,45 +203,10 @@ public:
     virtual srs_error_t tick(int event, srs_utime_t interval);
     // Remove the tick by event.
     void untick(int event);
-public:
-    // Cycle the hourglass, which will sleep resolution every time.
-    // and call handler when ticked.
-    virtual srs_error_t cycle();
-};
-
-// The handler for fast timer.
-class ISrsFastTimer
-{
-public:
-    ISrsFastTimer();
-    virtual ~ISrsFastTimer();
-public:
-    // Tick when timer is active.
-    virtual srs_error_t on_timer(srs_utime_t interval) = 0;
-};
-
-// The fast timer, shared by objects, for high performance.
-// For example, we should never start a timer for each connection or publisher or player,
-// instead, we should start only one fast timer in server.
-class SrsFastTimer : public ISrsCoroutineHandler
-{
-private:
-    SrsCoroutine* trd_;
-    srs_utime_t interval_;
-    std::vector<ISrsFastTimer*> handlers_;
-public:
-    SrsFastTimer(std::string label, srs_utime_t interval);
-    virtual ~SrsFastTimer();
-public:
-    srs_error_t start();
-public:
-    void subscribe(ISrsFastTimer* timer);
-    void unsubscribe(ISrsFastTimer* timer);
-// Interface ISrsCoroutineHandler
+// Interface ISrsFastTimer
 private:
-    // Cycle the hourglass, which will sleep resolution every time.
-    // and call handler when ticked.
-    virtual srs_error_t cycle();
+    // Call handler when ticked, for each resolution.
+    virtual srs_error_t on_timer(srs_utime_t interval);
 };
 
 // To monitor the system wall clock timer deviation.
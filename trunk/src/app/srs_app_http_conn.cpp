@@ -370,6 +370,20 @@ srs_error_t SrsHttpxConn::pop_message(ISrsHttpMessage** preq)
     return err;
 }
 
+srs_error_t SrsHttpxConn::enable_zerocopy()
+{
+    // The data of HTTPS is encrypted, see SrsSslConnection::enable_zerocopy.
+    if (ssl) {
+        return ssl->enable_zerocopy();
+    }
+
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(io_);
+    if (!fw) {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "MSG_ZEROCOPY not supported");
+    }
+    return fw->enable_zerocopy();
+}
+
 srs_error_t SrsHttpxConn::on_start()
 {
     srs_error_t err = srs_success;
@@ -388,9 +402,15 @@ srs_error_t SrsHttpxConn::on_start()
             return srs_error_wrap(err, "handshake");
         }
 
+        // Offload the encryption to kernel, or fallback to OpenSSL.
+        if (_srs_config->get_https_stream_ktls() && (err = ssl->setup_ktls()) != srs_success) {
+            srs_warn("https: ignore ktls err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+        }
+
         int cost = srsu2msi(srs_update_system_time() - starttime);
-        srs_trace("https: stream server done, use key %s and cert %s, cost=%dms",
-            key_file.c_str(), crt_file.c_str(), cost);
+        srs_trace("https: stream server done, use key %s and cert %s, ktls=%d, cost=%dms",
+            key_file.c_str(), crt_file.c_str(), ssl->ktls_enabled(), cost);
     }
 
     return err;
@@ -148,6 +148,8 @@ public:
     // @see https://github.com/ossrs/srs/issues/636#issuecomment-298208427
     // @remark Should only used in HTTP-FLV streaming connection.
     virtual srs_error_t pop_message(ISrsHttpMessage** preq);
+    // Enable MSG_ZEROCOPY for HTTP streaming, not supported for HTTPS.
+    virtual srs_error_t enable_zerocopy();
 // Interface ISrsHttpConnOwner.
 public:
     virtual srs_error_t on_start();
@@ -38,6 +38,7 @@ using namespace std;
 #include <srs_app_statistic.hpp>
 #include <srs_app_hybrid.hpp>
 #include <srs_protocol_log.hpp>
+#include <srs_app_hls.hpp>
 
 #define SRS_CONTEXT_IN_HLS "hls_ctx"
 
@@ -63,12 +64,13 @@ void SrsHlsVirtualConn::expire()
 
 SrsHlsStream::SrsHlsStream()
 {
-    _srs_hybrid->timer5s()->subscribe(this);
+    timer_ = new SrsWheelTimer(this, 5 * SRS_UTIME_SECONDS);
+    _srs_hybrid->wheel()->add(timer_);
 }
 
 SrsHlsStream::~SrsHlsStream()
 {
-    _srs_hybrid->timer5s()->unsubscribe(this);
+    srs_freep(timer_);
 
     std::map<std::string, SrsHlsVirtualConn*>::iterator it;
     for (it = map_ctx_info_.begin(); it != map_ctx_info_.end(); ++it) {
@@ -382,14 +384,166 @@ bool SrsHlsStream::is_interrupt(std::string id) {
     return false;
 }
 
+SrsHlsMemoryReader::SrsHlsMemoryReader()
+{
+    buffer_ = NULL;
+    pos_ = 0;
+}
+
+SrsHlsMemoryReader::~SrsHlsMemoryReader()
+{
+    srs_freep(buffer_);
+}
+
+srs_error_t SrsHlsMemoryReader::open(string p)
+{
+    // Hold a reference of bytes, so the segment is never freed when reading, even it's expired.
+    if ((buffer_ = _srs_hls_memory->fetch(p)) != NULL) {
+        pos_ = 0;
+        return srs_success;
+    }
+
+    return SrsFileReader::open(p);
+}
+
+void SrsHlsMemoryReader::close()
+{
+    if (buffer_) {
+        srs_freep(buffer_);
+        return;
+    }
+
+    SrsFileReader::close();
+}
+
+bool SrsHlsMemoryReader::is_open()
+{
+    return buffer_ || SrsFileReader::is_open();
+}
+
+int64_t SrsHlsMemoryReader::tellg()
+{
+    return buffer_ ? pos_ : SrsFileReader::tellg();
+}
+
+void SrsHlsMemoryReader::skip(int64_t size)
+{
+    if (!buffer_) {
+        SrsFileReader::skip(size);
+        return;
+    }
+
+    pos_ = srs_min(pos_ + size, (int64_t)buffer_->length());
+}
+
+int64_t SrsHlsMemoryReader::seek2(int64_t offset)
+{
+    if (!buffer_) {
+        return SrsFileReader::seek2(offset);
+    }
+
+    pos_ = srs_max((int64_t)0, srs_min(offset, (int64_t)buffer_->length()));
+    return pos_;
+}
+
+int64_t SrsHlsMemoryReader::filesize()
+{
+    return buffer_ ? buffer_->length() : SrsFileReader::filesize();
+}
+
+srs_error_t SrsHlsMemoryReader::read(void* buf, size_t count, ssize_t* pnread)
+{
+    if (!buffer_) {
+        return SrsFileReader::read(buf, count, pnread);
+    }
+
+    int64_t left = buffer_->length() - pos_;
+    if (left <= 0) {
+        return srs_error_new(ERROR_SYSTEM_FILE_EOF, "file EOF");
+    }
+
+    int nn = (int)srs_min((int64_t)count, left);
+    memcpy(buf, buffer_->bytes() + pos_, nn);
+    pos_ += nn;
+
+    if (pnread) {
+        *pnread = nn;
+    }
+
+    return srs_success;
+}
+
+srs_error_t SrsHlsMemoryReader::lseek(off_t offset, int whence, off_t* seeked)
+{
+    if (!buffer_) {
+        return SrsFileReader::lseek(offset, whence, seeked);
+    }
+
+    int64_t pos = offset;
+    if (whence == SEEK_CUR) {
+        pos = pos_ + offset;
+    } else if (whence == SEEK_END) {
+        pos = buffer_->length() + offset;
+    }
+
+    if (pos < 0 || pos > buffer_->length()) {
+        return srs_error_new(ERROR_SYSTEM_FILE_SEEK, "seek %d failed", (int)pos);
+    }
+
+    pos_ = pos;
+    if (seeked) {
+        *seeked = pos;
+    }
+
+    return srs_success;
+}
+
+SrsHlsMemoryReaderFactory::SrsHlsMemoryReaderFactory()
+{
+}
+
+SrsHlsMemoryReaderFactory::~SrsHlsMemoryReaderFactory()
+{
+}
+
+SrsFileReader* SrsHlsMemoryReaderFactory::create_file_reader()
+{
+    return new SrsHlsMemoryReader();
+}
+
+bool srs_hls_memory_path_exists(string path)
+{
+    return _srs_hls_memory->exists(path) || srs_path_exists(path);
+}
+
 SrsVodStream::SrsVodStream(string root_dir) : SrsHttpFileServer(root_dir)
 {
+    // Serve the HLS in memory first, then the files on disk.
+    srs_freep(fs_factory);
+    fs_factory = new SrsHlsMemoryReaderFactory();
+    _srs_path_exists = srs_hls_memory_path_exists;
 }
 
 SrsVodStream::~SrsVodStream()
 {
 }
 
+srs_error_t SrsVodStream::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    // For LL-HLS, hold the request of preload hint part until it's ready.
+    if (srs_string_ends_with(r->path(), ".ts")) {
+        string fullpath = srs_http_fs_fullpath(dir, entry->pattern, r->path());
+        if ((err = _srs_hls_memory->wait_hint(fullpath)) != srs_success) {
+            srs_warn("LL-HLS: ignore hint err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+        }
+    }
+
+    return SrsHttpFileServer::serve_http(w, r);
+}
+
 srs_error_t SrsVodStream::serve_flv_stream(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, string fullpath, int64_t offset)
 {
     srs_error_t err = srs_success;
@@ -537,6 +691,19 @@ srs_error_t SrsVodStream::serve_m3u8_ctx(ISrsHttpResponseWriter * w, ISrsHttpMes
         req->vhost = parsed_vhost->arg0();
     }
 
+    // For LL-HLS, hold the blocking playlist reload until the segment or part is ready.
+    string msn = r->query_get("_HLS_msn");
+    if (!msn.empty()) {
+        string part = r->query_get("_HLS_part");
+        err = _srs_hls_memory->wait_playlist(fullpath, ::atoll(msn.c_str()), part.empty() ? -1 : ::atoi(part.c_str()));
+        if (err != srs_success) {
+            int code = srs_error_code(err) == ERROR_HLS_BLOCKING_INVALID ? SRS_CONSTS_HTTP_BadRequest : SRS_CONSTS_HTTP_ServiceUnavailable;
+            srs_warn("LL-HLS: blocking reload err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+            return srs_go_http_error(w, code);
+        }
+    }
+
     // Try to serve by HLS streaming.
     bool served = false;
     if ((err = hls_.serve_m3u8_ctx(w, r, fs_factory, fullpath, req, &served)) != srs_success) {
@@ -11,7 +11,10 @@
 
 #include <srs_app_http_conn.hpp>
 
+#include <srs_kernel_file.hpp>
+
 class ISrsFileReaderFactory;
+class SrsHlsMemoryBuffer;
 
 // HLS virtual connection, build on query string ctx of hls stream.
 class SrsHlsVirtualConn: public ISrsExpire
@@ -35,6 +38,7 @@ class SrsHlsStream : public ISrsFastTimer
 private:
     // The period of validity of the ctx
     std::map<std::string, SrsHlsVirtualConn*> map_ctx_info_;
+    SrsWheelTimer* timer_;
 public:
     SrsHlsStream();
     virtual ~SrsHlsStream();
@@ -54,6 +58,43 @@ private:
     srs_error_t on_timer(srs_utime_t interval);
 };
 
+// Read the HLS file from memory for hls_storage memory, or from disk if not in memory.
+class SrsHlsMemoryReader : public SrsFileReader
+{
+private:
+    // The bytes of file in memory, NULL if read from disk.
+    SrsHlsMemoryBuffer* buffer_;
+    int64_t pos_;
+public:
+    SrsHlsMemoryReader();
+    virtual ~SrsHlsMemoryReader();
+public:
+    virtual srs_error_t open(std::string p);
+    virtual void close();
+public:
+    virtual bool is_open();
+    virtual int64_t tellg();
+    virtual void skip(int64_t size);
+    virtual int64_t seek2(int64_t offset);
+    virtual int64_t filesize();
+public:
+    virtual srs_error_t read(void* buf, size_t count, ssize_t* pnread);
+    virtual srs_error_t lseek(off_t offset, int whence, off_t* seeked);
+};
+
+// The factory to create reader for HLS in memory.
+class SrsHlsMemoryReaderFactory : public ISrsFileReaderFactory
+{
+public:
+    SrsHlsMemoryReaderFactory();
+    virtual ~SrsHlsMemoryReaderFactory();
+public:
+    virtual SrsFileReader* create_file_reader();
+};
+
+// Whether the file exists in memory of HLS, or on disk.
+extern bool srs_hls_memory_path_exists(std::string path);
+
 // The Vod streaming, like FLV, MP4 or HLS streaming.
 class SrsVodStream : public SrsHttpFileServer
 {
@@ -62,6 +103,8 @@ private:
 public:
     SrsVodStream(std::string root_dir);
     virtual ~SrsVodStream();
+public:
+    virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
 protected:
     // The flv vod stream supports flv?start=offset-bytes.
     // For example, http://server/file.flv?start=10240
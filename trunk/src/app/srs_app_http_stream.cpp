@@ -15,6 +15,7 @@
 #include <unistd.h>
 
 #include <sstream>
+#include <map>
 using namespace std;
 
 #include <srs_protocol_stream.hpp>
@@ -33,6 +34,7 @@ using namespace std;
 #include <srs_kernel_aac.hpp>
 #include <srs_kernel_mp3.hpp>
 #include <srs_kernel_ts.hpp>
+#include <srs_kernel_codec.hpp>
 #include <srs_app_pithy_print.hpp>
 #include <srs_app_source.hpp>
 #include <srs_app_server.hpp>
@@ -174,73 +176,364 @@ ISrsBufferEncoder::~ISrsBufferEncoder()
 {
 }
 
-SrsTsStreamEncoder::SrsTsStreamEncoder()
+SrsTsPacketRun::SrsTsPacketRun()
 {
-    enc = new SrsTsTransmuxer();
+    seq = 0;
+    random_access = false;
+    packets = NULL;
 }
 
-SrsTsStreamEncoder::~SrsTsStreamEncoder()
+SrsTsPacketRun::~SrsTsPacketRun()
 {
-    srs_freep(enc);
+    srs_freep(packets);
+}
+
+SrsTsSharedMuxer::SrsTsSharedMuxer(SrsLiveSource* s, SrsRequest* r)
+{
+    req = r->copy()->as_http();
+    source = s;
+    trd = new SrsDummyCoroutine();
+    nn_viewers_ = 0;
+    cond_ = srs_cond_new();
+
+    next_seq_ = 0;
+    packets_ = new SrsSimpleStream();
+    has_video_ = false;
+    last_random_access_ = -1;
+}
+
+SrsTsSharedMuxer::~SrsTsSharedMuxer()
+{
+    srs_freep(trd);
+
+    clear();
+    srs_freep(packets_);
+    srs_cond_destroy(cond_);
+    srs_freep(req);
+}
+
+srs_error_t SrsTsSharedMuxer::update_auth(SrsLiveSource* s, SrsRequest* r)
+{
+    srs_freep(req);
+    req = r->copy()->as_http();
+    source = s;
+
+    return srs_success;
 }
 
-srs_error_t SrsTsStreamEncoder::initialize(SrsFileWriter* w, SrsBufferCache* /*c*/)
+srs_error_t SrsTsSharedMuxer::subscribe()
 {
     srs_error_t err = srs_success;
-    
-    if ((err = enc->initialize(w)) != srs_success) {
-        return srs_error_wrap(err, "init encoder");
+
+    if (nn_viewers_++ > 0) {
+        return err;
     }
-    
+
+    // Wait for the coroutine of last session to quit, which was interrupted when the last viewer left.
+    srs_freep(trd);
+
+    trd = new SrsSTCoroutine("http-ts", this);
+    if ((err = trd->start()) != srs_success) {
+        nn_viewers_--;
+        return srs_error_wrap(err, "coroutine");
+    }
+
     return err;
 }
 
-srs_error_t SrsTsStreamEncoder::write_audio(int64_t timestamp, char* data, int size)
+void SrsTsSharedMuxer::unsubscribe()
 {
-    srs_error_t err = srs_success;
-    
-    if ((err = enc->write_audio(timestamp, data, size)) != srs_success) {
-        return srs_error_wrap(err, "write audio");
+    if (--nn_viewers_ > 0) {
+        return;
     }
-    
-    return err;
+
+    // Never join the coroutine here, because a new viewer might subscribe when we are waiting for it.
+    trd->interrupt();
+    clear();
+}
+
+int SrsTsSharedMuxer::fetch(int64_t& seq, std::vector<SrsSharedPtrMessage*>& runs, int max)
+{
+    if (runs_.empty()) {
+        return 0;
+    }
+
+    // Start from the last random access point, when viewer starts, or too slow that the runs are dropped.
+    int dropped = 0;
+    int64_t first = runs_.front()->seq;
+    if (seq < 0 || seq < first) {
+        int64_t start = -1;
+        for (int i = (int)runs_.size() - 1; i >= 0; i--) {
+            if (runs_.at(i)->random_access) {
+                start = runs_.at(i)->seq;
+                break;
+            }
+        }
+
+        // Wait for a random access point.
+        if (start < 0) {
+            return 0;
+        }
+
+        // The continuity counters jump for the slow viewer, so notify the discontinuity before the runs.
+        if (seq >= 0) {
+            dropped = (int)(start - seq);
+            runs.push_back(discontinuity(start));
+        }
+        seq = start;
+    }
+
+    for (int i = (int)(seq - first); i < (int)runs_.size() && (int)runs.size() < max; i++) {
+        SrsTsPacketRun* run = runs_.at(i);
+        runs.push_back(run->packets->copy());
+        seq = run->seq + 1;
+    }
+
+    return dropped;
+}
+
+void SrsTsSharedMuxer::wait(srs_utime_t timeout)
+{
+    srs_cond_timedwait(cond_, timeout);
 }
 
-srs_error_t SrsTsStreamEncoder::write_video(int64_t timestamp, char* data, int size)
+srs_error_t SrsTsSharedMuxer::cycle()
 {
     srs_error_t err = srs_success;
-    
-    if ((err = enc->write_video(timestamp, data, size)) != srs_success) {
-        return srs_error_wrap(err, "write video");
+
+    while (true) {
+        if ((err = trd->pull()) != srs_success) {
+            return srs_error_wrap(err, "http ts");
+        }
+
+        if ((err = do_cycle()) != srs_success) {
+            // Quit for the coroutine is interrupted, or retry later.
+            if ((err = trd->pull()) != srs_success) {
+                return srs_error_wrap(err, "http ts");
+            }
+
+            srs_warn("http: ts muxer err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+            srs_usleep(SRS_CONSTS_RTMP_PULSE);
+        }
     }
-    
+
     return err;
 }
 
-srs_error_t SrsTsStreamEncoder::write_metadata(int64_t /*timestamp*/, char* /*data*/, int /*size*/)
+srs_error_t SrsTsSharedMuxer::do_cycle()
 {
-    return srs_success;
+    srs_error_t err = srs_success;
+
+    // The runs of last session are not continuous with the new encoder.
+    clear();
+
+    SrsLiveConsumer* consumer = NULL;
+    SrsAutoFree(SrsLiveConsumer, consumer);
+    if ((err = source->create_consumer(consumer)) != srs_success) {
+        return srs_error_wrap(err, "create consumer");
+    }
+    if ((err = source->consumer_dumps(consumer, true, true, true)) != srs_success) {
+        return srs_error_wrap(err, "dumps consumer");
+    }
+
+    SrsTsTransmuxer* enc = new SrsTsTransmuxer();
+    SrsAutoFree(SrsTsTransmuxer, enc);
+    enc->set_has_audio(_srs_config->get_vhost_http_remux_has_audio(req->vhost));
+    enc->set_has_video(_srs_config->get_vhost_http_remux_has_video(req->vhost));
+    if ((err = enc->initialize(this)) != srs_success) {
+        return srs_error_wrap(err, "init encoder");
+    }
+
+    SrsPithyPrint* pprint = SrsPithyPrint::create_http_stream_cache();
+    SrsAutoFree(SrsPithyPrint, pprint);
+
+    SrsMessageArray msgs(SRS_PERF_MW_MSGS);
+    srs_trace("http: start ts muxer, viewers=%d", nn_viewers_);
+
+    while (nn_viewers_ > 0) {
+        if ((err = trd->pull()) != srs_success) {
+            return srs_error_wrap(err, "http ts");
+        }
+
+        pprint->elapse();
+
+        // each msg in msgs.msgs must be free, for the SrsMessageArray never free them.
+        int count = 0;
+        if ((err = consumer->dump_packets(&msgs, count)) != srs_success) {
+            return srs_error_wrap(err, "consumer dump packets");
+        }
+
+        if (count <= 0) {
+            // directly use sleep, donot use consumer wait.
+            srs_usleep(SRS_CONSTS_RTMP_PULSE);
+            continue;
+        }
+
+        if (pprint->can_print()) {
+            srs_trace("-> " SRS_CONSTS_LOG_HTTP_STREAM_CACHE " http: ts muxer got %d msgs, runs=%d, viewers=%d, age=%d",
+                count, (int)runs_.size(), nn_viewers_, pprint->age());
+        }
+
+        for (int i = 0; i < count; i++) {
+            SrsSharedPtrMessage* msg = msgs.msgs[i];
+            if (err == srs_success) {
+                err = mux(enc, msg);
+            }
+            srs_freep(msg);
+        }
+        if (err != srs_success) {
+            return srs_error_wrap(err, "mux");
+        }
+
+        srs_cond_broadcast(cond_);
+    }
+
+    srs_trace("http: stop ts muxer, runs=%d", (int)runs_.size());
+    clear();
+
+    return err;
 }
 
-bool SrsTsStreamEncoder::has_cache()
+// The max number of runs in queue, about 50s for 30fps video and 44.1kHz AAC.
+#define SRS_TS_SHARED_MAX_RUNS 4096
+
+srs_error_t SrsTsSharedMuxer::mux(SrsTsTransmuxer* enc, SrsSharedPtrMessage* msg)
 {
-    // for ts stream, use gop cache of SrsLiveSource is ok.
-    return false;
+    srs_error_t err = srs_success;
+
+    // The IDR frame is a random access point, or each second of audio for pure audio stream. We write the PAT/PMT
+    // before the frame, so the viewer is able to start at the run.
+    bool random_access = false;
+    if (msg->is_video() && SrsFlvVideo::keyframe(msg->payload, msg->size) && !SrsFlvVideo::sh(msg->payload, msg->size)) {
+        random_access = has_video_ = true;
+    } else if (msg->is_audio() && !has_video_ && !SrsFlvAudio::sh(msg->payload, msg->size)) {
+        random_access = (last_random_access_ < 0 || msg->timestamp - last_random_access_ >= 1000);
+    }
+    if (random_access) {
+        enc->reset_context();
+    }
+
+    packets_->erase(packets_->length());
+    if (msg->is_audio()) {
+        err = enc->write_audio(msg->timestamp, msg->payload, msg->size);
+    } else if (msg->is_video()) {
+        err = enc->write_video(msg->timestamp, msg->payload, msg->size);
+    }
+    if (err != srs_success) {
+        return srs_error_wrap(err, "write");
+    }
+
+    // Ignore the message without any packets, for example, sequence header.
+    if (packets_->length() <= 0) {
+        return err;
+    }
+    srs_assert(packets_->length() % SRS_TS_PACKET_SIZE == 0);
+
+    SrsTsPacketRun* run = new SrsTsPacketRun();
+    run->seq = next_seq_++;
+    run->random_access = random_access;
+    run->packets = new SrsSharedPtrMessage();
+    run->packets->timestamp = msg->timestamp;
+
+    char* buf = new char[packets_->length()];
+    memcpy(buf, packets_->bytes(), packets_->length());
+    run->packets->wrap(buf, packets_->length());
+
+    if (random_access) {
+        last_random_access_ = msg->timestamp;
+
+        // Keep the runs from the previous random access point, and drop the older ones.
+        for (int i = (int)runs_.size() - 1; i >= 0; i--) {
+            if (runs_.at(i)->random_access) {
+                for (; i > 0; i--) {
+                    SrsTsPacketRun* r = runs_.front();
+                    srs_freep(r);
+                    runs_.pop_front();
+                }
+                break;
+            }
+        }
+    }
+    runs_.push_back(run);
+
+    while ((int)runs_.size() > SRS_TS_SHARED_MAX_RUNS) {
+        SrsTsPacketRun* r = runs_.front();
+        srs_freep(r);
+        runs_.pop_front();
+    }
+
+    return err;
 }
 
-srs_error_t SrsTsStreamEncoder::dump_cache(SrsLiveConsumer* /*consumer*/, SrsRtmpJitterAlgorithm /*jitter*/)
+void SrsTsSharedMuxer::clear()
 {
-    // for ts stream, ignore cache.
-    return srs_success;
+    for (int i = 0; i < (int)runs_.size(); i++) {
+        SrsTsPacketRun* run = runs_.at(i);
+        srs_freep(run);
+    }
+    runs_.clear();
+
+    has_video_ = false;
+    last_random_access_ = -1;
 }
 
-void SrsTsStreamEncoder::set_has_audio(bool v)
+SrsSharedPtrMessage* SrsTsSharedMuxer::discontinuity(int64_t start)
 {
-    enc->set_has_audio(v);
+    // The continuity counter before the first packet of each PID since the run of start.
+    std::vector<int> pids;
+    std::map<int, int> ccs;
+
+    for (int i = (int)(start - runs_.front()->seq); i < (int)runs_.size(); i++) {
+        SrsSharedPtrMessage* packets = runs_.at(i)->packets;
+        for (int pos = 0; pos + SRS_TS_PACKET_SIZE <= packets->size; pos += SRS_TS_PACKET_SIZE) {
+            uint8_t* p = (uint8_t*)packets->payload + pos;
+            int pid = (p[1] & 0x1f) << 8 | p[2];
+            if (pid == SrsTsPidNULL || ccs.find(pid) != ccs.end()) {
+                continue;
+            }
+
+            // The continuity counter is not increased for packet without payload.
+            int cc = p[3] & 0x0f;
+            bool has_payload = (p[3] & 0x10) != 0;
+            ccs[pid] = has_payload ? ((cc - 1) & 0x0f) : cc;
+            pids.push_back(pid);
+        }
+    }
+
+    // For each PID, a TS packet with only adaptation field, which sets the discontinuity_indicator, so the next
+    // packet is allowed to be discontinuous, see the discontinuity_indicator of ISO_IEC_13818-1-MPEG2-TS.pdf.
+    int size = (int)pids.size() * SRS_TS_PACKET_SIZE;
+    char* buf = new char[srs_max(1, size)];
+    for (int i = 0; i < (int)pids.size(); i++) {
+        uint8_t* p = (uint8_t*)buf + i * SRS_TS_PACKET_SIZE;
+        int pid = pids.at(i);
+
+        p[0] = 0x47;
+        p[1] = (uint8_t)((pid >> 8) & 0x1f);
+        p[2] = (uint8_t)pid;
+        p[3] = (uint8_t)((SrsTsAdaptationFieldTypeAdaptionOnly << 4) | ccs[pid]);
+        // The adaptation field length, and the flags with discontinuity_indicator, then the stuffing bytes.
+        p[4] = SRS_TS_PACKET_SIZE - 5;
+        p[5] = 0x80;
+        memset(p + 6, 0xff, SRS_TS_PACKET_SIZE - 6);
+    }
+
+    SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+    msg->timestamp = runs_.at((int)(start - runs_.front()->seq))->packets->timestamp;
+    msg->wrap(buf, size);
+    return msg;
 }
-void SrsTsStreamEncoder::set_has_video(bool v)
+
+srs_error_t SrsTsSharedMuxer::write(void* buf, size_t size, ssize_t* nwrite)
 {
-    enc->set_has_video(v);
+    packets_->append((const char*)buf, (int)size);
+
+    if (nwrite) {
+        *nwrite = size;
+    }
+
+    return srs_success;
 }
 
 SrsFlvStreamEncoder::SrsFlvStreamEncoder()
@@ -386,6 +679,16 @@ srs_error_t SrsFlvStreamEncoder::write_tags(SrsSharedPtrMessage** msgs, int coun
     return enc->write_tags(msgs, count);
 }
 
+int64_t SrsFlvStreamEncoder::source_bytes()
+{
+    return enc->source_bytes();
+}
+
+int64_t SrsFlvStreamEncoder::viewer_bytes()
+{
+    return enc->viewer_bytes();
+}
+
 srs_error_t SrsFlvStreamEncoder::write_header(bool has_video, bool has_audio)
 {
     srs_error_t err = srs_success;
@@ -515,10 +818,18 @@ srs_error_t SrsMp3StreamEncoder::dump_cache(SrsLiveConsumer* consumer, SrsRtmpJi
 SrsBufferWriter::SrsBufferWriter(ISrsHttpResponseWriter* w)
 {
     writer = w;
+    pin_ = NULL;
 }
 
 SrsBufferWriter::~SrsBufferWriter()
 {
+    srs_freep(pin_);
+}
+
+void SrsBufferWriter::set_pin(ISrsZeroCopyPin* pin)
+{
+    srs_freep(pin_);
+    pin_ = pin;
 }
 
 srs_error_t SrsBufferWriter::open(std::string /*file*/)
@@ -550,6 +861,13 @@ srs_error_t SrsBufferWriter::write(void* buf, size_t count, ssize_t* pnwrite)
 
 srs_error_t SrsBufferWriter::writev(const iovec* iov, int iovcnt, ssize_t* pnwrite)
 {
+    ISrsHttpFileResponseWriter* fw = dynamic_cast<ISrsHttpFileResponseWriter*>(writer);
+    if (pin_ && fw) {
+        ISrsZeroCopyPin* pin = pin_;
+        pin_ = NULL;
+        return fw->writev_zerocopy(iov, iovcnt, pin, pnwrite);
+    }
+
     return writer->writev(iov, iovcnt, pnwrite);
 }
 
@@ -558,10 +876,12 @@ SrsLiveStream::SrsLiveStream(SrsLiveSource* s, SrsRequest* r, SrsBufferCache* c)
     source = s;
     cache = c;
     req = r->copy()->as_http();
+    ts_muxer = NULL;
 }
 
 SrsLiveStream::~SrsLiveStream()
 {
+    srs_freep(ts_muxer);
     srs_freep(req);
 }
 
@@ -571,6 +891,10 @@ srs_error_t SrsLiveStream::update_auth(SrsLiveSource* s, SrsRequest* r)
     
     srs_freep(req);
     req = r->copy()->as_http();
+
+    if (ts_muxer) {
+        ts_muxer->update_auth(s, r);
+    }
     
     return srs_success;
 }
@@ -643,10 +967,8 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
         enc = new SrsMp3StreamEncoder();
     } else if (srs_string_ends_with(entry->pattern, ".ts")) {
         w->header()->set_content_type("video/MP2T");
-        enc_desc = "TS";
-        enc = new SrsTsStreamEncoder();
-        ((SrsTsStreamEncoder*)enc)->set_has_audio(has_audio);
-        ((SrsTsStreamEncoder*)enc)->set_has_video(has_video);
+        // The TS is muxed once by the shared muxer, for all viewers.
+        return do_serve_ts(w, r);
     } else {
         return srs_error_new(ERROR_HTTP_LIVE_STREAM_EXT, "invalid pattern=%s", entry->pattern.c_str());
     }
@@ -695,6 +1017,14 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
     SrsHttpxConn* hxc = dynamic_cast<SrsHttpxConn*>(hc->handler());
     srs_assert(hxc);
 
+    // Send the FLV tags by MSG_ZEROCOPY, fallback to copy if not supported.
+    bool zerocopy = ffe && _srs_config->get_play_zerocopy(req->vhost);
+    if (zerocopy && (err = hxc->enable_zerocopy()) != srs_success) {
+        srs_warn("http: ignore zerocopy err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+        zerocopy = false;
+    }
+
     // Start a thread to receive all messages from client, then drop them.
     SrsHttpRecvThread* trd = new SrsHttpRecvThread(hxc);
     SrsAutoFree(SrsHttpRecvThread, trd);
@@ -703,10 +1033,13 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
         return srs_error_wrap(err, "start recv thread");
     }
 
+    SrsStatistic* stat = SrsStatistic::instance();
+    srs_utime_t last_stat = 0;
+
     srs_utime_t mw_sleep = _srs_config->get_mw_sleep(req->vhost);
-    srs_trace("FLV %s, encoder=%s, mw_sleep=%dms, cache=%d, msgs=%d, dinm=%d, guess_av=%d/%d/%d",
+    srs_trace("FLV %s, encoder=%s, mw_sleep=%dms, cache=%d, msgs=%d, dinm=%d, guess_av=%d/%d/%d, zerocopy=%d",
         entry->pattern.c_str(), enc_desc.c_str(), srsu2msi(mw_sleep), enc->has_cache(), msgs.max, drop_if_not_match,
-        has_audio, has_video, guess_has_av);
+        has_audio, has_video, guess_has_av, zerocopy);
 
     // TODO: free and erase the disabled entry after all related connections is closed.
     // TODO: FXIME: Support timeout for player, quit infinite-loop.
@@ -740,12 +1073,21 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
         
         // sendout all messages.
         if (ffe) {
+            // The payloads are pinned by the messages, until sent by MSG_ZEROCOPY.
+            if (zerocopy) {
+                writer.set_pin(new SrsSharedPtrPin(msgs.msgs, count));
+            }
             err = ffe->write_tags(msgs.msgs, count);
         } else {
             err = streaming_send_messages(enc, msgs.msgs, count);
         }
 
-        // TODO: FIXME: Update the stat.
+        // Update the bytes of FLV tags encoded by source and viewer to stat, about once per second.
+        srs_utime_t now = srs_get_system_time();
+        if (ffe && now - last_stat >= 1 * SRS_UTIME_SECONDS) {
+            last_stat = now;
+            stat->on_client_flv(_srs_context->get_id().c_str(), ffe->source_bytes(), ffe->viewer_bytes());
+        }
 
         // free the messages.
         for (int i = 0; i < count; i++) {
@@ -764,6 +1106,103 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
     return srs_error_new(ERROR_HTTP_STREAM_EOF, "Stream EOF");
 }
 
+srs_error_t SrsLiveStream::do_serve_ts(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    // Create the shared muxer when the first viewer comes.
+    if (!ts_muxer) {
+        ts_muxer = new SrsTsSharedMuxer(source, req);
+    }
+
+    if ((err = ts_muxer->subscribe()) != srs_success) {
+        return srs_error_wrap(err, "start ts muxer");
+    }
+
+    // Enter chunked mode, because we didn't set the content-length.
+    w->write_header(SRS_CONSTS_HTTP_OK);
+
+    err = do_serve_ts_runs(w, r);
+    ts_muxer->unsubscribe();
+
+    return err;
+}
+
+srs_error_t SrsLiveStream::do_serve_ts_runs(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    SrsPithyPrint* pprint = SrsPithyPrint::create_http_stream();
+    SrsAutoFree(SrsPithyPrint, pprint);
+
+    // Use receive thread to accept the close event to avoid FD leak.
+    SrsHttpMessage* hr = dynamic_cast<SrsHttpMessage*>(r);
+    SrsHttpConn* hc = dynamic_cast<SrsHttpConn*>(hr->connection());
+    SrsHttpxConn* hxc = dynamic_cast<SrsHttpxConn*>(hc->handler());
+    srs_assert(hxc);
+
+    SrsHttpRecvThread* trd = new SrsHttpRecvThread(hxc);
+    SrsAutoFree(SrsHttpRecvThread, trd);
+
+    if ((err = trd->start()) != srs_success) {
+        return srs_error_wrap(err, "start recv thread");
+    }
+
+    SrsBufferWriter writer(w);
+
+    // Start from the last random access point.
+    int64_t seq = -1;
+    std::vector<SrsSharedPtrMessage*> runs;
+    std::vector<iovec> iovs;
+
+    srs_utime_t mw_sleep = _srs_config->get_mw_sleep(req->vhost);
+    srs_trace("TS %s, shared muxer, mw_sleep=%dms, msgs=%d", entry->pattern.c_str(), srsu2msi(mw_sleep),
+        SRS_PERF_MW_MSGS);
+
+    while (entry->enabled) {
+        // Whether client closed the FD.
+        if ((err = trd->pull()) != srs_success) {
+            return srs_error_wrap(err, "recv thread");
+        }
+
+        pprint->elapse();
+
+        int dropped = ts_muxer->fetch(seq, runs, SRS_PERF_MW_MSGS);
+        if (runs.empty()) {
+            ts_muxer->wait(mw_sleep);
+            continue;
+        }
+
+        if (pprint->can_print() || dropped > 0) {
+            srs_trace("-> " SRS_CONSTS_LOG_HTTP_STREAM " http: got %d ts runs, dropped=%d, age=%d, mw=%d",
+                (int)runs.size(), dropped, pprint->age(), srsu2msi(mw_sleep));
+        }
+
+        // Write the shared TS packets directly, without copy.
+        iovs.resize(runs.size());
+        for (int i = 0; i < (int)runs.size(); i++) {
+            SrsSharedPtrMessage* run = runs.at(i);
+            iovs[i].iov_base = run->payload;
+            iovs[i].iov_len = run->size;
+        }
+        err = writer.writev(&iovs[0], (int)iovs.size(), NULL);
+
+        for (int i = 0; i < (int)runs.size(); i++) {
+            SrsSharedPtrMessage* run = runs.at(i);
+            srs_freep(run);
+        }
+        runs.clear();
+
+        if (err != srs_success) {
+            return srs_error_wrap(err, "send ts runs");
+        }
+    }
+
+    // Here, the entry is disabled by encoder un-publishing or reloading,
+    // so we must return a io.EOF error to disconnect the client, or the client will never quit.
+    return srs_error_new(ERROR_HTTP_STREAM_EOF, "Stream EOF");
+}
+
 srs_error_t SrsLiveStream::http_hooks_on_play(ISrsHttpMessage* r)
 {
     srs_error_t err = srs_success;
@@ -11,10 +11,15 @@
 
 #include <srs_app_http_conn.hpp>
 
+#include <deque>
+#include <vector>
+
 class SrsAacTransmuxer;
 class SrsMp3Transmuxer;
 class SrsFlvTransmuxer;
 class SrsTsTransmuxer;
+class SrsSimpleStream;
+class ISrsZeroCopyPin;
 
 // A cache for HTTP Live Streaming encoder, to make android(weixin) happy.
 class SrsBufferCache : public ISrsCoroutineHandler
@@ -90,29 +95,82 @@ public:
 public:
     // Write the tags in a time.
     virtual srs_error_t write_tags(SrsSharedPtrMessage** msgs, int count);
+    // Get the bytes of tags encoded for all viewers of source, and encoded for this viewer.
+    virtual int64_t source_bytes();
+    virtual int64_t viewer_bytes();
 private:
     virtual srs_error_t write_header(bool has_video, bool has_audio);
 };
 
-// Transmux RTMP to HTTP TS Streaming.
-class SrsTsStreamEncoder : public ISrsBufferEncoder
+// The TS packets muxed from a message by SrsTsSharedMuxer, shared by all HTTP-TS viewers.
+class SrsTsPacketRun
 {
-private:
-    SrsTsTransmuxer* enc;
 public:
-    SrsTsStreamEncoder();
-    virtual ~SrsTsStreamEncoder();
+    // The sequence of run, increased by one for each run of source.
+    int64_t seq;
+    // Whether the run is a random access point, which starts with the PAT/PMT, followed by an IDR frame or an
+    // audio frame for pure audio stream, so a viewer is able to start from this run.
+    bool random_access;
+    // The 188 bytes aligned TS packets, refcounted by copy.
+    SrsSharedPtrMessage* packets;
 public:
-    virtual srs_error_t initialize(SrsFileWriter* w, SrsBufferCache* c);
-    virtual srs_error_t write_audio(int64_t timestamp, char* data, int size);
-    virtual srs_error_t write_video(int64_t timestamp, char* data, int size);
-    virtual srs_error_t write_metadata(int64_t timestamp, char* data, int size);
+    SrsTsPacketRun();
+    virtual ~SrsTsPacketRun();
+};
+
+// The shared TS muxer of source, which consumes the source and muxes TS once for all HTTP-TS viewers, so the
+// PES packetization, PAT/PMT and CRC is done once instead of for each viewer. The viewer starts from the last random
+// access point, then writes the shared runs of TS packets directly.
+class SrsTsSharedMuxer : public ISrsCoroutineHandler, public ISrsStreamWriter
+{
+private:
+    SrsLiveSource* source;
+    SrsRequest* req;
+    SrsCoroutine* trd;
+    // The number of viewers, the coroutine only runs when there are viewers.
+    int nn_viewers_;
+    // Signal the viewers when got new runs.
+    srs_cond_t cond_;
+private:
+    // The queue of runs, starts from a random access point.
+    std::deque<SrsTsPacketRun*> runs_;
+    // The sequence of next run.
+    int64_t next_seq_;
+    // The TS packets of current message, written by the transmuxer.
+    SrsSimpleStream* packets_;
+    // Whether got video, and the timestamp of last random access point, for pure audio stream.
+    bool has_video_;
+    int64_t last_random_access_;
 public:
-    virtual bool has_cache();
-    virtual srs_error_t dump_cache(SrsLiveConsumer* consumer, SrsRtmpJitterAlgorithm jitter);
+    SrsTsSharedMuxer(SrsLiveSource* s, SrsRequest* r);
+    virtual ~SrsTsSharedMuxer();
+    virtual srs_error_t update_auth(SrsLiveSource* s, SrsRequest* r);
 public:
-    void set_has_audio(bool v);
-    void set_has_video(bool v);
+    // When viewer starts or stops to play the stream, start the coroutine for the first viewer, and stop it when
+    // the last viewer leaves.
+    virtual srs_error_t subscribe();
+    virtual void unsubscribe();
+    // Fetch the runs for viewer, which starts from the last random access point if seq is negative. If the viewer
+    // is resynced, the first run is the TS packets to notify the discontinuity of continuity counters.
+    // @param seq The sequence of run to fetch, updated to the next run to fetch.
+    // @param runs The copied packets of runs, user must free them.
+    // @param max The max number of runs to fetch.
+    // @return The number of runs dropped, because the viewer is too slow.
+    virtual int fetch(int64_t& seq, std::vector<SrsSharedPtrMessage*>& runs, int max);
+    // Wait for new runs, for viewer.
+    virtual void wait(srs_utime_t timeout);
+// Interface ISrsCoroutineHandler
+public:
+    virtual srs_error_t cycle();
+private:
+    virtual srs_error_t do_cycle();
+    virtual srs_error_t mux(SrsTsTransmuxer* enc, SrsSharedPtrMessage* msg);
+    virtual void clear();
+    // Create the TS packets to notify the discontinuity of each PID, for the viewer resynced to the run of start.
+    virtual SrsSharedPtrMessage* discontinuity(int64_t start);
+// Interface ISrsStreamWriter
+public:
+    virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
 };
 
 // Transmux RTMP with AAC stream to HTTP AAC Streaming.
@@ -158,9 +216,14 @@ class SrsBufferWriter : public SrsFileWriter
 {
 private:
     ISrsHttpResponseWriter* writer;
+    // The pin for the next writev, to send by MSG_ZEROCOPY.
+    ISrsZeroCopyPin* pin_;
 public:
     SrsBufferWriter(ISrsHttpResponseWriter* w);
     virtual ~SrsBufferWriter();
+public:
+    // Set the pin of buffers for the next writev, which is freed by writer.
+    virtual void set_pin(ISrsZeroCopyPin* pin);
 public:
     virtual srs_error_t open(std::string file);
     virtual void close();
@@ -180,6 +243,8 @@ private:
     SrsRequest* req;
     SrsLiveSource* source;
     SrsBufferCache* cache;
+    // The shared TS muxer for HTTP-TS viewers, created when the first viewer comes.
+    SrsTsSharedMuxer* ts_muxer;
 public:
     SrsLiveStream(SrsLiveSource* s, SrsRequest* r, SrsBufferCache* c);
     virtual ~SrsLiveStream();
@@ -188,6 +253,8 @@ public:
     virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
 private:
     virtual srs_error_t do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
+    virtual srs_error_t do_serve_ts(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
+    virtual srs_error_t do_serve_ts_runs(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
     virtual srs_error_t http_hooks_on_play(ISrsHttpMessage* r);
     virtual void http_hooks_on_stop(ISrsHttpMessage* r);
     virtual srs_error_t streaming_send_messages(ISrsBufferEncoder* enc, SrsSharedPtrMessage** msgs, int nb_msgs);
@@ -13,6 +13,7 @@
 #include <srs_app_utility.hpp>
 #include <srs_app_dvr.hpp>
 #include <srs_app_tencentcloud.hpp>
+#include <srs_app_threads.hpp>
 
 using namespace std;
 
@@ -24,6 +25,13 @@ extern SrsPps* _srs_pps_pub;
 extern SrsPps* _srs_pps_conn;
 extern SrsPps* _srs_pps_dispose;
 
+extern SrsPps* _srs_pps_afile;
+extern SrsPps* _srs_pps_afile_bytes;
+extern SrsPps* _srs_pps_afile_full;
+
+extern SrsPps* _srs_pps_zcbytes;
+extern SrsPps* _srs_pps_zccopied;
+
 #if defined(SRS_DEBUG) && defined(SRS_DEBUG_STATS)
 extern unsigned long long _st_stat_recvfrom;
 extern unsigned long long _st_stat_recvfrom_eagain;
@@ -113,6 +121,8 @@ extern SrsPps* _srs_pps_objs_rfua;
 extern SrsPps* _srs_pps_objs_rbuf;
 extern SrsPps* _srs_pps_objs_msgs;
 extern SrsPps* _srs_pps_objs_rothers;
+extern SrsPps* _srs_pps_objs_rhit;
+extern SrsPps* _srs_pps_objs_rmiss;
 
 ISrsHybridServer::ISrsHybridServer()
 {
@@ -124,23 +134,21 @@ ISrsHybridServer::~ISrsHybridServer()
 
 SrsHybridServer::SrsHybridServer()
 {
-    // Create global shared timer.
-    timer20ms_ = new SrsFastTimer("hybrid", 20 * SRS_UTIME_MILLISECONDS);
-    timer100ms_ = new SrsFastTimer("hybrid", 100 * SRS_UTIME_MILLISECONDS);
-    timer1s_ = new SrsFastTimer("hybrid", 1 * SRS_UTIME_SECONDS);
-    timer5s_ = new SrsFastTimer("hybrid", 5 * SRS_UTIME_SECONDS);
+    // Create global shared timing wheel.
+    wheel_ = new SrsTimingWheel("hybrid", 20 * SRS_UTIME_MILLISECONDS);
 
     clock_monitor_ = new SrsClockWallMonitor();
+    clock_timer_ = new SrsWheelTimer(clock_monitor_, 20 * SRS_UTIME_MILLISECONDS);
+    timer_ = new SrsWheelTimer(this, 5 * SRS_UTIME_SECONDS);
 }
 
 SrsHybridServer::~SrsHybridServer()
 {
+    srs_freep(clock_timer_);
+    srs_freep(timer_);
     srs_freep(clock_monitor_);
 
-    srs_freep(timer20ms_);
-    srs_freep(timer100ms_);
-    srs_freep(timer1s_);
-    srs_freep(timer5s_);
+    srs_freep(wheel_);
 
     vector<ISrsHybridServer*>::iterator it;
     for (it = servers.begin(); it != servers.end(); ++it) {
@@ -160,19 +168,7 @@ srs_error_t SrsHybridServer::initialize()
     srs_error_t err = srs_success;
 
     // Start the timer first.
-    if ((err = timer20ms_->start()) != srs_success) {
-        return srs_error_wrap(err, "start timer");
-    }
-
-    if ((err = timer100ms_->start()) != srs_success) {
-        return srs_error_wrap(err, "start timer");
-    }
-
-    if ((err = timer1s_->start()) != srs_success) {
-        return srs_error_wrap(err, "start timer");
-    }
-
-    if ((err = timer5s_->start()) != srs_success) {
+    if ((err = wheel_->start()) != srs_success) {
         return srs_error_wrap(err, "start timer");
     }
 
@@ -181,6 +177,11 @@ srs_error_t SrsHybridServer::initialize()
         return srs_error_wrap(err, "dvr async");
     }
 
+    // Start the coroutine for disk writer threads, if enabled.
+    if ((err = _srs_async_file->start()) != srs_success) {
+        return srs_error_wrap(err, "async file");
+    }
+
 #ifdef SRS_APM
     // Initialize TencentCloud CLS object.
     if ((err = _srs_cls->initialize()) != srs_success) {
@@ -192,8 +193,8 @@ srs_error_t SrsHybridServer::initialize()
 #endif
 
     // Register some timers.
-    timer20ms_->subscribe(clock_monitor_);
-    timer5s_->subscribe(this);
+    wheel_->add(clock_timer_);
+    wheel_->add(timer_);
 
     // Initialize all hybrid servers.
     vector<ISrsHybridServer*>::iterator it;
@@ -251,24 +252,9 @@ SrsServerAdapter* SrsHybridServer::srs()
     return NULL;
 }
 
-SrsFastTimer* SrsHybridServer::timer20ms()
+SrsTimingWheel* SrsHybridServer::wheel()
 {
-    return timer20ms_;
-}
-
-SrsFastTimer* SrsHybridServer::timer100ms()
-{
-    return timer100ms_;
-}
-
-SrsFastTimer* SrsHybridServer::timer1s()
-{
-    return timer1s_;
-}
-
-SrsFastTimer* SrsHybridServer::timer5s()
-{
-    return timer5s_;
+    return wheel_;
 }
 
 srs_error_t SrsHybridServer::on_timer(srs_utime_t interval)
@@ -303,6 +289,28 @@ srs_error_t SrsHybridServer::on_timer(srs_utime_t interval)
         free_desc = buf;
     }
 
+    string afile_desc;
+    _srs_pps_afile->update(); _srs_pps_afile_bytes->update(); _srs_pps_afile_full->update();
+    if (_srs_pps_afile->r10s() || _srs_pps_afile_full->r10s() || _srs_async_file->depth()) {
+        snprintf(buf, sizeof(buf), ", afile=(%d,kbps:%d,full:%d,depth:%d,KB:%d)", _srs_pps_afile->r10s(),
+            (int)(_srs_pps_afile_bytes->r10s() * 8 / 1000), _srs_pps_afile_full->r10s(), _srs_async_file->depth(),
+            (int)(_srs_async_file->bytes() / 1024));
+        afile_desc = buf;
+    }
+
+    // The bytes sent by MSG_ZEROCOPY, and the percent of bytes copied by kernel or fallback.
+    // The closed sockets are reaped here, because there might be no other socket to reap them.
+    string zc_desc;
+    _srs_zerocopy_reaper->reap();
+    _srs_pps_zcbytes->update(); _srs_pps_zccopied->update();
+    if (_srs_pps_zcbytes->r10s() || _srs_pps_zccopied->r10s() || _srs_zerocopy_reaper->size()) {
+        int64_t total = (int64_t)_srs_pps_zcbytes->r10s() + _srs_pps_zccopied->r10s();
+        snprintf(buf, sizeof(buf), ", zc=(kbps:%d,copied:%d,%d%%,closing:%d)", (int)((int64_t)_srs_pps_zcbytes->r10s() * 8 / 1000),
+            (int)((int64_t)_srs_pps_zccopied->r10s() * 8 / 1000), total ? (int)((int64_t)_srs_pps_zccopied->r10s() * 100 / total) : 0,
+            _srs_zerocopy_reaper->size());
+        zc_desc = buf;
+    }
+
     string recvfrom_desc;
 #if defined(SRS_DEBUG) && defined(SRS_DEBUG_STATS)
     _srs_pps_recvfrom->update(_st_stat_recvfrom); _srs_pps_recvfrom_eagain->update(_st_stat_recvfrom_eagain);
@@ -381,17 +389,19 @@ srs_error_t SrsHybridServer::on_timer(srs_utime_t interval)
     string objs_desc;
 #ifdef SRS_RTC
     _srs_pps_objs_rtps->update(); _srs_pps_objs_rraw->update(); _srs_pps_objs_rfua->update(); _srs_pps_objs_rbuf->update(); _srs_pps_objs_msgs->update(); _srs_pps_objs_rothers->update();
+    _srs_pps_objs_rhit->update(); _srs_pps_objs_rmiss->update();
     if (_srs_pps_objs_rtps->r10s() || _srs_pps_objs_rraw->r10s() || _srs_pps_objs_rfua->r10s() || _srs_pps_objs_rbuf->r10s() || _srs_pps_objs_msgs->r10s() || _srs_pps_objs_rothers->r10s()) {
-        snprintf(buf, sizeof(buf), ", objs=(pkt:%d,raw:%d,fua:%d,msg:%d,oth:%d,buf:%d)",
+        snprintf(buf, sizeof(buf), ", objs=(pkt:%d,raw:%d,fua:%d,msg:%d,oth:%d,buf:%d,hit:%d,miss:%d)",
             _srs_pps_objs_rtps->r10s(), _srs_pps_objs_rraw->r10s(), _srs_pps_objs_rfua->r10s(),
-            _srs_pps_objs_msgs->r10s(), _srs_pps_objs_rothers->r10s(), _srs_pps_objs_rbuf->r10s());
+            _srs_pps_objs_msgs->r10s(), _srs_pps_objs_rothers->r10s(), _srs_pps_objs_rbuf->r10s(),
+            _srs_pps_objs_rhit->r10s(), _srs_pps_objs_rmiss->r10s());
         objs_desc = buf;
     }
 #endif
 
-    srs_trace("Hybrid cpu=%.2f%%,%dMB%s%s%s%s%s%s%s%s%s%s%s",
+    srs_trace("Hybrid cpu=%.2f%%,%dMB%s%s%s%s%s%s%s%s%s%s%s%s%s",
         u->percent * 100, memory,
-        cid_desc.c_str(), timer_desc.c_str(),
+        cid_desc.c_str(), timer_desc.c_str(), afile_desc.c_str(), zc_desc.c_str(),
         recvfrom_desc.c_str(), io_desc.c_str(), msg_desc.c_str(),
         epoll_desc.c_str(), sched_desc.c_str(), clock_desc.c_str(),
         thread_desc.c_str(), free_desc.c_str(), objs_desc.c_str()
@@ -37,11 +37,11 @@ class SrsHybridServer : public ISrsFastTimer
 {
 private:
     std::vector<ISrsHybridServer*> servers;
-    SrsFastTimer* timer20ms_;
-    SrsFastTimer* timer100ms_;
-    SrsFastTimer* timer1s_;
-    SrsFastTimer* timer5s_;
+    // The global shared timing wheel, for timers of all objects.
+    SrsTimingWheel* wheel_;
     SrsClockWallMonitor* clock_monitor_;
+    SrsWheelTimer* clock_timer_;
+    SrsWheelTimer* timer_;
 public:
     SrsHybridServer();
     virtual ~SrsHybridServer();
@@ -53,10 +53,7 @@ public:
     virtual void stop();
 public:
     virtual SrsServerAdapter* srs();
-    SrsFastTimer* timer20ms();
-    SrsFastTimer* timer100ms();
-    SrsFastTimer* timer1s();
-    SrsFastTimer* timer5s();
+    SrsTimingWheel* wheel();
 // interface ISrsFastTimer
 private:
     srs_error_t on_timer(srs_utime_t interval);
@@ -16,6 +16,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <netdb.h>
+#ifdef __linux__
+#include <netinet/udp.h>
+#endif
 using namespace std;
 
 #include <srs_core_autofree.hpp>
@@ -35,6 +38,14 @@ SrsPps* _srs_pps_fast_addrs = NULL;
 
 SrsPps* _srs_pps_spkts = NULL;
 
+SrsPps* _srs_pps_rmmsgs = NULL;
+SrsPps* _srs_pps_rmmsgs_pkts = NULL;
+SrsPps* _srs_pps_rmmsgs_full = NULL;
+
+SrsPps* _srs_pps_smmsgs = NULL;
+SrsPps* _srs_pps_smmsgs_pkts = NULL;
+SrsPps* _srs_pps_sgso = NULL;
+
 // set the max packet size.
 #define SRS_UDP_MAX_PACKET_SIZE 65535
 
@@ -417,6 +428,11 @@ int SrsUdpMuxSocket::recvfrom(srs_utime_t timeout)
         return nread;
     }
 
+    return on_recvfrom(nread);
+}
+
+int SrsUdpMuxSocket::on_recvfrom(int nread)
+{
     // Reset the fast cache buffer size.
     cache_buffer_->set_size(nread);
     cache_buffer_->skip(-1 * cache_buffer_->pos());
@@ -591,6 +607,361 @@ SrsUdpMuxSocket* SrsUdpMuxSocket::copy_sendonly()
     return sendonly;
 }
 
+SrsUdpMuxBatch::SrsUdpMuxBatch(srs_netfd_t fd, int size)
+{
+    lfd_ = fd;
+    nn_sockets_ = srs_max(1, size);
+
+    sockets_ = new SrsUdpMuxSocket*[nn_sockets_];
+    for (int i = 0; i < nn_sockets_; i++) {
+        sockets_[i] = new SrsUdpMuxSocket(fd);
+    }
+
+#ifdef __linux__
+    msgs_ = new struct mmsghdr[nn_sockets_];
+    iovs_ = new struct iovec[nn_sockets_];
+    memset(msgs_, 0, sizeof(struct mmsghdr) * nn_sockets_);
+
+    // Bind each message header to the buffer and address of socket, which never changes.
+    for (int i = 0; i < nn_sockets_; i++) {
+        SrsUdpMuxSocket* skt = sockets_[i];
+
+        iovs_[i].iov_base = skt->buf;
+        iovs_[i].iov_len = skt->nb_buf;
+
+        struct msghdr* hdr = &msgs_[i].msg_hdr;
+        hdr->msg_name = (sockaddr*)&skt->from;
+        hdr->msg_iov = &iovs_[i];
+        hdr->msg_iovlen = 1;
+    }
+#endif
+}
+
+SrsUdpMuxBatch::~SrsUdpMuxBatch()
+{
+    for (int i = 0; i < nn_sockets_; i++) {
+        SrsUdpMuxSocket* skt = sockets_[i];
+        srs_freep(skt);
+    }
+    srs_freepa(sockets_);
+
+#ifdef __linux__
+    srs_freepa(msgs_);
+    srs_freepa(iovs_);
+#endif
+}
+
+int SrsUdpMuxBatch::recvmmsg(srs_utime_t timeout)
+{
+#ifndef __linux__
+    // Fallback to recvfrom, one packet each time.
+    SrsUdpMuxSocket* skt = sockets_[0];
+    int nread = skt->recvfrom(timeout);
+    if (nread < 0) {
+        return nread;
+    }
+    if (nread == 0) {
+        skt->nread = 0;
+    }
+    return 1;
+#else
+    // The kernel overwrites the namelen, so we must reset it for each batch.
+    for (int i = 0; i < nn_sockets_; i++) {
+        msgs_[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        msgs_[i].msg_len = 0;
+    }
+
+    int nn_msgs = srs_recvmmsg(lfd_, msgs_, nn_sockets_, 0, timeout);
+    if (nn_msgs <= 0) {
+        return nn_msgs;
+    }
+
+    for (int i = 0; i < nn_msgs; i++) {
+        SrsUdpMuxSocket* skt = sockets_[i];
+        skt->fromlen = (int)msgs_[i].msg_hdr.msg_namelen;
+        skt->nread = (int)msgs_[i].msg_len;
+
+        // Mark the socket as empty if ignored, so that user could skip it.
+        if (skt->nread <= 0 || skt->on_recvfrom(skt->nread) <= 0) {
+            skt->nread = 0;
+        }
+    }
+
+    // Update the stat.
+    ++_srs_pps_rmmsgs->sugar;
+    _srs_pps_rmmsgs_pkts->sugar += nn_msgs;
+    if (nn_msgs == nn_sockets_) {
+        ++_srs_pps_rmmsgs_full->sugar;
+    }
+
+    return nn_msgs;
+#endif
+}
+
+SrsUdpMuxSocket* SrsUdpMuxBatch::at(int index)
+{
+    srs_assert(index >= 0 && index < nn_sockets_);
+    return sockets_[index];
+}
+
+int SrsUdpMuxBatch::size()
+{
+    return nn_sockets_;
+}
+
+ISrsUdpMuxSendBatchHandler::ISrsUdpMuxSendBatchHandler()
+{
+}
+
+ISrsUdpMuxSendBatchHandler::~ISrsUdpMuxSendBatchHandler()
+{
+}
+
+SrsUdpMuxSendBatch::SrsUdpMuxSendBatch(int size, int packet_size)
+{
+    nn_packets_ = 0;
+    nn_bytes_ = 0;
+    capacity_ = srs_max(1, size);
+    gso_ = false;
+    flushing_ = false;
+
+    iovs_ = new struct iovec[capacity_];
+    buffers_ = new SrsBuffer*[capacity_];
+    for (int i = 0; i < capacity_; i++) {
+        char* buf = new char[packet_size];
+        iovs_[i].iov_base = buf;
+        iovs_[i].iov_len = 0;
+        buffers_[i] = new SrsBuffer(buf, packet_size);
+    }
+
+#ifdef __linux__
+    msgs_ = new struct mmsghdr[capacity_];
+    memset(msgs_, 0, sizeof(struct mmsghdr) * capacity_);
+    for (int i = 0; i < capacity_; i++) {
+        msgs_[i].msg_hdr.msg_iov = &iovs_[i];
+        msgs_[i].msg_hdr.msg_iovlen = 1;
+    }
+#endif
+}
+
+SrsUdpMuxSendBatch::~SrsUdpMuxSendBatch()
+{
+    for (int i = 0; i < capacity_; i++) {
+        char* buf = (char*)iovs_[i].iov_base;
+        srs_freepa(buf);
+        srs_freep(buffers_[i]);
+    }
+    srs_freepa(iovs_);
+    srs_freepa(buffers_);
+
+#ifdef __linux__
+    srs_freepa(msgs_);
+#endif
+}
+
+SrsUdpMuxSendBatch* SrsUdpMuxSendBatch::set_gso(bool v)
+{
+#if defined(__linux__) && defined(UDP_SEGMENT)
+    gso_ = v;
+#endif
+    return this;
+}
+
+void SrsUdpMuxSendBatch::fetch(iovec** piov, SrsBuffer** pbuf)
+{
+    srs_assert(nn_packets_ < capacity_);
+
+    SrsBuffer* buf = buffers_[nn_packets_];
+    buf->skip(-1 * buf->pos());
+
+    *piov = &iovs_[nn_packets_];
+    *pbuf = buf;
+}
+
+void SrsUdpMuxSendBatch::commit()
+{
+    srs_assert(nn_packets_ < capacity_);
+    nn_bytes_ += (int)iovs_[nn_packets_].iov_len;
+    nn_packets_++;
+}
+
+int SrsUdpMuxSendBatch::nn_packets()
+{
+    return nn_packets_;
+}
+
+int SrsUdpMuxSendBatch::nn_bytes()
+{
+    return nn_bytes_;
+}
+
+bool SrsUdpMuxSendBatch::empty()
+{
+    return nn_packets_ == 0;
+}
+
+bool SrsUdpMuxSendBatch::full()
+{
+    return nn_packets_ >= capacity_;
+}
+
+bool SrsUdpMuxSendBatch::flushing()
+{
+    return flushing_;
+}
+
+srs_error_t SrsUdpMuxSendBatch::flush(SrsUdpMuxSocket* skt, srs_utime_t timeout, ISrsUdpMuxSendBatchHandler* handler)
+{
+    srs_error_t err = srs_success;
+
+    if (nn_packets_ == 0) {
+        return err;
+    }
+
+    // The packets are dropped if failed, like sendto.
+    flushing_ = true;
+    if (handler && (err = handler->on_send_batch(iovs_, nn_packets_)) != srs_success) {
+        err = srs_error_wrap(err, "handler");
+    }
+    if (err == srs_success) {
+        err = do_flush(skt, timeout);
+    }
+    flushing_ = false;
+
+    int nn_packets = nn_packets_;
+    nn_packets_ = nn_bytes_ = 0;
+
+    if (err != srs_success) {
+        return srs_error_wrap(err, "flush %d packets", nn_packets);
+    }
+
+    // Yield to another coroutines, like sendto.
+    // @see https://github.com/ossrs/srs/issues/2194#issuecomment-777542162
+    skt->nn_msgs_for_yield_ += nn_packets;
+    if (skt->nn_msgs_for_yield_ > 20) {
+        skt->nn_msgs_for_yield_ = 0;
+        srs_thread_yield();
+    }
+
+    return err;
+}
+
+srs_error_t SrsUdpMuxSendBatch::do_flush(SrsUdpMuxSocket* skt, srs_utime_t timeout)
+{
+    srs_error_t err = srs_success;
+
+#ifndef __linux__
+    // Fallback to sendto, one packet each time.
+    for (int i = 0; i < nn_packets_; i++) {
+        if ((err = skt->sendto(iovs_[i].iov_base, (int)iovs_[i].iov_len, timeout)) != srs_success) {
+            return srs_error_wrap(err, "sendto");
+        }
+    }
+    return err;
+#else
+    _srs_pps_spkts->sugar += nn_packets_;
+
+    // Send all packets by one sendmsg with UDP GSO, if they are the same size.
+    int sent = 0;
+    if (gso_ && nn_packets_ > 1 && is_gso_segments()) {
+        if ((err = sendgso(skt, timeout, &sent)) == srs_success) {
+            return err;
+        }
+
+        // Disable GSO if not supported by kernel or device, and fallback to sendmmsg.
+        srs_warn("UDP: Disable GSO for err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+        gso_ = false;
+    }
+
+    // The address might change, for example, network switching, so we set it for each batch.
+    for (int i = sent; i < nn_packets_; i++) {
+        struct msghdr* hdr = &msgs_[i].msg_hdr;
+        hdr->msg_name = (sockaddr*)&skt->from;
+        hdr->msg_namelen = (socklen_t)skt->fromlen;
+        msgs_[i].msg_len = 0;
+    }
+
+    // The sendmmsg might send part of messages, so we should send the left ones.
+    while (sent < nn_packets_) {
+        int r0 = srs_sendmmsg(skt->lfd, &msgs_[sent], nn_packets_ - sent, 0, timeout);
+        if (r0 <= 0) {
+            if (r0 < 0 && errno == ETIME) {
+                return srs_error_new(ERROR_SOCKET_TIMEOUT, "sendmmsg timeout %d ms", srsu2msi(timeout));
+            }
+            return srs_error_new(ERROR_SOCKET_WRITE, "sendmmsg %d/%d", sent, nn_packets_);
+        }
+
+        sent += r0;
+        ++_srs_pps_smmsgs->sugar;
+        _srs_pps_smmsgs_pkts->sugar += r0;
+    }
+
+    return err;
+#endif
+}
+
+#ifdef __linux__
+bool SrsUdpMuxSendBatch::is_gso_segments()
+{
+    size_t segment = iovs_[0].iov_len;
+    for (int i = 1; i < nn_packets_ - 1; i++) {
+        if (iovs_[i].iov_len != segment) {
+            return false;
+        }
+    }
+    return iovs_[nn_packets_ - 1].iov_len <= segment;
+}
+
+srs_error_t SrsUdpMuxSendBatch::sendgso(SrsUdpMuxSocket* skt, srs_utime_t timeout, int* psent)
+{
+    srs_error_t err = srs_success;
+
+#ifndef UDP_SEGMENT
+    return srs_error_new(ERROR_SOCKET_WRITE, "no UDP_SEGMENT");
+#else
+    uint16_t segment = (uint16_t)iovs_[0].iov_len;
+
+    // The kernel limits the number of segments to 64, and the total size to the max UDP payload.
+    int max_segments = srs_min(64, 65507 / srs_max(1, (int)segment));
+
+    int& sent = *psent;
+    char control[CMSG_SPACE(sizeof(uint16_t))];
+    while (sent < nn_packets_) {
+        int nn = srs_min(max_segments, nn_packets_ - sent);
+
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = (sockaddr*)&skt->from;
+        msg.msg_namelen = (socklen_t)skt->fromlen;
+        msg.msg_iov = &iovs_[sent];
+        msg.msg_iovlen = nn;
+
+        // Tell kernel to split the payload to segments, see https://lwn.net/Articles/752184/
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        struct cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+        cm->cmsg_level = IPPROTO_UDP;
+        cm->cmsg_type = UDP_SEGMENT;
+        cm->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        memcpy(CMSG_DATA(cm), &segment, sizeof(uint16_t));
+
+        if (srs_sendmsg(skt->lfd, &msg, 0, timeout) <= 0) {
+            return srs_error_new(ERROR_SOCKET_WRITE, "sendmsg gso segment=%d, packets=%d/%d", segment, sent, nn_packets_);
+        }
+
+        sent += nn;
+        ++_srs_pps_sgso->sugar;
+        _srs_pps_smmsgs_pkts->sugar += nn;
+    }
+
+    return err;
+#endif
+}
+#endif
+
 SrsUdpMuxListener::SrsUdpMuxListener(ISrsUdpMuxHandler* h, std::string i, int p)
 {
     handler = h;
@@ -598,6 +969,7 @@ SrsUdpMuxListener::SrsUdpMuxListener(ISrsUdpMuxHandler* h, std::string i, int p)
     ip = i;
     port = p;
     lfd = NULL;
+    nn_recvmmsg_ = 0;
     
     nb_buf = SRS_UDP_MAX_PACKET_SIZE;
     buf = new char[nb_buf];
@@ -613,6 +985,12 @@ SrsUdpMuxListener::~SrsUdpMuxListener()
     srs_freepa(buf);
 }
 
+SrsUdpMuxListener* SrsUdpMuxListener::set_recvmmsg(int v)
+{
+    nn_recvmmsg_ = v;
+    return this;
+}
+
 int SrsUdpMuxListener::fd()
 {
     return srs_netfd_fileno(lfd);
@@ -707,6 +1085,14 @@ srs_error_t SrsUdpMuxListener::cycle()
     // and we can reuse the plaintext h264/opus with players when got plaintext.
     SrsUdpMuxSocket skt(lfd);
 
+    // For recvmmsg, we receive a batch of packets into the preallocated sockets.
+    SrsUdpMuxBatch* batch = NULL;
+    if (nn_recvmmsg_ > 1) {
+        batch = new SrsUdpMuxBatch(lfd, nn_recvmmsg_);
+        srs_trace("UDP #%d enable recvmmsg, batch=%d", srs_netfd_fileno(lfd), batch->size());
+    }
+    SrsAutoFree(SrsUdpMuxBatch, batch);
+
     // How many messages to run a yield.
     uint32_t nn_msgs_for_yield = 0;
 
@@ -717,33 +1103,43 @@ srs_error_t SrsUdpMuxListener::cycle()
 
         nn_loop++;
 
-        int nread = skt.recvfrom(SRS_UTIME_NO_TIMEOUT);
-        if (nread <= 0) {
-            if (nread < 0) {
-                srs_warn("udp recv error nn=%d", nread);
+        if (batch) {
+            int nn_pkts = batch->recvmmsg(SRS_UTIME_NO_TIMEOUT);
+            if (nn_pkts <= 0) {
+                if (nn_pkts < 0) {
+                    srs_warn("udp recvmmsg error nn=%d", nn_pkts);
+                }
+                // remux udp never return
+                continue;
             }
-            // remux udp never return
-            continue;
-        }
 
-        nn_msgs++;
-        nn_msgs_stage++;
-
-        // Handle the UDP packet.
-        err = handler->on_udp_packet(&skt);
+            for (int i = 0; i < nn_pkts; i++) {
+                SrsUdpMuxSocket* pkt = batch->at(i);
+                if (pkt->size() <= 0) {
+                    continue;
+                }
 
-        // Use pithy print to show more smart information.
-        if (err != srs_success) {
-            uint32_t nn = 0;
-            if (pp_pkt_handler_err->can_print(err, &nn)) {
-                // For performance, only restore context when output log.
-                _srs_context->set_id(cid);
+                nn_msgs++;
+                nn_msgs_stage++;
+                nn_msgs_for_yield++;
 
-                // Append more information.
-                err = srs_error_wrap(err, "size=%u, data=[%s]", skt.size(), srs_string_dumps_hex(skt.data(), skt.size(), 8).c_str());
-                srs_warn("handle udp pkt, count=%u/%u, err: %s", pp_pkt_handler_err->nn_count, nn, srs_error_desc(err).c_str());
+                on_udp_packet(pkt, pp_pkt_handler_err);
             }
-            srs_freep(err);
+        } else {
+            int nread = skt.recvfrom(SRS_UTIME_NO_TIMEOUT);
+            if (nread <= 0) {
+                if (nread < 0) {
+                    srs_warn("udp recv error nn=%d", nread);
+                }
+                // remux udp never return
+                continue;
+            }
+
+            nn_msgs++;
+            nn_msgs_stage++;
+            nn_msgs_for_yield++;
+
+            on_udp_packet(&skt, pp_pkt_handler_err);
         }
 
         pprint->elapse();
@@ -780,7 +1176,7 @@ srs_error_t SrsUdpMuxListener::cycle()
 
         // Yield to another coroutines.
         // @see https://github.com/ossrs/srs/issues/2194#issuecomment-777485531
-        if (++nn_msgs_for_yield > 10) {
+        if (nn_msgs_for_yield > 10) {
             nn_msgs_for_yield = 0;
             srs_thread_yield();
         }
@@ -789,3 +1185,23 @@ srs_error_t SrsUdpMuxListener::cycle()
     return err;
 }
 
+void SrsUdpMuxListener::on_udp_packet(SrsUdpMuxSocket* skt, SrsErrorPithyPrint* pp_pkt_handler_err)
+{
+    // Handle the UDP packet.
+    srs_error_t err = handler->on_udp_packet(skt);
+
+    // Use pithy print to show more smart information.
+    if (err != srs_success) {
+        uint32_t nn = 0;
+        if (pp_pkt_handler_err->can_print(err, &nn)) {
+            // For performance, only restore context when output log.
+            _srs_context->set_id(cid);
+
+            // Append more information.
+            err = srs_error_wrap(err, "size=%u, data=[%s]", skt->size(), srs_string_dumps_hex(skt->data(), skt->size(), 8).c_str());
+            srs_warn("handle udp pkt, count=%u/%u, err: %s", pp_pkt_handler_err->nn_count, nn, srs_error_desc(err).c_str());
+        }
+        srs_freep(err);
+    }
+}
+
@@ -22,6 +22,7 @@ struct sockaddr;
 
 class SrsBuffer;
 class SrsUdpMuxSocket;
+class SrsErrorPithyPrint;
 class ISrsListener;
 
 // The udp packet handler.
@@ -155,6 +156,8 @@ public:
 // TODO: FIXME: Rename it. Refine it for performance issue.
 class SrsUdpMuxSocket
 {
+    friend class SrsUdpMuxBatch;
+    friend class SrsUdpMuxSendBatch;
 private:
     // For sender yield only.
     uint32_t nn_msgs_for_yield_;
@@ -194,6 +197,94 @@ public:
     uint64_t fast_id();
     SrsBuffer* buffer();
     SrsUdpMuxSocket* copy_sendonly();
+private:
+    // Parse the packet in buf, which is received by recvfrom or recvmmsg.
+    int on_recvfrom(int nread);
+};
+
+// A preallocated ring of UDP mux sockets, to receive a batch of packets by one recvmmsg, so that we
+// reduce the syscalls when there are lots of packets, and fallback to recvfrom if not linux.
+class SrsUdpMuxBatch
+{
+private:
+    srs_netfd_t lfd_;
+    int nn_sockets_;
+    SrsUdpMuxSocket** sockets_;
+#ifdef __linux__
+    struct mmsghdr* msgs_;
+    struct iovec* iovs_;
+#endif
+public:
+    SrsUdpMuxBatch(srs_netfd_t fd, int size);
+    virtual ~SrsUdpMuxBatch();
+public:
+    // Receive a batch of packets, block util at least one packet arrives.
+    // @return The number of sockets which got packets, or -1 for error.
+    // @remark The socket which got an ignored packet, such as health check, is set to empty, that
+    //       means its size is 0, user should ignore it.
+    int recvmmsg(srs_utime_t timeout);
+    // Get the socket at index, which is valid before next recvmmsg.
+    SrsUdpMuxSocket* at(int index);
+    // The capacity of batch.
+    int size();
+};
+
+// A batch of UDP packets to the same peer, to send by one sendmmsg, or by one sendmsg with UDP GSO(generic
+// segmentation offload) if all packets are the same size, so that we reduce the syscalls for players. It
+// fallbacks to sendto for each packet if not linux.
+// The handler to process the packets of batch before sending, for example, to cipher RTP to SRTP.
+class ISrsUdpMuxSendBatchHandler
+{
+public:
+    ISrsUdpMuxSendBatchHandler();
+    virtual ~ISrsUdpMuxSendBatchHandler();
+public:
+    // Process the packets in place, and update the iov_len of them.
+    virtual srs_error_t on_send_batch(iovec* iovs, int nn_iovs) = 0;
+};
+
+class SrsUdpMuxSendBatch
+{
+private:
+    int nn_packets_;
+    int nn_bytes_;
+    int capacity_;
+    // Whether try to send by UDP GSO, disabled if kernel not supported.
+    bool gso_;
+    // Whether the batch is flushing, which might yield to other coroutines.
+    bool flushing_;
+    struct iovec* iovs_;
+    SrsBuffer** buffers_;
+#ifdef __linux__
+    struct mmsghdr* msgs_;
+#endif
+public:
+    SrsUdpMuxSendBatch(int size, int packet_size);
+    virtual ~SrsUdpMuxSendBatch();
+public:
+    SrsUdpMuxSendBatch* set_gso(bool v);
+    // Fetch the iovec and buffer of next packet, user should encode packet into the buffer, set the iov_len
+    // and commit it. User must flush the batch when full, before fetching the next one.
+    void fetch(iovec** piov, SrsBuffer** pbuf);
+    // Commit the fetched packet, whose size is the iov_len.
+    void commit();
+    // The number of packets and bytes in batch.
+    int nn_packets();
+    int nn_bytes();
+    bool empty();
+    bool full();
+    bool flushing();
+    // Send all packets to the peer of skt, and reset the batch. If handler is not NULL, it's called to process
+    // the packets before sending, and the batch is still flushing even if the handler yields.
+    srs_error_t flush(SrsUdpMuxSocket* skt, srs_utime_t timeout, ISrsUdpMuxSendBatchHandler* handler = NULL);
+private:
+    srs_error_t do_flush(SrsUdpMuxSocket* skt, srs_utime_t timeout);
+#ifdef __linux__
+    // Whether all packets are the same size, except the last one which might be smaller.
+    bool is_gso_segments();
+    // Send packets by sendmsg with UDP_SEGMENT, the psent is the number of packets sent even if failed.
+    srs_error_t sendgso(SrsUdpMuxSocket* skt, srs_utime_t timeout, int* psent);
+#endif
 };
 
 class SrsUdpMuxListener : public ISrsCoroutineHandler
@@ -209,9 +300,13 @@ private:
     ISrsUdpMuxHandler* handler;
     std::string ip;
     int port;
+    // The max number of packets to receive by one recvmmsg, disabled if not greater than 1.
+    int nn_recvmmsg_;
 public:
     SrsUdpMuxListener(ISrsUdpMuxHandler* h, std::string i, int p);
     virtual ~SrsUdpMuxListener();
+public:
+    SrsUdpMuxListener* set_recvmmsg(int v);
 public:
     virtual int fd();
     virtual srs_netfd_t stfd();
@@ -222,6 +317,8 @@ public:
     virtual srs_error_t cycle();
 private:
     void set_socket_buffer();
+    // Handle the packet of socket, ignore and print the error.
+    void on_udp_packet(SrsUdpMuxSocket* skt, SrsErrorPithyPrint* pp_pkt_handler_err);
 };
 
 #endif
@@ -13,6 +13,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <poll.h>
 
 #include <srs_app_config.hpp>
 #include <srs_kernel_error.hpp>
@@ -28,6 +29,93 @@
 // reserved for the end of log data, it must be strlen(LOG_TAIL)
 #define LOG_TAIL_SIZE 1
 
+// The size of ring for async log.
+#define SRS_ASYNC_LOG_RING (8 * 1024 * 1024)
+// The interval in ms for log thread to write the logs in ring, in batch.
+#define SRS_ASYNC_LOG_INTERVAL 10
+
+SrsLogRing::SrsLogRing(int capacity)
+{
+    capacity_ = 1;
+    while ((int)capacity_ < capacity) {
+        capacity_ <<= 1;
+    }
+    data_ = new char[capacity_];
+    head_ = tail_ = 0;
+}
+
+SrsLogRing::~SrsLogRing()
+{
+    srs_freepa(data_);
+}
+
+bool SrsLogRing::push(const iovec* iovs, int nn_iovs)
+{
+    uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+
+    size_t size = 0;
+    for (int i = 0; i < nn_iovs; i++) {
+        size += iovs[i].iov_len;
+    }
+    if (size > capacity_ - (tail - head)) {
+        return false;
+    }
+
+    for (int i = 0; i < nn_iovs; i++) {
+        const char* p = (const char*)iovs[i].iov_base;
+        uint32_t left = (uint32_t)iovs[i].iov_len;
+
+        // Copy in two pieces, when wrap around the end of ring.
+        while (left > 0) {
+            uint32_t pos = tail & (capacity_ - 1);
+            uint32_t nn = srs_min(left, capacity_ - pos);
+            memcpy(data_ + pos, p, nn);
+            p += nn;
+            left -= nn;
+            tail += nn;
+        }
+    }
+
+    __atomic_store_n(&tail_, tail, __ATOMIC_RELEASE);
+    return true;
+}
+
+int SrsLogRing::peek(iovec* iovs, int* pnn_iovs)
+{
+    uint32_t head = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+    uint32_t size = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE) - head;
+
+    uint32_t pos = head & (capacity_ - 1);
+    uint32_t first = srs_min(size, capacity_ - pos);
+
+    int nn_iovs = 0;
+    if (first > 0) {
+        iovs[nn_iovs].iov_base = data_ + pos;
+        iovs[nn_iovs++].iov_len = first;
+    }
+    if (size > first) {
+        iovs[nn_iovs].iov_base = data_;
+        iovs[nn_iovs++].iov_len = size - first;
+    }
+
+    *pnn_iovs = nn_iovs;
+    return (int)size;
+}
+
+void SrsLogRing::consume(int size)
+{
+    uint32_t head = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+    __atomic_store_n(&head_, head + (uint32_t)size, __ATOMIC_RELEASE);
+}
+
+bool SrsLogRing::half_full()
+{
+    uint32_t head = __atomic_load_n(&head_, __ATOMIC_ACQUIRE);
+    uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_ACQUIRE);
+    return tail - head >= capacity_ / 2;
+}
+
 SrsFileLog::SrsFileLog()
 {
     level_ = SrsLogLevelTrace;
@@ -38,10 +126,19 @@ SrsFileLog::SrsFileLog()
     utc = false;
 
     mutex_ = new SrsThreadMutex();
+
+    ring_ = NULL;
+    trd_ = NULL;
+    wakeup_[0] = wakeup_[1] = -1;
+    waiting_ = false;
+    reopen_ = false;
+    dropped_ = 0;
 }
 
 SrsFileLog::~SrsFileLog()
 {
+    stop_async();
+
     srs_freepa(log_data);
     
     if (fd > 0) {
@@ -74,6 +171,14 @@ srs_error_t SrsFileLog::initialize()
 
 void SrsFileLog::reopen()
 {
+    // The log file is owned by log thread, so we notify it to reopen the file, which might be changed by reload.
+    if (ring_) {
+        SrsThreadLocker(mutex_);
+        filename_ = _srs_config->get_log_file();
+        __atomic_store_n(&reopen_, true, __ATOMIC_RELEASE);
+        return;
+    }
+
     if (fd > 0) {
         ::close(fd);
     }
@@ -122,6 +227,53 @@ void SrsFileLog::log(SrsLogLevel level, const char* tag, const SrsContextId& con
     write_log(fd, log_data, size, level);
 }
 
+srs_error_t SrsFileLog::start_async()
+{
+    srs_error_t err = srs_success;
+
+    if (!_srs_config || !_srs_config->get_log_async()) {
+        return err;
+    }
+
+    // The caller should never block when wakeup the log thread.
+    if ((err = srs_async_pipe(wakeup_)) != srs_success) {
+        return srs_error_wrap(err, "create pipe");
+    }
+
+    filename_ = _srs_config->get_log_file();
+    ring_ = new SrsLogRing(SRS_ASYNC_LOG_RING);
+
+    if ((err = _srs_thread_pool->execute("log", SrsFileLog::start, this, &trd_)) != srs_success) {
+        srs_freep(ring_);
+        return srs_error_wrap(err, "start log thread");
+    }
+
+    return err;
+}
+
+void SrsFileLog::stop_async()
+{
+    if (!trd_) {
+        return;
+    }
+
+    // Notify the log thread to quit, by closing the pipe.
+    if (true) {
+        SrsThreadLocker(mutex_);
+        ::close(wakeup_[1]);
+        wakeup_[1] = -1;
+    }
+
+    _srs_thread_pool->join(trd_);
+    trd_ = NULL;
+    ::close(wakeup_[0]);
+    wakeup_[0] = -1;
+
+    // Write the logs directly, after the log thread quits.
+    SrsThreadLocker(mutex_);
+    srs_freep(ring_);
+}
+
 void SrsFileLog::write_log(int& fd, char *str_log, int size, int level)
 {
     // ensure the tail and EOF of string
@@ -131,6 +283,12 @@ void SrsFileLog::write_log(int& fd, char *str_log, int size, int level)
     
     // add some to the end of char.
     str_log[size++] = LOG_TAIL;
+
+    // Push to ring and written by log thread, if async.
+    if (ring_) {
+        write_async(str_log, size, level);
+        return;
+    }
     
     // if not to file, to console and return.
     if (!log_to_file_tank) {
@@ -162,14 +320,135 @@ void SrsFileLog::write_log(int& fd, char *str_log, int size, int level)
     }
 }
 
-void SrsFileLog::open_log_file()
+void SrsFileLog::write_async(char* str_log, int size, int level)
 {
-    if (!_srs_config) {
+    // Notice the dropped logs, when there is space in ring.
+    if (dropped_ > 0) {
+        char buf[128];
+        int nn = snprintf(buf, sizeof(buf), "[async log] dropped %d logs, for log thread is too slow%c", dropped_, LOG_TAIL);
+
+        iovec iov;
+        iov.iov_base = buf;
+        iov.iov_len = nn;
+        if (!ring_->push(&iov, 1)) {
+            dropped_++;
+            return;
+        }
+        dropped_ = 0;
+    }
+
+    iovec iovs[3];
+    iovs[0].iov_base = (char*)"";
+    iovs[0].iov_len = 0;
+    iovs[1].iov_base = str_log;
+    iovs[1].iov_len = size;
+    iovs[2].iov_base = (char*)"";
+    iovs[2].iov_len = 0;
+
+    // Print color msg for console, see write_log.
+    if (!log_to_file_tank && level == SrsLogLevelWarn) {
+        iovs[0].iov_base = (char*)"\033[33m";
+        iovs[0].iov_len = 5;
+    } else if (!log_to_file_tank && level > SrsLogLevelWarn) {
+        iovs[0].iov_base = (char*)"\033[31m";
+        iovs[0].iov_len = 5;
+    }
+    if (iovs[0].iov_len > 0) {
+        iovs[2].iov_base = (char*)"\033[0m";
+        iovs[2].iov_len = 4;
+    }
+
+    // Drop the log if ring is full, never block the caller.
+    if (!ring_->push(iovs, 3)) {
+        dropped_++;
         return;
     }
-    
-    std::string filename = _srs_config->get_log_file();
-    
+
+    // The log thread writes the logs about every 10ms, so only wakeup it when the ring is half full, to avoid
+    // dropping logs. Ignore EAGAIN because the pipe is full of wakeups.
+    if (ring_->half_full() && __atomic_exchange_n(&waiting_, false, __ATOMIC_SEQ_CST)) {
+        char c = 0;
+        ::write(wakeup_[1], &c, 1);
+    }
+}
+
+srs_error_t SrsFileLog::start(void* arg)
+{
+    SrsFileLog* log = (SrsFileLog*)arg;
+    return log->cycle();
+}
+
+srs_error_t SrsFileLog::cycle()
+{
+    char buf[64];
+    bool quit = false;
+
+    while (true) {
+        if (__atomic_exchange_n(&reopen_, false, __ATOMIC_ACQ_REL)) {
+            if (fd > 0) {
+                ::close(fd);
+            }
+            fd = -1;
+        }
+
+        iovec iovs[2];
+        int nn_iovs = 0;
+        int size = ring_->peek(iovs, &nn_iovs);
+
+        // Quit when notified and all logs are written.
+        if (size <= 0 && quit) {
+            break;
+        }
+
+        // Wait for logs about every 10ms, so the logs are written in batch. The producer only wakeup us when the
+        // ring is half full, or closes the pipe to quit.
+        if (size <= 0) {
+            pollfd pfd;
+            pfd.fd = wakeup_[0];
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+
+            __atomic_store_n(&waiting_, true, __ATOMIC_SEQ_CST);
+            int r0 = ::poll(&pfd, 1, SRS_ASYNC_LOG_INTERVAL);
+            __atomic_store_n(&waiting_, false, __ATOMIC_SEQ_CST);
+
+            if (r0 > 0) {
+                ssize_t nn = ::read(wakeup_[0], buf, sizeof(buf));
+                if (nn < 0 && errno != EINTR && errno != EAGAIN) {
+                    return srs_error_new(ERROR_SYSTEM_FILE_READ, "read fd=%d, r0=%d", wakeup_[0], (int)nn);
+                }
+                quit = (nn == 0);
+            }
+            continue;
+        }
+
+        if (log_to_file_tank && fd < 0) {
+            open_log_file();
+        }
+
+        // Ignore any error, and the logs are dropped if failed.
+        int target = log_to_file_tank ? fd : STDOUT_FILENO;
+        if (target >= 0) {
+            ::writev(target, iovs, nn_iovs);
+        }
+
+        ring_->consume(size);
+    }
+
+    return srs_success;
+}
+
+void SrsFileLog::open_log_file()
+{
+    // The log thread uses the cached filename, because config is not thread-safe.
+    std::string filename;
+    if (ring_) {
+        SrsThreadLocker(mutex_);
+        filename = filename_;
+    } else if (_srs_config) {
+        filename = _srs_config->get_log_file();
+    }
+
     if (filename.empty()) {
         return;
     }
@@ -11,11 +11,13 @@
 
 #include <string.h>
 #include <string>
+#include <sys/uio.h>
 
 #include <srs_app_reload.hpp>
 #include <srs_protocol_log.hpp>
 
 class SrsThreadMutex;
+class SrsThreadEntry;
 
 // For log TAGs.
 #define TAG_MAIN "MAIN"
@@ -25,6 +27,30 @@ class SrsThreadMutex;
 #define TAG_RESOURCE_UNSUB "RESOURCE_UNSUB"
 #define TAG_LARGE_TIMER "LARGE_TIMER"
 
+// The lock-free ring of log bytes, for single producer and single consumer thread, which never blocks and fails
+// if full. The capacity is rounded up to power of 2.
+class SrsLogRing
+{
+private:
+    uint32_t capacity_;
+    char* data_;
+    // The head is only written by consumer, while the tail is only written by producer.
+    uint32_t head_;
+    uint32_t tail_;
+public:
+    SrsLogRing(int capacity);
+    virtual ~SrsLogRing();
+public:
+    // Push all the bytes of iovs by producer, return false and push nothing if not enough space.
+    bool push(const iovec* iovs, int nn_iovs);
+    // Peek the bytes by consumer, in at most two pieces, return the number of bytes.
+    int peek(iovec* iovs, int* pnn_iovs);
+    // Consume the bytes by consumer, after peek and written.
+    void consume(int size);
+    // Whether the bytes in ring are more than half of capacity, by producer or consumer.
+    bool half_full();
+};
+
 // Use memory/disk cache and donot flush when write log.
 // it's ok to use it without config, which will log to console, and default trace level.
 // when you want to use different level, override this classs, set the protected _level.
@@ -44,6 +70,21 @@ private:
     // TODO: FIXME: use macro define like SRS_MULTI_THREAD_LOG to switch enable log mutex or not.
     // Mutex for multithread log.
     SrsThreadMutex* mutex_;
+private:
+    // For async log, the formatted logs are pushed to the ring, and written by the log thread.
+    SrsLogRing* ring_;
+    SrsThreadEntry* trd_;
+    // The pipe to wakeup the log thread, only when it's waiting and the ring is half full, because the log thread
+    // writes the logs about every 10ms. The log thread quits when the write fd is closed, after all logs in ring
+    // are written.
+    int wakeup_[2];
+    bool waiting_;
+    // The log file, cached for the log thread, because config is not thread-safe. Protected by mutex.
+    std::string filename_;
+    // Whether to reopen the log file, set by reopen and done by the log thread.
+    bool reopen_;
+    // The number of logs dropped for ring is full, since last drop notice.
+    int dropped_;
 public:
     SrsFileLog();
     virtual ~SrsFileLog();
@@ -52,9 +93,20 @@ public:
     virtual srs_error_t initialize();
     virtual void reopen();
     virtual void log(SrsLogLevel level, const char* tag, const SrsContextId& context_id, const char* fmt, va_list args);
+public:
+    // Start the log thread to write logs in background, if async log is enabled.
+    // @remark Should be called by primordial thread, before other threads are started.
+    virtual srs_error_t start_async();
+    // Stop the log thread after all logs in ring are written, then write logs directly.
+    virtual void stop_async();
 private:
     virtual void write_log(int& fd, char* str_log, int size, int level);
+    virtual void write_async(char* str_log, int size, int level);
     virtual void open_log_file();
+private:
+    // The entry of log thread.
+    static srs_error_t start(void* arg);
+    srs_error_t cycle();
 };
 
 #endif
@@ -168,15 +168,18 @@ srs_error_t SrsSecurityTransport::srtp_initialize()
 
     std::string send_key;
     std::string recv_key;
+    SrsSrtpProfile profile = SrsSrtpProfileAes128CmSha1_80;
 
-    if ((err = dtls_->get_srtp_key(recv_key, send_key)) != srs_success) {
+    if ((err = dtls_->get_srtp_key(recv_key, send_key, &profile)) != srs_success) {
         return err;
     }
     
-    if ((err = srtp_->initialize(recv_key, send_key)) != srs_success) {
-        return srs_error_wrap(err, "srtp init");
+    if ((err = srtp_->initialize(recv_key, send_key, profile)) != srs_success) {
+        return srs_error_wrap(err, "srtp init, profile=%s", srs_srtp_profile_string(profile).c_str());
     }
 
+    srs_trace("RTC: SRTP init, profile=%s", srs_srtp_profile_string(profile).c_str());
+
     return err;
 }
 
@@ -190,6 +193,11 @@ srs_error_t SrsSecurityTransport::protect_rtcp(void* packet, int* nb_cipher)
     return srtp_->protect_rtcp(packet, nb_cipher);
 }
 
+srs_error_t SrsSecurityTransport::protect_rtps(iovec* iovs, int nn_iovs)
+{
+    return _srs_async_srtp->protect_rtps(srtp_, iovs, nn_iovs);
+}
+
 srs_error_t SrsSecurityTransport::unprotect_rtp(void* packet, int* nb_plaintext)
 {
     return srtp_->unprotect_rtp(packet, nb_plaintext);
@@ -218,6 +226,11 @@ srs_error_t SrsSemiSecurityTransport::protect_rtcp(void* packet, int* nb_cipher)
     return srs_success;
 }
 
+srs_error_t SrsSemiSecurityTransport::protect_rtps(iovec* iovs, int nn_iovs)
+{
+    return srs_success;
+}
+
 SrsPlaintextTransport::SrsPlaintextTransport(ISrsRtcNetwork* s)
 {
     network_ = s;
@@ -273,6 +286,11 @@ srs_error_t SrsPlaintextTransport::protect_rtcp(void* packet, int* nb_cipher)
     return srs_success;
 }
 
+srs_error_t SrsPlaintextTransport::protect_rtps(iovec* iovs, int nn_iovs)
+{
+    return srs_success;
+}
+
 srs_error_t SrsPlaintextTransport::unprotect_rtp(void* packet, int* nb_plaintext)
 {
     return srs_success;
@@ -420,7 +438,6 @@ SrsRtcPlayStream::SrsRtcPlayStream(SrsRtcConnection* s, const SrsContextId& cid)
     realtime = true;
 
     nack_enabled_ = false;
-    nack_no_copy_ = false;
 
     _srs_config->subscribe(this);
     nack_epp = new SrsErrorPithyPrint();
@@ -495,20 +512,8 @@ srs_error_t SrsRtcPlayStream::initialize(SrsRequest* req, std::map<uint32_t, Srs
     }
 
     // TODO: FIXME: Support reload.
-    nack_enabled_ = _srs_config->get_rtc_nack_enabled(req->vhost);
-    nack_no_copy_ = _srs_config->get_rtc_nack_no_copy(req->vhost);
-    srs_trace("RTC player nack=%d, nnc=%d", nack_enabled_, nack_no_copy_);
-
-    // Setup tracks.
-    for (map<uint32_t, SrsRtcAudioSendTrack*>::iterator it = audio_tracks_.begin(); it != audio_tracks_.end(); ++it) {
-        SrsRtcAudioSendTrack* track = it->second;
-        track->set_nack_no_copy(nack_no_copy_);
-    }
-
-    for (map<uint32_t, SrsRtcVideoSendTrack*>::iterator it = video_tracks_.begin(); it != video_tracks_.end(); ++it) {
-        SrsRtcVideoSendTrack* track = it->second;
-        track->set_nack_no_copy(nack_no_copy_);
-    }
+    nack_enabled_ = _srs_config->get_vhost_snapshot(req->vhost)->rtc_nack_enabled;
+    srs_trace("RTC player nack=%d", nack_enabled_);
 
     return err;
 }
@@ -552,6 +557,14 @@ void SrsRtcPlayStream::on_stream_change(SrsRtcSourceDescription* desc)
     }
 }
 
+void SrsRtcPlayStream::on_queue_overflow()
+{
+    // Request keyframe(PLI) for video, because packets are dropped until the next keyframe.
+    for (map<uint32_t, SrsRtcVideoSendTrack*>::iterator it = video_tracks_.begin(); it != video_tracks_.end(); ++it) {
+        pli_worker_->request_keyframe(it->first, cid_);
+    }
+}
+
 srs_error_t SrsRtcPlayStream::on_reload_vhost_play(string vhost)
 {
     if (req_->vhost != vhost) {
@@ -641,22 +654,41 @@ srs_error_t SrsRtcPlayStream::cycle()
     SrsErrorPithyPrint* epp = new SrsErrorPithyPrint();
     SrsAutoFree(SrsErrorPithyPrint, epp);
 
+    SrsStatistic* stat = SrsStatistic::instance();
+    srs_utime_t last_stat = 0;
+
     while (true) {
         if ((err = trd_->pull()) != srs_success) {
             return srs_error_wrap(err, "rtc sender thread");
         }
 
+        // Update the queue of consumer to stat, about once per second.
+        srs_utime_t now = srs_get_system_time();
+        if (now - last_stat >= 1 * SRS_UTIME_SECONDS) {
+            last_stat = now;
+            stat->on_client_queue(cid_.c_str(), consumer->queue_size(), consumer->queue_depth(),
+                consumer->nn_dropped(), consumer->nn_overflows());
+        }
+
         // Wait for amount of packets.
         SrsRtpPacket* pkt = NULL;
         consumer->dump_packet(&pkt);
         if (!pkt) {
+            // Send the batched packets before waiting, so the packets of this wakeup are sent by one syscall.
+            if ((err = session_->flush_send_batch()) != srs_success) {
+                uint32_t nn = 0;
+                if (epp->can_print(err, &nn)) {
+                    srs_warn("play flush batch, nn=%u/%u, err: %s", epp->nn_count, nn, srs_error_desc(err).c_str());
+                }
+                srs_freep(err);
+            }
+
             // TODO: FIXME: We should check the quit event.
             consumer->wait(mw_msgs);
             continue;
         }
 
         // Send-out the RTP packet and do cleanup
-        // @remark Note that the pkt might be set to NULL.
         if ((err = send_packet(pkt)) != srs_success) {
             uint32_t nn = 0;
             if (epp->can_print(err, &nn)) {
@@ -665,13 +697,12 @@ srs_error_t SrsRtcPlayStream::cycle()
             srs_freep(err);
         }
 
-        // Free the packet.
-        // @remark Note that the pkt might be set to NULL.
-        srs_freep(pkt);
+        // Release the packet, which is shared by all players.
+        srs_rtp_packet_free(pkt);
     }
 }
 
-srs_error_t SrsRtcPlayStream::send_packet(SrsRtpPacket*& pkt)
+srs_error_t SrsRtcPlayStream::send_packet(SrsRtpPacket* pkt)
 {
     srs_error_t err = srs_success;
 
@@ -721,15 +752,15 @@ srs_error_t SrsRtcPlayStream::send_packet(SrsRtpPacket*& pkt)
         return err;
     }
 
-    // Consume packet by track.
-    if ((err = track->on_rtp(pkt)) != srs_success) {
+    // Consume packet by track, the packet is shared so the track writes its own header.
+    SrsRtpHeader header;
+    if ((err = track->on_rtp(pkt, &header)) != srs_success) {
         return srs_error_wrap(err, "audio track, SSRC=%u, SEQ=%u", ssrc, pkt->header.get_sequence());
     }
 
     // For NACK to handle packet.
-    // @remark Note that the pkt might be set to NULL.
     if (nack_enabled_) {
-        if ((err = track->on_nack(&pkt)) != srs_success) {
+        if ((err = track->on_nack(pkt, &header)) != srs_success) {
             return srs_error_wrap(err, "on nack");
         }
     }
@@ -853,6 +884,11 @@ srs_error_t SrsRtcPlayStream::on_rtcp_nack(SrsRtcpNack* rtcp)
         return srs_error_wrap(err, "track response nack. id:%s, ssrc=%u", target->get_track_id().c_str(), ssrc);
     }
 
+    // Never delay the retransmitted packets in batch.
+    if ((err = session_->flush_send_batch()) != srs_success) {
+        return srs_error_wrap(err, "flush nack");
+    }
+
     return err;
 }
 
@@ -920,12 +956,13 @@ srs_error_t SrsRtcPlayStream::do_request_keyframe(uint32_t ssrc, SrsContextId ci
 
 SrsRtcPublishRtcpTimer::SrsRtcPublishRtcpTimer(SrsRtcPublishStream* p) : p_(p)
 {
-    _srs_hybrid->timer1s()->subscribe(this);
+    timer_ = new SrsWheelTimer(this, 1 * SRS_UTIME_SECONDS);
+    _srs_hybrid->wheel()->add(timer_);
 }
 
 SrsRtcPublishRtcpTimer::~SrsRtcPublishRtcpTimer()
 {
-    _srs_hybrid->timer1s()->unsubscribe(this);
+    srs_freep(timer_);
 }
 
 srs_error_t SrsRtcPublishRtcpTimer::on_timer(srs_utime_t interval)
@@ -956,12 +993,13 @@ srs_error_t SrsRtcPublishRtcpTimer::on_timer(srs_utime_t interval)
 
 SrsRtcPublishTwccTimer::SrsRtcPublishTwccTimer(SrsRtcPublishStream* p) : p_(p)
 {
-    _srs_hybrid->timer100ms()->subscribe(this);
+    timer_ = new SrsWheelTimer(this, 100 * SRS_UTIME_MILLISECONDS);
+    _srs_hybrid->wheel()->add(timer_);
 }
 
 SrsRtcPublishTwccTimer::~SrsRtcPublishTwccTimer()
 {
-    _srs_hybrid->timer100ms()->unsubscribe(this);
+    srs_freep(timer_);
 }
 
 srs_error_t SrsRtcPublishTwccTimer::on_timer(srs_utime_t interval)
@@ -1151,10 +1189,10 @@ srs_error_t SrsRtcPublishStream::initialize(SrsRequest* r, SrsRtcSourceDescripti
         rtcp_twcc_.set_media_ssrc(media_ssrc);
     }
 
-    nack_enabled_ = _srs_config->get_rtc_nack_enabled(req_->vhost);
-    nack_no_copy_ = _srs_config->get_rtc_nack_no_copy(req_->vhost);
-    pt_to_drop_ = (uint16_t)_srs_config->get_rtc_drop_for_pt(req_->vhost);
-    twcc_enabled_ = _srs_config->get_rtc_twcc_enabled(req_->vhost);
+    nack_enabled_ = _srs_config->get_vhost_snapshot(req_->vhost)->rtc_nack_enabled;
+    nack_no_copy_ = _srs_config->get_vhost_snapshot(req_->vhost)->rtc_nack_no_copy;
+    pt_to_drop_ = (uint16_t)_srs_config->get_vhost_snapshot(req_->vhost)->rtc_drop_for_pt;
+    twcc_enabled_ = _srs_config->get_vhost_snapshot(req_->vhost)->rtc_twcc_enabled;
 
     // No TWCC when negotiate, disable it.
     if (twcc_id <= 0) {
@@ -1719,12 +1757,13 @@ void SrsRtcPublishStream::update_send_report_time(uint32_t ssrc, const SrsNtp& n
 
 SrsRtcConnectionNackTimer::SrsRtcConnectionNackTimer(SrsRtcConnection* p) : p_(p)
 {
-    _srs_hybrid->timer20ms()->subscribe(this);
+    timer_ = new SrsWheelTimer(this, 20 * SRS_UTIME_MILLISECONDS);
+    _srs_hybrid->wheel()->add(timer_);
 }
 
 SrsRtcConnectionNackTimer::~SrsRtcConnectionNackTimer()
 {
-    _srs_hybrid->timer20ms()->unsubscribe(this);
+    srs_freep(timer_);
 }
 
 srs_error_t SrsRtcConnectionNackTimer::on_timer(srs_utime_t interval)
@@ -1769,6 +1808,13 @@ SrsRtcConnection::SrsRtcConnection(SrsRtcServer* s, const SrsContextId& cid)
     cache_iov_->iov_len = kRtpPacketSize;
     cache_buffer_ = new SrsBuffer((char*)cache_iov_->iov_base, kRtpPacketSize);
 
+    send_batch_ = NULL;
+    int nn_sendmmsg = _srs_config->get_rtc_server_sendmmsg();
+    if (nn_sendmmsg > 1) {
+        send_batch_ = new SrsUdpMuxSendBatch(nn_sendmmsg, kRtpPacketSize);
+        send_batch_->set_gso(_srs_config->get_rtc_server_gso());
+    }
+
     last_stun_time = 0;
     session_timeout = 0;
     disposing_ = false;
@@ -1814,6 +1860,7 @@ SrsRtcConnection::~SrsRtcConnection()
         srs_freep(cache_iov_);
     }
     srs_freep(cache_buffer_);
+    srs_freep(send_batch_);
 
     srs_freep(req_);
     srs_freep(pli_epp);
@@ -2005,7 +2052,7 @@ srs_error_t SrsRtcConnection::initialize(SrsRequest* r, bool dtls, bool srtp, st
     session_timeout = _srs_config->get_rtc_stun_timeout(req_->vhost);
     last_stun_time = srs_get_system_time();
 
-    nack_enabled_ = _srs_config->get_rtc_nack_enabled(req_->vhost);
+    nack_enabled_ = _srs_config->get_vhost_snapshot(req_->vhost)->rtc_nack_enabled;
 
     srs_trace("RTC init session, user=%s, url=%s, encrypt=%u/%u, DTLS(role=%s, version=%s), timeout=%dms, nack=%d",
         username.c_str(), r->get_stream_url().c_str(), dtls, srtp, cfg->dtls_role.c_str(), cfg->dtls_version.c_str(),
@@ -2436,25 +2483,35 @@ void SrsRtcConnection::simulate_player_drop_packet(SrsRtpHeader* h, int nn_bytes
     nn_simulate_player_nack_drop--;
 }
 
-srs_error_t SrsRtcConnection::do_send_packet(SrsRtpPacket* pkt)
+srs_error_t SrsRtcConnection::do_send_packet(SrsRtpPacket* pkt, SrsRtpHeader* header)
 {
     srs_error_t err = srs_success;
 
     // For this message, select the first iovec.
     iovec* iov = cache_iov_;
+    SrsBuffer* buf = cache_buffer_;
+    buf->skip(-1 * buf->pos());
+
+    // Select the next iovec of batch, only for UDP network, and never append packet when flushing.
+    SrsUdpMuxSendBatch* batch = send_batch_;
+    if (batch && (batch->flushing() || networks_->available() != networks_->udp())) {
+        batch = NULL;
+    }
+    if (batch) {
+        batch->fetch(&iov, &buf);
+    }
     iov->iov_len = kRtpPacketSize;
-    cache_buffer_->skip(-1 * cache_buffer_->pos());
 
     // Marshal packet to bytes in iovec.
     if (true) {
-        if ((err = pkt->encode(cache_buffer_)) != srs_success) {
+        if ((err = pkt->encode(buf, header)) != srs_success) {
             return srs_error_wrap(err, "encode packet");
         }
-        iov->iov_len = cache_buffer_->pos();
+        iov->iov_len = buf->pos();
     }
 
-    // Cipher RTP to SRTP packet.
-    if (true) {
+    // Cipher RTP to SRTP packet. For batch, all packets are ciphered when flushing, see SrsRtcUdpNetwork::on_send_batch.
+    if (!batch) {
         int nn_encrypt = (int)iov->iov_len;
         if ((err = networks_->available()->protect_rtp(iov->iov_base, &nn_encrypt)) != srs_success) {
             return srs_error_wrap(err, "srtp protect");
@@ -2464,13 +2521,22 @@ srs_error_t SrsRtcConnection::do_send_packet(SrsRtpPacket* pkt)
 
     // For NACK simulator, drop packet.
     if (nn_simulate_player_nack_drop) {
-        simulate_player_drop_packet(&pkt->header, (int)iov->iov_len);
+        simulate_player_drop_packet(header, (int)iov->iov_len);
         iov->iov_len = 0;
         return err;
     }
 
     ++_srs_pps_srtps->sugar;
 
+    // Send the batch when full, or when player is going to wait for packets, see SrsRtcPlayStream::cycle.
+    if (batch) {
+        batch->commit();
+        if (batch->full()) {
+            return flush_send_batch();
+        }
+        return err;
+    }
+
     if ((err = networks_->available()->write(iov->iov_base, iov->iov_len, NULL)) != srs_success) {
         srs_warn("RTC: Write %d bytes err %s", iov->iov_len, srs_error_desc(err).c_str());
         srs_freep(err);
@@ -2478,8 +2544,24 @@ srs_error_t SrsRtcConnection::do_send_packet(SrsRtpPacket* pkt)
     }
 
     // Detail log, should disable it in release version.
-    srs_info("RTC: SEND PT=%u, SSRC=%#x, SEQ=%u, Time=%u, %u/%u bytes", pkt->header.get_payload_type(), pkt->header.get_ssrc(),
-        pkt->header.get_sequence(), pkt->header.get_timestamp(), pkt->nb_bytes(), iov->iov_len);
+    srs_info("RTC: SEND PT=%u, SSRC=%#x, SEQ=%u, Time=%u, %u/%u bytes", header->get_payload_type(), header->get_ssrc(),
+        header->get_sequence(), header->get_timestamp(), pkt->nb_bytes(), iov->iov_len);
+
+    return err;
+}
+
+srs_error_t SrsRtcConnection::flush_send_batch()
+{
+    srs_error_t err = srs_success;
+
+    if (!send_batch_ || send_batch_->empty() || send_batch_->flushing()) {
+        return err;
+    }
+
+    // The packets are dropped if failed, the caller decides whether to ignore the error.
+    if ((err = networks_->udp()->write_batch(send_batch_)) != srs_success) {
+        return srs_error_wrap(err, "write batch");
+    }
 
     return err;
 }
@@ -2514,7 +2596,7 @@ srs_error_t SrsRtcConnection::on_binding_request(SrsStunPacket* r, string& ice_p
 
     ++_srs_pps_sstuns->sugar;
 
-    bool strict_check = _srs_config->get_rtc_stun_strict_check(req_->vhost);
+    bool strict_check = _srs_config->get_vhost_snapshot(req_->vhost)->rtc_stun_strict_check;
     if (strict_check && r->get_ice_controlled()) {
         // @see: https://tools.ietf.org/html/draft-ietf-ice-rfc5245bis-00#section-6.1.3.1
         // TODO: Send 487 (Role Conflict) error response.
@@ -2584,8 +2666,8 @@ srs_error_t SrsRtcConnection::negotiate_publish_capability(SrsRtcUserConfig* ruc
     SrsRequest* req = ruc->req_;
     const SrsSdp& remote_sdp = ruc->remote_sdp_;
 
-    bool nack_enabled = _srs_config->get_rtc_nack_enabled(req->vhost);
-    bool twcc_enabled = _srs_config->get_rtc_twcc_enabled(req->vhost);
+    bool nack_enabled = _srs_config->get_vhost_snapshot(req->vhost)->rtc_nack_enabled;
+    bool twcc_enabled = _srs_config->get_vhost_snapshot(req->vhost)->rtc_twcc_enabled;
     // TODO: FIME: Should check packetization-mode=1 also.
     bool has_42e01f = srs_sdp_has_h264_profile(remote_sdp, "42e01f");
 
@@ -3015,8 +3097,8 @@ srs_error_t SrsRtcConnection::negotiate_play_capability(SrsRtcUserConfig* ruc, s
     SrsRequest* req = ruc->req_;
     const SrsSdp& remote_sdp = ruc->remote_sdp_;
 
-    bool nack_enabled = _srs_config->get_rtc_nack_enabled(req->vhost);
-    bool twcc_enabled = _srs_config->get_rtc_twcc_enabled(req->vhost);
+    bool nack_enabled = _srs_config->get_vhost_snapshot(req->vhost)->rtc_nack_enabled;
+    bool twcc_enabled = _srs_config->get_vhost_snapshot(req->vhost)->rtc_twcc_enabled;
     // TODO: FIME: Should check packetization-mode=1 also.
     bool has_42e01f = srs_sdp_has_h264_profile(remote_sdp, "42e01f");
 
@@ -31,6 +31,7 @@
 #include <sys/socket.h>
 
 class SrsUdpMuxSocket;
+class SrsUdpMuxSendBatch;
 class SrsLiveConsumer;
 class SrsStunPacket;
 class SrsRtcServer;
@@ -84,6 +85,8 @@ public:
     // The nb_cipher should be initialized to the size of cipher, with some paddings.
     virtual srs_error_t protect_rtp(void* packet, int* nb_cipher) = 0;
     virtual srs_error_t protect_rtcp(void* packet, int* nb_cipher) = 0;
+    // Encrypt a batch of RTP packets in place, maybe by crypto workers, see SrsAsyncSRTPManager.
+    virtual srs_error_t protect_rtps(iovec* iovs, int nn_iovs) = 0;
     // Decrypt the packet(cipher) to plaintext, which is also the packet ptr.
     // The nb_plaintext should be initialized to the size of cipher.
     virtual srs_error_t unprotect_rtp(void* packet, int* nb_plaintext) = 0;
@@ -112,6 +115,7 @@ public:
     // The nb_cipher should be initialized to the size of cipher, with some paddings.
     srs_error_t protect_rtp(void* packet, int* nb_cipher);
     srs_error_t protect_rtcp(void* packet, int* nb_cipher);
+    srs_error_t protect_rtps(iovec* iovs, int nn_iovs);
     // Decrypt the packet(cipher) to plaintext, which is also the packet ptr.
     // The nb_plaintext should be initialized to the size of cipher.
     srs_error_t unprotect_rtp(void* packet, int* nb_plaintext);
@@ -134,6 +138,7 @@ public:
 public:
     srs_error_t protect_rtp(void* packet, int* nb_cipher);
     srs_error_t protect_rtcp(void* packet, int* nb_cipher);
+    srs_error_t protect_rtps(iovec* iovs, int nn_iovs);
 };
 
 // Plaintext transport, without DTLS or SRTP.
@@ -155,6 +160,7 @@ public:
 public:
     srs_error_t protect_rtp(void* packet, int* nb_cipher);
     srs_error_t protect_rtcp(void* packet, int* nb_cipher);
+    srs_error_t protect_rtps(iovec* iovs, int nn_iovs);
     srs_error_t unprotect_rtp(void* packet, int* nb_plaintext);
     srs_error_t unprotect_rtcp(void* packet, int* nb_plaintext);
 };
@@ -235,7 +241,6 @@ private:
     bool realtime;
     // Whether enabled nack.
     bool nack_enabled_;
-    bool nack_no_copy_;
 private:
     // Whether player started.
     bool is_started;
@@ -247,6 +252,7 @@ public:
 // Interface ISrsRtcSourceChangeCallback
 public:
     void on_stream_change(SrsRtcSourceDescription* desc);
+    void on_queue_overflow();
 // interface ISrsReloadHandler
 public:
     virtual srs_error_t on_reload_vhost_play(std::string vhost);
@@ -258,7 +264,7 @@ public:
 public:
     virtual srs_error_t cycle();
 private:
-    srs_error_t send_packet(SrsRtpPacket*& pkt);
+    srs_error_t send_packet(SrsRtpPacket* pkt);
 public:
     // Directly set the status of track, generally for init to set the default value.
     void set_all_tracks_status(bool status);
@@ -280,6 +286,7 @@ class SrsRtcPublishRtcpTimer : public ISrsFastTimer
 {
 private:
     SrsRtcPublishStream* p_;
+    SrsWheelTimer* timer_;
 public:
     SrsRtcPublishRtcpTimer(SrsRtcPublishStream* p);
     virtual ~SrsRtcPublishRtcpTimer();
@@ -293,6 +300,7 @@ class SrsRtcPublishTwccTimer : public ISrsFastTimer
 {
 private:
     SrsRtcPublishStream* p_;
+    SrsWheelTimer* timer_;
 public:
     SrsRtcPublishTwccTimer(SrsRtcPublishStream* p);
     virtual ~SrsRtcPublishTwccTimer();
@@ -403,6 +411,7 @@ class SrsRtcConnectionNackTimer : public ISrsFastTimer
 {
 private:
     SrsRtcConnection* p_;
+    SrsWheelTimer* timer_;
 public:
     SrsRtcConnectionNackTimer(SrsRtcConnection* p);
     virtual ~SrsRtcConnectionNackTimer();
@@ -430,6 +439,8 @@ private:
 private:
     iovec* cache_iov_;
     SrsBuffer* cache_buffer_;
+    // The batch of packets to send by sendmmsg or UDP GSO, NULL if disabled.
+    SrsUdpMuxSendBatch* send_batch_;
 private:
     // key: stream id
     std::map<std::string, SrsRtcPlayStream*> players_;
@@ -531,7 +542,10 @@ public:
     // Simulate the NACK to drop nn packets.
     void simulate_nack_drop(int nn);
     void simulate_player_drop_packet(SrsRtpHeader* h, int nn_bytes);
-    srs_error_t do_send_packet(SrsRtpPacket* pkt);
+    // Send the packet shared by players, with the header of player.
+    srs_error_t do_send_packet(SrsRtpPacket* pkt, SrsRtpHeader* header);
+    // Send the batched packets, see do_send_packet.
+    srs_error_t flush_send_batch();
     // Directly set the status of play track, generally for init to set the default value.
     void set_all_tracks_status(std::string stream_uri, bool is_publish, bool status);
 public:
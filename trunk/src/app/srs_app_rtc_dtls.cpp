@@ -9,6 +9,7 @@
 using namespace std;
 
 #include <string.h>
+#include <pthread.h>
 
 #include <srs_kernel_log.hpp>
 #include <srs_kernel_error.hpp>
@@ -20,6 +21,8 @@ using namespace std;
 #include <srs_app_log.hpp>
 #include <srs_kernel_utility.hpp>
 #include <srs_protocol_utility.hpp>
+#include <srs_app_threads.hpp>
+#include <srs_kernel_kbps.hpp>
 
 #include <srtp2/srtp.h>
 #include <openssl/ssl.h>
@@ -29,6 +32,11 @@ using namespace std;
 // @see https://github.com/ossrs/srs/issues/2415
 const int DTLS_FRAGMENT_MAX_SIZE = 1200;
 
+// The max packets to queue when the handshake is in DTLS worker, for example, the flight of certificates.
+const int DTLS_MAX_PENDINGS = 16;
+
+extern SrsPps* _srs_pps_adtls_drop;
+
 // Defined in HTTP/HTTPS client.
 extern int srs_verify_callback(int preverify_ok, X509_STORE_CTX *ctx);
 
@@ -44,12 +52,15 @@ unsigned int dtls_timer_cb(SSL* dtls, unsigned int previous_us)
     SrsDtlsImpl* dtls_impl = (SrsDtlsImpl*)SSL_get_ex_data(dtls, 0);
     srs_assert(dtls_impl);
 
+    // The DTLS might be freed when handshake in DTLS worker, which is always DTLS server that never resets timer.
+    SrsAsyncDtlsTask* task = (SrsAsyncDtlsTask*)SSL_get_ex_data(dtls, 1);
+
     // Double the timeout. Note that it can be 0.
     unsigned int timeout_us = previous_us * 2;
 
     // If previous_us is 0, for example, the HelloVerifyRequest, we should response it ASAP.
     // When got ServerHello, we should reset the timer.
-    if (previous_us == 0 || dtls_impl->should_reset_timer()) {
+    if (previous_us == 0 || (!task && dtls_impl->should_reset_timer())) {
         timeout_us =  50 * 1000; // in us
     }
 
@@ -67,6 +78,9 @@ void ssl_on_info(const SSL* dtls, int where, int ret)
     SrsDtlsImpl* dtls_impl = (SrsDtlsImpl*)SSL_get_ex_data(dtls, 0);
     srs_assert(dtls_impl);
 
+    // The task when handshake in DTLS worker, see SrsAsyncDtlsManager.
+    SrsAsyncDtlsTask* task = (SrsAsyncDtlsTask*)SSL_get_ex_data(dtls, 1);
+
     const char* method;
     int w = where& ~SSL_ST_MASK;
     if (w & SSL_ST_CONNECT) {
@@ -96,8 +110,14 @@ void ssl_on_info(const SSL* dtls, int where, int ret)
                 alert_desc.c_str(), SSL_alert_desc_string_long(ret), where, ret, r1);
         }
 
-        // Notify the DTLS to handle the ALERT message, which maybe means media connection disconnect.
-        dtls_impl->callback_by_ssl(alert_type, alert_desc);
+        // Notify the DTLS to handle the ALERT message, which maybe means media connection disconnect. If in DTLS
+        // worker, the alert is notified by the hybrid thread when the task is done.
+        if (task) {
+            task->alert_types.push_back(alert_type);
+            task->alert_descs.push_back(alert_desc);
+        } else {
+            dtls_impl->callback_by_ssl(alert_type, alert_desc);
+        }
     } else if (where & SSL_CB_EXIT) {
         if (ret == 0) {
             srs_warn("DTLS: Fail method=%s state=%s(%s), where=%d, ret=%d, r1=%d", method, SSL_state_string(dtls),
@@ -114,6 +134,72 @@ void ssl_on_info(const SSL* dtls, int where, int ret)
     }
 }
 
+string srs_srtp_profile_string(SrsSrtpProfile v)
+{
+    switch (v) {
+        case SrsSrtpProfileAes128CmSha1_80: return "AES_CM_128_HMAC_SHA1_80";
+        case SrsSrtpProfileAeadAes128Gcm: return "AEAD_AES_128_GCM";
+        case SrsSrtpProfileAeadAes256Gcm: return "AEAD_AES_256_GCM";
+        default: return "Unknown";
+    }
+}
+
+void srs_srtp_policy_set_profile(srtp_policy_t* policy, SrsSrtpProfile v)
+{
+    switch (v) {
+        case SrsSrtpProfileAeadAes128Gcm:
+            srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy->rtp);
+            srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy->rtcp);
+            break;
+        case SrsSrtpProfileAeadAes256Gcm:
+            srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy->rtp);
+            srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy->rtcp);
+            break;
+        default:
+            srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy->rtp);
+            srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy->rtcp);
+            break;
+    }
+}
+
+// Whether the profiles are supported, detected once because it's used by the hybrid and DTLS threads.
+static bool _srs_srtp_profiles[3] = {true, false, false};
+static pthread_once_t _srs_srtp_profiles_once = PTHREAD_ONCE_INIT;
+
+// Detect by creating a context, because the GCM ciphers are not registered if libsrtp without openssl.
+static void srs_srtp_detect_profiles()
+{
+    SrsSrtpProfile profiles[] = {SrsSrtpProfileAeadAes128Gcm, SrsSrtpProfileAeadAes256Gcm};
+    for (int i = 0; i < (int)(sizeof(profiles) / sizeof(SrsSrtpProfile)); i++) {
+        SrsSrtpProfile v = profiles[i];
+        uint8_t key[SRTP_AES_GCM_256_KEY_LEN_WSALT] = {0};
+
+        srtp_policy_t policy;
+        bzero(&policy, sizeof(policy));
+        srs_srtp_policy_set_profile(&policy, v);
+        policy.ssrc.type = ssrc_any_outbound;
+        policy.key = key;
+
+        srtp_t ctx = NULL;
+        _srs_srtp_profiles[v] = (srtp_create(&ctx, &policy) == srtp_err_status_ok);
+        if (ctx) {
+            srtp_dealloc(ctx);
+        }
+    }
+}
+
+bool srs_srtp_profile_supported(SrsSrtpProfile v)
+{
+    if (v == SrsSrtpProfileAes128CmSha1_80) {
+        return true;
+    }
+
+    // Note that the srtp_init() must be done before it.
+    pthread_once(&_srs_srtp_profiles_once, srs_srtp_detect_profiles);
+
+    return _srs_srtp_profiles[v];
+}
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 SSL_CTX* srs_build_dtls_ctx(SrsDtlsVersion version, std::string role)
@@ -181,11 +267,22 @@ SSL_CTX* srs_build_dtls_ctx(SrsDtlsVersion version, std::string role)
         // @see https://www.openssl.org/docs/man1.0.2/man3/SSL_CTX_set_read_ahead.html
         SSL_CTX_set_read_ahead(dtls_ctx, 1);
 
-        // TODO: Maybe we can use SRTP-GCM in future.
+        // Prefer the AEAD GCM profiles, which are much cheaper than CTR with HMAC-SHA1 on AES-NI/CLMUL machines,
+        // and fallback to SRTP_AES128_CM_SHA1_80 if peer does not offer them. The server selects the profile by
+        // the order of its own list, please read ssl/d1_srtp.c
         // @see https://bugs.chromium.org/p/chromium/issues/detail?id=713701
-        // @see https://groups.google.com/forum/#!topic/discuss-webrtc/PvCbWSetVAQ
-        // @remark Only support SRTP_AES128_CM_SHA1_80, please read ssl/d1_srtp.c
-        srs_assert(SSL_CTX_set_tlsext_use_srtp(dtls_ctx, "SRTP_AES128_CM_SHA1_80") == 0);
+        string profiles = "SRTP_AES128_CM_SHA1_80";
+#ifdef SRTP_AEAD_AES_128_GCM
+        if (_srs_config->get_rtc_server_srtp_gcm()) {
+            if (srs_srtp_profile_supported(SrsSrtpProfileAeadAes256Gcm)) {
+                profiles = "SRTP_AEAD_AES_256_GCM:" + profiles;
+            }
+            if (srs_srtp_profile_supported(SrsSrtpProfileAeadAes128Gcm)) {
+                profiles = "SRTP_AEAD_AES_128_GCM:" + profiles;
+            }
+        }
+#endif
+        srs_assert(SSL_CTX_set_tlsext_use_srtp(dtls_ctx, profiles.c_str()) == 0);
     }
 
     return dtls_ctx;
@@ -401,6 +498,8 @@ SrsDtlsImpl::SrsDtlsImpl(ISrsDtlsCallback* callback)
     nn_arq_packets = 0;
 
     version_ = SrsDtlsVersionAuto;
+
+    task_ = NULL;
 }
 
 SrsDtlsImpl::~SrsDtlsImpl()
@@ -410,6 +509,14 @@ SrsDtlsImpl::~SrsDtlsImpl()
             version_, nn_arq_packets);
     }
 
+    // The SSL is used by DTLS worker, so it's freed by the task when it's done.
+    if (task_) {
+        task_->dtls = NULL;
+        task_->ctx = dtls_ctx;
+        dtls_ctx = NULL;
+        dtls = NULL;
+    }
+
     if (dtls_ctx) {
         SSL_CTX_free(dtls_ctx);
         dtls_ctx = NULL;
@@ -497,6 +604,12 @@ srs_error_t SrsDtlsImpl::do_on_dtls(char* data, int nb_data)
         srs_info("DTLS: After done, got %d bytes", nb_data);
     }
 
+    // Do the handshake of DTLS server by DTLS workers if enabled, note that the DTLS client is not supported, because
+    // its ARQ coroutine also uses the SSL.
+    if (!handshake_done_for_us && !is_dtls_client() && _srs_async_dtls->enabled()) {
+        return post_handshake(data, nb_data);
+    }
+
     int r0 = 0;
     // TODO: FIXME: Why reset it before writing?
     if ((r0 = BIO_reset(bio_in)) != 1) {
@@ -520,6 +633,17 @@ srs_error_t SrsDtlsImpl::do_on_dtls(char* data, int nb_data)
         return srs_error_wrap(err, "do handshake");
     }
 
+    if ((err = do_read()) != srs_success) {
+        return srs_error_wrap(err, "read");
+    }
+
+    return err;
+}
+
+srs_error_t SrsDtlsImpl::do_read()
+{
+    srs_error_t err = srs_success;
+
     // If there is data in bio_in, read it to let SSL consume it.
     // @remark Limit the max loop, to avoid the dead loop.
     for (int i = 0; i < 1024 && BIO_ctrl_pending(bio_in) > 0; i++) {
@@ -579,6 +703,13 @@ srs_error_t SrsDtlsImpl::do_handshake()
     int r0 = SSL_do_handshake(dtls);
     int r1 = SSL_get_error(dtls, r0);
 
+    return on_handshake(r0, r1);
+}
+
+srs_error_t SrsDtlsImpl::on_handshake(int r0, int r1)
+{
+    srs_error_t err = srs_success;
+
     // Fatal SSL error, for example, no available suite when peer is DTLS 1.0 while we are DTLS 1.2.
     if (r0 < 0 && (r1 != SSL_ERROR_NONE && r1 != SSL_ERROR_WANT_READ && r1 != SSL_ERROR_WANT_WRITE)) {
         return srs_error_new(ERROR_RTC_DTLS, "handshake r0=%d, r1=%d", r0, r1);
@@ -615,6 +746,97 @@ srs_error_t SrsDtlsImpl::do_handshake()
     return err;
 }
 
+srs_error_t SrsDtlsImpl::post_handshake(char* data, int nb_data)
+{
+    srs_error_t err = srs_success;
+
+    // Handle the done tasks by self, so that the task is never stuck even if the collector is blocked or failed,
+    // because peer always retransmits the packets.
+    if (task_) {
+        _srs_async_dtls->collect();
+    }
+
+    // The SSL is used by DTLS worker, so queue the packet until the task is done.
+    if (task_) {
+        if ((int)pendings_.size() < DTLS_MAX_PENDINGS) {
+            pendings_.push_back(string(data, nb_data));
+        } else {
+            ++_srs_pps_adtls_drop->sugar;
+            srs_warn("DTLS: Drop %d bytes for %d pendings", nb_data, (int)pendings_.size());
+        }
+        return err;
+    }
+
+    // Trace the detail of DTLS packet.
+    state_trace((uint8_t*)data, nb_data, true, 1, SSL_ERROR_NONE, false);
+
+    SrsAsyncDtlsTask* task = new SrsAsyncDtlsTask(this, dtls, data, nb_data);
+    SSL_set_ex_data(dtls, 1, task);
+
+    // Drop the packet when DTLS workers are busy, because the peer will retransmit it, so that a join storm never
+    // stalls the hybrid thread.
+    if (!_srs_async_dtls->post(task)) {
+        SSL_set_ex_data(dtls, 1, NULL);
+        srs_freep(task);
+        srs_warn("DTLS: Drop %d bytes for DTLS workers are busy", nb_data);
+        return err;
+    }
+
+    task_ = task;
+
+    return err;
+}
+
+void SrsDtlsImpl::on_async_handshake(SrsAsyncDtlsTask* task)
+{
+    srs_error_t err = srs_success;
+
+    task_ = NULL;
+    SSL_set_ex_data(dtls, 1, NULL);
+
+    if ((err = do_async_handshake(task)) != srs_success) {
+        srs_warn("DTLS: async handshake err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+    }
+
+    // Handle the packets received during the task, until another task is posted.
+    while (!task_ && !pendings_.empty()) {
+        string pkt = pendings_.front();
+        pendings_.erase(pendings_.begin());
+
+        if ((err = on_dtls((char*)pkt.data(), (int)pkt.size())) != srs_success) {
+            srs_warn("DTLS: pending packet err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+        }
+    }
+}
+
+srs_error_t SrsDtlsImpl::do_async_handshake(SrsAsyncDtlsTask* task)
+{
+    srs_error_t err = srs_success;
+
+    // Notify the alerts during the handshake, in hybrid thread.
+    for (int i = 0; i < (int)task->alert_types.size(); i++) {
+        callback_by_ssl(task->alert_types.at(i), task->alert_descs.at(i));
+    }
+
+    if (task->err != srs_success) {
+        err = task->err;
+        task->err = srs_success;
+        return srs_error_wrap(err, "worker");
+    }
+
+    if ((err = on_handshake(task->r0, task->r1)) != srs_success) {
+        return srs_error_wrap(err, "do handshake");
+    }
+
+    if ((err = do_read()) != srs_success) {
+        return srs_error_wrap(err, "read");
+    }
+
+    return err;
+}
+
 void SrsDtlsImpl::state_trace(uint8_t* data, int length, bool incoming, int r0, int r1, bool arq)
 {
     // change_cipher_spec(20), alert(21), handshake(22), application_data(23)
@@ -639,27 +861,42 @@ void SrsDtlsImpl::state_trace(uint8_t* data, int length, bool incoming, int r0,
         nn_arq_packets, r0, r1, length, content_type, size, handshake_type);
 }
 
-const int SRTP_MASTER_KEY_KEY_LEN = 16;
-const int SRTP_MASTER_KEY_SALT_LEN = 14;
-srs_error_t SrsDtlsImpl::get_srtp_key(std::string& recv_key, std::string& send_key)
+srs_error_t SrsDtlsImpl::get_srtp_key(std::string& recv_key, std::string& send_key, SrsSrtpProfile* profile)
 {
     srs_error_t err = srs_success;
 
-    unsigned char material[SRTP_MASTER_KEY_LEN * 2] = {0};  // client(SRTP_MASTER_KEY_KEY_LEN + SRTP_MASTER_KEY_SALT_LEN) + server
+    // The length of master key and salt, depends on the negotiated profile.
+    // @see https://www.rfc-editor.org/rfc/rfc7714#section-12
+    *profile = SrsSrtpProfileAes128CmSha1_80;
+    int key_len = SRTP_AES_128_KEY_LEN, salt_len = SRTP_SALT_LEN;
+#ifdef SRTP_AEAD_AES_128_GCM
+    SRTP_PROTECTION_PROFILE* selected = SSL_get_selected_srtp_profile(dtls);
+    if (selected && selected->id == SRTP_AEAD_AES_128_GCM) {
+        *profile = SrsSrtpProfileAeadAes128Gcm;
+        key_len = SRTP_AES_128_KEY_LEN; salt_len = SRTP_AEAD_SALT_LEN;
+    } else if (selected && selected->id == SRTP_AEAD_AES_256_GCM) {
+        *profile = SrsSrtpProfileAeadAes256Gcm;
+        key_len = SRTP_AES_256_KEY_LEN; salt_len = SRTP_AEAD_SALT_LEN;
+    }
+#endif
+
+    // The material is client key, server key, client salt and server salt.
+    unsigned char material[(SRTP_AES_256_KEY_LEN + SRTP_SALT_LEN) * 2] = {0};
+    int nn_material = (key_len + salt_len) * 2;
     static const string dtls_srtp_lable = "EXTRACTOR-dtls_srtp";
-    if (!SSL_export_keying_material(dtls, material, sizeof(material), dtls_srtp_lable.c_str(), dtls_srtp_lable.size(), NULL, 0, 0)) {
+    if (!SSL_export_keying_material(dtls, material, nn_material, dtls_srtp_lable.c_str(), dtls_srtp_lable.size(), NULL, 0, 0)) {
         return srs_error_new(ERROR_RTC_SRTP_INIT, "SSL export key r0=%lu", ERR_get_error());
     }
 
     size_t offset = 0;
 
-    std::string client_master_key(reinterpret_cast<char*>(material), SRTP_MASTER_KEY_KEY_LEN);
-    offset += SRTP_MASTER_KEY_KEY_LEN;
-    std::string server_master_key(reinterpret_cast<char*>(material + offset), SRTP_MASTER_KEY_KEY_LEN);
-    offset += SRTP_MASTER_KEY_KEY_LEN;
-    std::string client_master_salt(reinterpret_cast<char*>(material + offset), SRTP_MASTER_KEY_SALT_LEN);
-    offset += SRTP_MASTER_KEY_SALT_LEN;
-    std::string server_master_salt(reinterpret_cast<char*>(material + offset), SRTP_MASTER_KEY_SALT_LEN);
+    std::string client_master_key(reinterpret_cast<char*>(material), key_len);
+    offset += key_len;
+    std::string server_master_key(reinterpret_cast<char*>(material + offset), key_len);
+    offset += key_len;
+    std::string client_master_salt(reinterpret_cast<char*>(material + offset), salt_len);
+    offset += salt_len;
+    std::string server_master_salt(reinterpret_cast<char*>(material + offset), salt_len);
 
     if (is_dtls_client()) {
         recv_key = server_master_key + server_master_salt;
@@ -981,7 +1218,7 @@ srs_error_t SrsDtlsEmptyImpl::on_dtls(char* data, int nb_data)
     return srs_success;
 }
 
-srs_error_t SrsDtlsEmptyImpl::get_srtp_key(std::string& recv_key, std::string& send_key)
+srs_error_t SrsDtlsEmptyImpl::get_srtp_key(std::string& recv_key, std::string& send_key, SrsSrtpProfile* profile)
 {
     return srs_success;
 }
@@ -1038,15 +1275,21 @@ srs_error_t SrsDtls::on_dtls(char* data, int nb_data)
     return impl->on_dtls(data, nb_data);
 }
 
-srs_error_t SrsDtls::get_srtp_key(std::string& recv_key, std::string& send_key)
+srs_error_t SrsDtls::get_srtp_key(std::string& recv_key, std::string& send_key, SrsSrtpProfile* profile)
 {
-    return impl->get_srtp_key(recv_key, send_key);
+    return impl->get_srtp_key(recv_key, send_key, profile);
 }
 
 SrsSRTP::SrsSRTP()
 {
     recv_ctx_ = NULL;
     send_ctx_ = NULL;
+
+    // Only lock the send context if it's shared with the crypto workers.
+    lock_ = NULL;
+    if (_srs_async_srtp && _srs_async_srtp->enabled()) {
+        lock_ = new SrsThreadMutex();
+    }
 }
 
 SrsSRTP::~SrsSRTP()
@@ -1058,20 +1301,19 @@ SrsSRTP::~SrsSRTP()
     if (send_ctx_) {
         srtp_dealloc(send_ctx_);
     }
+
+    srs_freep(lock_);
 }
 
-srs_error_t SrsSRTP::initialize(string recv_key, std::string send_key)
+srs_error_t SrsSRTP::initialize(string recv_key, std::string send_key, SrsSrtpProfile profile)
 {
     srs_error_t err = srs_success;
 
     srtp_policy_t policy;
     bzero(&policy, sizeof(policy));
 
-    // TODO: Maybe we can use SRTP-GCM in future.
-    // @see https://bugs.chromium.org/p/chromium/issues/detail?id=713701
-    // @see https://groups.google.com/forum/#!topic/discuss-webrtc/PvCbWSetVAQ
-    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
-    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+    // The key is master key and salt, whose length depends on the profile.
+    srs_srtp_policy_set_profile(&policy, profile);
 
     policy.ssrc.value = 0;
     // TODO: adjust window_size
@@ -1114,7 +1356,14 @@ srs_error_t SrsSRTP::protect_rtp(void* packet, int* nb_cipher)
     }
 
     srtp_err_status_t r0 = srtp_err_status_ok;
-    if ((r0 = srtp_protect(send_ctx_, packet, nb_cipher)) != srtp_err_status_ok) {
+    if (lock_) {
+        SrsThreadLocker(lock_);
+        r0 = srtp_protect(send_ctx_, packet, nb_cipher);
+    } else {
+        r0 = srtp_protect(send_ctx_, packet, nb_cipher);
+    }
+
+    if (r0 != srtp_err_status_ok) {
         return srs_error_new(ERROR_RTC_SRTP_PROTECT, "rtp protect r0=%u", r0);
     }
 
@@ -1131,7 +1380,14 @@ srs_error_t SrsSRTP::protect_rtcp(void* packet, int* nb_cipher)
     }
 
     srtp_err_status_t r0 = srtp_err_status_ok;
-    if ((r0 = srtp_protect_rtcp(send_ctx_, packet, nb_cipher)) != srtp_err_status_ok) {
+    if (lock_) {
+        SrsThreadLocker(lock_);
+        r0 = srtp_protect_rtcp(send_ctx_, packet, nb_cipher);
+    } else {
+        r0 = srtp_protect_rtcp(send_ctx_, packet, nb_cipher);
+    }
+
+    if (r0 != srtp_err_status_ok) {
         return srs_error_new(ERROR_RTC_SRTP_PROTECT, "rtcp protect r0=%u", r0);
     }
 
@@ -18,6 +18,8 @@
 #include <srs_app_st.hpp>
 
 class SrsRequest;
+class SrsThreadMutex;
+class SrsAsyncDtlsTask;
 
 class SrsDtlsCertificate
 {
@@ -64,6 +66,18 @@ enum SrsDtlsVersion {
     SrsDtlsVersion1_2
 };
 
+// The SRTP protection profile negotiated by DTLS, see https://www.rfc-editor.org/rfc/rfc7714#section-14.2
+enum SrsSrtpProfile {
+    SrsSrtpProfileAes128CmSha1_80 = 0,
+    SrsSrtpProfileAeadAes128Gcm,
+    SrsSrtpProfileAeadAes256Gcm
+};
+
+extern std::string srs_srtp_profile_string(SrsSrtpProfile v);
+
+// Whether the profile is supported by libsrtp, for example, GCM requires libsrtp built with openssl.
+extern bool srs_srtp_profile_supported(SrsSrtpProfile v);
+
 class ISrsDtlsCallback
 {
 public:
@@ -106,6 +120,11 @@ protected:
     bool handshake_done_for_us;
     // The stat for ARQ packets.
     int nn_arq_packets;
+private:
+    // The handshake task in DTLS worker, the SSL is only used by worker until it's done.
+    SrsAsyncDtlsTask* task_;
+    // The packets received when the task is in worker, handled after the task is done.
+    std::vector<std::string> pendings_;
 public:
     SrsDtlsImpl(ISrsDtlsCallback* callback);
     virtual ~SrsDtlsImpl();
@@ -114,12 +133,19 @@ public:
     virtual srs_error_t start_active_handshake() = 0;
     virtual bool should_reset_timer() = 0;
     virtual srs_error_t on_dtls(char* data, int nb_data);
+    // When the handshake task is done by DTLS worker, see SrsAsyncDtlsManager.
+    void on_async_handshake(SrsAsyncDtlsTask* task);
 protected:
     srs_error_t do_on_dtls(char* data, int nb_data);
     srs_error_t do_handshake();
+    srs_error_t on_handshake(int r0, int r1);
+    srs_error_t do_read();
     void state_trace(uint8_t* data, int length, bool incoming, int r0, int r1, bool arq);
+private:
+    srs_error_t post_handshake(char* data, int nb_data);
+    srs_error_t do_async_handshake(SrsAsyncDtlsTask* task);
 public:
-    srs_error_t get_srtp_key(std::string& recv_key, std::string& send_key);
+    srs_error_t get_srtp_key(std::string& recv_key, std::string& send_key, SrsSrtpProfile* profile);
     void callback_by_ssl(std::string type, std::string desc);
 protected:
     virtual srs_error_t on_final_out_data(uint8_t* data, int size) = 0;
@@ -184,7 +210,7 @@ public:
     virtual bool should_reset_timer();
     virtual srs_error_t on_dtls(char* data, int nb_data);
 public:
-    srs_error_t get_srtp_key(std::string& recv_key, std::string& send_key);
+    srs_error_t get_srtp_key(std::string& recv_key, std::string& send_key, SrsSrtpProfile* profile);
     void callback_by_ssl(std::string type, std::string desc);
 protected:
     virtual srs_error_t on_final_out_data(uint8_t* data, int size);
@@ -209,7 +235,7 @@ public:
     // @remark When we are passive(DTLS server), we start handshake when got DTLS packet.
     srs_error_t on_dtls(char* data, int nb_data);
 public:
-    srs_error_t get_srtp_key(std::string& recv_key, std::string& send_key);
+    srs_error_t get_srtp_key(std::string& recv_key, std::string& send_key, SrsSrtpProfile* profile);
 };
 
 class SrsSRTP
@@ -217,12 +243,15 @@ class SrsSRTP
 private:
     srtp_t recv_ctx_;
     srtp_t send_ctx_;
+    // The send context might be used by crypto worker, see SrsAsyncSRTPManager. It's NULL if not offload, and the
+    // recv context is only used by the hybrid thread, so it's never locked.
+    SrsThreadMutex* lock_;
 public:
     SrsSRTP();
     virtual ~SrsSRTP();
 public:
-    // Intialize srtp context with recv_key and send_key.
-    srs_error_t initialize(std::string recv_key, std::string send_key);
+    // Intialize srtp context with recv_key and send_key, for the negotiated profile.
+    srs_error_t initialize(std::string recv_key, std::string send_key, SrsSrtpProfile profile);
 public:
     srs_error_t protect_rtp(void* packet, int* nb_cipher);
     srs_error_t protect_rtcp(void* packet, int* nb_cipher);
@@ -436,6 +436,30 @@ srs_error_t SrsRtcUdpNetwork::write(void* buf, size_t size, ssize_t* nwrite)
     return sendonly_skt_->sendto(buf, size, SRS_UTIME_NO_TIMEOUT);
 }
 
+srs_error_t SrsRtcUdpNetwork::write_batch(SrsUdpMuxSendBatch* batch)
+{
+    return batch->flush(sendonly_skt_, SRS_UTIME_NO_TIMEOUT, this);
+}
+
+srs_error_t SrsRtcUdpNetwork::on_send_batch(iovec* iovs, int nn_iovs)
+{
+    srs_error_t err = srs_success;
+
+    // Cipher RTP to SRTP packets, by crypto workers if enabled.
+    if ((err = transport_->protect_rtps(iovs, nn_iovs)) != srs_success) {
+        return srs_error_wrap(err, "srtp protect %d packets", nn_iovs);
+    }
+
+    // Update stat when we sending data, by the size of SRTP packets, which includes the auth tag.
+    int nn_bytes = 0;
+    for (int i = 0; i < nn_iovs; i++) {
+        nn_bytes += (int)iovs[i].iov_len;
+    }
+    delta_->add_delta(0, nn_bytes);
+
+    return err;
+}
+
 SrsRtcTcpNetwork::SrsRtcTcpNetwork(SrsRtcConnection* conn, SrsEphemeralDelta* delta)
 {
     conn_ = conn;
@@ -23,6 +23,7 @@ class SrsNetworkDelta;
 class SrsTcpConnection;
 class ISrsKbpsDelta;
 class SrsUdpMuxSocket;
+class SrsUdpMuxSendBatch;
 class SrsErrorPithyPrint;
 class ISrsRtcTransport;
 class SrsEphemeralDelta;
@@ -119,7 +120,7 @@ public:
 };
 
 // The WebRTC over UDP network.
-class SrsRtcUdpNetwork : public ISrsRtcNetwork
+class SrsRtcUdpNetwork : public ISrsRtcNetwork, public ISrsUdpMuxSendBatchHandler
 {
 private:
     // WebRTC session object.
@@ -169,6 +170,12 @@ public:
 // Interface ISrsStreamWriter.
 public:
     virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
+    // Send all packets in batch to the peer, by sendmmsg or UDP GSO. The packets in batch are plaintext, which
+    // are ciphered when flushing, see on_send_batch.
+    srs_error_t write_batch(SrsUdpMuxSendBatch* batch);
+// Interface ISrsUdpMuxSendBatchHandler.
+public:
+    virtual srs_error_t on_send_batch(iovec* iovs, int nn_iovs);
 };
 
 class SrsRtcTcpNetwork: public ISrsRtcNetwork
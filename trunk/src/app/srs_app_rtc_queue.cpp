@@ -38,7 +38,7 @@ SrsRtpRingBuffer::~SrsRtpRingBuffer()
 {
     for (int i = 0; i < capacity_; ++i) {
         SrsRtpPacket* pkt = queue_[i];
-        srs_freep(pkt);
+        srs_rtp_packet_free(pkt);
     }
     srs_freepa(queue_);
 }
@@ -63,7 +63,7 @@ void SrsRtpRingBuffer::advance_to(uint16_t seq)
 void SrsRtpRingBuffer::set(uint16_t at, SrsRtpPacket* pkt)
 {
     SrsRtpPacket* p = queue_[at % capacity_];
-    srs_freep(p);
+    srs_rtp_packet_free(p);
 
     queue_[at % capacity_] = pkt;
 }
@@ -150,7 +150,7 @@ void SrsRtpRingBuffer::clear_histroy(uint16_t seq)
     for (uint16_t i = 0; i < capacity_; i++) {
         SrsRtpPacket* p = queue_[i];
         if (p && p->header.get_sequence() < seq) {
-            srs_freep(p);
+            srs_rtp_packet_free(p);
             queue_[i] = NULL;
         }
     }
@@ -161,12 +161,101 @@ void SrsRtpRingBuffer::clear_all_histroy()
     for (uint16_t i = 0; i < capacity_; i++) {
         SrsRtpPacket* p = queue_[i];
         if (p) {
-            srs_freep(p);
+            srs_rtp_packet_free(p);
             queue_[i] = NULL;
         }
     }
 }
 
+SrsRtpPacketRing::SrsRtpPacketRing(int capacity)
+{
+    capacity_ = srs_max(1, capacity);
+    head_ = size_ = 0;
+
+    queue_ = new SrsRtpPacket*[capacity_];
+    memset(queue_, 0, sizeof(SrsRtpPacket*) * capacity_);
+}
+
+SrsRtpPacketRing::~SrsRtpPacketRing()
+{
+    while (!empty()) {
+        SrsRtpPacket* pkt = pop();
+        srs_rtp_packet_free(pkt);
+    }
+    srs_freepa(queue_);
+}
+
+bool SrsRtpPacketRing::empty()
+{
+    return size_ == 0;
+}
+
+bool SrsRtpPacketRing::full()
+{
+    return size_ >= capacity_;
+}
+
+int SrsRtpPacketRing::size()
+{
+    return size_;
+}
+
+int SrsRtpPacketRing::capacity()
+{
+    return capacity_;
+}
+
+void SrsRtpPacketRing::push(SrsRtpPacket* pkt)
+{
+    srs_assert(size_ < capacity_);
+
+    queue_[(head_ + size_) % capacity_] = pkt;
+    size_++;
+}
+
+SrsRtpPacket* SrsRtpPacketRing::pop()
+{
+    if (size_ == 0) {
+        return NULL;
+    }
+
+    SrsRtpPacket* pkt = queue_[head_];
+    queue_[head_] = NULL;
+
+    head_ = (head_ + 1) % capacity_;
+    size_--;
+
+    return pkt;
+}
+
+int SrsRtpPacketRing::drop_until_keyframe()
+{
+    // Find the start of next keyframe, that is the first keyframe packet after a non-keyframe video packet,
+    // so we skip the keyframe at head, which is not the next one. Note that audio packets are ignored.
+    int start = size_;
+    bool prev_keyframe = true;
+    for (int i = 0; i < size_; i++) {
+        SrsRtpPacket* pkt = queue_[(head_ + i) % capacity_];
+        if (pkt->is_audio()) {
+            continue;
+        }
+
+        bool keyframe = pkt->is_keyframe();
+        if (keyframe && !prev_keyframe) {
+            start = i;
+            break;
+        }
+        prev_keyframe = keyframe;
+    }
+
+    for (int i = 0; i < start; i++) {
+        SrsRtpPacket* pkt = pop();
+        srs_rtp_packet_free(pkt);
+    }
+
+    return start;
+}
+
 SrsNackOption::SrsNackOption()
 {
     max_count = 15;
@@ -19,6 +19,7 @@
 class SrsRtpPacket;
 class SrsRtpQueue;
 class SrsRtpRingBuffer;
+class SrsRtpPacketRing;
 
 // For UDP, the packets sequence may present as bellow:
 //      [seq1(done)|seq2|seq3 ... seq10|seq11(lost)|seq12|seq13]
@@ -75,6 +76,33 @@ public:
     void clear_all_histroy();
 };
 
+// The fixed-capacity FIFO of RTP packets for RTC consumer, which never grows, so a stalled player never
+// consumes memory without limit.
+class SrsRtpPacketRing
+{
+private:
+    int capacity_;
+    // The position of the first packet, and the number of packets.
+    int head_;
+    int size_;
+    SrsRtpPacket** queue_;
+public:
+    SrsRtpPacketRing(int capacity);
+    virtual ~SrsRtpPacketRing();
+public:
+    bool empty();
+    bool full();
+    int size();
+    int capacity();
+    // Push packet to the tail, user must ensure the ring is not full.
+    void push(SrsRtpPacket* pkt);
+    // Pop packet from the head, NULL if empty.
+    SrsRtpPacket* pop();
+    // Drop packets before the start of next keyframe, or all packets if no keyframe.
+    // @return The number of dropped packets.
+    int drop_until_keyframe();
+};
+
 struct SrsNackOption
 {
     int max_count;
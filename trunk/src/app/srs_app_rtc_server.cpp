@@ -30,6 +30,7 @@ using namespace std;
 #include <srs_protocol_utility.hpp>
 #include <srs_protocol_log.hpp>
 #include <srs_app_rtc_network.hpp>
+#include <srs_app_threads.hpp>
 
 extern SrsPps* _srs_pps_rpkts;
 SrsPps* _srs_pps_rstuns = NULL;
@@ -39,10 +40,26 @@ extern SrsPps* _srs_pps_addrs;
 extern SrsPps* _srs_pps_fast_addrs;
 
 extern SrsPps* _srs_pps_spkts;
+
+extern SrsPps* _srs_pps_rmmsgs;
+extern SrsPps* _srs_pps_rmmsgs_pkts;
+extern SrsPps* _srs_pps_rmmsgs_full;
+
+extern SrsPps* _srs_pps_smmsgs;
+extern SrsPps* _srs_pps_smmsgs_pkts;
+extern SrsPps* _srs_pps_sgso;
 extern SrsPps* _srs_pps_sstuns;
 extern SrsPps* _srs_pps_srtcps;
 extern SrsPps* _srs_pps_srtps;
 
+extern SrsPps* _srs_pps_asrtps;
+extern SrsPps* _srs_pps_asrtps_pkts;
+extern SrsPps* _srs_pps_asrtps_full;
+
+extern SrsPps* _srs_pps_adtls;
+extern SrsPps* _srs_pps_adtls_full;
+extern SrsPps* _srs_pps_adtls_drop;
+
 extern SrsPps* _srs_pps_ids;
 extern SrsPps* _srs_pps_fids;
 extern SrsPps* _srs_pps_fids_level0;
@@ -286,6 +303,7 @@ SrsRtcUserConfig::~SrsRtcUserConfig()
 SrsRtcServer::SrsRtcServer()
 {
     async = new SrsAsyncCallWorker();
+    timer_ = new SrsWheelTimer(this, 5 * SRS_UTIME_SECONDS);
 
     _srs_config->subscribe(this);
 }
@@ -304,6 +322,7 @@ SrsRtcServer::~SrsRtcServer()
 
     async->stop();
     srs_freep(async);
+    srs_freep(timer_);
 }
 
 srs_error_t SrsRtcServer::initialize()
@@ -312,7 +331,7 @@ srs_error_t SrsRtcServer::initialize()
 
     // The RTC server start a timer, do routines of RTC server.
     // @see SrsRtcServer::on_timer()
-    _srs_hybrid->timer5s()->subscribe(this);
+    _srs_hybrid->wheel()->add(timer_);
 
     // Initialize the black hole.
     if ((err = _srs_blackhole->initialize()) != srs_success) {
@@ -321,6 +340,16 @@ srs_error_t SrsRtcServer::initialize()
 
     async->start();
 
+    // Start to collect the packets ciphered by crypto threads, if enabled.
+    if ((err = _srs_async_srtp->start()) != srs_success) {
+        return srs_error_wrap(err, "async srtp");
+    }
+
+    // Start to collect the handshakes done by DTLS threads, if enabled.
+    if ((err = _srs_async_dtls->start()) != srs_success) {
+        return srs_error_wrap(err, "async dtls");
+    }
+
     return err;
 }
 
@@ -351,8 +380,10 @@ srs_error_t SrsRtcServer::listen_udp()
     srs_assert(listeners.empty());
 
     int nn_listeners = _srs_config->get_rtc_server_reuseport();
+    int nn_recvmmsg = _srs_config->get_rtc_server_recvmmsg();
     for (int i = 0; i < nn_listeners; i++) {
         SrsUdpMuxListener* listener = new SrsUdpMuxListener(this, ip, port);
+        listener->set_recvmmsg(nn_recvmmsg);
 
         if ((err = listener->listen()) != srs_success) {
             srs_freep(listener);
@@ -667,6 +698,15 @@ srs_error_t SrsRtcServer::on_timer(srs_utime_t interval)
         rpkts_desc = buf;
     }
 
+    // The packets carried by each recvmmsg batch, and the batches which are full.
+    string rmmsg_desc;
+    _srs_pps_rmmsgs->update(); _srs_pps_rmmsgs_pkts->update(); _srs_pps_rmmsgs_full->update();
+    if (_srs_pps_rmmsgs->r10s()) {
+        snprintf(buf, sizeof(buf), ", rmmsg=(%d,pkts:%d,avg:%.1f,full:%d)", _srs_pps_rmmsgs->r10s(), _srs_pps_rmmsgs_pkts->r10s(),
+            (double)_srs_pps_rmmsgs_pkts->r10s() / _srs_pps_rmmsgs->r10s(), _srs_pps_rmmsgs_full->r10s());
+        rmmsg_desc = buf;
+    }
+
     string spkts_desc;
     _srs_pps_spkts->update(); _srs_pps_srtps->update(); _srs_pps_sstuns->update(); _srs_pps_srtcps->update();
     if (_srs_pps_spkts->r10s() || _srs_pps_srtps->r10s() || _srs_pps_sstuns->r10s() || _srs_pps_srtcps->r10s()) {
@@ -674,6 +714,33 @@ srs_error_t SrsRtcServer::on_timer(srs_utime_t interval)
         spkts_desc = buf;
     }
 
+    // The syscalls of sendmmsg and GSO, and the packets carried by them.
+    string smmsg_desc;
+    _srs_pps_smmsgs->update(); _srs_pps_smmsgs_pkts->update(); _srs_pps_sgso->update();
+    if (_srs_pps_smmsgs->r10s() || _srs_pps_sgso->r10s()) {
+        snprintf(buf, sizeof(buf), ", smmsg=(%d,gso:%d,pkts:%d,avg:%.1f)", _srs_pps_smmsgs->r10s(), _srs_pps_sgso->r10s(), _srs_pps_smmsgs_pkts->r10s(),
+            (double)_srs_pps_smmsgs_pkts->r10s() / (_srs_pps_smmsgs->r10s() + _srs_pps_sgso->r10s()));
+        smmsg_desc = buf;
+    }
+
+    // The batches ciphered by crypto threads, the packets of them, and the batches ciphered in place for busy.
+    string asrtp_desc;
+    _srs_pps_asrtps->update(); _srs_pps_asrtps_pkts->update(); _srs_pps_asrtps_full->update();
+    if (_srs_pps_asrtps->r10s() || _srs_pps_asrtps_full->r10s()) {
+        snprintf(buf, sizeof(buf), ", asrtp=(%d,pkts:%d,full:%d)", _srs_pps_asrtps->r10s(), _srs_pps_asrtps_pkts->r10s(), _srs_pps_asrtps_full->r10s());
+        asrtp_desc = buf;
+    }
+
+    // The handshake packets posted to DTLS threads, the packets dropped for busy, and the packets dropped for too
+    // many packets queued when the handshake is in DTLS thread.
+    string adtls_desc;
+    _srs_pps_adtls->update(); _srs_pps_adtls_full->update(); _srs_pps_adtls_drop->update();
+    if (_srs_pps_adtls->r10s() || _srs_pps_adtls_full->r10s() || _srs_pps_adtls_drop->r10s()) {
+        snprintf(buf, sizeof(buf), ", adtls=(%d,full:%d,drop:%d)", _srs_pps_adtls->r10s(), _srs_pps_adtls_full->r10s(),
+            _srs_pps_adtls_drop->r10s());
+        adtls_desc = buf;
+    }
+
     string rtcp_desc;
     _srs_pps_pli->update(); _srs_pps_twcc->update(); _srs_pps_rr->update();
     if (_srs_pps_pli->r10s() || _srs_pps_twcc->r10s() || _srs_pps_rr->r10s()) {
@@ -709,9 +776,9 @@ srs_error_t SrsRtcServer::on_timer(srs_utime_t interval)
         fid_desc = buf;
     }
 
-    srs_trace("RTC: Server conns=%u%s%s%s%s%s%s%s",
+    srs_trace("RTC: Server conns=%u%s%s%s%s%s%s%s%s%s%s%s",
         nn_rtc_conns,
-        rpkts_desc.c_str(), spkts_desc.c_str(), rtcp_desc.c_str(), snk_desc.c_str(), rnk_desc.c_str(), loss_desc.c_str(), fid_desc.c_str()
+        rpkts_desc.c_str(), rmmsg_desc.c_str(), spkts_desc.c_str(), smmsg_desc.c_str(), asrtp_desc.c_str(), adtls_desc.c_str(), rtcp_desc.c_str(), snk_desc.c_str(), rnk_desc.c_str(), loss_desc.c_str(), fid_desc.c_str()
     );
 
     return err;
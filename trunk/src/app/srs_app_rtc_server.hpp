@@ -83,6 +83,7 @@ class SrsRtcServer : public ISrsUdpMuxHandler, public ISrsFastTimer, public ISrs
 private:
     std::vector<SrsUdpMuxListener*> listeners;
     SrsAsyncCallWorker* async;
+    SrsWheelTimer* timer_;
 public:
     SrsRtcServer();
     virtual ~SrsRtcServer();
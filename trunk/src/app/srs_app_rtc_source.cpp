@@ -155,6 +155,10 @@ ISrsRtcSourceChangeCallback::~ISrsRtcSourceChangeCallback()
 SrsRtcConsumer::SrsRtcConsumer(SrsRtcSource* s)
 {
     source = s;
+    queue = NULL;
+    nn_dropped_ = nn_overflows_ = 0;
+    waiting_keyframe_ = false;
+    last_video_keyframe_ = false;
     should_update_source_id = false;
     handler_ = NULL;
 
@@ -167,11 +171,7 @@ SrsRtcConsumer::~SrsRtcConsumer()
 {
     source->on_consumer_destroy(this);
 
-    vector<SrsRtpPacket*>::iterator it;
-    for (it = queue.begin(); it != queue.end(); ++it) {
-        SrsRtpPacket* pkt = *it;
-        srs_freep(pkt);
-    }
+    srs_freep(queue);
 
     srs_cond_destroy(mw_wait);
 }
@@ -181,14 +181,54 @@ void SrsRtcConsumer::update_source_id()
     should_update_source_id = true;
 }
 
+void SrsRtcConsumer::set_queue_size(int v)
+{
+    srs_freep(queue);
+    queue = new SrsRtpPacketRing(v);
+}
+
 srs_error_t SrsRtcConsumer::enqueue(SrsRtpPacket* pkt)
 {
     srs_error_t err = srs_success;
 
-    queue.push_back(pkt);
+    // Drop packets until the next keyframe, and request a keyframe, when queue overflow.
+    if (queue->full()) {
+        int nn = queue->drop_until_keyframe();
+        nn_dropped_ += nn;
+        nn_overflows_++;
+
+        // If no keyframe in queue, all packets are dropped, so we should wait for the next keyframe. Never wait if the
+        // keyframe is not parsable, or the video is dropped forever.
+        if (queue->empty() && keyframe_parsable()) {
+            waiting_keyframe_ = true;
+        }
+
+        srs_warn("RTC: Consumer queue overflow, size=%d, dropped=%d/%" PRId64 ", overflows=%" PRId64 ", waiting=%d",
+            queue->capacity(), nn, nn_dropped_, nn_overflows_, waiting_keyframe_);
+
+        if (handler_) {
+            handler_->on_queue_overflow();
+        }
+    }
+
+    // Drop the video packets until the start of keyframe, but never drop audio packets.
+    if (!pkt->is_audio()) {
+        bool keyframe = pkt->is_keyframe();
+        bool keyframe_start = keyframe && !last_video_keyframe_;
+        last_video_keyframe_ = keyframe;
+
+        if (waiting_keyframe_ && !keyframe_start) {
+            nn_dropped_++;
+            srs_rtp_packet_free(pkt);
+            return err;
+        }
+        waiting_keyframe_ = false;
+    }
+
+    queue->push(pkt);
 
     if (mw_waiting) {
-        if ((int)queue.size() > mw_min_msgs) {
+        if (queue->size() > mw_min_msgs) {
             srs_cond_signal(mw_wait);
             mw_waiting = false;
             return err;
@@ -207,11 +247,7 @@ srs_error_t SrsRtcConsumer::dump_packet(SrsRtpPacket** ppkt)
         should_update_source_id = false;
     }
 
-    // TODO: FIXME: Refine performance by ring buffer.
-    if (!queue.empty()) {
-        *ppkt = queue.front();
-        queue.erase(queue.begin());
-    }
+    *ppkt = queue->pop();
 
     return err;
 }
@@ -221,7 +257,7 @@ void SrsRtcConsumer::wait(int nb_msgs)
     mw_min_msgs = nb_msgs;
 
     // when duration ok, signal to flush.
-    if ((int)queue.size() > mw_min_msgs) {
+    if (queue->size() > mw_min_msgs) {
         return;
     }
 
@@ -232,6 +268,40 @@ void SrsRtcConsumer::wait(int nb_msgs)
     srs_cond_wait(mw_wait);
 }
 
+bool SrsRtcConsumer::keyframe_parsable()
+{
+    // Only H.264 is parsed by RTP packet, while the publisher might use other codecs, such as AV1 or HEVC.
+    std::vector<SrsRtcTrackDescription*> descs = source->get_track_desc("video", "H264");
+    for (int i = 0; i < (int)descs.size(); i++) {
+        SrsRtcTrackDescription* desc = descs.at(i);
+        if (desc->media_ && desc->media_->name_ != "H264") {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int SrsRtcConsumer::queue_size()
+{
+    return queue->capacity();
+}
+
+int SrsRtcConsumer::queue_depth()
+{
+    return queue->size();
+}
+
+int64_t SrsRtcConsumer::nn_dropped()
+{
+    return nn_dropped_;
+}
+
+int64_t SrsRtcConsumer::nn_overflows()
+{
+    return nn_overflows_;
+}
+
 void SrsRtcConsumer::on_stream_change(SrsRtcSourceDescription* desc)
 {
     if (handler_) {
@@ -334,6 +404,7 @@ SrsRtcSource::SrsRtcSource()
 #endif
 
     pli_for_rtmp_ = pli_elapsed_ = 0;
+    timer_ = new SrsWheelTimer(this, 100 * SRS_UTIME_MILLISECONDS);
 }
 
 SrsRtcSource::~SrsRtcSource()
@@ -342,6 +413,7 @@ SrsRtcSource::~SrsRtcSource()
     // for all consumers are auto free.
     consumers.clear();
 
+    srs_freep(timer_);
 #ifdef SRS_FFMPEG_FIT
     srs_freep(frame_builder_);
 #endif
@@ -474,6 +546,7 @@ srs_error_t SrsRtcSource::create_consumer(SrsRtcConsumer*& consumer)
     srs_error_t err = srs_success;
 
     consumer = new SrsRtcConsumer(this);
+    consumer->set_queue_size(_srs_config->get_rtc_queue_size(req->vhost));
     consumers.push_back(consumer);
 
     // TODO: FIXME: Implements edge cluster.
@@ -558,7 +631,7 @@ srs_error_t SrsRtcSource::on_publish()
         pli_for_rtmp_ = _srs_config->get_rtc_pli_for_rtmp(req->vhost);
 
         // @see SrsRtcSource::on_timer()
-        _srs_hybrid->timer100ms()->subscribe(this);
+        _srs_hybrid->wheel()->add(timer_);
     }
 
     SrsStatistic* stat = SrsStatistic::instance();
@@ -592,7 +665,7 @@ void SrsRtcSource::on_unpublish()
     //free bridge resource
     if (bridge_) {
         // For SrsRtcSource::on_timer()
-        _srs_hybrid->timer100ms()->unsubscribe(this);
+        timer_->cancel();
 
 #ifdef SRS_FFMPEG_FIT
         frame_builder_->on_unpublish();
@@ -643,11 +716,18 @@ srs_error_t SrsRtcSource::on_rtp(SrsRtpPacket* pkt)
         return err;
     }
 
-    for (int i = 0; i < (int)consumers.size(); i++) {
-        SrsRtcConsumer* consumer = consumers.at(i);
-        if ((err = consumer->enqueue(pkt->copy())) != srs_success) {
-            return srs_error_wrap(err, "consume message");
+    // Copy the packet once, and share it with all consumers, each player writes its own header when
+    // marshaling the packet, see SrsRtcSendTrack::build_header.
+    if (!consumers.empty()) {
+        SrsRtpPacket* shared = pkt->copy();
+        for (int i = 0; i < (int)consumers.size(); i++) {
+            SrsRtcConsumer* consumer = consumers.at(i);
+            if ((err = consumer->enqueue(shared->share())) != srs_success) {
+                srs_rtp_packet_free(shared);
+                return srs_error_wrap(err, "consume message");
+            }
         }
+        srs_rtp_packet_free(shared);
     }
 
 #ifdef SRS_FFMPEG_FIT
@@ -2622,17 +2702,17 @@ SrsRtcSendTrack::SrsRtcSendTrack(SrsRtcConnection* session, SrsRtcTrackDescripti
 {
     session_ = session;
     track_desc_ = track_desc->copy();
-    nack_no_copy_ = false;
 
     // Make a different start of sequence number, for debugging.
     jitter_ts_ = new SrsRtcTsJitter(track_desc_->type_ == "audio" ? 10000 : 20000);
     jitter_seq_ = new SrsRtcSeqJitter(track_desc_->type_ == "audio" ? 100 : 200);
 
-    if (is_audio) {
-        rtp_queue_ = new SrsRtpRingBuffer(100);
-    } else {
-        rtp_queue_ = new SrsRtpRingBuffer(1000);
-    }
+    nn_rtp_queue_ = is_audio ? 100 : 1000;
+    rtp_queue_ = new SrsRtpRingBuffer(nn_rtp_queue_);
+    rtp_seqs_ = new uint16_t[nn_rtp_queue_];
+    rtp_timestamps_ = new uint32_t[nn_rtp_queue_];
+    memset(rtp_seqs_, 0, sizeof(uint16_t) * nn_rtp_queue_);
+    memset(rtp_timestamps_, 0, sizeof(uint32_t) * nn_rtp_queue_);
 
     nack_epp = new SrsErrorPithyPrint();
 }
@@ -2640,6 +2720,8 @@ SrsRtcSendTrack::SrsRtcSendTrack(SrsRtcConnection* session, SrsRtcTrackDescripti
 SrsRtcSendTrack::~SrsRtcSendTrack()
 {
     srs_freep(rtp_queue_);
+    srs_freepa(rtp_seqs_);
+    srs_freepa(rtp_timestamps_);
     srs_freep(track_desc_);
     srs_freep(nack_epp);
     srs_freep(jitter_ts_);
@@ -2661,7 +2743,8 @@ SrsRtpPacket* SrsRtcSendTrack::fetch_rtp_packet(uint16_t seq)
 
     // For NACK, it sequence must match exactly, or it cause SRTP fail.
     // Return packet only when sequence is equal.
-    if (pkt->header.get_sequence() == seq) {
+    uint16_t pkt_seq = rtp_seqs_[seq % nn_rtp_queue_];
+    if (pkt_seq == seq) {
         ++_srs_pps_rhnack->sugar;
         return pkt;
     }
@@ -2669,9 +2752,9 @@ SrsRtpPacket* SrsRtcSendTrack::fetch_rtp_packet(uint16_t seq)
 
     // Ignore if sequence not match.
     uint32_t nn = 0;
-    if (nack_epp->can_print(pkt->header.get_ssrc(), &nn)) {
-        srs_trace("RTC: NACK miss seq=%u, require_seq=%u, ssrc=%u, ts=%u, count=%u/%u, %d bytes", seq, pkt->header.get_sequence(),
-            pkt->header.get_ssrc(), pkt->header.get_timestamp(), nn, nack_epp->nn_count, pkt->nb_bytes());
+    if (nack_epp->can_print(track_desc_->ssrc_, &nn)) {
+        srs_trace("RTC: NACK miss seq=%u, require_seq=%u, ssrc=%u, ts=%u, count=%u/%u, %d bytes", seq, pkt_seq,
+            track_desc_->ssrc_, rtp_timestamps_[seq % nn_rtp_queue_], nn, nack_epp->nn_count, pkt->nb_bytes());
     }
     return NULL;
 }
@@ -2694,35 +2777,51 @@ std::string SrsRtcSendTrack::get_track_id()
     return track_desc_->id_;
 }
 
-void SrsRtcSendTrack::rebuild_packet(SrsRtpPacket* pkt)
+void SrsRtcSendTrack::build_header(SrsRtpPacket* pkt, SrsRtpHeader* header)
+{
+    *header = pkt->header;
+    header->set_ssrc(track_desc_->ssrc_);
+
+    // Should update PT, because subscriber may use different PT to publisher.
+    if (track_desc_->media_ && pkt->header.get_payload_type() == track_desc_->media_->pt_of_publisher_) {
+        // If PT is media from publisher, change to PT of media for subscriber.
+        header->set_payload_type(track_desc_->media_->pt_);
+    } else if (track_desc_->red_ && pkt->header.get_payload_type() == track_desc_->red_->pt_of_publisher_) {
+        // If PT is RED from publisher, change to PT of RED for subscriber.
+        header->set_payload_type(track_desc_->red_->pt_);
+    } else {
+        // TODO: FIXME: Should update PT for RTX.
+    }
+}
+
+void SrsRtcSendTrack::rebuild_header(SrsRtpHeader* header)
 {
     // Rebuild the sequence number.
-    int16_t seq = pkt->header.get_sequence();
-    pkt->header.set_sequence(jitter_seq_->correct(seq));
+    int16_t seq = header->get_sequence();
+    header->set_sequence(jitter_seq_->correct(seq));
 
     // Rebuild the timestamp.
-    uint32_t ts = pkt->header.get_timestamp();
-    pkt->header.set_timestamp(jitter_ts_->correct(ts));
+    uint32_t ts = header->get_timestamp();
+    header->set_timestamp(jitter_ts_->correct(ts));
 
-    srs_info("RTC: Correct %s seq=%u/%u, ts=%u/%u", track_desc_->type_.c_str(), seq, pkt->header.get_sequence(), ts, pkt->header.get_timestamp());
+    srs_info("RTC: Correct %s seq=%u/%u, ts=%u/%u", track_desc_->type_.c_str(), seq, header->get_sequence(), ts, header->get_timestamp());
 }
 
-srs_error_t SrsRtcSendTrack::on_nack(SrsRtpPacket** ppkt)
+srs_error_t SrsRtcSendTrack::on_nack(SrsRtpPacket* pkt, SrsRtpHeader* header)
 {
     srs_error_t err = srs_success;
 
-    SrsRtpPacket* pkt = *ppkt;
-    uint16_t seq = pkt->header.get_sequence();
-
-    // insert into video_queue and audio_queue
-    // We directly use the pkt, never copy it, so we should set the pkt to NULL.
-    if (nack_no_copy_) {
-        rtp_queue_->set(seq, pkt);
-        *ppkt = NULL;
-    } else {
-        rtp_queue_->set(seq, pkt->copy());
+    // Ignore if not sent, because the header of player is not built.
+    if (!track_desc_->is_active_) {
+        return err;
     }
 
+    // The packet is shared by all players, so we refer to it and keep the sequence and timestamp of player.
+    uint16_t seq = header->get_sequence();
+    rtp_queue_->set(seq, pkt->share());
+    rtp_seqs_[seq % nn_rtp_queue_] = seq;
+    rtp_timestamps_[seq % nn_rtp_queue_] = header->get_timestamp();
+
     return err;
 }
 
@@ -2739,14 +2838,20 @@ srs_error_t SrsRtcSendTrack::on_recv_nack(const vector<uint16_t>& lost_seqs)
             continue;
         }
 
+        // Build the header of player, which is sent before.
+        SrsRtpHeader header;
+        build_header(pkt, &header);
+        header.set_sequence(seq);
+        header.set_timestamp(rtp_timestamps_[seq % nn_rtp_queue_]);
+
         uint32_t nn = 0;
-        if (nack_epp->can_print(pkt->header.get_ssrc(), &nn)) {
-            srs_trace("RTC: NACK ARQ seq=%u, ssrc=%u, ts=%u, count=%u/%u, %d bytes", pkt->header.get_sequence(),
-                pkt->header.get_ssrc(), pkt->header.get_timestamp(), nn, nack_epp->nn_count, pkt->nb_bytes());
+        if (nack_epp->can_print(header.get_ssrc(), &nn)) {
+            srs_trace("RTC: NACK ARQ seq=%u, ssrc=%u, ts=%u, count=%u/%u, %d bytes", header.get_sequence(),
+                header.get_ssrc(), header.get_timestamp(), nn, nack_epp->nn_count, pkt->nb_bytes());
         }
 
         // By default, we send packets by sendmmsg.
-        if ((err = session_->do_send_packet(pkt)) != srs_success) {
+        if ((err = session_->do_send_packet(pkt, &header)) != srs_success) {
             return srs_error_wrap(err, "raw send");
         }
     }
@@ -2763,7 +2868,7 @@ SrsRtcAudioSendTrack::~SrsRtcAudioSendTrack()
 {
 }
 
-srs_error_t SrsRtcAudioSendTrack::on_rtp(SrsRtpPacket* pkt)
+srs_error_t SrsRtcAudioSendTrack::on_rtp(SrsRtpPacket* pkt, SrsRtpHeader* header)
 {
     srs_error_t err = srs_success;
 
@@ -2771,28 +2876,18 @@ srs_error_t SrsRtcAudioSendTrack::on_rtp(SrsRtpPacket* pkt)
         return err;
     }
 
-    pkt->header.set_ssrc(track_desc_->ssrc_);
-
-    // Should update PT, because subscriber may use different PT to publisher.
-    if (track_desc_->media_ && pkt->header.get_payload_type() == track_desc_->media_->pt_of_publisher_) {
-        // If PT is media from publisher, change to PT of media for subscriber.
-        pkt->header.set_payload_type(track_desc_->media_->pt_);
-    } else if (track_desc_->red_ && pkt->header.get_payload_type() == track_desc_->red_->pt_of_publisher_) {
-        // If PT is RED from publisher, change to PT of RED for subscriber.
-        pkt->header.set_payload_type(track_desc_->red_->pt_);
-    } else {
-        // TODO: FIXME: Should update PT for RTX.
-    }
+    // The packet is shared by all players, so never change it, but build the header of player.
+    build_header(pkt, header);
 
     // Rebuild the sequence number and timestamp of packet, see https://github.com/ossrs/srs/issues/3167
-    rebuild_packet(pkt);
+    rebuild_header(header);
 
-    if ((err = session_->do_send_packet(pkt)) != srs_success) {
+    if ((err = session_->do_send_packet(pkt, header)) != srs_success) {
         return srs_error_wrap(err, "raw send");
     }
 
-    srs_info("RTC: Send audio ssrc=%d, seqno=%d, keyframe=%d, ts=%u", pkt->header.get_ssrc(),
-        pkt->header.get_sequence(), pkt->is_keyframe(), pkt->header.get_timestamp());
+    srs_info("RTC: Send audio ssrc=%d, seqno=%d, keyframe=%d, ts=%u", header->get_ssrc(),
+        header->get_sequence(), pkt->is_keyframe(), header->get_timestamp());
 
     return err;
 }
@@ -2813,36 +2908,26 @@ SrsRtcVideoSendTrack::~SrsRtcVideoSendTrack()
 {
 }
 
-srs_error_t SrsRtcVideoSendTrack::on_rtp(SrsRtpPacket* pkt)
+srs_error_t SrsRtcVideoSendTrack::on_rtp(SrsRtpPacket* pkt, SrsRtpHeader* header)
 {
     srs_error_t err = srs_success;
 
     if (!track_desc_->is_active_) {
         return err;
     }
-    
-    pkt->header.set_ssrc(track_desc_->ssrc_);
 
-    // Should update PT, because subscriber may use different PT to publisher.
-    if (track_desc_->media_ && pkt->header.get_payload_type() == track_desc_->media_->pt_of_publisher_) {
-        // If PT is media from publisher, change to PT of media for subscriber.
-        pkt->header.set_payload_type(track_desc_->media_->pt_);
-    } else if (track_desc_->red_ && pkt->header.get_payload_type() == track_desc_->red_->pt_of_publisher_) {
-        // If PT is RED from publisher, change to PT of RED for subscriber.
-        pkt->header.set_payload_type(track_desc_->red_->pt_);
-    } else {
-        // TODO: FIXME: Should update PT for RTX.
-    }
+    // The packet is shared by all players, so never change it, but build the header of player.
+    build_header(pkt, header);
 
     // Rebuild the sequence number and timestamp of packet, see https://github.com/ossrs/srs/issues/3167
-    rebuild_packet(pkt);
+    rebuild_header(header);
 
-    if ((err = session_->do_send_packet(pkt)) != srs_success) {
+    if ((err = session_->do_send_packet(pkt, header)) != srs_success) {
         return srs_error_wrap(err, "raw send");
     }
 
-    srs_info("RTC: Send video ssrc=%d, seqno=%d, keyframe=%d, ts=%u", pkt->header.get_ssrc(),
-        pkt->header.get_sequence(), pkt->is_keyframe(), pkt->header.get_timestamp());
+    srs_info("RTC: Send video ssrc=%d, seqno=%d, keyframe=%d, ts=%u", header->get_ssrc(),
+        header->get_sequence(), pkt->is_keyframe(), header->get_timestamp());
 
     return err;
 }
@@ -37,6 +37,7 @@ class SrsRtcSourceDescription;
 class SrsRtcTrackDescription;
 class SrsRtcConnection;
 class SrsRtpRingBuffer;
+class SrsRtpPacketRing;
 class SrsRtpNackForReceiver;
 class SrsJsonObject;
 class SrsErrorPithyPrint;
@@ -73,6 +74,8 @@ public:
     virtual ~ISrsRtcSourceChangeCallback();
 public:
     virtual void on_stream_change(SrsRtcSourceDescription* desc) = 0;
+    // When consumer queue overflows, packets are dropped until the next keyframe, so request a keyframe.
+    virtual void on_queue_overflow() = 0;
 };
 
 // The RTC stream consumer, consume packets from RTC stream source.
@@ -80,7 +83,14 @@ class SrsRtcConsumer
 {
 private:
     SrsRtcSource* source;
-    std::vector<SrsRtpPacket*> queue;
+    SrsRtpPacketRing* queue;
+    // The total number of packets dropped for queue overflow, and the times of overflow.
+    int64_t nn_dropped_;
+    int64_t nn_overflows_;
+    // Whether drop video packets until keyframe, when all packets in queue are dropped.
+    bool waiting_keyframe_;
+    // Whether the last video packet is keyframe, to identify the start of keyframe.
+    bool last_video_keyframe_;
     // when source id changed, notice all consumers
     bool should_update_source_id;
     // The cond wait for mw.
@@ -96,13 +106,23 @@ public:
 public:
     // When source id changed, notice client to print.
     virtual void update_source_id();
+    // Set the max number of packets in queue, should be called before enqueue.
+    void set_queue_size(int v);
     // Put RTP packet into queue.
-    // @note We do not drop packet here, but drop it in sender.
+    // @remark When queue is full, drop packets until the next keyframe, and request keyframe.
     srs_error_t enqueue(SrsRtpPacket* pkt);
+    // The max and current number of packets in queue.
+    int queue_size();
+    int queue_depth();
+    int64_t nn_dropped();
+    int64_t nn_overflows();
     // For RTC, we only got one packet, because there is not many packets in queue.
     virtual srs_error_t dump_packet(SrsRtpPacket** ppkt);
     // Wait for at-least some messages incoming in queue.
     virtual void wait(int nb_msgs);
+private:
+    // Whether the keyframe of video is parsable, see SrsRtpPacket::is_keyframe.
+    bool keyframe_parsable();
 public:
     void set_handler(ISrsRtcSourceChangeCallback* h) { handler_ = h; } // SrsRtcConsumer::set_handler()
     void on_stream_change(SrsRtcSourceDescription* desc);
@@ -189,6 +209,7 @@ private:
     // The PLI for RTC2RTMP.
     srs_utime_t pli_for_rtmp_;
     srs_utime_t pli_elapsed_;
+    SrsWheelTimer* timer_;
 public:
     SrsRtcSource();
     virtual ~SrsRtcSource();
@@ -674,36 +695,38 @@ public:
 protected:
     // The owner connection for this track.
     SrsRtcConnection* session_;
-    // NACK ARQ ring buffer.
+    // NACK ARQ ring buffer, which refers to the packets shared by all players.
     SrsRtpRingBuffer* rtp_queue_;
+    int nn_rtp_queue_;
+    // The sequence and timestamp of player for packets in rtp_queue_, because the shared packet is read-only.
+    uint16_t* rtp_seqs_;
+    uint32_t* rtp_timestamps_;
 protected:
     // The jitter to correct ts and sequence number.
     SrsRtcTsJitter* jitter_ts_;
     SrsRtcSeqJitter* jitter_seq_;
 private:
-    // By config, whether no copy.
-    bool nack_no_copy_;
     // The pithy print for special stage.
     SrsErrorPithyPrint* nack_epp;
 public:
     SrsRtcSendTrack(SrsRtcConnection* session, SrsRtcTrackDescription* track_desc, bool is_audio);
     virtual ~SrsRtcSendTrack();
 public:
-    // SrsRtcSendTrack::set_nack_no_copy
-    void set_nack_no_copy(bool v) { nack_no_copy_ = v; }
     bool has_ssrc(uint32_t ssrc);
     SrsRtpPacket* fetch_rtp_packet(uint16_t seq);
     bool set_track_status(bool active);
     bool get_track_status();
     std::string get_track_id();
 protected:
-    void rebuild_packet(SrsRtpPacket* pkt);
+    // Build the header of player from the shared packet, with the SSRC and PT of subscriber.
+    void build_header(SrsRtpPacket* pkt, SrsRtpHeader* header);
+    void rebuild_header(SrsRtpHeader* header);
 public:
-    // Note that we can set the pkt to NULL to avoid copy, for example, if the NACK cache the pkt and
-    // set to NULL, nack nerver copy it but set the pkt to NULL.
-    srs_error_t on_nack(SrsRtpPacket** ppkt);
+    // Cache the shared packet for NACK, with the header of player which is built by on_rtp.
+    srs_error_t on_nack(SrsRtpPacket* pkt, SrsRtpHeader* header);
 public:
-    virtual srs_error_t on_rtp(SrsRtpPacket* pkt) = 0;
+    // Send the shared packet, and output the header of player.
+    virtual srs_error_t on_rtp(SrsRtpPacket* pkt, SrsRtpHeader* header) = 0;
     virtual srs_error_t on_rtcp(SrsRtpPacket* pkt) = 0;
     virtual srs_error_t on_recv_nack(const std::vector<uint16_t>& lost_seqs);
 };
@@ -714,7 +737,7 @@ public:
     SrsRtcAudioSendTrack(SrsRtcConnection* session, SrsRtcTrackDescription* track_desc);
     virtual ~SrsRtcAudioSendTrack();
 public:
-    virtual srs_error_t on_rtp(SrsRtpPacket* pkt);
+    virtual srs_error_t on_rtp(SrsRtpPacket* pkt, SrsRtpHeader* header);
     virtual srs_error_t on_rtcp(SrsRtpPacket* pkt);
 };
 
@@ -724,7 +747,7 @@ public:
     SrsRtcVideoSendTrack(SrsRtcConnection* session, SrsRtcTrackDescription* track_desc);
     virtual ~SrsRtcVideoSendTrack();
 public:
-    virtual srs_error_t on_rtp(SrsRtpPacket* pkt);
+    virtual srs_error_t on_rtp(SrsRtpPacket* pkt, SrsRtpHeader* header);
     virtual srs_error_t on_rtcp(SrsRtpPacket* pkt);
 };
 
@@ -811,9 +811,18 @@ srs_error_t SrsRtmpConn::do_playing(SrsLiveSource* source, SrsLiveConsumer* cons
     skt->set_socket_buffer(mw_sleep);
     // initialize the send_min_interval
     send_min_interval = _srs_config->get_send_min_interval(req->vhost);
+
+    // Send the payloads by MSG_ZEROCOPY, fallback to copy if not supported.
+    bool zerocopy = _srs_config->get_play_zerocopy(req->vhost);
+    if (zerocopy && (err = skt->enable_zerocopy()) != srs_success) {
+        srs_warn("rtmp: ignore zerocopy err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+        zerocopy = false;
+    }
+    rtmp->set_zerocopy(zerocopy);
     
-    srs_trace("start play smi=%dms, mw_sleep=%d, mw_msgs=%d, realtime=%d, tcp_nodelay=%d",
-        srsu2msi(send_min_interval), srsu2msi(mw_sleep), mw_msgs, realtime, tcp_nodelay);
+    srs_trace("start play smi=%dms, mw_sleep=%d, mw_msgs=%d, realtime=%d, tcp_nodelay=%d, zerocopy=%d",
+        srsu2msi(send_min_interval), srsu2msi(mw_sleep), mw_msgs, realtime, tcp_nodelay, zerocopy);
 
 #ifdef SRS_APM
     ISrsApmSpan* span = _srs_apm->span("play-cycle")->set_kind(SrsApmKindProducer)->as_child(span_client_)
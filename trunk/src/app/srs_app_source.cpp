@@ -136,99 +136,224 @@ int64_t SrsRtmpJitter::get_time()
     return last_pkt_correct_time;
 }
 
-#ifdef SRS_PERF_QUEUE_FAST_VECTOR
-SrsFastVector::SrsFastVector()
+SrsMessageRing::SrsMessageRing()
 {
-    count = 0;
-    nb_msgs = 8;
-    msgs = new SrsSharedPtrMessage*[nb_msgs];
+    capacity_ = 8;
+    msgs_ = new SrsSharedPtrMessage*[capacity_];
+    head_ = tail_ = indexed_ = 0;
+    video_sh_ = audio_sh_ = metadata_ = -1;
 }
 
-SrsFastVector::~SrsFastVector()
+SrsMessageRing::~SrsMessageRing()
 {
-    free();
-    srs_freepa(msgs);
+    clear();
+    srs_freepa(msgs_);
 }
 
-int SrsFastVector::size()
+int SrsMessageRing::size()
 {
-    return count;
+    return (int)(tail_ - head_);
+}
+
+bool SrsMessageRing::empty()
+{
+    return head_ == tail_;
 }
 
-int SrsFastVector::begin()
+SrsSharedPtrMessage* SrsMessageRing::at(int index)
 {
-    return 0;
+    srs_assert(index >= 0 && index < size());
+    return slot(head_ + index);
 }
 
-int SrsFastVector::end()
+void SrsMessageRing::push_back(SrsSharedPtrMessage* msg)
 {
+    if (tail_ - head_ >= capacity_) {
+        grow();
+    }
+
+    // Never index the message here, because most messages are dumped by consumer before the index is used.
+    slot(tail_++) = msg;
+}
+
+int SrsMessageRing::pop_front(SrsSharedPtrMessage** pmsgs, int max)
+{
+    int count = srs_min(max, size());
+    if (count <= 0) {
+        return 0;
+    }
+
+    // Copy at most two segments, because the ring may wrap around.
+    int index = (int)(head_ & (capacity_ - 1));
+    int first = srs_min(count, capacity_ - index);
+    memcpy(pmsgs, msgs_ + index, first * sizeof(SrsSharedPtrMessage*));
+    if (first < count) {
+        memcpy(pmsgs + first, msgs_, (count - first) * sizeof(SrsSharedPtrMessage*));
+    }
+
+    head_ += count;
+    while (!keyframes_.empty() && keyframes_.front() < head_) {
+        keyframes_.pop_front();
+    }
+
     return count;
 }
 
-SrsSharedPtrMessage** SrsFastVector::data()
+int64_t SrsMessageRing::drop_front(int n)
 {
-    return msgs;
+    srs_assert(n >= 0 && n <= size());
+
+    // The kept messages are found by index.
+    build_index();
+
+    int64_t end = head_ + n;
+    int64_t pos = end;
+    int64_t bytes = 0;
+
+    // Free from back to front, and move the kept messages to the front of the left messages, in the same order.
+    for (int64_t i = end - 1; i >= head_; i--) {
+        SrsSharedPtrMessage* msg = slot(i);
+
+        int64_t* kept = NULL;
+        if (i == video_sh_) {
+            kept = &video_sh_;
+        } else if (i == audio_sh_) {
+            kept = &audio_sh_;
+        } else if (i == metadata_) {
+            kept = &metadata_;
+        }
+
+        if (kept) {
+            slot(--pos) = msg;
+            *kept = pos;
+            continue;
+        }
+
+        bytes += msg->size;
+        srs_freep(msg);
+    }
+    head_ = pos;
+
+    while (!keyframes_.empty() && keyframes_.front() < end) {
+        keyframes_.pop_front();
+    }
+
+    return bytes;
 }
 
-SrsSharedPtrMessage* SrsFastVector::at(int index)
+void SrsMessageRing::clear()
 {
-    srs_assert(index < count);
-    return msgs[index];
+    for (int64_t i = head_; i < tail_; i++) {
+        SrsSharedPtrMessage* msg = slot(i);
+        srs_freep(msg);
+    }
+
+    head_ = tail_ = indexed_ = 0;
+    keyframes_.clear();
+    video_sh_ = audio_sh_ = metadata_ = -1;
 }
 
-void SrsFastVector::clear()
+int SrsMessageRing::nn_keyframes()
 {
-    count = 0;
+    build_index();
+    return (int)keyframes_.size();
 }
 
-void SrsFastVector::erase(int _begin, int _end)
+int SrsMessageRing::keyframe(int i)
 {
-    srs_assert(_begin < _end);
-    
-    // move all erased to previous.
-    for (int i = 0; i < count - _end; i++) {
-        msgs[_begin + i] = msgs[_end + i];
+    build_index();
+    return (int)(keyframes_.at(i) - head_);
+}
+
+int SrsMessageRing::headers(int index)
+{
+    build_index();
+
+    int64_t pos = head_ + index;
+
+    int count = 0;
+    if (video_sh_ >= head_ && video_sh_ < pos) {
+        count++;
     }
-    
-    // update the count.
-    count -= _end - _begin;
+    if (audio_sh_ >= head_ && audio_sh_ < pos) {
+        count++;
+    }
+    if (metadata_ >= head_ && metadata_ < pos) {
+        count++;
+    }
+    return count;
+}
+
+SrsSharedPtrMessage* SrsMessageRing::video_sh()
+{
+    build_index();
+    return video_sh_ >= head_ ? slot(video_sh_) : NULL;
+}
+
+SrsSharedPtrMessage* SrsMessageRing::audio_sh()
+{
+    build_index();
+    return audio_sh_ >= head_ ? slot(audio_sh_) : NULL;
+}
+
+SrsSharedPtrMessage*& SrsMessageRing::slot(int64_t pos)
+{
+    return msgs_[pos & (capacity_ - 1)];
 }
 
-void SrsFastVector::push_back(SrsSharedPtrMessage* msg)
+void SrsMessageRing::build_index()
 {
-    // increase vector.
-    if (count >= nb_msgs) {
-        int size = srs_max(SRS_PERF_MW_MSGS * 8, nb_msgs * 2);
-        SrsSharedPtrMessage** buf = new SrsSharedPtrMessage*[size];
-        for (int i = 0; i < nb_msgs; i++) {
-            buf[i] = msgs[i];
+    // The messages dumped before indexed are ignored, because the index is only for the messages in ring.
+    for (int64_t pos = srs_max(indexed_, head_); pos < tail_; pos++) {
+        SrsSharedPtrMessage* msg = slot(pos);
+
+        if (msg->is_video()) {
+            if (SrsFlvVideo::sh(msg->payload, msg->size)) {
+                video_sh_ = pos;
+            } else if (SrsFlvVideo::keyframe(msg->payload, msg->size)) {
+                keyframes_.push_back(pos);
+            }
+        } else if (msg->is_audio()) {
+            if (SrsFlvAudio::sh(msg->payload, msg->size)) {
+                audio_sh_ = pos;
+            }
+        } else {
+            metadata_ = pos;
         }
-        srs_info("fast vector incrase %d=>%d", nb_msgs, size);
-        
-        // use new array.
-        srs_freepa(msgs);
-        msgs = buf;
-        nb_msgs = size;
     }
-    
-    msgs[count++] = msg;
+    indexed_ = tail_;
 }
 
-void SrsFastVector::free()
+void SrsMessageRing::grow()
 {
-    for (int i = 0; i < count; i++) {
-        SrsSharedPtrMessage* msg = msgs[i];
-        srs_freep(msg);
+    int capacity = capacity_ * 2;
+    while (capacity < SRS_PERF_MW_MSGS * 8) {
+        capacity *= 2;
     }
-    count = 0;
+
+    // The absolute positions are not changed, only the slots are.
+    SrsSharedPtrMessage** msgs = new SrsSharedPtrMessage*[capacity];
+    for (int64_t i = head_; i < tail_; i++) {
+        msgs[i & (capacity - 1)] = slot(i);
+    }
+    srs_info("message ring increase %d=>%d", capacity_, capacity);
+
+    srs_freepa(msgs_);
+    msgs_ = msgs;
+    capacity_ = capacity;
 }
-#endif
 
 SrsMessageQueue::SrsMessageQueue(bool ignore_shrink)
 {
     _ignore_shrink = ignore_shrink;
     max_queue_size = 0;
     av_start_time = av_end_time = -1;
+
+    adaptive_drop_ = false;
+    drop_nonref_ = drop_gop_ = 0;
+    drain_rate_ = -1;
+    drained_ = drain_window_ = 0;
+    nn_drop_frames_ = nn_drop_gops_ = nn_drop_bytes_ = 0;
 }
 
 SrsMessageQueue::~SrsMessageQueue()
@@ -251,10 +376,52 @@ void SrsMessageQueue::set_queue_size(srs_utime_t queue_size)
 	max_queue_size = queue_size;
 }
 
+void SrsMessageQueue::set_adaptive_drop(bool enabled, srs_utime_t nonref, srs_utime_t gop)
+{
+    adaptive_drop_ = enabled;
+    drop_nonref_ = nonref;
+    drop_gop_ = gop;
+}
+
+double SrsMessageQueue::drain_rate()
+{
+    return drain_rate_;
+}
+
+int64_t SrsMessageQueue::nn_drop_frames()
+{
+    return nn_drop_frames_;
+}
+
+int64_t SrsMessageQueue::nn_drop_gops()
+{
+    return nn_drop_gops_;
+}
+
+int64_t SrsMessageQueue::nn_drop_bytes()
+{
+    return nn_drop_bytes_;
+}
+
 srs_error_t SrsMessageQueue::enqueue(SrsSharedPtrMessage* msg, bool* is_overflow)
 {
     srs_error_t err = srs_success;
 
+    // For slow consumer which drains slower than realtime, drop the non-reference frames first, which never
+    // corrupt the decoding of other frames.
+    bool is_slow = false;
+    if (adaptive_drop_ && msg->is_video()) {
+        update_drain_rate();
+        is_slow = drain_rate_ >= 0 && drain_rate_ < 1.0;
+
+        if (is_slow && av_end_time - av_start_time > drop_nonref_ && SrsFlvVideo::disposable(msg->payload, msg->size)) {
+            nn_drop_frames_++;
+            nn_drop_bytes_ += msg->size;
+            srs_freep(msg);
+            return err;
+        }
+    }
+
     msgs.push_back(msg);
 
     // If jitter is off, the timestamp of first sequence header is zero, which wll cause SRS to shrink and drop the
@@ -268,6 +435,13 @@ srs_error_t SrsMessageQueue::enqueue(SrsSharedPtrMessage* msg, bool* is_overflow
         av_end_time = srs_utime_t(msg->timestamp * SRS_UTIME_MILLISECONDS);
     }
 
+    // Then drop the oldest GOPs, if still too slow to drain the queue.
+    while (is_slow && av_end_time - av_start_time > drop_gop_) {
+        if (!drop_gop()) {
+            break;
+        }
+    }
+
     if (max_queue_size <= 0) {
         return err;
     }
@@ -294,24 +468,16 @@ srs_error_t SrsMessageQueue::dump_packets(int max_count, SrsSharedPtrMessage** p
     }
     
     srs_assert(max_count > 0);
-    count = srs_min(max_count, nb_msgs);
-    
-    SrsSharedPtrMessage** omsgs = msgs.data();
-    memcpy(pmsgs, omsgs, count * sizeof(SrsSharedPtrMessage*));
+    count = msgs.pop_front(pmsgs, max_count);
 
-    SrsSharedPtrMessage* last = omsgs[count - 1];
-    av_start_time = srs_utime_t(last->timestamp * SRS_UTIME_MILLISECONDS);
+    SrsSharedPtrMessage* last = pmsgs[count - 1];
 
-    if (count >= nb_msgs) {
-        // the pmsgs is big enough and clear msgs at most time.
-        msgs.clear();
-    } else {
-        // erase some vector elements may cause memory copy,
-        // maybe can use more efficient vector.swap to avoid copy.
-        // @remark for the pmsgs is big enough, for instance, SRS_PERF_MW_MSGS 128,
-        //      the rtmp play client will get 128msgs once, so this branch rarely execute.
-        msgs.erase(msgs.begin(), msgs.begin() + count);
+    // Accumulate the media duration drained by consumer, to estimate the drain rate.
+    srs_utime_t start_time = srs_utime_t(last->timestamp * SRS_UTIME_MILLISECONDS);
+    if (av_start_time >= 0 && start_time > av_start_time) {
+        drained_ += start_time - av_start_time;
     }
+    av_start_time = start_time;
     
     return err;
 }
@@ -325,9 +491,8 @@ srs_error_t SrsMessageQueue::dump_packets(SrsLiveConsumer* consumer, bool atc, S
         return err;
     }
     
-    SrsSharedPtrMessage** omsgs = msgs.data();
     for (int i = 0; i < nb_msgs; i++) {
-        SrsSharedPtrMessage* msg = omsgs[i];
+        SrsSharedPtrMessage* msg = msgs.at(i);
         if ((err = consumer->enqueue(msg, atc, ag)) != srs_success) {
             return srs_error_wrap(err, "consume message");
         }
@@ -338,60 +503,85 @@ srs_error_t SrsMessageQueue::dump_packets(SrsLiveConsumer* consumer, bool atc, S
 
 void SrsMessageQueue::shrink()
 {
-    SrsSharedPtrMessage* video_sh = NULL;
-    SrsSharedPtrMessage* audio_sh = NULL;
     int msgs_size = (int)msgs.size();
-    
-    // Remove all msgs, mark the sequence headers.
-    for (int i = 0; i < (int)msgs.size(); i++) {
-        SrsSharedPtrMessage* msg = msgs.at(i);
-        
-        if (msg->is_video() && SrsFlvVideo::sh(msg->payload, msg->size)) {
-            srs_freep(video_sh);
-            video_sh = msg;
-            continue;
+
+    // Keep the last GOP if it fits the queue size, so the consumer is able to decode the left messages.
+    int nn_keyframes = msgs.nn_keyframes();
+    int last = nn_keyframes > 0 ? msgs.keyframe(nn_keyframes - 1) : -1;
+    srs_utime_t last_time = last > 0 ? srs_utime_t(msgs.at(last)->timestamp * SRS_UTIME_MILLISECONDS) : -1;
+
+    if (last > 0 && av_end_time - last_time <= max_queue_size) {
+        msgs.drop_front(last);
+        av_start_time = last_time;
+    } else {
+        // Remove all msgs, except the sequence headers.
+        msgs.drop_front(msgs_size);
+
+        // Update av_start_time, the start time of queue.
+        av_start_time = av_end_time;
+
+        // Update the timestamps of sequence headers.
+        if (msgs.video_sh()) {
+            msgs.video_sh()->timestamp = srsu2ms(av_end_time);
         }
-        else if (msg->is_audio() && SrsFlvAudio::sh(msg->payload, msg->size)) {
-            srs_freep(audio_sh);
-            audio_sh = msg;
-            continue;
+        if (msgs.audio_sh()) {
+            msgs.audio_sh()->timestamp = srsu2ms(av_end_time);
         }
-        
-        srs_freep(msg);
     }
-    msgs.clear();
     
-    // Update av_start_time, the start time of queue.
-    av_start_time = av_end_time;
+    if (!_ignore_shrink) {
+        srs_trace("shrinking, size=%d, removed=%d, max=%dms", (int)msgs.size(), msgs_size - (int)msgs.size(), srsu2msi(max_queue_size));
+    }
+}
 
-    // Push back sequence headers and update their timestamps.
-    if (video_sh) {
-        video_sh->timestamp = srsu2ms(av_end_time);
-        msgs.push_back(video_sh);
+void SrsMessageQueue::update_drain_rate()
+{
+    srs_utime_t now = srs_get_system_time();
+    if (!drain_window_) {
+        drain_window_ = now;
+        return;
     }
-    if (audio_sh) {
-        audio_sh->timestamp = srsu2ms(av_end_time);
-        msgs.push_back(audio_sh);
+
+    // Estimate the drain rate every second, smoothed by the previous rate.
+    srs_utime_t elapsed = now - drain_window_;
+    if (elapsed < SRS_UTIME_SECONDS) {
+        return;
     }
-    
-    if (!_ignore_shrink) {
-        srs_trace("shrinking, size=%d, removed=%d, max=%dms", (int)msgs.size(), msgs_size - (int)msgs.size(), srsu2msi(max_queue_size));
+
+    double rate = (double)drained_ / elapsed;
+    drain_rate_ = (drain_rate_ < 0) ? rate : (drain_rate_ + rate) / 2;
+
+    drained_ = 0;
+    drain_window_ = now;
+}
+
+bool SrsMessageQueue::drop_gop()
+{
+    // Find the next keyframe, which starts the next GOP, and there must be some frames to drop before it.
+    int next = -1;
+    for (int i = 0; i < msgs.nn_keyframes(); i++) {
+        int pos = msgs.keyframe(i);
+        if (pos > msgs.headers(pos)) {
+            next = pos;
+            break;
+        }
+    }
+    if (next < 0) {
+        return false;
     }
+
+    av_start_time = srs_utime_t(msgs.at(next)->timestamp * SRS_UTIME_MILLISECONDS);
+
+    // Drop the messages before the next keyframe, but keep the latest metadata and sequence headers, which are
+    // moved to the front of the next GOP.
+    nn_drop_bytes_ += msgs.drop_front(next);
+    nn_drop_gops_++;
+
+    return true;
 }
 
 void SrsMessageQueue::clear()
 {
-#ifndef SRS_PERF_QUEUE_FAST_VECTOR
-    std::vector<SrsSharedPtrMessage*>::iterator it;
-    
-    for (it = msgs.begin(); it != msgs.end(); ++it) {
-        SrsSharedPtrMessage* msg = *it;
-        srs_freep(msg);
-    }
-#else
-    msgs.free();
-#endif
-    
     msgs.clear();
     
     av_start_time = av_end_time = -1;
@@ -423,6 +613,11 @@ SrsLiveConsumer::SrsLiveConsumer(SrsLiveSource* s)
 
 SrsLiveConsumer::~SrsLiveConsumer()
 {
+    if (queue->nn_drop_frames() || queue->nn_drop_gops()) {
+        srs_trace("consumer adaptive drop frames=%" PRId64 ", gops=%" PRId64 ", bytes=%" PRId64 ", rate=%.2f",
+            queue->nn_drop_frames(), queue->nn_drop_gops(), queue->nn_drop_bytes(), queue->drain_rate());
+    }
+
     source->on_consumer_destroy(this);
     srs_freep(jitter);
     srs_freep(queue);
@@ -437,6 +632,11 @@ void SrsLiveConsumer::set_queue_size(srs_utime_t queue_size)
     queue->set_queue_size(queue_size);
 }
 
+void SrsLiveConsumer::set_adaptive_drop(bool enabled, srs_utime_t nonref, srs_utime_t gop)
+{
+    queue->set_adaptive_drop(enabled, nonref, gop);
+}
+
 void SrsLiveConsumer::update_source_id()
 {
     should_update_source_id = true;
@@ -968,7 +1168,7 @@ srs_error_t SrsOriginHub::on_audio(SrsSharedPtrMessage* shared_audio)
     if ((err = hls->on_audio(msg, format)) != srs_success) {
         // apply the error strategy for hls.
         // @see https://github.com/ossrs/srs/issues/264
-        std::string hls_error_strategy = _srs_config->get_hls_on_error(req_->vhost);
+        std::string hls_error_strategy = _srs_config->get_vhost_snapshot(req_->vhost)->hls_on_error;
         if (srs_config_hls_is_on_error_ignore(hls_error_strategy)) {
             srs_warn("hls: ignore audio error %s", srs_error_desc(err).c_str());
             hls->on_unpublish();
@@ -1062,7 +1262,7 @@ srs_error_t SrsOriginHub::on_video(SrsSharedPtrMessage* shared_video, bool is_se
         // TODO: We should support more strategies.
         // apply the error strategy for hls.
         // @see https://github.com/ossrs/srs/issues/264
-        std::string hls_error_strategy = _srs_config->get_hls_on_error(req_->vhost);
+        std::string hls_error_strategy = _srs_config->get_vhost_snapshot(req_->vhost)->hls_on_error;
         if (srs_config_hls_is_on_error_ignore(hls_error_strategy)) {
             srs_warn("hls: ignore video error %s", srs_error_desc(err).c_str());
             hls->on_unpublish();
@@ -2110,9 +2310,11 @@ srs_error_t SrsLiveSource::on_reload_vhost_play(string vhost)
         if (true) {
             std::vector<SrsLiveConsumer*>::iterator it;
             
+            SrsVhostSnapshot* snapshot = _srs_config->get_vhost_snapshot(req->vhost);
             for (it = consumers.begin(); it != consumers.end(); ++it) {
                 SrsLiveConsumer* consumer = *it;
                 consumer->set_queue_size(v);
+                consumer->set_adaptive_drop(snapshot->adaptive_drop, snapshot->adaptive_drop_nonref, snapshot->adaptive_drop_gop);
             }
             
             srs_trace("consumers reload queue size success.");
@@ -2206,8 +2408,8 @@ srs_error_t SrsLiveSource::on_meta_data(SrsCommonMessage* msg, SrsOnMetaDataPack
     
     // if allow atc_auto and bravo-atc detected, open atc for vhost.
     SrsAmf0Any* prop = NULL;
-    atc = _srs_config->get_atc(req->vhost);
-    if (_srs_config->get_atc_auto(req->vhost)) {
+    atc = _srs_config->get_vhost_snapshot(req->vhost)->atc;
+    if (_srs_config->get_vhost_snapshot(req->vhost)->atc_auto) {
         if ((prop = metadata->metadata->get_property("bravo_atc")) != NULL) {
             if (prop->is_string() && prop->to_str() == "true") {
                 atc = true;
@@ -2226,7 +2428,7 @@ srs_error_t SrsLiveSource::on_meta_data(SrsCommonMessage* msg, SrsOnMetaDataPack
     
     // when already got metadata, drop when reduce sequence header.
     bool drop_for_reduce = false;
-    if (meta->data() && _srs_config->get_reduce_sequence_header(req->vhost)) {
+    if (meta->data() && _srs_config->get_vhost_snapshot(req->vhost)->reduce_sequence_header) {
         drop_for_reduce = true;
         srs_warn("drop for reduce sh metadata, size=%d", msg->size);
     }
@@ -2323,7 +2525,7 @@ srs_error_t SrsLiveSource::on_audio_imp(SrsSharedPtrMessage* msg)
 
     // whether consumer should drop for the duplicated sequence header.
     bool drop_for_reduce = false;
-    if (is_sequence_header && meta->previous_ash() && _srs_config->get_reduce_sequence_header(req->vhost)) {
+    if (is_sequence_header && meta->previous_ash() && _srs_config->get_vhost_snapshot(req->vhost)->reduce_sequence_header) {
         if (meta->previous_ash()->size == msg->size) {
             drop_for_reduce = srs_bytes_equals(meta->previous_ash()->payload, msg->payload, msg->size);
             srs_warn("drop for reduce sh audio, size=%d", msg->size);
@@ -2425,7 +2627,7 @@ srs_error_t SrsLiveSource::on_video_imp(SrsSharedPtrMessage* msg)
     // user can disable the sps parse to workaround when parse sps failed.
     // @see https://github.com/ossrs/srs/issues/474
     if (is_sequence_header) {
-        format_->avc_parse_sps = _srs_config->get_parse_sps(req->vhost);
+        format_->avc_parse_sps = _srs_config->get_vhost_snapshot(req->vhost)->parse_sps;
     }
 
     if ((err = format_->on_video(msg)) != srs_success) {
@@ -2440,7 +2642,7 @@ srs_error_t SrsLiveSource::on_video_imp(SrsSharedPtrMessage* msg)
     
     // whether consumer should drop for the duplicated sequence header.
     bool drop_for_reduce = false;
-    if (is_sequence_header && meta->previous_vsh() && _srs_config->get_reduce_sequence_header(req->vhost)) {
+    if (is_sequence_header && meta->previous_vsh() && _srs_config->get_vhost_snapshot(req->vhost)->reduce_sequence_header) {
         if (meta->previous_vsh()->size == msg->size) {
             drop_for_reduce = srs_bytes_equals(meta->previous_vsh()->payload, msg->payload, msg->size);
             srs_warn("drop for reduce sh video, size=%d", msg->size);
@@ -2696,7 +2898,7 @@ srs_error_t SrsLiveSource::create_consumer(SrsLiveConsumer*& consumer)
     publisher_idle_at_ = 0;
 
     // for edge, when play edge stream, check the state
-    if (_srs_config->get_vhost_is_edge(req->vhost)) {
+    if (_srs_config->get_vhost_snapshot(req->vhost)->is_edge) {
         // notice edge to start for the first client.
         if ((err = play_edge->on_client_play()) != srs_success) {
             return srs_error_wrap(err, "play edge");
@@ -2710,8 +2912,10 @@ srs_error_t SrsLiveSource::consumer_dumps(SrsLiveConsumer* consumer, bool ds, bo
 {
     srs_error_t err = srs_success;
 
-    srs_utime_t queue_size = _srs_config->get_queue_length(req->vhost);
+    SrsVhostSnapshot* snapshot = _srs_config->get_vhost_snapshot(req->vhost);
+    srs_utime_t queue_size = snapshot->queue_length;
     consumer->set_queue_size(queue_size);
+    consumer->set_adaptive_drop(snapshot->adaptive_drop, snapshot->adaptive_drop_nonref, snapshot->adaptive_drop_gop);
 
     // if atc, update the sequence header to gop cache time.
     if (atc && !gop_cache->empty()) {
@@ -2762,7 +2966,7 @@ void SrsLiveSource::on_consumer_destroy(SrsLiveConsumer* consumer)
 
         // For edge server, the stream die when the last player quit, because the edge stream is created by player
         // activities, so it should die when all players quit.
-        if (_srs_config->get_vhost_is_edge(req->vhost)) {
+        if (_srs_config->get_vhost_snapshot(req->vhost)->is_edge) {
             stream_die_at_ = srs_get_system_time();
         }
 
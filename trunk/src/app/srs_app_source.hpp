@@ -10,6 +10,7 @@
 #include <srs_core.hpp>
 
 #include <map>
+#include <deque>
 #include <vector>
 #include <string>
 
@@ -76,29 +77,57 @@ public:
     virtual int64_t get_time();
 };
 
-#ifdef SRS_PERF_QUEUE_FAST_VECTOR
-// To alloc and increase fixed space, fast remove and insert for msgs sender.
-class SrsFastVector
+// The ring of messages for the queue, with the index of keyframes and the latest sequence headers, so that the
+// queue never moves the messages when dumping, and never scans the messages twice when dropping GOPs. The index is
+// built lazily when used, so the messages dumped by consumer are never scanned. The capacity is increased when
+// full, but it is fixed in most time because the queue is limited by duration.
+class SrsMessageRing
 {
 private:
-    SrsSharedPtrMessage** msgs;
-    int nb_msgs;
-    int count;
-public:
-    SrsFastVector();
-    virtual ~SrsFastVector();
+    SrsSharedPtrMessage** msgs_;
+    // The capacity, which is power of 2.
+    int capacity_;
+    // The absolute position of the first and after the last message.
+    int64_t head_;
+    int64_t tail_;
+    // The absolute position after the last indexed message.
+    int64_t indexed_;
+    // The absolute positions of keyframes, not including the sequence headers.
+    std::deque<int64_t> keyframes_;
+    // The absolute positions of the latest video and audio sequence headers, and metadata, -1 if not found.
+    int64_t video_sh_;
+    int64_t audio_sh_;
+    int64_t metadata_;
+public:
+    SrsMessageRing();
+    virtual ~SrsMessageRing();
 public:
     virtual int size();
-    virtual int begin();
-    virtual int end();
-    virtual SrsSharedPtrMessage** data();
+    virtual bool empty();
     virtual SrsSharedPtrMessage* at(int index);
-    virtual void clear();
-    virtual void erase(int _begin, int _end);
     virtual void push_back(SrsSharedPtrMessage* msg);
-    virtual void free();
+    // Move at most max messages from the front to pmsgs, return the number of messages.
+    virtual int pop_front(SrsSharedPtrMessage** pmsgs, int max);
+    // Free the first n messages, but keep the latest sequence headers and metadata in them, which are moved to the
+    // front of the left messages. Return the bytes of freed messages.
+    virtual int64_t drop_front(int n);
+    // Free all messages.
+    virtual void clear();
+public:
+    // The number of keyframes, and the index of the i-th keyframe.
+    virtual int nn_keyframes();
+    virtual int keyframe(int i);
+    // The number of the latest sequence headers and metadata before the index.
+    virtual int headers(int index);
+    // The latest video and audio sequence headers, NULL if not in ring.
+    virtual SrsSharedPtrMessage* video_sh();
+    virtual SrsSharedPtrMessage* audio_sh();
+private:
+    SrsSharedPtrMessage*& slot(int64_t pos);
+    // Index the keyframes and sequence headers of messages not indexed.
+    void build_index();
+    virtual void grow();
 };
-#endif
 
 // The message queue for the consumer(client), forwarder.
 // We limit the size in seconds, drop old messages(the whole gop) if full.
@@ -113,11 +142,23 @@ private:
     bool _ignore_shrink;
     // The max queue size, shrink if exceed it.
     srs_utime_t max_queue_size;
-#ifdef SRS_PERF_QUEUE_FAST_VECTOR
-    SrsFastVector msgs;
-#else
-    std::vector<SrsSharedPtrMessage*> msgs;
-#endif
+    SrsMessageRing msgs;
+private:
+    // Whether drop frames adaptively for slow consumer, by the drain rate, before exceeds the max queue size.
+    bool adaptive_drop_;
+    // Drop the non-reference frames if queue exceeds it.
+    srs_utime_t drop_nonref_;
+    // Drop the oldest GOP if queue exceeds it.
+    srs_utime_t drop_gop_;
+    // The drain rate of consumer, the media duration dumped in a wall clock duration, 1.0 is realtime.
+    double drain_rate_;
+    // The media duration dumped in current window, and the start time of window.
+    srs_utime_t drained_;
+    srs_utime_t drain_window_;
+    // The counters for dropped messages.
+    int64_t nn_drop_frames_;
+    int64_t nn_drop_gops_;
+    int64_t nn_drop_bytes_;
 public:
     SrsMessageQueue(bool ignore_shrink = false);
     virtual ~SrsMessageQueue();
@@ -129,6 +170,16 @@ public:
     // Set the queue size
     // @param queue_size the queue size in srs_utime_t.
     virtual void set_queue_size(srs_utime_t queue_size);
+    // Set the adaptive drop for slow consumer.
+    // @param nonref the queue duration to drop the non-reference frames.
+    // @param gop the queue duration to drop the oldest GOP.
+    virtual void set_adaptive_drop(bool enabled, srs_utime_t nonref, srs_utime_t gop);
+    // Get the estimated drain rate of consumer, 1.0 is realtime.
+    virtual double drain_rate();
+    // Get the counters of dropped frames, GOPs and bytes.
+    virtual int64_t nn_drop_frames();
+    virtual int64_t nn_drop_gops();
+    virtual int64_t nn_drop_bytes();
 public:
     // Enqueue the message, the timestamp always monotonically.
     // @param msg, the msg to enqueue, user never free it whatever the return code.
@@ -143,9 +194,13 @@ public:
     // @remark the atc/tba/tbv/ag are same to SrsLiveConsumer.enqueue().
     virtual srs_error_t dump_packets(SrsLiveConsumer* consumer, bool atc, SrsRtmpJitterAlgorithm ag);
 private:
-    // Remove a gop from the front.
-    // if no iframe found, clear it.
+    // Remove the messages before the last GOP, if the last GOP fits the queue size.
+    // Otherwise, clear it, only keep the sequence headers.
     virtual void shrink();
+    // Update the drain rate of consumer, when the window is elapsed.
+    virtual void update_drain_rate();
+    // Drop the oldest GOP, keep the sequence headers and metadata. Return false if no next keyframe.
+    virtual bool drop_gop();
 public:
     // clear all messages in queue.
     virtual void clear();
@@ -188,6 +243,8 @@ public:
 public:
     // Set the size of queue.
     virtual void set_queue_size(srs_utime_t queue_size);
+    // Set the adaptive drop for slow player, see SrsMessageQueue.
+    virtual void set_adaptive_drop(bool enabled, srs_utime_t nonref, srs_utime_t gop);
     // when source id changed, notice client to print.
     virtual void update_source_id();
 public:
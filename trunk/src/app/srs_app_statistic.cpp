@@ -98,6 +98,7 @@ SrsStatisticStream::SrsStatisticStream()
 
     nb_clients = 0;
     frames = new SrsPps();
+    flv_source_bytes = flv_viewer_bytes = 0;
 }
 
 SrsStatisticStream::~SrsStatisticStream()
@@ -172,6 +173,14 @@ srs_error_t SrsStatisticStream::dumps(SrsJsonObject* obj)
         audio->set("channel", SrsJsonAny::integer(asound_type + 1));
         audio->set("profile", SrsJsonAny::str(srs_aac_object2str(aac_object).c_str()));
     }
+
+    if (flv_source_bytes > 0 || flv_viewer_bytes > 0) {
+        SrsJsonObject* oflv = SrsJsonAny::object();
+        obj->set("flv", oflv);
+
+        oflv->set("source_bytes", SrsJsonAny::integer(flv_source_bytes));
+        oflv->set("viewer_bytes", SrsJsonAny::integer(flv_viewer_bytes));
+    }
     
     return err;
 }
@@ -212,6 +221,10 @@ SrsStatisticClient::SrsStatisticClient()
     create = srs_get_system_time();
 
     kbps = new SrsKbps();
+
+    queue_size = queue_depth = 0;
+    queue_dropped = queue_overflows = 0;
+    flv_source_bytes = flv_viewer_bytes = 0;
 }
 
 SrsStatisticClient::~SrsStatisticClient()
@@ -244,6 +257,24 @@ srs_error_t SrsStatisticClient::dumps(SrsJsonObject* obj)
 
     okbps->set("recv_30s", SrsJsonAny::integer(kbps->get_recv_kbps_30s()));
     okbps->set("send_30s", SrsJsonAny::integer(kbps->get_send_kbps_30s()));
+
+    if (queue_size > 0) {
+        SrsJsonObject* oqueue = SrsJsonAny::object();
+        obj->set("queue", oqueue);
+
+        oqueue->set("size", SrsJsonAny::integer(queue_size));
+        oqueue->set("depth", SrsJsonAny::integer(queue_depth));
+        oqueue->set("dropped", SrsJsonAny::integer(queue_dropped));
+        oqueue->set("overflows", SrsJsonAny::integer(queue_overflows));
+    }
+
+    if (flv_source_bytes > 0 || flv_viewer_bytes > 0) {
+        SrsJsonObject* oflv = SrsJsonAny::object();
+        obj->set("flv", oflv);
+
+        oflv->set("source_bytes", SrsJsonAny::integer(flv_source_bytes));
+        oflv->set("viewer_bytes", SrsJsonAny::integer(flv_viewer_bytes));
+    }
     
     return err;
 }
@@ -453,6 +484,33 @@ srs_error_t SrsStatistic::on_client(std::string id, SrsRequest* req, ISrsExpire*
     return err;
 }
 
+void SrsStatistic::on_client_queue(std::string id, int size, int depth, int64_t dropped, int64_t overflows)
+{
+    std::map<std::string, SrsStatisticClient*>::iterator it = clients.find(id);
+    if (it == clients.end()) return;
+
+    SrsStatisticClient* client = it->second;
+    client->queue_size = size;
+    client->queue_depth = depth;
+    client->queue_dropped = dropped;
+    client->queue_overflows = overflows;
+}
+
+void SrsStatistic::on_client_flv(std::string id, int64_t source_bytes, int64_t viewer_bytes)
+{
+    std::map<std::string, SrsStatisticClient*>::iterator it = clients.find(id);
+    if (it == clients.end()) return;
+
+    // Sum the delta of client to stream.
+    SrsStatisticClient* client = it->second;
+    SrsStatisticStream* stream = client->stream;
+    stream->flv_source_bytes += source_bytes - client->flv_source_bytes;
+    stream->flv_viewer_bytes += viewer_bytes - client->flv_viewer_bytes;
+
+    client->flv_source_bytes = source_bytes;
+    client->flv_viewer_bytes = viewer_bytes;
+}
+
 void SrsStatistic::on_disconnect(std::string id, srs_error_t err)
 {
     std::map<std::string, SrsStatisticClient*>::iterator it = clients.find(id);
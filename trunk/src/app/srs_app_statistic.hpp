@@ -63,6 +63,9 @@ public:
     SrsKbps* kbps;
     // The fps of stream.
     SrsPps* frames;
+    // The bytes of FLV tags encoded once for all viewers, and encoded by each viewer.
+    int64_t flv_source_bytes;
+    int64_t flv_viewer_bytes;
 public:
     bool has_video;
     SrsVideoCodecId vcodec;
@@ -115,6 +118,16 @@ public:
 public:
     // The stream total kbps.
     SrsKbps* kbps;
+public:
+    // The consumer queue of RTC player, the size is 0 if not available.
+    int queue_size;
+    int queue_depth;
+    int64_t queue_dropped;
+    int64_t queue_overflows;
+public:
+    // The bytes of FLV tags of HTTP-FLV viewer, encoded for all viewers of source or only for this viewer.
+    int64_t flv_source_bytes;
+    int64_t flv_viewer_bytes;
 public:
     SrsStatisticClient();
     virtual ~SrsStatisticClient();
@@ -192,6 +205,16 @@ public:
     //      only got the request object, so the client specified by id maybe not
     //      exists in stat.
     virtual void on_disconnect(std::string id, srs_error_t err);
+    // When consumer queue of client updated.
+    // @param size, the capacity of queue.
+    // @param depth, the number of packets in queue.
+    // @param dropped, the total dropped packets.
+    // @param overflows, the total times of queue overflow.
+    virtual void on_client_queue(std::string id, int size, int depth, int64_t dropped, int64_t overflows);
+    // When HTTP-FLV viewer encoded FLV tags.
+    // @param source_bytes, the total bytes of tags encoded and shared by all viewers.
+    // @param viewer_bytes, the total bytes of tags encoded only for this viewer.
+    virtual void on_client_flv(std::string id, int64_t source_bytes, int64_t viewer_bytes);
 private:
     // Cleanup the stream if stream is not active and for the last client.
     void cleanup_stream(SrsStatisticStream* stream);
@@ -18,6 +18,7 @@
 #include <srs_app_async_call.hpp>
 #include <srs_app_tencentcloud.hpp>
 #include <srs_app_conn.hpp>
+#include <srs_app_hls.hpp>
 #ifdef SRS_RTC
 #include <srs_app_rtc_dtls.hpp>
 #include <srs_app_rtc_conn.hpp>
@@ -36,6 +37,8 @@ using namespace std;
 #include <unistd.h>
 #include <fcntl.h>
 
+#include <openssl/err.h>
+
 #if defined(SRS_OSX) || defined(SRS_CYGWIN64)
     pid_t gettid() {
         return 0;
@@ -152,10 +155,30 @@ extern SrsPps* _srs_pps_fast_addrs;
 
 extern SrsPps* _srs_pps_spkts;
 
+extern SrsPps* _srs_pps_rmmsgs;
+extern SrsPps* _srs_pps_rmmsgs_pkts;
+extern SrsPps* _srs_pps_rmmsgs_full;
+
+extern SrsPps* _srs_pps_smmsgs;
+extern SrsPps* _srs_pps_smmsgs_pkts;
+extern SrsPps* _srs_pps_sgso;
+
 extern SrsPps* _srs_pps_sstuns;
 extern SrsPps* _srs_pps_srtcps;
 extern SrsPps* _srs_pps_srtps;
 
+SrsPps* _srs_pps_asrtps = NULL;
+SrsPps* _srs_pps_asrtps_pkts = NULL;
+SrsPps* _srs_pps_asrtps_full = NULL;
+
+SrsPps* _srs_pps_adtls = NULL;
+SrsPps* _srs_pps_adtls_full = NULL;
+SrsPps* _srs_pps_adtls_drop = NULL;
+
+SrsPps* _srs_pps_afile = NULL;
+SrsPps* _srs_pps_afile_bytes = NULL;
+SrsPps* _srs_pps_afile_full = NULL;
+
 extern SrsPps* _srs_pps_pli;
 extern SrsPps* _srs_pps_twcc;
 extern SrsPps* _srs_pps_rr;
@@ -173,11 +196,16 @@ extern SrsPps* _srs_pps_cids_set;
 
 extern SrsPps* _srs_pps_objs_msgs;
 
+extern SrsPps* _srs_pps_zcbytes;
+extern SrsPps* _srs_pps_zccopied;
+
 extern SrsPps* _srs_pps_objs_rtps;
 extern SrsPps* _srs_pps_objs_rraw;
 extern SrsPps* _srs_pps_objs_rfua;
 extern SrsPps* _srs_pps_objs_rbuf;
 extern SrsPps* _srs_pps_objs_rothers;
+extern SrsPps* _srs_pps_objs_rhit;
+extern SrsPps* _srs_pps_objs_rmiss;
 
 SrsCircuitBreaker::SrsCircuitBreaker()
 {
@@ -192,10 +220,12 @@ SrsCircuitBreaker::SrsCircuitBreaker()
     hybrid_high_water_level_ = 0;
     hybrid_critical_water_level_ = 0;
     hybrid_dying_water_level_ = 0;
+    timer_ = new SrsWheelTimer(this, 1 * SRS_UTIME_SECONDS);
 }
 
 SrsCircuitBreaker::~SrsCircuitBreaker()
 {
+    srs_freep(timer_);
 }
 
 srs_error_t SrsCircuitBreaker::initialize()
@@ -212,7 +242,7 @@ srs_error_t SrsCircuitBreaker::initialize()
 
     // Update the water level for circuit breaker.
     // @see SrsCircuitBreaker::on_timer()
-    _srs_hybrid->timer1s()->subscribe(this);
+    _srs_hybrid->wheel()->add(timer_);
 
     srs_trace("CircuitBreaker: enabled=%d, high=%dx%d, critical=%dx%d, dying=%dx%d", enabled_,
         high_pulse_, high_threshold_, critical_pulse_, critical_threshold_,
@@ -321,6 +351,7 @@ srs_error_t srs_global_initialize()
     _srs_sources = new SrsLiveSourceManager();
     _srs_stages = new SrsStageManager();
     _srs_circuit_breaker = new SrsCircuitBreaker();
+    _srs_hls_memory = new SrsHlsMemoryStore();
 
 #ifdef SRS_SRT
     _srs_srt_sources = new SrsSrtSourceManager();
@@ -420,11 +451,35 @@ srs_error_t srs_global_initialize()
     _srs_pps_spkts = new SrsPps();
     _srs_pps_objs_msgs = new SrsPps();
 
+    _srs_pps_rmmsgs = new SrsPps();
+    _srs_pps_rmmsgs_pkts = new SrsPps();
+    _srs_pps_rmmsgs_full = new SrsPps();
+
+    _srs_pps_smmsgs = new SrsPps();
+    _srs_pps_smmsgs_pkts = new SrsPps();
+    _srs_pps_sgso = new SrsPps();
+
+    _srs_pps_afile = new SrsPps();
+    _srs_pps_afile_bytes = new SrsPps();
+    _srs_pps_afile_full = new SrsPps();
+
+    _srs_pps_zcbytes = new SrsPps();
+    _srs_pps_zccopied = new SrsPps();
+    _srs_zerocopy_reaper = new SrsZeroCopyReaper();
+
 #ifdef SRS_RTC
     _srs_pps_sstuns = new SrsPps();
     _srs_pps_srtcps = new SrsPps();
     _srs_pps_srtps = new SrsPps();
 
+    _srs_pps_asrtps = new SrsPps();
+    _srs_pps_asrtps_pkts = new SrsPps();
+    _srs_pps_asrtps_full = new SrsPps();
+
+    _srs_pps_adtls = new SrsPps();
+    _srs_pps_adtls_full = new SrsPps();
+    _srs_pps_adtls_drop = new SrsPps();
+
     _srs_pps_rstuns = new SrsPps();
     _srs_pps_rrtps = new SrsPps();
     _srs_pps_rrtcps = new SrsPps();
@@ -440,11 +495,24 @@ srs_error_t srs_global_initialize()
     _srs_pps_objs_rfua = new SrsPps();
     _srs_pps_objs_rbuf = new SrsPps();
     _srs_pps_objs_rothers = new SrsPps();
+    _srs_pps_objs_rhit = new SrsPps();
+    _srs_pps_objs_rmiss = new SrsPps();
 #endif
 
     // Create global async worker for DVR.
     _srs_dvr_async = new SrsAsyncCallWorker();
 
+    // Create global async file, the disk writers are started by thread pool if enabled.
+    _srs_async_file = new SrsAsyncFileManager();
+
+#ifdef SRS_RTC
+    // Create global async SRTP, the workers are started by thread pool if enabled.
+    _srs_async_srtp = new SrsAsyncSRTPManager();
+
+    // Create global async DTLS, the workers are started by thread pool if enabled.
+    _srs_async_dtls = new SrsAsyncDtlsManager();
+#endif
+
 #ifdef SRS_APM
     // Initialize global TencentCloud CLS object.
     _srs_cls = new SrsClsClient();
@@ -503,6 +571,7 @@ SrsThreadEntry::SrsThreadEntry()
     tid = 0;
 
     err = srs_success;
+    joinable = false;
 }
 
 SrsThreadEntry::~SrsThreadEntry()
@@ -638,7 +707,7 @@ srs_error_t SrsThreadPool::acquire_pid_file()
     return srs_success;
 }
 
-srs_error_t SrsThreadPool::execute(string label, srs_error_t (*start)(void* arg), void* arg)
+srs_error_t SrsThreadPool::execute(string label, srs_error_t (*start)(void* arg), void* arg, SrsThreadEntry** pentry)
 {
     srs_error_t err = srs_success;
 
@@ -660,6 +729,7 @@ srs_error_t SrsThreadPool::execute(string label, srs_error_t (*start)(void* arg)
     entry->label = label;
     entry->start = start;
     entry->arg = arg;
+    entry->joinable = (pentry != NULL);
 
     // The id of thread, should equal to the debugger thread id.
     // For gdb, it's: info threads
@@ -680,10 +750,22 @@ srs_error_t SrsThreadPool::execute(string label, srs_error_t (*start)(void* arg)
     }
 
     entry->trd = trd;
+    if (pentry) {
+        *pentry = entry;
+    }
 
     return err;
 }
 
+void SrsThreadPool::join(SrsThreadEntry* entry)
+{
+    // https://man7.org/linux/man-pages/man3/pthread_join.3.html
+    int r0 = pthread_join(entry->trd, NULL);
+    if (r0 != 0) {
+        srs_warn("join thread #%d(%s), r0=%d", entry->num, entry->label.c_str(), r0);
+    }
+}
+
 srs_error_t SrsThreadPool::run()
 {
     srs_error_t err = srs_success;
@@ -701,6 +783,11 @@ srs_error_t SrsThreadPool::run()
             for (int i = 0; i < (int)threads.size(); i++) {
                 SrsThreadEntry* entry = threads.at(i);
                 if (entry->err != srs_success) {
+                    // Ignore the joinable thread, which is stopped by its owner.
+                    if (entry->joinable && srs_error_code(entry->err) == ERROR_THREAD_FINISHED) {
+                        continue;
+                    }
+
                     // Quit with success.
                     if (srs_error_code(entry->err) == ERROR_THREAD_FINISHED) {
                         srs_trace("quit for thread #%d(%s) finished", entry->num, entry->label.c_str());
@@ -803,3 +890,647 @@ void* SrsThreadPool::start(void* arg)
 // It MUST be thread-safe, global and shared object.
 SrsThreadPool* _srs_thread_pool = new SrsThreadPool();
 
+
+srs_error_t srs_async_pipe(int fds[2])
+{
+    if (::pipe(fds) < 0) {
+        return srs_error_new(ERROR_SYSTEM_CREATE_PIPE, "create pipe");
+    }
+
+    int flags = fcntl(fds[1], F_GETFL, 0);
+    if (fcntl(fds[1], F_SETFL, flags | O_NONBLOCK) < 0) {
+        return srs_error_new(ERROR_SYSTEM_CREATE_PIPE, "set nonblock fd=%d", fds[1]);
+    }
+
+    return srs_success;
+}
+
+#ifdef SRS_RTC
+
+SrsAsyncSRTPTask::SrsAsyncSRTPTask(SrsSRTP* s, iovec* v, int n)
+{
+    srtp = s;
+    iovs = v;
+    nn_iovs = n;
+    err = srs_success;
+    done = false;
+    cond = srs_cond_new();
+}
+
+SrsAsyncSRTPTask::~SrsAsyncSRTPTask()
+{
+    srs_freep(err);
+    srs_cond_destroy(cond);
+}
+
+void SrsAsyncSRTPTask::execute()
+{
+    for (int i = 0; i < nn_iovs; i++) {
+        iovec* iov = iovs + i;
+
+        int nn = (int)iov->iov_len;
+        if ((err = srtp->protect_rtp(iov->iov_base, &nn)) != srs_success) {
+            err = srs_error_wrap(err, "packet %d/%d", i, nn_iovs);
+            return;
+        }
+        iov->iov_len = (size_t)nn;
+    }
+}
+
+SrsAsyncSRTPManager::SrsAsyncSRTPManager()
+{
+}
+
+SrsAsyncSRTPManager::~SrsAsyncSRTPManager()
+{
+}
+
+srs_error_t SrsAsyncSRTPManager::initialize(int nn_workers)
+{
+    // Each coroutine waits for at most one task, so it's large enough for lots of sessions.
+    return initialize_workers(nn_workers, 1024, "crypto", false);
+}
+
+srs_error_t SrsAsyncSRTPManager::start()
+{
+    srs_error_t err = srs_success;
+
+    if (workers_.empty() || enabled()) {
+        return err;
+    }
+
+    if ((err = start_collector("asrtp")) != srs_success) {
+        return srs_error_wrap(err, "start collector");
+    }
+
+    srs_trace("RTC: Start async SRTP with %d crypto workers", (int)workers_.size());
+
+    return err;
+}
+
+srs_error_t SrsAsyncSRTPManager::protect_rtps(SrsSRTP* srtp, iovec* iovs, int nn_iovs)
+{
+    srs_error_t err = srs_success;
+
+    SrsAsyncSRTPTask task(srtp, iovs, nn_iovs);
+
+    // Select the worker by session, so that the packets of a session are always in the same worker.
+    SrsAsyncWorker<SrsAsyncSRTPTask>* worker = NULL;
+    if (enabled()) {
+        uint64_t hash = (uint64_t)(uintptr_t)srtp;
+        worker = workers_.at((hash >> 4) % workers_.size());
+    }
+
+    // Process the packets in place, if disabled or worker is busy.
+    if (!worker || !worker->post(&task)) {
+        if (worker) {
+            ++_srs_pps_asrtps_full->sugar;
+        }
+
+        task.execute();
+        err = task.err;
+        task.err = srs_success;
+        return err;
+    }
+
+    ++_srs_pps_asrtps->sugar;
+    _srs_pps_asrtps_pkts->sugar += nn_iovs;
+
+    // Never quit when interrupted or timeout, because the worker is still using the task and packets. Collect
+    // the done tasks by self when timeout, so it never hangs even if the collector is blocked or failed.
+    while (!task.done) {
+        if (srs_cond_timedwait(task.cond, SRS_ASYNC_POLL_INTERVAL) != 0) {
+            collect();
+        }
+    }
+
+    err = task.err;
+    task.err = srs_success;
+    return err;
+}
+
+void SrsAsyncSRTPManager::on_done(SrsAsyncSRTPTask* task)
+{
+    // Wakeup the coroutine which is waiting for the done task.
+    task->done = true;
+    srs_cond_signal(task->cond);
+}
+
+SrsAsyncSRTPManager* _srs_async_srtp = NULL;
+
+SrsAsyncDtlsTask::SrsAsyncDtlsTask(SrsDtlsImpl* d, SSL* s, char* p, int n)
+{
+    dtls = d;
+    ssl = s;
+    ctx = NULL;
+    cid = _srs_context->get_id();
+    size = n;
+    data = new char[n];
+    memcpy(data, p, n);
+    r0 = r1 = 0;
+    err = srs_success;
+}
+
+SrsAsyncDtlsTask::~SrsAsyncDtlsTask()
+{
+    // Free the SSL of DTLS which is freed before the task is done.
+    if (!dtls) {
+        SSL_free(ssl);
+        SSL_CTX_free(ctx);
+    }
+
+    srs_freepa(data);
+    srs_freep(err);
+}
+
+void SrsAsyncDtlsTask::execute()
+{
+    BIO* bio_in = SSL_get_rbio(ssl);
+    BIO* bio_out = SSL_get_wbio(ssl);
+
+    if ((r0 = BIO_reset(bio_in)) != 1) {
+        err = srs_error_new(ERROR_OpenSslBIOReset, "BIO_reset r0=%d", r0);
+        return;
+    }
+    if ((r0 = BIO_reset(bio_out)) != 1) {
+        err = srs_error_new(ERROR_OpenSslBIOReset, "BIO_reset r0=%d", r0);
+        return;
+    }
+
+    if ((r0 = BIO_write(bio_in, data, size)) <= 0) {
+        err = srs_error_new(ERROR_OpenSslBIOWrite, "BIO_write r0=%d", r0);
+        return;
+    }
+
+    // The error queue of OpenSSL is per thread, so clear the errors of other sessions before SSL_get_error.
+    ERR_clear_error();
+
+    r0 = SSL_do_handshake(ssl);
+    r1 = SSL_get_error(ssl, r0);
+}
+
+SrsAsyncDtlsManager::SrsAsyncDtlsManager()
+{
+    next_ = 0;
+}
+
+SrsAsyncDtlsManager::~SrsAsyncDtlsManager()
+{
+}
+
+srs_error_t SrsAsyncDtlsManager::initialize(int nn_workers)
+{
+    // Each DTLS posts at most one task, and a handshake takes about 1ms, so the queue is about 256ms of
+    // handshakes, and the joins more than it are dropped and retransmitted by peers. Notify for each task,
+    // because a handshake takes about 1ms, so the flight is sent ASAP.
+    return initialize_workers(nn_workers, 256, "dtls", true);
+}
+
+srs_error_t SrsAsyncDtlsManager::start()
+{
+    srs_error_t err = srs_success;
+
+    if (workers_.empty() || enabled()) {
+        return err;
+    }
+
+    if ((err = start_collector("adtls")) != srs_success) {
+        return srs_error_wrap(err, "start collector");
+    }
+
+    srs_trace("RTC: Start async DTLS with %d DTLS workers", (int)workers_.size());
+
+    return err;
+}
+
+bool SrsAsyncDtlsManager::post(SrsAsyncDtlsTask* task)
+{
+    // The handshakes of sessions are independent, so post to the first worker which is not full.
+    for (int i = 0; i < (int)workers_.size(); i++) {
+        SrsAsyncWorker<SrsAsyncDtlsTask>* worker = workers_.at(next_);
+        next_ = (next_ + 1) % (int)workers_.size();
+        if (worker->post(task)) {
+            ++_srs_pps_adtls->sugar;
+            return true;
+        }
+    }
+
+    ++_srs_pps_adtls_full->sugar;
+    return false;
+}
+
+void SrsAsyncDtlsManager::on_done(SrsAsyncDtlsTask* task)
+{
+    // Continue the handshake of done task, in the context of connection.
+    if (task->dtls) {
+        SrsContextRestore(_srs_context->get_id());
+        _srs_context->set_id(task->cid);
+        task->dtls->on_async_handshake(task);
+    }
+    srs_freep(task);
+}
+
+SrsAsyncDtlsManager* _srs_async_dtls = NULL;
+
+#endif
+
+SrsAsyncFileTask::SrsAsyncFileTask(SrsAsyncFileWriter* w, SrsAsyncFileOp o)
+{
+    writer = w;
+    op = o;
+    fd = -1;
+    flags = 0;
+    buf = NULL;
+    size = 0;
+    offset = 0;
+    err = srs_success;
+}
+
+SrsAsyncFileTask::~SrsAsyncFileTask()
+{
+    srs_freepa(buf);
+    srs_freep(err);
+}
+
+void SrsAsyncFileTask::execute()
+{
+    if (op == SrsAsyncFileOpOpen) {
+        if ((fd = ::open(path.c_str(), flags, 0666)) < 0) {
+            err = srs_error_new(ERROR_SYSTEM_FILE_OPENE, "open file %s failed, errno=%d", path.c_str(), errno);
+            return;
+        }
+        if ((flags & O_APPEND) != 0) {
+            offset = ::lseek(fd, 0, SEEK_END);
+        }
+    } else if (op == SrsAsyncFileOpWrite) {
+        for (int pos = 0; pos < size;) {
+            ssize_t nn = ::write(fd, buf + pos, size - pos);
+            if (nn < 0 && errno == EINTR) {
+                continue;
+            }
+            if (nn <= 0) {
+                err = srs_error_new(ERROR_SYSTEM_FILE_WRITE, "write fd=%d, size=%d, errno=%d", fd, size - pos, errno);
+                return;
+            }
+            pos += (int)nn;
+        }
+    } else if (op == SrsAsyncFileOpSeek) {
+        if (::lseek(fd, (off_t)offset, SEEK_SET) < 0) {
+            err = srs_error_new(ERROR_SYSTEM_FILE_SEEK, "seek fd=%d to %" PRId64 ", errno=%d", fd, offset, errno);
+        }
+    } else if (op == SrsAsyncFileOpClose) {
+        if (::close(fd) < 0) {
+            err = srs_error_new(ERROR_SYSTEM_FILE_CLOSE, "close fd=%d, errno=%d", fd, errno);
+        }
+    }
+}
+
+SrsAsyncFileManager::SrsAsyncFileManager()
+{
+    depth_ = 0;
+    bytes_ = 0;
+}
+
+SrsAsyncFileManager::~SrsAsyncFileManager()
+{
+}
+
+srs_error_t SrsAsyncFileManager::initialize(int nn_workers)
+{
+    // Notify for each task, because the disk is slow, and the coroutine might wait for it.
+    return initialize_workers(nn_workers, 4096, "disk", true);
+}
+
+srs_error_t SrsAsyncFileManager::start()
+{
+    srs_error_t err = srs_success;
+
+    if (workers_.empty() || enabled()) {
+        return err;
+    }
+
+    if ((err = start_collector("afile")) != srs_success) {
+        return srs_error_wrap(err, "start collector");
+    }
+
+    srs_trace("Start async file with %d disk writers", (int)workers_.size());
+
+    return err;
+}
+
+int SrsAsyncFileManager::depth()
+{
+    return depth_;
+}
+
+int64_t SrsAsyncFileManager::bytes()
+{
+    return bytes_;
+}
+
+bool SrsAsyncFileManager::post(SrsAsyncFileTask* task)
+{
+    // Select the worker by writer, so that the tasks of a file are always in the same worker.
+    uint64_t hash = (uint64_t)(uintptr_t)task->writer;
+    SrsAsyncWorker<SrsAsyncFileTask>* worker = workers_.at((hash >> 4) % workers_.size());
+
+    if (!worker->post(task)) {
+        return false;
+    }
+
+    depth_++;
+    bytes_ += task->size;
+
+    ++_srs_pps_afile->sugar;
+    _srs_pps_afile_bytes->sugar += task->size;
+
+    return true;
+}
+
+void SrsAsyncFileManager::on_done(SrsAsyncFileTask* task)
+{
+    depth_--;
+    bytes_ -= task->size;
+
+    // Notify the writer of the done task, in the order of tasks.
+    task->writer->on_done(task);
+    srs_freep(task);
+}
+
+SrsAsyncFileManager* _srs_async_file = NULL;
+
+// The size of buffer to merge small writes, for example, the TS packets of HLS.
+#define SRS_ASYNC_FILE_BUFFER (64 * 1024)
+// The max bytes in flight of a file, the writer waits for the disk when exceed it.
+#define SRS_ASYNC_FILE_MAX_BYTES (8 * 1024 * 1024)
+
+SrsAsyncFileWriter::SrsAsyncFileWriter()
+{
+    async_ = false;
+    fd_ = -1;
+    position_ = size_ = 0;
+    buf_ = NULL;
+    nn_buf_ = 0;
+    nn_tasks_ = 0;
+    nn_bytes_ = 0;
+    err_ = srs_success;
+    cond_ = srs_cond_new();
+}
+
+SrsAsyncFileWriter::~SrsAsyncFileWriter()
+{
+    close();
+
+    srs_freepa(buf_);
+    srs_freep(err_);
+    srs_cond_destroy(cond_);
+}
+
+srs_error_t SrsAsyncFileWriter::set_iobuf_size(int size)
+{
+    // The small writes are always merged, so ignore the io buffer.
+    if (async_) {
+        return srs_success;
+    }
+
+    return SrsFileWriter::set_iobuf_size(size);
+}
+
+srs_error_t SrsAsyncFileWriter::open(string p)
+{
+    return do_open(p, false);
+}
+
+srs_error_t SrsAsyncFileWriter::open_append(string p)
+{
+    return do_open(p, true);
+}
+
+srs_error_t SrsAsyncFileWriter::do_open(string p, bool append)
+{
+    srs_error_t err = srs_success;
+
+    if (is_open()) {
+        return srs_error_new(ERROR_SYSTEM_FILE_ALREADY_OPENED, "file %s already opened", p.c_str());
+    }
+
+    // Write file in place, if disk writers are disabled.
+    if (!_srs_async_file || !_srs_async_file->enabled()) {
+        return append ? SrsFileWriter::open_append(p) : SrsFileWriter::open(p);
+    }
+
+    srs_freep(err_);
+    path_ = p;
+    position_ = size_ = 0;
+
+    SrsAsyncFileTask* task = new SrsAsyncFileTask(this, SrsAsyncFileOpOpen);
+    task->path = p;
+    task->flags = O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC);
+    post(task);
+
+    // Wait for the fd, because the open might block for slow disk.
+    wait();
+
+    if (err_ != srs_success) {
+        err = err_;
+        err_ = srs_success;
+        return srs_error_wrap(err, "async open");
+    }
+
+    async_ = true;
+
+    return err;
+}
+
+void SrsAsyncFileWriter::close()
+{
+    if (!async_) {
+        SrsFileWriter::close();
+        return;
+    }
+
+    flush();
+    async_ = false;
+
+    SrsAsyncFileTask* task = new SrsAsyncFileTask(this, SrsAsyncFileOpClose);
+    task->fd = fd_;
+    post(task);
+
+    // Wait for all writes to be done, so the file is complete when closed, for example, to rename it.
+    wait();
+    fd_ = -1;
+
+    if (err_ != srs_success) {
+        srs_warn("close file %s failed, %s", path_.c_str(), srs_error_desc(err_).c_str());
+        srs_freep(err_);
+    }
+}
+
+bool SrsAsyncFileWriter::is_open()
+{
+    if (!async_) {
+        return SrsFileWriter::is_open();
+    }
+
+    return fd_ >= 0;
+}
+
+void SrsAsyncFileWriter::seek2(int64_t offset)
+{
+    if (!async_) {
+        SrsFileWriter::seek2(offset);
+        return;
+    }
+
+    srs_error_t err = lseek((off_t)offset, SEEK_SET, NULL);
+    srs_assert(err == srs_success);
+}
+
+int64_t SrsAsyncFileWriter::tellg()
+{
+    if (!async_) {
+        return SrsFileWriter::tellg();
+    }
+
+    return position_;
+}
+
+srs_error_t SrsAsyncFileWriter::write(void* buf, size_t count, ssize_t* pnwrite)
+{
+    if (!async_) {
+        return SrsFileWriter::write(buf, count, pnwrite);
+    }
+
+    // Return the error of previous writes.
+    if (err_ != srs_success) {
+        return srs_error_wrap(srs_error_copy(err_), "async write %s", path_.c_str());
+    }
+
+    if (nn_buf_ + (int)count > SRS_ASYNC_FILE_BUFFER) {
+        flush();
+    }
+
+    if ((int)count >= SRS_ASYNC_FILE_BUFFER) {
+        SrsAsyncFileTask* task = new SrsAsyncFileTask(this, SrsAsyncFileOpWrite);
+        task->fd = fd_;
+        task->buf = new char[count];
+        task->size = (int)count;
+        memcpy(task->buf, buf, count);
+        post(task);
+    } else {
+        if (!buf_) {
+            buf_ = new char[SRS_ASYNC_FILE_BUFFER];
+        }
+        memcpy(buf_ + nn_buf_, buf, count);
+        nn_buf_ += (int)count;
+    }
+
+    position_ += count;
+    size_ = srs_max(size_, position_);
+
+    if (pnwrite) {
+        *pnwrite = count;
+    }
+
+    return srs_success;
+}
+
+srs_error_t SrsAsyncFileWriter::lseek(off_t offset, int whence, off_t* seeked)
+{
+    if (!async_) {
+        return SrsFileWriter::lseek(offset, whence, seeked);
+    }
+
+    int64_t pos = offset;
+    if (whence == SEEK_CUR) {
+        pos = position_ + offset;
+    } else if (whence == SEEK_END) {
+        pos = size_ + offset;
+    }
+    if (pos < 0) {
+        return srs_error_new(ERROR_SYSTEM_FILE_SEEK, "seek file %s to %" PRId64, path_.c_str(), pos);
+    }
+
+    // The writes before seek must be posted first.
+    flush();
+
+    SrsAsyncFileTask* task = new SrsAsyncFileTask(this, SrsAsyncFileOpSeek);
+    task->fd = fd_;
+    task->offset = pos;
+    post(task);
+
+    position_ = pos;
+    if (seeked) {
+        *seeked = (off_t)pos;
+    }
+
+    return srs_success;
+}
+
+void SrsAsyncFileWriter::on_done(SrsAsyncFileTask* task)
+{
+    nn_tasks_--;
+    nn_bytes_ -= task->size;
+
+    if (task->op == SrsAsyncFileOpOpen && task->err == srs_success) {
+        fd_ = task->fd;
+        position_ = size_ = task->offset;
+    }
+
+    // Keep the first error, to return it by next write.
+    if (task->err != srs_success && err_ == srs_success) {
+        err_ = task->err;
+        task->err = srs_success;
+    }
+
+    srs_cond_signal(cond_);
+}
+
+void SrsAsyncFileWriter::flush()
+{
+    if (nn_buf_ <= 0) {
+        return;
+    }
+
+    // The task owns the buffer, and a new one is allocated by next write.
+    SrsAsyncFileTask* task = new SrsAsyncFileTask(this, SrsAsyncFileOpWrite);
+    task->fd = fd_;
+    task->buf = buf_;
+    task->size = nn_buf_;
+    post(task);
+
+    buf_ = NULL;
+    nn_buf_ = 0;
+}
+
+void SrsAsyncFileWriter::post(SrsAsyncFileTask* task)
+{
+    bool full = false;
+
+    // Wait for the disk when too many bytes in flight, to limit the memory.
+    while (nn_tasks_ > 0 && nn_bytes_ + task->size > SRS_ASYNC_FILE_MAX_BYTES) {
+        full = true;
+        srs_cond_wait(cond_);
+    }
+
+    nn_tasks_++;
+    nn_bytes_ += task->size;
+
+    // Wait for the queue to be available, there might be no task of this file in the queue.
+    while (!_srs_async_file->post(task)) {
+        full = true;
+        srs_cond_timedwait(cond_, 10 * SRS_UTIME_MILLISECONDS);
+    }
+
+    if (full) {
+        ++_srs_pps_afile_full->sugar;
+    }
+}
+
+void SrsAsyncFileWriter::wait()
+{
+    // Never quit when interrupted, because the worker is still using the task.
+    while (nn_tasks_ > 0) {
+        srs_cond_wait(cond_);
+    }
+}
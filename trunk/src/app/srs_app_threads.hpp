@@ -10,11 +10,23 @@
 #include <srs_core.hpp>
 
 #include <srs_app_hourglass.hpp>
+#include <srs_app_st.hpp>
+#include <srs_kernel_file.hpp>
 
 #include <pthread.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#include <string>
+#include <vector>
+
+#include <openssl/ssl.h>
 
 class SrsThreadPool;
 class SrsProcSelfStat;
+class SrsSRTP;
+class SrsDtlsImpl;
+class SrsAsyncFileWriter;
 
 // Protect server in high load.
 class SrsCircuitBreaker : public ISrsFastTimer
@@ -34,6 +46,7 @@ private:
     int hybrid_high_water_level_;
     int hybrid_critical_water_level_;
     int hybrid_dying_water_level_;
+    SrsWheelTimer* timer_;
 public:
     SrsCircuitBreaker();
     virtual ~SrsCircuitBreaker();
@@ -104,6 +117,8 @@ public:
     pthread_t trd;
     // The exit error of thread.
     srs_error_t err;
+    // Whether the thread is stopped and joined by its owner, so the pool never quits when it's done.
+    bool joinable;
 public:
     SrsThreadEntry();
     virtual ~SrsThreadEntry();
@@ -141,8 +156,11 @@ private:
     // Require the PID file for the whole process.
     virtual srs_error_t acquire_pid_file();
 public:
-    // Execute start function with label in thread.
-    srs_error_t execute(std::string label, srs_error_t (*start)(void* arg), void* arg);
+    // Execute start function with label in thread. If pentry is not NULL, the thread is joinable, and the owner
+    // should notify it to quit and join it by the entry.
+    srs_error_t execute(std::string label, srs_error_t (*start)(void* arg), void* arg, SrsThreadEntry** pentry = NULL);
+    // Wait for the joinable thread to quit, which is notified to quit by its owner.
+    void join(SrsThreadEntry* entry);
     // Run in the primordial thread, util stop or quit.
     srs_error_t run();
     // Stop the thread pool and quit the primordial thread.
@@ -158,5 +176,553 @@ private:
 // It MUST be thread-safe, global and shared object.
 extern SrsThreadPool* _srs_thread_pool;
 
+// The lock-free queue for single producer thread and single consumer thread, which never blocks and
+// fails if full or empty. The capacity is rounded up to power of 2.
+template<typename T>
+class SrsThreadSpscQueue
+{
+private:
+    uint32_t capacity_;
+    T* items_;
+    // The head is only written by consumer, while the tail is only written by producer.
+    uint32_t head_;
+    uint32_t tail_;
+public:
+    SrsThreadSpscQueue(int capacity) {
+        capacity_ = 1;
+        while ((int)capacity_ < capacity) {
+            capacity_ <<= 1;
+        }
+        items_ = new T[capacity_];
+        head_ = tail_ = 0;
+    }
+    virtual ~SrsThreadSpscQueue() {
+        srs_freepa(items_);
+    }
+public:
+    // Push by the producer thread, return false if full.
+    bool push(const T& v) {
+        uint32_t tail = __atomic_load_n(&tail_, __ATOMIC_RELAXED);
+        if (tail - __atomic_load_n(&head_, __ATOMIC_ACQUIRE) >= capacity_) {
+            return false;
+        }
+        items_[tail & (capacity_ - 1)] = v;
+        __atomic_store_n(&tail_, tail + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+    // Pop by the consumer thread, return false if empty.
+    bool pop(T* pv) {
+        uint32_t head = __atomic_load_n(&head_, __ATOMIC_RELAXED);
+        if (head == __atomic_load_n(&tail_, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        *pv = items_[head & (capacity_ - 1)];
+        __atomic_store_n(&head_, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+};
+
+// Create a pipe, whose write fd is nonblocking, so the writer never blocks when notify the reader.
+extern srs_error_t srs_async_pipe(int fds[2]);
+
+// The worker thread, which receives tasks from the hybrid thread and sends them back when done. The task T should
+// provide execute(), which is called by the worker thread.
+template<typename T>
+class SrsAsyncWorker
+{
+private:
+    // The tasks from hybrid thread, and the done tasks to hybrid thread.
+    SrsThreadSpscQueue<T*>* tasks_;
+    SrsThreadSpscQueue<T*>* dones_;
+    // The number of tasks posted and not fetched, only accessed by hybrid thread.
+    int capacity_;
+    int inflight_;
+    // The pipe to wakeup worker when there are new tasks, and the worker quits when the write fd is closed.
+    int wakeup_[2];
+    // The write fd of pipe to notify the hybrid thread when there are done tasks.
+    int notify_;
+    // Whether notify the hybrid thread for each task, or once for a batch of tasks.
+    bool notify_each_;
+    // The worker thread, joined when stop.
+    SrsThreadEntry* trd_;
+public:
+    SrsAsyncWorker(int notify, bool notify_each) {
+        tasks_ = NULL;
+        dones_ = NULL;
+        capacity_ = 0;
+        inflight_ = 0;
+        wakeup_[0] = wakeup_[1] = -1;
+        notify_ = notify;
+        notify_each_ = notify_each;
+        trd_ = NULL;
+    }
+    virtual ~SrsAsyncWorker() {
+        stop();
+
+        srs_freep(tasks_);
+        srs_freep(dones_);
+
+        if (wakeup_[0] >= 0) {
+            ::close(wakeup_[0]);
+        }
+    }
+public:
+    srs_error_t initialize(int capacity) {
+        // The done queue never overflows, because the tasks in flight never exceed its size.
+        tasks_ = new SrsThreadSpscQueue<T*>(capacity);
+        dones_ = new SrsThreadSpscQueue<T*>(capacity);
+        capacity_ = capacity;
+
+        // The hybrid thread should never block when wakeup the worker.
+        return srs_async_pipe(wakeup_);
+    }
+    // Start the worker thread with label, by the primordial thread.
+    srs_error_t run(std::string label) {
+        return _srs_thread_pool->execute(label, SrsAsyncWorker<T>::start, this, &trd_);
+    }
+    // Stop the worker thread, by closing the wakeup pipe and join it. The tasks not done are dropped.
+    void stop() {
+        if (wakeup_[1] >= 0) {
+            ::close(wakeup_[1]);
+            wakeup_[1] = -1;
+        }
+
+        if (trd_) {
+            _srs_thread_pool->join(trd_);
+            trd_ = NULL;
+        }
+    }
+    // Post task to worker by hybrid thread, return false if queue is full.
+    bool post(T* task) {
+        // The done tasks not fetched also count, or the worker might fail to push them to the done queue.
+        if (inflight_ >= capacity_ || !tasks_->push(task)) {
+            return false;
+        }
+        inflight_++;
+
+        // Ignore EAGAIN, because the pipe is full of wakeups.
+        char c = 0;
+        if (::write(wakeup_[1], &c, 1) < 0) {
+            srs_verbose("ignore wakeup, errno=%d", errno);
+        }
+
+        return true;
+    }
+    // Fetch the done task by hybrid thread, return false if no one.
+    bool fetch(T** ptask) {
+        if (!dones_->pop(ptask)) {
+            return false;
+        }
+
+        inflight_--;
+        return true;
+    }
+public:
+    // The entry of worker thread.
+    static srs_error_t start(void* arg) {
+        SrsAsyncWorker<T>* worker = (SrsAsyncWorker<T>*)arg;
+        return worker->cycle();
+    }
+private:
+    srs_error_t cycle() {
+        char buf[64];
+
+        while (true) {
+            // Block until hybrid thread post some tasks, or quit when the pipe is closed.
+            ssize_t nn = ::read(wakeup_[0], buf, sizeof(buf));
+            if (nn == 0) {
+                return srs_success;
+            }
+            if (nn < 0 && errno != EINTR) {
+                return srs_error_new(ERROR_SYSTEM_FILE_READ, "read fd=%d, r0=%d", wakeup_[0], (int)nn);
+            }
+
+            bool has_done = false;
+            T* task = NULL;
+            while (tasks_->pop(&task)) {
+                task->execute();
+                dones_->push(task);
+                has_done = true;
+
+                if (notify_each_) {
+                    notify();
+                }
+            }
+
+            if (has_done && !notify_each_) {
+                notify();
+            }
+        }
+
+        return srs_success;
+    }
+    void notify() {
+        // Ignore EAGAIN, because the pipe is full of notifications.
+        char c = 0;
+        if (::write(notify_, &c, 1) < 0) {
+            srs_verbose("ignore notify, errno=%d", errno);
+        }
+    }
+};
+
+// The interval to poll the done tasks, when the collector fails to read the pipe, or the coroutine waits too long.
+#define SRS_ASYNC_POLL_INTERVAL (10 * SRS_UTIME_MILLISECONDS)
+
+// The manager of async workers, which posts tasks to workers, and collects the done tasks by a coroutine of the
+// hybrid thread, then handles them by on_done.
+template<typename T>
+class SrsAsyncManager : public ISrsCoroutineHandler
+{
+protected:
+    std::vector<SrsAsyncWorker<T>*> workers_;
+private:
+    // The pipe to notify the hybrid thread that some tasks are done.
+    int dones_[2];
+    srs_netfd_t stfd_;
+    SrsFastCoroutine* trd_;
+public:
+    SrsAsyncManager() {
+        dones_[0] = dones_[1] = -1;
+        stfd_ = NULL;
+        trd_ = NULL;
+    }
+    virtual ~SrsAsyncManager() {
+        srs_freep(trd_);
+
+        // Stop the worker threads before free them, and before close the pipe they notify.
+        for (int i = 0; i < (int)workers_.size(); i++) {
+            SrsAsyncWorker<T>* worker = workers_.at(i);
+            srs_freep(worker);
+        }
+        workers_.clear();
+
+        // The read fd is closed by stfd.
+        if (stfd_) {
+            srs_close_stfd(stfd_);
+        } else if (dones_[0] >= 0) {
+            ::close(dones_[0]);
+        }
+        if (dones_[1] >= 0) {
+            ::close(dones_[1]);
+        }
+    }
+protected:
+    // Create and start the worker threads with label, by the primordial thread.
+    // @param capacity The max number of tasks in flight of each worker.
+    // @param notify_each Whether worker notifies for each task, or once for a batch of tasks.
+    srs_error_t initialize_workers(int nn_workers, int capacity, std::string label, bool notify_each) {
+        srs_error_t err = srs_success;
+
+        if (nn_workers <= 0) {
+            return err;
+        }
+
+        // The worker should never block when notify the hybrid thread.
+        if ((err = srs_async_pipe(dones_)) != srs_success) {
+            return srs_error_wrap(err, "create pipe");
+        }
+
+        for (int i = 0; i < nn_workers; i++) {
+            SrsAsyncWorker<T>* worker = new SrsAsyncWorker<T>(dones_[1], notify_each);
+            workers_.push_back(worker);
+
+            if ((err = worker->initialize(capacity)) != srs_success) {
+                return srs_error_wrap(err, "init worker #%d", i);
+            }
+
+            if ((err = worker->run(label)) != srs_success) {
+                return srs_error_wrap(err, "start worker #%d", i);
+            }
+        }
+
+        return err;
+    }
+    // Start the coroutine with name to collect done tasks, by the hybrid thread.
+    srs_error_t start_collector(const char* name) {
+        srs_error_t err = srs_success;
+
+        if ((stfd_ = srs_netfd_open(dones_[0])) == NULL) {
+            return srs_error_new(ERROR_ST_OPEN_SOCKET, "open fd=%d", dones_[0]);
+        }
+
+        trd_ = new SrsFastCoroutine(name, this);
+        if ((err = trd_->start()) != srs_success) {
+            return srs_error_wrap(err, "start coroutine");
+        }
+
+        return err;
+    }
+public:
+    // Whether the workers are running, or the tasks are done by the hybrid thread.
+    bool enabled() {
+        return trd_ != NULL;
+    }
+    // Handle the done tasks, in the order of tasks for each worker, by the hybrid thread. It's also used by the
+    // task owner which waits too long, so that it never hangs even if the collector fails to read the pipe.
+    void collect() {
+        for (int i = 0; i < (int)workers_.size(); i++) {
+            SrsAsyncWorker<T>* worker = workers_.at(i);
+
+            T* task = NULL;
+            while (worker->fetch(&task)) {
+                on_done(task);
+            }
+        }
+    }
+protected:
+    // Handle the done task, by the hybrid thread.
+    virtual void on_done(T* task) = 0;
+// Interface ISrsCoroutineHandler
+public:
+    virtual srs_error_t cycle() {
+        srs_error_t err = srs_success;
+
+        char buf[64];
+        int nn_errors = 0;
+
+        while (true) {
+            if ((err = trd_->pull()) != srs_success) {
+                return srs_error_wrap(err, "pull");
+            }
+
+            // Never quit for error, or the tasks are never done. Poll the done tasks if fail to read the pipe.
+            ssize_t nn = srs_read(stfd_, buf, sizeof(buf), SRS_UTIME_NO_TIMEOUT);
+            if (nn <= 0) {
+                if (!nn_errors++) {
+                    srs_warn("async: ignore read fd=%d, r0=%d, errno=%d", dones_[0], (int)nn, errno);
+                }
+                srs_usleep(SRS_ASYNC_POLL_INTERVAL);
+            }
+
+            collect();
+        }
+
+        return err;
+    }
+};
+
+#ifdef SRS_RTC
+
+// The task to protect a batch of RTP packets, in place, by a crypto worker thread.
+class SrsAsyncSRTPTask
+{
+public:
+    SrsSRTP* srtp;
+    // The packets, the iov_len is updated to the size of result.
+    iovec* iovs;
+    int nn_iovs;
+    // The error of the first failed packet, the packets after it are not processed.
+    srs_error_t err;
+    // Whether the task is done by worker, only accessed by the hybrid thread.
+    bool done;
+    srs_cond_t cond;
+public:
+    SrsAsyncSRTPTask(SrsSRTP* s, iovec* v, int n);
+    virtual ~SrsAsyncSRTPTask();
+public:
+    // Do the crypto of all packets, in the thread of caller.
+    void execute();
+};
+
+// Offload the SRTP protect to crypto worker threads, so that the AES of packets runs in
+// parallel with the I/O of the hybrid thread. The coroutine waits for its task to be done, and the tasks of
+// a SRTP session always run in the same worker, so the order of packets are kept for each SSRC.
+class SrsAsyncSRTPManager : public SrsAsyncManager<SrsAsyncSRTPTask>
+{
+public:
+    SrsAsyncSRTPManager();
+    virtual ~SrsAsyncSRTPManager();
+public:
+    // Create and start the worker threads, by the primordial thread.
+    srs_error_t initialize(int nn_workers);
+    // Start the coroutine to collect done tasks, by the hybrid thread.
+    srs_error_t start();
+public:
+    // Protect packets by worker, the coroutine is blocked until done. The packets are processed by the caller
+    // if there is no worker.
+    srs_error_t protect_rtps(SrsSRTP* srtp, iovec* iovs, int nn_iovs);
+protected:
+    virtual void on_done(SrsAsyncSRTPTask* task);
+};
+
+extern SrsAsyncSRTPManager* _srs_async_srtp;
+
+// The task to feed a DTLS packet to SSL and do the handshake, by a DTLS worker thread.
+class SrsAsyncDtlsTask
+{
+public:
+    // The DTLS which posts the task, set to NULL if it's freed before the task is done.
+    SrsDtlsImpl* dtls;
+    // The SSL of DTLS, only accessed by worker until the task is done. If the DTLS is freed, the SSL and its ctx
+    // are owned and freed by the task.
+    SSL* ssl;
+    SSL_CTX* ctx;
+    // The context id of connection, to restore it when the task is done.
+    SrsContextId cid;
+    // The packet from peer, owned by task.
+    char* data;
+    int size;
+    // The result of SSL_do_handshake, set by worker.
+    int r0;
+    int r1;
+    // The DTLS alerts during handshake, set by worker and notified by the hybrid thread.
+    std::vector<std::string> alert_types;
+    std::vector<std::string> alert_descs;
+    // The error of BIO, set by worker.
+    srs_error_t err;
+public:
+    SrsAsyncDtlsTask(SrsDtlsImpl* d, SSL* s, char* p, int n);
+    virtual ~SrsAsyncDtlsTask();
+public:
+    // Do the handshake, in the thread of caller.
+    void execute();
+};
+
+// Offload the DTLS handshakes of RTC server to DTLS worker threads, so that the ECDHE and ECDSA of a join storm
+// never stall the media of other sessions in the hybrid thread. The packet is posted without waiting, and the
+// DTLS continues to send the flight and derive the SRTP keys in the hybrid thread when the task is done. The
+// queue of workers is bounded, so the packets are dropped when workers are busy, and the peer retransmits them.
+class SrsAsyncDtlsManager : public SrsAsyncManager<SrsAsyncDtlsTask>
+{
+private:
+    // The next worker to post task to, by round robin.
+    int next_;
+public:
+    SrsAsyncDtlsManager();
+    virtual ~SrsAsyncDtlsManager();
+public:
+    // Create and start the worker threads, by the primordial thread.
+    srs_error_t initialize(int nn_workers);
+    // Start the coroutine to collect done tasks, by the hybrid thread.
+    srs_error_t start();
+public:
+    // Post task to an idle worker, return false if all workers are busy.
+    bool post(SrsAsyncDtlsTask* task);
+protected:
+    virtual void on_done(SrsAsyncDtlsTask* task);
+};
+
+extern SrsAsyncDtlsManager* _srs_async_dtls;
+
+#endif
+
+// The operation of async file task.
+enum SrsAsyncFileOp
+{
+    SrsAsyncFileOpOpen = 0,
+    SrsAsyncFileOpWrite,
+    SrsAsyncFileOpSeek,
+    SrsAsyncFileOpClose,
+};
+
+// The task to open, write, seek or close a file, executed by the disk writer thread.
+class SrsAsyncFileTask
+{
+public:
+    SrsAsyncFileWriter* writer;
+    SrsAsyncFileOp op;
+    // The fd of file, or set by worker when open it.
+    int fd;
+    // For open, the path and flags of file.
+    std::string path;
+    int flags;
+    // For write, the bytes owned by task.
+    char* buf;
+    int size;
+    // For seek, the absolute offset. For open, set to the size of file by worker.
+    int64_t offset;
+    // The error of task, set by worker.
+    srs_error_t err;
+public:
+    SrsAsyncFileTask(SrsAsyncFileWriter* w, SrsAsyncFileOp o);
+    virtual ~SrsAsyncFileTask();
+public:
+    // Do the file operation, in the thread of caller.
+    void execute();
+};
+
+// Offload the blocking file I/O of HLS, DVR and DASH to disk writer threads, so that a slow disk or NFS never
+// stalls the hybrid thread. The writes are posted without waiting, while the open and close wait for all tasks
+// of file to be done, so the rename of segment is always after its data is written.
+class SrsAsyncFileManager : public SrsAsyncManager<SrsAsyncFileTask>
+{
+private:
+    // The number and bytes of tasks in flight, for metrics.
+    int depth_;
+    int64_t bytes_;
+public:
+    SrsAsyncFileManager();
+    virtual ~SrsAsyncFileManager();
+public:
+    // Create and start the worker threads, by the primordial thread.
+    srs_error_t initialize(int nn_workers);
+    // Start the coroutine to collect done tasks, by the hybrid thread.
+    srs_error_t start();
+    // The number and bytes of tasks in flight.
+    int depth();
+    int64_t bytes();
+public:
+    // Post task to worker, the tasks of a writer always go to the same worker, so they are done in order.
+    // @return false if queue is full.
+    bool post(SrsAsyncFileTask* task);
+protected:
+    virtual void on_done(SrsAsyncFileTask* task);
+};
+
+extern SrsAsyncFileManager* _srs_async_file;
+
+// The file writer which posts the file I/O to disk writer threads, see SrsAsyncFileManager. The small writes are
+// merged to a buffer before posting, and the writer waits when too many bytes are in flight. It works as
+// SrsFileWriter if disk writer threads are disabled.
+class SrsAsyncFileWriter : public SrsFileWriter
+{
+private:
+    // Whether the opened file is written by disk writer thread.
+    bool async_;
+    std::string path_;
+    int fd_;
+    // The position and size of file, maintained by hybrid thread.
+    int64_t position_;
+    int64_t size_;
+    // The buffer to merge small writes.
+    char* buf_;
+    int nn_buf_;
+private:
+    // The number and bytes of tasks in flight.
+    int nn_tasks_;
+    int64_t nn_bytes_;
+    // The first error of done tasks, returned by next write.
+    srs_error_t err_;
+    // Signal when task is done.
+    srs_cond_t cond_;
+public:
+    SrsAsyncFileWriter();
+    virtual ~SrsAsyncFileWriter();
+public:
+    virtual srs_error_t set_iobuf_size(int size);
+    virtual srs_error_t open(std::string p);
+    virtual srs_error_t open_append(std::string p);
+    virtual void close();
+public:
+    virtual bool is_open();
+    virtual void seek2(int64_t offset);
+    virtual int64_t tellg();
+// Interface ISrsWriteSeeker
+public:
+    virtual srs_error_t write(void* buf, size_t count, ssize_t* pnwrite);
+    virtual srs_error_t lseek(off_t offset, int whence, off_t* seeked);
+public:
+    // When task is done by worker, called by hybrid thread.
+    void on_done(SrsAsyncFileTask* task);
+private:
+    srs_error_t do_open(std::string p, bool append);
+    // Post the merged buffer to worker.
+    void flush();
+    // Post task to worker, wait when queue is full or too many bytes in flight.
+    void post(SrsAsyncFileTask* task);
+    // Wait for all tasks to be done.
+    void wait();
+};
+
 #endif
 
@@ -93,10 +93,6 @@
  * whether set the socket recv buffer size.
  */
 #undef SRS_PERF_MW_SO_RCVBUF
-/**
- * whether enable the fast vector for qeueue.
- */
-#define SRS_PERF_QUEUE_FAST_VECTOR
 /**
  * whether use cond wait to send messages.
  * @remark this improve performance for large connectios.
@@ -163,6 +159,28 @@
     #undef SRS_PERF_SO_SNDBUF_SIZE
 #endif
 
+/**
+ * The max number of free RTP packets, payloads and buffers in the pool of each thread.
+ * @remark 0 to disable the pool.
+ */
+#define SRS_PERF_RTP_POOL_SIZE 4096
+
+/**
+ * For MSG_ZEROCOPY, the writes less than this size are copied, because it's more expensive to pin the pages and
+ * handle the notification for small writes, see https://docs.kernel.org/networking/msg_zerocopy.html
+ */
+#define SRS_PERF_ZEROCOPY_MIN_BYTES 16384
+/**
+ * For MSG_ZEROCOPY, the iovs less than this size, such as the RTMP chunk headers and FLV tag headers, are copied
+ * and kept by socket until sent, because they are generally in a cache which is reused by the next write.
+ */
+#define SRS_PERF_ZEROCOPY_COPY_IOV 128
+/**
+ * For MSG_ZEROCOPY, the closed socket keeps the buffers until kernel completes the sending, or this timeout when
+ * peer never acks the data. Note that kernel holds the pages, so it's safe to free the buffers after timeout.
+ */
+#define SRS_PERF_ZEROCOPY_REAP_TIMEOUT (30 * SRS_UTIME_SECONDS)
+
 /**
  * whether ensure glibc memory check.
  */
@@ -238,6 +238,89 @@ bool SrsFlvVideo::hevc(char* data, int size)
 }
 #endif
 
+bool SrsFlvVideo::disposable(char* data, int size)
+{
+    // 5bytes required, for the header and cts.
+    if (size < 5) {
+        return false;
+    }
+
+    uint8_t frame_type = data[0];
+    bool is_ext_header = frame_type & 0x80;
+
+    bool is_avc = false;
+    int pos = 0;
+    if (!is_ext_header) {
+        // See rtmp_specification_1.0.pdf
+        SrsVideoCodecId codec_id = (SrsVideoCodecId)(frame_type & 0x0f);
+        frame_type = (frame_type >> 4) & 0x0f;
+        if (data[1] != SrsVideoAvcFrameTraitNALU) {
+            return false;
+        }
+        if (codec_id != SrsVideoCodecIdAVC && codec_id != SrsVideoCodecIdHEVC) {
+            return false;
+        }
+        is_avc = codec_id == SrsVideoCodecIdAVC;
+        pos = 5;
+    } else {
+        // See https://github.com/veovera/enhanced-rtmp
+        uint8_t packet_type = frame_type & 0x0f;
+        frame_type = (frame_type >> 4) & 0x07;
+        if (data[1] != 'h' || data[2] != 'v' || data[3] != 'c' || data[4] != '1') {
+            return false;
+        }
+        if (packet_type == SrsVideoHEVCFrameTraitPacketTypeCodedFrames) {
+            pos = 8;
+        } else if (packet_type == SrsVideoHEVCFrameTraitPacketTypeCodedFramesX) {
+            pos = 5;
+        } else {
+            return false;
+        }
+    }
+
+    if (frame_type == SrsVideoAvcFrameTypeDisposableInterFrame) {
+        return true;
+    }
+    if (frame_type != SrsVideoAvcFrameTypeInterFrame) {
+        return false;
+    }
+
+    // Check all coded slices, which must be non-reference.
+    bool has_slice = false;
+    while (pos + 5 <= size) {
+        uint8_t* p = (uint8_t*)data + pos;
+        uint32_t nb_nalu = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+        if (nb_nalu == 0 || nb_nalu > (uint32_t)(size - pos - 4)) {
+            return false;
+        }
+
+        uint8_t header = p[4];
+        if (is_avc) {
+            // The nal_ref_idc is 0 for non-reference slice.
+            SrsAvcNaluType nalu_type = (SrsAvcNaluType)(header & 0x1f);
+            if (nalu_type >= SrsAvcNaluTypeNonIDR && nalu_type <= SrsAvcNaluTypeIDR) {
+                if ((header >> 5) & 0x03) {
+                    return false;
+                }
+                has_slice = true;
+            }
+        } else {
+            // The even VCL NALU types before RSV_VCL_N14 are sub-layer non-reference pictures.
+            int nalu_type = (header >> 1) & 0x3f;
+            if (nalu_type < 32) {
+                if (nalu_type > 14 || (nalu_type % 2) != 0) {
+                    return false;
+                }
+                has_slice = true;
+            }
+        }
+
+        pos += 4 + nb_nalu;
+    }
+
+    return has_slice;
+}
+
 bool SrsFlvVideo::acceptable(char* data, int size)
 {
     // 1bytes required.
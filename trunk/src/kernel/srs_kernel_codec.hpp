@@ -287,6 +287,10 @@ public:
     // Check whether codec is HEVC(H.265).
     static bool hevc(char* data, int size);
 #endif
+    // Whether the frame is disposable, that is, a non-keyframe which is never referenced by other frames, for
+    // example, the B frames of H.264 without pyramid. All the coded slices must be non-reference, and the NALU
+    // length is 4 bytes.
+    static bool disposable(char* data, int size);
     /**
      * check the video RTMP/flv header info,
      * @return true if video RTMP/flv header is ok.
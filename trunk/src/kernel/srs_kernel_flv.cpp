@@ -182,6 +182,33 @@ SrsSharedMessageHeader::~SrsSharedMessageHeader()
 {
 }
 
+// The max number of chunk sizes to cache chunks for a message, generally all players use the same chunk size.
+#define SRS_SHARED_PTR_CHUNKS_MAX 4
+
+SrsSharedPtrChunks::SrsSharedPtrChunks(int size)
+{
+    chunk_size = size;
+    iovs = NULL;
+    nb_iovs = 0;
+}
+
+SrsSharedPtrChunks::~SrsSharedPtrChunks()
+{
+    srs_freepa(iovs);
+}
+
+// The max number of timestamps to cache FLV tags for a message, generally the viewers share the same timestamp.
+#define SRS_SHARED_PTR_FLV_TAGS_MAX 4
+
+SrsSharedPtrFlvTag::SrsSharedPtrFlvTag(int64_t ts)
+{
+    timestamp = ts;
+}
+
+SrsSharedPtrFlvTag::~SrsSharedPtrFlvTag()
+{
+}
+
 SrsSharedPtrMessage::SrsSharedPtrPayload::SrsSharedPtrPayload()
 {
     payload = NULL;
@@ -192,6 +219,16 @@ SrsSharedPtrMessage::SrsSharedPtrPayload::SrsSharedPtrPayload()
 SrsSharedPtrMessage::SrsSharedPtrPayload::~SrsSharedPtrPayload()
 {
     srs_freepa(payload);
+
+    for (int i = 0; i < (int)chunks.size(); i++) {
+        SrsSharedPtrChunks* c = chunks.at(i);
+        srs_freep(c);
+    }
+
+    for (int i = 0; i < (int)flv_tags.size(); i++) {
+        SrsSharedPtrFlvTag* tag = flv_tags.at(i);
+        srs_freep(tag);
+    }
 }
 
 SrsSharedPtrMessage::SrsSharedPtrMessage() : timestamp(0), stream_id(0), size(0), payload(NULL)
@@ -325,6 +362,83 @@ int SrsSharedPtrMessage::chunk_header(char* cache, int nb_cache, bool c0)
     }
 }
 
+SrsSharedPtrChunks* SrsSharedPtrMessage::chunks(int chunk_size)
+{
+    // The iovs point to the shared payload, and the c3 header depends on timestamp if extended.
+    if (!ptr || !payload || size <= 0 || payload != ptr->payload || size != ptr->size || chunk_size <= 0) {
+        return NULL;
+    }
+    if ((uint32_t)timestamp >= RTMP_EXTENDED_TIMESTAMP) {
+        return NULL;
+    }
+
+    for (int i = 0; i < (int)ptr->chunks.size(); i++) {
+        SrsSharedPtrChunks* c = ptr->chunks.at(i);
+        if (c->chunk_size == chunk_size) {
+            return c;
+        }
+    }
+
+    // Never change the cached chunks, because the iovs might be used by other connections.
+    if ((int)ptr->chunks.size() >= SRS_SHARED_PTR_CHUNKS_MAX) {
+        return NULL;
+    }
+
+    SrsSharedPtrChunks* c = new SrsSharedPtrChunks(chunk_size);
+    ptr->chunks.push_back(c);
+
+    int nbh = srs_chunk_header_c3(ptr->header.perfer_cid, (uint32_t)timestamp, c->c3, sizeof(c->c3));
+    srs_assert(nbh > 0);
+
+    int nb_chunks = (size + chunk_size - 1) / chunk_size;
+    c->nb_iovs = 2 * nb_chunks;
+    c->iovs = new iovec[c->nb_iovs];
+
+    char* p = payload;
+    for (int i = 0; i < nb_chunks; i++) {
+        iovec* iov = c->iovs + 2 * i;
+
+        // The c0 header is generated by each connection.
+        iov[0].iov_base = (i == 0)? NULL : c->c3;
+        iov[0].iov_len = (i == 0)? 0 : nbh;
+
+        int payload_size = srs_min(chunk_size, (int)(payload + size - p));
+        iov[1].iov_base = p;
+        iov[1].iov_len = payload_size;
+        p += payload_size;
+    }
+
+    return c;
+}
+
+SrsSharedPtrFlvTag* SrsSharedPtrMessage::flv_tag(int64_t timestamp, bool& created)
+{
+    created = false;
+
+    // The tag header depends on the size of payload, which must be the shared one.
+    if (!ptr || payload != ptr->payload || size != ptr->size) {
+        return NULL;
+    }
+
+    for (int i = 0; i < (int)ptr->flv_tags.size(); i++) {
+        SrsSharedPtrFlvTag* tag = ptr->flv_tags.at(i);
+        if (tag->timestamp == timestamp) {
+            return tag;
+        }
+    }
+
+    // Never change the cached tags, because the iovs might be used by other viewers.
+    if ((int)ptr->flv_tags.size() >= SRS_SHARED_PTR_FLV_TAGS_MAX) {
+        return NULL;
+    }
+
+    SrsSharedPtrFlvTag* tag = new SrsSharedPtrFlvTag(timestamp);
+    ptr->flv_tags.push_back(tag);
+    created = true;
+
+    return tag;
+}
+
 SrsSharedPtrMessage* SrsSharedPtrMessage::copy()
 {
     srs_assert(ptr);
@@ -367,6 +481,8 @@ SrsFlvTransmuxer::SrsFlvTransmuxer()
     iovss_cache = NULL;
     nb_ppts = 0;
     ppts = NULL;
+    source_bytes_ = 0;
+    viewer_bytes_ = 0;
 }
 
 SrsFlvTransmuxer::~SrsFlvTransmuxer()
@@ -536,26 +652,42 @@ srs_error_t SrsFlvTransmuxer::write_tags(SrsSharedPtrMessage** msgs, int count)
     for (int i = 0; i < count; i++) {
         SrsSharedPtrMessage* msg = msgs[i];
         
-        // Cache FLV packet header.
-        if (msg->is_audio()) {
-            if (drop_if_not_match_ && !has_audio_) continue; // Ignore audio packets if no audio stream.
-            cache_audio(msg->timestamp, msg->payload, msg->size, cache);
-        } else if (msg->is_video()) {
-            if (drop_if_not_match_ && !has_video_) continue; // Ignore video packets if no video stream.
-            cache_video(msg->timestamp, msg->payload, msg->size, cache);
-        } else {
-            cache_metadata(SrsFrameTypeScript, msg->payload, msg->size, cache);
+        // Ignore audio or video packets if no such stream.
+        if (msg->is_audio() && drop_if_not_match_ && !has_audio_) continue;
+        if (msg->is_video() && drop_if_not_match_ && !has_video_) continue;
+
+        // Use the FLV tag shared by all viewers if possible, or encode in the cache of this viewer.
+        bool created = false;
+        SrsSharedPtrFlvTag* tag = msg->flv_tag(msg->is_av()? msg->timestamp : 0, created);
+        char* header = tag? tag->header : cache;
+        char* tag_pts = tag? tag->pts : pts;
+
+        if (!tag || created) {
+            // Cache FLV packet header.
+            if (msg->is_audio()) {
+                cache_audio(msg->timestamp, msg->payload, msg->size, header);
+            } else if (msg->is_video()) {
+                cache_video(msg->timestamp, msg->payload, msg->size, header);
+            } else {
+                cache_metadata(SrsFrameTypeScript, msg->payload, msg->size, header);
+            }
+
+            // Cache FLV pts.
+            cache_pts(SRS_FLV_TAG_HEADER_SIZE + msg->size, tag_pts);
+
+            if (tag) {
+                source_bytes_ += SRS_FLV_TAG_HEADER_SIZE + SRS_FLV_PREVIOUS_TAG_SIZE;
+            } else {
+                viewer_bytes_ += SRS_FLV_TAG_HEADER_SIZE + SRS_FLV_PREVIOUS_TAG_SIZE;
+            }
         }
         
-        // Cache FLV pts.
-        cache_pts(SRS_FLV_TAG_HEADER_SIZE + msg->size, pts);
-        
         // Set cache to iovec.
-        iovs[0].iov_base = cache;
+        iovs[0].iov_base = header;
         iovs[0].iov_len = SRS_FLV_TAG_HEADER_SIZE;
         iovs[1].iov_base = msg->payload;
         iovs[1].iov_len = msg->size;
-        iovs[2].iov_base = pts;
+        iovs[2].iov_base = tag_pts;
         iovs[2].iov_len = SRS_FLV_PREVIOUS_TAG_SIZE;
         
         // Move to next cache.
@@ -572,6 +704,16 @@ srs_error_t SrsFlvTransmuxer::write_tags(SrsSharedPtrMessage** msgs, int count)
     return err;
 }
 
+int64_t SrsFlvTransmuxer::source_bytes()
+{
+    return source_bytes_;
+}
+
+int64_t SrsFlvTransmuxer::viewer_bytes()
+{
+    return viewer_bytes_;
+}
+
 void SrsFlvTransmuxer::cache_metadata(char type, char* data, int size, char* cache)
 {
     srs_assert(data);
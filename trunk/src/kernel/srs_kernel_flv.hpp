@@ -8,6 +8,7 @@
 #define SRS_KERNEL_FLV_HPP
 
 #include <srs_core.hpp>
+#include <srs_kernel_consts.hpp>
 
 #include <string>
 #include <vector>
@@ -239,6 +240,40 @@ public:
     virtual ~SrsSharedMessageHeader();
 };
 
+// The cache of chunked RTMP wire of a message for a chunk size, the iovs of chunk headers and payloads, which
+// are the same for all connections with the same chunk size, see SrsSharedPtrMessage::chunks.
+class SrsSharedPtrChunks
+{
+public:
+    // The chunk size of the RTMP connections.
+    int chunk_size;
+    // The iovs of chunks, the header and payload of each chunk. Note that the first iov is the c0 header, which
+    // is empty in cache, because it depends on the timestamp and stream id of each connection.
+    iovec* iovs;
+    int nb_iovs;
+    // The c3 header, shared by all chunks except the first one.
+    char c3[SRS_CONSTS_RTMP_MAX_FMT3_HEADER_SIZE];
+public:
+    SrsSharedPtrChunks(int size);
+    virtual ~SrsSharedPtrChunks();
+};
+
+// The cache of FLV tag of a message for a timestamp, the tag header and previous tag size, which are the same for
+// all HTTP-FLV viewers with the same timestamp, see SrsSharedPtrMessage::flv_tag.
+class SrsSharedPtrFlvTag
+{
+public:
+    // The timestamp of FLV tag, 0 for script data.
+    int64_t timestamp;
+    // The FLV tag header.
+    char header[SRS_FLV_TAG_HEADER_SIZE];
+    // The previous tag size.
+    char pts[SRS_FLV_PREVIOUS_TAG_SIZE];
+public:
+    SrsSharedPtrFlvTag(int64_t ts);
+    virtual ~SrsSharedPtrFlvTag();
+};
+
 // The shared ptr message.
 // For audio/video/data message that need less memory copy.
 // and only for output.
@@ -284,6 +319,10 @@ private:
         int size;
         // The reference count
         int shared_count;
+        // The cache of chunks for different chunk size.
+        std::vector<SrsSharedPtrChunks*> chunks;
+        // The cache of FLV tags for different timestamp.
+        std::vector<SrsSharedPtrFlvTag*> flv_tags;
     public:
         SrsSharedPtrPayload();
         virtual ~SrsSharedPtrPayload();
@@ -324,6 +363,17 @@ public:
     // generate the chunk header to cache.
     // @return the size of header.
     virtual int chunk_header(char* cache, int nb_cache, bool c0);
+    // Get the chunks of message for the chunk size, which is cached and shared by all copies of message, so the
+    // players with the same chunk size reuse one set of iovs, and only need to generate the c0 header.
+    // @return The chunks, or NULL if not cacheable, for example, extended timestamp or too many chunk sizes.
+    // @remark User should never free the chunks, which is freed with the payload.
+    virtual SrsSharedPtrChunks* chunks(int chunk_size);
+    // Get the FLV tag of message for the timestamp, which is cached and shared by all copies of message, so the
+    // viewers with the same timestamp reuse one FLV tag header.
+    // @param created Whether the FLV tag is created, and user should encode the tag header and previous tag size.
+    // @return The FLV tag, or NULL if too many timestamps.
+    // @remark User should never free the FLV tag, which is freed with the payload.
+    virtual SrsSharedPtrFlvTag* flv_tag(int64_t timestamp, bool& created);
 public:
     // copy current shared ptr message, use ref-count.
     // @remark, assert object is created.
@@ -388,9 +438,17 @@ private:
     // The cache iovss.
     int nb_iovss_cache;
     iovec* iovss_cache;
+private:
+    // The bytes of FLV tag headers and previous tag sizes, encoded for the shared FLV tags of messages, or
+    // encoded by this transmuxer only, see SrsSharedPtrMessage::flv_tag.
+    int64_t source_bytes_;
+    int64_t viewer_bytes_;
 public:
     // Write the tags in a time.
     virtual srs_error_t write_tags(SrsSharedPtrMessage** msgs, int count);
+    // Get the bytes of tags encoded for all viewers of source, and encoded for this viewer.
+    virtual int64_t source_bytes();
+    virtual int64_t viewer_bytes();
 private:
     virtual void cache_metadata(char type, char* data, int size, char* cache);
     virtual void cache_audio(int64_t timestamp, char* data, int size, char* cache);
@@ -24,6 +24,31 @@ SrsPps* _srs_pps_objs_rraw = NULL;
 SrsPps* _srs_pps_objs_rfua = NULL;
 SrsPps* _srs_pps_objs_rbuf = NULL;
 SrsPps* _srs_pps_objs_rothers = NULL;
+SrsPps* _srs_pps_objs_rhit = NULL;
+SrsPps* _srs_pps_objs_rmiss = NULL;
+
+// The pools of RTP objects and buffers, for each thread.
+static __thread SrsRtpObjectPool* _srs_rtp_packet_pool = NULL;
+static __thread SrsRtpObjectPool* _srs_rtp_raw_pool = NULL;
+static __thread SrsRtpObjectPool* _srs_rtp_fua_pool = NULL;
+static __thread SrsRtpBufferPool* _srs_rtp_buffer_pool = NULL;
+
+// Get the pool of current thread, create it if not exists.
+SrsRtpObjectPool* srs_rtp_pool_of(SrsRtpObjectPool*& pool, size_t object_size)
+{
+    if (!pool) {
+        pool = new SrsRtpObjectPool(object_size, SRS_PERF_RTP_POOL_SIZE);
+    }
+    return pool;
+}
+
+SrsRtpBufferPool* srs_rtp_buffer_pool()
+{
+    if (!_srs_rtp_buffer_pool) {
+        _srs_rtp_buffer_pool = new SrsRtpBufferPool(SRS_PERF_RTP_POOL_SIZE);
+    }
+    return _srs_rtp_buffer_pool;
+}
 
 /* @see https://tools.ietf.org/html/rfc1889#section-5.1
   0                   1                   2                   3
@@ -751,6 +776,114 @@ ISrsRtspPacketDecodeHandler::~ISrsRtspPacketDecodeHandler()
 {
 }
 
+SrsRtpObjectPool::SrsRtpObjectPool(size_t object_size, int capacity)
+{
+    // The free object should be large enough to store the next pointer.
+    object_size_ = srs_max(object_size, sizeof(void*));
+    capacity_ = capacity;
+    free_ = NULL;
+    nn_free_ = 0;
+}
+
+SrsRtpObjectPool::~SrsRtpObjectPool()
+{
+    while (free_) {
+        void* p = free_;
+        free_ = *(void**)p;
+        ::operator delete(p);
+    }
+}
+
+void* SrsRtpObjectPool::allocate(size_t size)
+{
+    if (free_ && size == object_size_) {
+        void* p = free_;
+        free_ = *(void**)p;
+        nn_free_--;
+
+        ++_srs_pps_objs_rhit->sugar;
+        return p;
+    }
+
+    ++_srs_pps_objs_rmiss->sugar;
+    return ::operator new(size);
+}
+
+void SrsRtpObjectPool::deallocate(void* p, size_t size)
+{
+    if (!p) {
+        return;
+    }
+
+    if (size != object_size_ || nn_free_ >= capacity_) {
+        ::operator delete(p);
+        return;
+    }
+
+    *(void**)p = free_;
+    free_ = p;
+    nn_free_++;
+}
+
+int SrsRtpObjectPool::size()
+{
+    return nn_free_;
+}
+
+SrsRtpBufferPool::SrsRtpBufferPool(int capacity)
+{
+    capacity_ = capacity;
+}
+
+SrsRtpBufferPool::~SrsRtpBufferPool()
+{
+    for (int i = 0; i < (int)buffers_.size(); i++) {
+        SrsSharedPtrMessage* buffer = buffers_.at(i);
+        srs_freep(buffer);
+    }
+}
+
+SrsSharedPtrMessage* SrsRtpBufferPool::allocate()
+{
+    if (buffers_.empty()) {
+        ++_srs_pps_objs_rmiss->sugar;
+        return NULL;
+    }
+
+    SrsSharedPtrMessage* buffer = buffers_.back();
+    buffers_.pop_back();
+
+    // Reset the fields, which might be changed by user.
+    buffer->timestamp = 0;
+    buffer->stream_id = 0;
+
+    ++_srs_pps_objs_rhit->sugar;
+    return buffer;
+}
+
+void SrsRtpBufferPool::deallocate(SrsSharedPtrMessage*& buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    // Only recycle the buffer created by SrsRtpPacket::wrap, which is not shared by others. The media message
+    // from RTMP is never recycled, see SrsRtpPacket::wrap(SrsSharedPtrMessage*).
+    bool reusable = buffer->count() == 0 && buffer->size == kRtpPacketSize && !buffer->is_av();
+    if (!reusable || (int)buffers_.size() >= capacity_) {
+        srs_freep(buffer);
+        return;
+    }
+
+    buffers_.push_back(buffer);
+    buffer = NULL;
+}
+
+int SrsRtpBufferPool::size()
+{
+    return (int)buffers_.size();
+}
+
 SrsRtpPacket::SrsRtpPacket()
 {
     payload_ = NULL;
@@ -763,6 +896,7 @@ SrsRtpPacket::SrsRtpPacket()
     cached_payload_size = 0;
     decode_handler = NULL;
     avsync_time_ = -1;
+    shared_count_ = 0;
 
     ++_srs_pps_objs_rtps->sugar;
 }
@@ -770,7 +904,17 @@ SrsRtpPacket::SrsRtpPacket()
 SrsRtpPacket::~SrsRtpPacket()
 {
     srs_freep(payload_);
-    srs_freep(shared_buffer_);
+    srs_rtp_buffer_pool()->deallocate(shared_buffer_);
+}
+
+void* SrsRtpPacket::operator new(size_t size)
+{
+    return srs_rtp_pool_of(_srs_rtp_packet_pool, sizeof(SrsRtpPacket))->allocate(size);
+}
+
+void SrsRtpPacket::operator delete(void* p, size_t size)
+{
+    srs_rtp_pool_of(_srs_rtp_packet_pool, sizeof(SrsRtpPacket))->deallocate(p, size);
 }
 
 char* SrsRtpPacket::wrap(int size)
@@ -783,8 +927,13 @@ char* SrsRtpPacket::wrap(int size)
         return shared_buffer_->payload;
     }
 
+    // Reuse the buffer from pool, which is large enough for RTP packet.
+    srs_rtp_buffer_pool()->deallocate(shared_buffer_);
+    if (size <= kRtpPacketSize && (shared_buffer_ = srs_rtp_buffer_pool()->allocate()) != NULL) {
+        return shared_buffer_->payload;
+    }
+
     // Create a large enough message, with under-layer buffer.
-    srs_freep(shared_buffer_);
     shared_buffer_ = new SrsSharedPtrMessage();
 
     // Create under-layer buffer for new message
@@ -841,6 +990,28 @@ SrsRtpPacket* SrsRtpPacket::copy()
     return cp;
 }
 
+SrsRtpPacket* SrsRtpPacket::share()
+{
+    shared_count_++;
+    return this;
+}
+
+void srs_rtp_packet_free(SrsRtpPacket*& pkt)
+{
+    if (!pkt) {
+        return;
+    }
+
+    // Free the packet when the last reference released.
+    if (pkt->shared_count_ > 0) {
+        pkt->shared_count_--;
+        pkt = NULL;
+        return;
+    }
+
+    srs_freep(pkt);
+}
+
 void SrsRtpPacket::set_padding(int size)
 {
     header.set_padding(size);
@@ -882,10 +1053,15 @@ uint64_t SrsRtpPacket::nb_bytes()
 }
 
 srs_error_t SrsRtpPacket::encode(SrsBuffer* buf)
+{
+    return encode(buf, &header);
+}
+
+srs_error_t SrsRtpPacket::encode(SrsBuffer* buf, SrsRtpHeader* h)
 {
     srs_error_t err = srs_success;
 
-    if ((err = header.encode(buf)) != srs_success) {
+    if ((err = h->encode(buf)) != srs_success) {
         return srs_error_wrap(err, "rtp header");
     }
 
@@ -893,8 +1069,8 @@ srs_error_t SrsRtpPacket::encode(SrsBuffer* buf)
         return srs_error_wrap(err, "rtp payload");
     }
 
-    if (header.get_padding() > 0) {
-        uint8_t padding = header.get_padding();
+    if (h->get_padding() > 0) {
+        uint8_t padding = h->get_padding();
         if (!buf->require(padding)) {
             return srs_error_new(ERROR_RTC_RTP_MUXER, "requires %d bytes", padding);
         }
@@ -978,6 +1154,16 @@ SrsRtpRawPayload::~SrsRtpRawPayload()
 {
 }
 
+void* SrsRtpRawPayload::operator new(size_t size)
+{
+    return srs_rtp_pool_of(_srs_rtp_raw_pool, sizeof(SrsRtpRawPayload))->allocate(size);
+}
+
+void SrsRtpRawPayload::operator delete(void* p, size_t size)
+{
+    srs_rtp_pool_of(_srs_rtp_raw_pool, sizeof(SrsRtpRawPayload))->deallocate(p, size);
+}
+
 uint64_t SrsRtpRawPayload::nb_bytes()
 {
     return nn_payload;
@@ -1438,6 +1624,16 @@ SrsRtpFUAPayload2::~SrsRtpFUAPayload2()
 {
 }
 
+void* SrsRtpFUAPayload2::operator new(size_t size)
+{
+    return srs_rtp_pool_of(_srs_rtp_fua_pool, sizeof(SrsRtpFUAPayload2))->allocate(size);
+}
+
+void SrsRtpFUAPayload2::operator delete(void* p, size_t size)
+{
+    srs_rtp_pool_of(_srs_rtp_fua_pool, sizeof(SrsRtpFUAPayload2))->deallocate(p, size);
+}
+
 uint64_t SrsRtpFUAPayload2::nb_bytes()
 {
     return 2 + size;
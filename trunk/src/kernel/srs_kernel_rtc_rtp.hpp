@@ -8,6 +8,7 @@
 #define SRS_KERNEL_RTC_RTP_HPP
 
 #include <srs_core.hpp>
+#include <srs_core_performance.hpp>
 
 #include <srs_kernel_buffer.hpp>
 #include <srs_kernel_codec.hpp>
@@ -269,6 +270,49 @@ public:
     virtual void on_before_decode_payload(SrsRtpPacket* pkt, SrsBuffer* buf, ISrsRtpPayloader** ppayload, SrsRtspPacketPayloadType* ppt) = 0;
 };
 
+// The slab pool of RTP objects, for example, SrsRtpPacket and its payloads, which keeps the freed objects in a
+// freelist, to avoid malloc and free for each RTP packet. Each thread has its own pools, without lock.
+// @remark The pool only recycles the memory, the object is always reset by its constructor when reused.
+class SrsRtpObjectPool
+{
+private:
+    size_t object_size_;
+    int capacity_;
+    // The freelist, each free object stores the next free object in its first bytes.
+    void* free_;
+    int nn_free_;
+public:
+    SrsRtpObjectPool(size_t object_size, int capacity);
+    virtual ~SrsRtpObjectPool();
+public:
+    // Allocate the memory for object, from the freelist if the size matches.
+    void* allocate(size_t size);
+    // Free the memory to freelist, or to system if pool is full.
+    void deallocate(void* p, size_t size);
+    // The number of free objects in pool.
+    int size();
+};
+
+// The pool of the 1500 bytes buffers, that is the shared message of RTP packet, see SrsRtpPacket::wrap. Each
+// thread has its own pool, without lock.
+// @remark The buffer is reset when reused, and the content is always written by the user of wrap.
+class SrsRtpBufferPool
+{
+private:
+    int capacity_;
+    std::vector<SrsSharedPtrMessage*> buffers_;
+public:
+    SrsRtpBufferPool(int capacity);
+    virtual ~SrsRtpBufferPool();
+public:
+    // Get a buffer of kRtpPacketSize bytes, NULL if pool is empty.
+    SrsSharedPtrMessage* allocate();
+    // Recycle the buffer, or free it if not reusable, for example, shared by others.
+    void deallocate(SrsSharedPtrMessage*& buffer);
+    // The number of free buffers in pool.
+    int size();
+};
+
 // The RTP packet with cached shared message.
 class SrsRtpPacket
 {
@@ -300,9 +344,16 @@ private:
     ISrsRtspPacketDecodeHandler* decode_handler;
 private:
     int64_t avsync_time_;
+private:
+    // The reference count, the packet is shared and read-only if not zero, see share().
+    int shared_count_;
 public:
     SrsRtpPacket();
     virtual ~SrsRtpPacket();
+public:
+    // Alloc and free the packet by pool.
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
 public:
     // Wrap buffer to shared_message, which is managed by us.
     char* wrap(int size);
@@ -311,6 +362,10 @@ public:
     char* wrap(SrsSharedPtrMessage* msg);
     // Copy the RTP packet.
     virtual SrsRtpPacket* copy();
+    // Share the RTP packet by reference count, for example, fan-out to all consumers of source. The shared
+    // packet is read-only, user should never change it, and must free it by srs_rtp_packet_free.
+    SrsRtpPacket* share();
+    friend void srs_rtp_packet_free(SrsRtpPacket*& pkt);
 public:
     // Parse the TWCC extension, ignore by default.
     void enable_twcc_decode() { header.enable_twcc_decode(); } // SrsRtpPacket::enable_twcc_decode
@@ -333,12 +388,18 @@ public:
     virtual uint64_t nb_bytes();
     virtual srs_error_t encode(SrsBuffer* buf);
     virtual srs_error_t decode(SrsBuffer* buf);
+    // Encode the packet with the specified header, for player to marshal a shared packet with its own
+    // SSRC, PT, sequence and timestamp, without changing the packet.
+    srs_error_t encode(SrsBuffer* buf, SrsRtpHeader* h);
 public:
     bool is_keyframe();
     void set_avsync_time(int64_t avsync_time) { avsync_time_ = avsync_time; }
     int64_t get_avsync_time() const { return avsync_time_; }
 };
 
+// Free the packet, or decrease the reference count if shared, and set the pkt to NULL.
+extern void srs_rtp_packet_free(SrsRtpPacket*& pkt);
+
 // Single payload data.
 class SrsRtpRawPayload : public ISrsRtpPayloader
 {
@@ -350,6 +411,10 @@ public:
 public:
     SrsRtpRawPayload();
     virtual ~SrsRtpRawPayload();
+public:
+    // Alloc and free the payload by pool.
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
 // interface ISrsRtpPayloader
 public:
     virtual uint64_t nb_bytes();
@@ -448,6 +513,10 @@ public:
 public:
     SrsRtpFUAPayload2();
     virtual ~SrsRtpFUAPayload2();
+public:
+    // Alloc and free the payload by pool.
+    static void* operator new(size_t size);
+    static void operator delete(void* p, size_t size);
 // interface ISrsRtpPayloader
 public:
     virtual uint64_t nb_bytes();
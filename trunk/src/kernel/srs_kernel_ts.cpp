@@ -188,10 +188,13 @@ SrsTsContext::SrsTsContext()
     sync_byte = 0x47; // ts default sync byte.
     vcodec = SrsVideoCodecIdReserved;
     acodec = SrsAudioCodecIdReserved1;
+    packets_ = new char[SRS_TS_PES_PACKETS * SRS_TS_PACKET_SIZE];
 }
 
 SrsTsContext::~SrsTsContext()
 {
+    srs_freepa(packets_);
+
     std::map<int, SrsTsChannel*>::iterator it;
     for (it = pids.begin(); it != pids.end(); ++it) {
         SrsTsChannel* channel = it->second;
@@ -431,6 +434,23 @@ srs_error_t SrsTsContext::encode_pat_pmt(ISrsStreamWriter* writer, int16_t vpid,
     return err;
 }
 
+// Write the 33bits timestamp in 5 bytes, see SrsMpegPES::encode_33bits_dts_pts.
+static char* srs_ts_encode_33bits(char* p, uint8_t fb, int64_t v)
+{
+    int32_t val = int32_t(fb << 4 | (((v >> 30) & 0x07) << 1) | 1);
+    *p++ = val;
+
+    val = int32_t((((v >> 15) & 0x7fff) << 1) | 1);
+    *p++ = (val >> 8);
+    *p++ = val;
+
+    val = int32_t((((v) & 0x7fff) << 1) | 1);
+    *p++ = (val >> 8);
+    *p++ = val;
+
+    return p;
+}
+
 srs_error_t SrsTsContext::encode_pes(ISrsStreamWriter* writer, SrsTsMessage* msg, int16_t pid, SrsTsStream sid, bool pure_audio)
 {
     srs_error_t err = srs_success;
@@ -456,83 +476,134 @@ srs_error_t SrsTsContext::encode_pes(ISrsStreamWriter* writer, SrsTsMessage* msg
     SrsTsChannel* channel = get(pid);
     srs_assert(channel);
     
+    // write pcr according to message.
+    bool write_pcr = msg->write_pcr;
+
+    // for pure audio, always write pcr.
+    // TODO: FIXME: maybe only need to write at begin and end of ts.
+    if (pure_audio && msg->is_audio()) {
+        write_pcr = true;
+    }
+
+    // it's ok to set pcr equals to dts,
+    // @see https://github.com/ossrs/srs/issues/311
+    // Fig. 3.18. Program Clock Reference of Digital-Video-and-Audio-Broadcasting-Technology, page 65
+    // In MPEG-2, these are the "Program Clock Refer- ence" (PCR) values which are
+    // nothing else than an up-to-date copy of the STC counter fed into the transport
+    // stream at a certain time. The data stream thus carries an accurate internal
+    // "clock time". All coding and de- coding processes are controlled by this clock
+    // time. To do this, the receiver, i.e. the MPEG decoder, must read out the
+    // "clock time", namely the PCR values, and compare them with its own internal
+    // system clock, that is to say its own 42 bit counter.
+    int64_t pcr = write_pcr? msg->dts : -1;
+
+    // Encode the packets to the contiguous buffer, and flush a batch of packets in one write.
+    char* p = msg->payload->bytes();
+    char* end = p + msg->payload->length();
+    while (p < end) {
+        int nn = encode_pes_packets(packets_, SRS_TS_PES_PACKETS, msg, channel, pid, pcr, &p);
+        if ((err = writer->write(packets_, nn * SRS_TS_PACKET_SIZE, NULL)) != srs_success) {
+            return srs_error_wrap(err, "ts: write packets");
+        }
+    }
+    
+    return err;
+}
+
+int SrsTsContext::encode_pes_packets(char* buf, int nb_packets, SrsTsMessage* msg, SrsTsChannel* channel, int16_t pid, int64_t pcr, char** pp)
+{
     char* start = msg->payload->bytes();
     char* end = start + msg->payload->length();
-    char* p = start;
-    
-    while (p < end) {
-        SrsTsPacket* pkt = NULL;
-        if (p == start) {
-            // write pcr according to message.
-            bool write_pcr = msg->write_pcr;
-            
-            // for pure audio, always write pcr.
-            // TODO: FIXME: maybe only need to write at begin and end of ts.
-            if (pure_audio && msg->is_audio()) {
-                write_pcr = true;
+    char* p = *pp;
+
+    int nn = 0;
+    for (; nn < nb_packets && p < end; nn++) {
+        char* pkt = buf + nn * SRS_TS_PACKET_SIZE;
+        bool first = (p == start);
+
+        // The PES header with 5B PTS or 10B PTS and DTS, see SrsMpegPES::size.
+        int pes_header_data_length = (msg->dts == msg->pts)? 5 : 10;
+        int nb_pes = first? 9 + pes_header_data_length : 0;
+        // The adaptation field with PCR, see SrsTsAdaptationField::size.
+        bool has_pcr = first && pcr >= 0;
+        int nb_af = has_pcr? 8 : 0;
+
+        int left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - 4 - nb_af - nb_pes);
+        int nb_stuffings = SRS_TS_PACKET_SIZE - 4 - nb_af - nb_pes - left;
+        if (nb_stuffings > 0) {
+            // Padding by adaptation field, consume the af size if no af, see SrsTsPacket::padding.
+            if (!nb_af) {
+                nb_af = 2;
+                nb_stuffings = srs_max(0, nb_stuffings - 2);
             }
-            
-            // it's ok to set pcr equals to dts,
-            // @see https://github.com/ossrs/srs/issues/311
-            // Fig. 3.18. Program Clock Reference of Digital-Video-and-Audio-Broadcasting-Technology, page 65
-            // In MPEG-2, these are the "Program Clock Refer- ence" (PCR) values which are
-            // nothing else than an up-to-date copy of the STC counter fed into the transport
-            // stream at a certain time. The data stream thus carries an accurate internal
-            // "clock time". All coding and de- coding processes are controlled by this clock
-            // time. To do this, the receiver, i.e. the MPEG decoder, must read out the
-            // "clock time", namely the PCR values, and compare them with its own internal
-            // system clock, that is to say its own 42 bit counter.
-            int64_t pcr = write_pcr? msg->dts : -1;
-            
+            nb_af += nb_stuffings;
+            left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - 4 - nb_af - nb_pes);
+        }
+
+        // 4B ts packet header, see SrsTsPacket::encode.
+        int16_t pidv = (pid & 0x1FFF) | (first? 0x4000 : 0);
+        int8_t afc = nb_af? SrsTsAdaptationFieldTypeBoth : SrsTsAdaptationFieldTypePayloadOnly;
+        char* q = pkt;
+        *q++ = sync_byte;
+        *q++ = (char)(pidv >> 8);
+        *q++ = (char)pidv;
+        *q++ = (char)((channel->continuity_counter++ & 0x0F) | ((afc << 4) & 0x30));
+
+        // The adaptation field, see SrsTsAdaptationField::encode.
+        if (nb_af) {
+            *q++ = (char)(nb_af - 1);
             // TODO: FIXME: finger it why use discontinuity of msg.
-            pkt = SrsTsPacket::create_pes_first(this,
-                pid, msg->sid, channel->continuity_counter++, msg->is_discontinuity,
-                pcr, msg->dts, msg->pts, msg->payload->length()
-            );
-        } else {
-            pkt = SrsTsPacket::create_pes_continue(this, pid, msg->sid, channel->continuity_counter++);
-        }
-        SrsAutoFree(SrsTsPacket, pkt);
-        
-        pkt->sync_byte = sync_byte;
-        
-        char* buf = new char[SRS_TS_PACKET_SIZE];
-        SrsAutoFreeA(char, buf);
-        
-        // set the left bytes with 0xFF.
-        int nb_buf = pkt->size();
-        srs_assert(nb_buf < SRS_TS_PACKET_SIZE);
-        
-        int left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - nb_buf);
-        int nb_stuffings = SRS_TS_PACKET_SIZE - nb_buf - left;
-        if (nb_stuffings > 0) {
-            // set all bytes to stuffings.
-            memset(buf, 0xFF, SRS_TS_PACKET_SIZE);
-            
-            // padding with stuffings.
-            pkt->padding(nb_stuffings);
-            
-            // size changed, recalc it.
-            nb_buf = pkt->size();
-            srs_assert(nb_buf < SRS_TS_PACKET_SIZE);
-            
-            left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - nb_buf);
-            nb_stuffings = SRS_TS_PACKET_SIZE - nb_buf - left;
-            srs_assert(nb_stuffings == 0);
+            *q++ = has_pcr? (char)(((msg->is_discontinuity << 7) & 0x80) | 0x10) : 0x00;
+            if (has_pcr) {
+                // @remark, use pcr base and ignore the extension
+                // @see https://github.com/ossrs/srs/issues/250#issuecomment-71349370
+                int64_t pcrv = 0x7E00 | ((pcr << 15) & 0xFFFFFFFF8000LL);
+                for (int i = 5; i >= 0; i--) {
+                    *q++ = (char)(pcrv >> (i * 8));
+                }
+            }
+            // The stuffing bytes.
+            int nb_reserved = nb_af - (has_pcr? 8 : 2);
+            memset(q, 0xFF, nb_reserved);
+            q += nb_reserved;
+        }
+
+        // The PES header, see SrsMpegPES::encode.
+        if (first) {
+            int size = msg->payload->length();
+            int32_t pplv = (size > 0 && size <= 0xFFFF)? size + 3 + pes_header_data_length : 0;
+            pplv = (pplv > 0xFFFF)? 0 : pplv;
+
+            *q++ = 0x00;
+            *q++ = 0x00;
+            *q++ = 0x01;
+            *q++ = (char)msg->sid;
+            *q++ = (char)(pplv >> 8);
+            *q++ = (char)pplv;
+            *q++ = (char)0x80;
+            *q++ = (char)((msg->dts == msg->pts)? 0x80 : 0xC0);
+            *q++ = (char)pes_header_data_length;
+
+            if (msg->dts == msg->pts) {
+                q = srs_ts_encode_33bits(q, 0x02, msg->pts);
+            } else {
+                q = srs_ts_encode_33bits(q, 0x03, msg->pts);
+                q = srs_ts_encode_33bits(q, 0x01, msg->dts);
+
+                // check sync, the diff of dts and pts should never greater than 1s.
+                if (msg->dts - msg->pts > 90000 || msg->pts - msg->dts > 90000) {
+                    srs_warn("ts: sync dts=%" PRId64 ", pts=%" PRId64, msg->dts, msg->pts);
+                }
+            }
         }
-        memcpy(buf + nb_buf, p, left);
+
+        srs_assert(q + left == pkt + SRS_TS_PACKET_SIZE);
+        memcpy(q, p, left);
         p += left;
-        
-        SrsBuffer stream(buf, nb_buf);
-        if ((err = pkt->encode(&stream)) != srs_success) {
-            return srs_error_wrap(err, "ts: encode packet");
-        }
-        if ((err = writer->write(buf, SRS_TS_PACKET_SIZE, NULL)) != srs_success) {
-            return srs_error_wrap(err, "ts: write packet");
-        }
     }
-    
-    return err;
+
+    *pp = p;
+    return nn;
 }
 
 SrsTsPacket::SrsTsPacket(SrsTsContext* c)
@@ -3311,6 +3382,11 @@ srs_error_t SrsTsTransmuxer::write_video(int64_t timestamp, char* data, int size
     return flush_video();
 }
 
+void SrsTsTransmuxer::reset_context()
+{
+    context->reset();
+}
+
 srs_error_t SrsTsTransmuxer::flush_audio()
 {
     srs_error_t err = srs_success;
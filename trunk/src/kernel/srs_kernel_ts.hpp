@@ -33,6 +33,10 @@ class SrsPsPacket;
 // Transport Stream packets are 188 bytes in length.
 #define SRS_TS_PACKET_SIZE          188
 
+// The max number of TS packets to encode PES into the contiguous buffer, then flush to writer in one write.
+// Note that a video frame of 64 packets is about 11KB, so most audio and P frames are written in one write.
+#define SRS_TS_PES_PACKETS          64
+
 // The aggregate pure audio for hls, in ts tbn(ms * 90).
 #define SRS_CONSTS_HLS_PURE_AUDIO_AGGREGATE 720 * 90
 
@@ -306,6 +310,9 @@ private:
     // when any codec changed, write the PAT/PMT.
     SrsVideoCodecId vcodec;
     SrsAudioCodecId acodec;
+private:
+    // The contiguous buffer of SRS_TS_PES_PACKETS TS packets, to encode PES without any allocation.
+    char* packets_;
 public:
     SrsTsContext();
     virtual ~SrsTsContext();
@@ -341,6 +348,11 @@ public:
 private:
     virtual srs_error_t encode_pat_pmt(ISrsStreamWriter* writer, int16_t vpid, SrsTsStream vs, int16_t apid, SrsTsStream as);
     virtual srs_error_t encode_pes(ISrsStreamWriter* writer, SrsTsMessage* msg, int16_t pid, SrsTsStream sid, bool pure_audio);
+    // Encode the PES of msg to TS packets in buf, which is nb_packets*SRS_TS_PACKET_SIZE bytes, starting from the
+    // payload at *pp, which is updated to the next byte to encode. The first packet carries the PES header and the
+    // PCR if pcr is not negative, just the same as SrsTsPacket::create_pes_first and SrsTsPacket::padding.
+    // @return The number of TS packets encoded in buf.
+    int encode_pes_packets(char* buf, int nb_packets, SrsTsMessage* msg, SrsTsChannel* channel, int16_t pid, int64_t pcr, char** pp);
 };
 
 // The packet in ts stream,
@@ -1354,6 +1366,8 @@ public:
     // @remark assert data is not NULL.
     virtual srs_error_t write_audio(int64_t timestamp, char* data, int size);
     virtual srs_error_t write_video(int64_t timestamp, char* data, int size);
+    // Write the PAT/PMT again before the next frame, for example, to start a random access point.
+    virtual void reset_context();
 private:
     virtual srs_error_t flush_audio();
     virtual srs_error_t flush_video();
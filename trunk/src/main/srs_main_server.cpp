@@ -258,6 +258,12 @@ int main(int argc, char** argv, char** envp)
     if (err != srs_success) {
         srs_error("Failed, %s", srs_error_desc(err).c_str());
     }
+
+    // Write all the logs in ring before quit, if async log.
+    SrsFileLog* log = dynamic_cast<SrsFileLog*>(_srs_log);
+    if (log) {
+        log->stop_async();
+    }
     
     int ret = srs_error_code(err);
     srs_freep(err);
@@ -513,12 +519,47 @@ srs_error_t run_in_thread_pool()
         return srs_error_wrap(err, "init thread pool");
     }
 
+    // Start the log thread before other threads, if async log is enabled.
+    SrsFileLog* log = dynamic_cast<SrsFileLog*>(_srs_log);
+    if (log && (err = log->start_async()) != srs_success) {
+        return srs_error_wrap(err, "start log thread");
+    }
+
     // Start the hybrid service worker thread, for RTMP and RTC server, etc.
     if ((err = _srs_thread_pool->execute("hybrid", run_hybrid_server, (void*)NULL)) != srs_success) {
         return srs_error_wrap(err, "start hybrid server thread");
     }
 
-    srs_trace("Pool: Start threads primordial=1, hybrids=1 ok");
+    // Start the crypto threads for RTC, to protect RTP to SRTP for players.
+    int cryptos = 0;
+#ifdef SRS_RTC
+    if (_srs_config->get_rtc_server_enabled()) {
+        cryptos = _srs_config->get_rtc_server_crypto_threads();
+    }
+    if ((err = _srs_async_srtp->initialize(cryptos)) != srs_success) {
+        return srs_error_wrap(err, "start crypto threads");
+    }
+#endif
+
+    // Start the DTLS threads for RTC, to do the DTLS handshakes.
+    int dtlss = 0;
+#ifdef SRS_RTC
+    if (_srs_config->get_rtc_server_enabled()) {
+        dtlss = _srs_config->get_rtc_server_dtls_threads();
+    }
+    if ((err = _srs_async_dtls->initialize(dtlss)) != srs_success) {
+        return srs_error_wrap(err, "start dtls threads");
+    }
+#endif
+
+    // Start the disk writer threads, for HLS, DVR and DASH.
+    int writers = _srs_config->get_threads_disk_writers();
+    if ((err = _srs_async_file->initialize(writers)) != srs_success) {
+        return srs_error_wrap(err, "start disk writer threads");
+    }
+
+    srs_trace("Pool: Start threads primordial=1, hybrids=1, cryptos=%d, dtlss=%d, writers=%d ok", cryptos,
+        dtlss, writers);
 
     return _srs_thread_pool->run();
 #endif
@@ -19,6 +19,7 @@ using namespace std;
 #include <srs_core_autofree.hpp>
 #include <srs_protocol_rtmp_stack.hpp>
 #include <srs_protocol_conn.hpp>
+#include <srs_protocol_io.hpp>
 #include <srs_protocol_http_stack.hpp>
 
 SrsHttpParser::SrsHttpParser()
@@ -759,11 +760,18 @@ srs_error_t SrsHttpMessageWriter::write(char* data, int size)
 }
 
 srs_error_t SrsHttpMessageWriter::writev(const iovec* iov, int iovcnt, ssize_t* pnwrite)
+{
+    return writev_zerocopy(iov, iovcnt, NULL, pnwrite);
+}
+
+srs_error_t SrsHttpMessageWriter::writev_zerocopy(const iovec* iov, int iovcnt, ISrsZeroCopyPin* pin, ssize_t* pnwrite)
 {
     srs_error_t err = srs_success;
     
     // when header not ready, or not chunked, send one by one.
     if (!header_wrote_ || content_length != -1) {
+        srs_freep(pin);
+
         ssize_t nwrite = 0;
         for (int i = 0; i < iovcnt; i++) {
             nwrite += iov[i].iov_len;
@@ -781,11 +789,13 @@ srs_error_t SrsHttpMessageWriter::writev(const iovec* iov, int iovcnt, ssize_t*
     
     // ignore NULL content.
     if (iovcnt <= 0) {
+        srs_freep(pin);
         return err;
     }
 
     // whatever header is wrote, we should try to send header.
     if ((err = send_header(NULL, 0)) != srs_success) {
+        srs_freep(pin);
         return srs_error_wrap(err, "send header");
     }
     
@@ -809,6 +819,7 @@ srs_error_t SrsHttpMessageWriter::writev(const iovec* iov, int iovcnt, ssize_t*
     // chunk header
     int nb_size = snprintf(header_cache, SRS_HTTP_HEADER_CACHE_SIZE, "%x", size);
     if (nb_size <= 0 || nb_size >= SRS_HTTP_HEADER_CACHE_SIZE) {
+        srs_freep(pin);
         return srs_error_new(ERROR_HTTP_CONTENT_LENGTH, "overflow size=%d, expect=%d", size, nb_size);
     }
     iovss[0].iov_base = (char*)header_cache;
@@ -828,9 +839,14 @@ srs_error_t SrsHttpMessageWriter::writev(const iovec* iov, int iovcnt, ssize_t*
     iovss[2+iovcnt].iov_base = (char*)SRS_HTTP_CRLF;
     iovss[2+iovcnt].iov_len = 2;
 
-    // sendout all ioves.
+    // sendout all ioves, the chunk header and eof are small and copied by socket for MSG_ZEROCOPY.
     ssize_t nwrite = 0;
-    if ((err = srs_write_large_iovs(skt, iovss, nb_iovss, &nwrite)) != srs_success) {
+    if (pin) {
+        err = srs_write_large_iovs_zerocopy(skt, iovss, nb_iovss, pin, &nwrite);
+    } else {
+        err = srs_write_large_iovs(skt, iovss, nb_iovss, &nwrite);
+    }
+    if (err != srs_success) {
         return srs_error_wrap(err, "writev large iovs");
     }
     
@@ -896,6 +912,71 @@ srs_error_t SrsHttpMessageWriter::send_header(char* data, int size)
     return skt->write((void*)buf.c_str(), buf.length(), NULL);
 }
 
+bool SrsHttpMessageWriter::sendfile_supported()
+{
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(skt);
+    return fw && fw->sendfile_supported();
+}
+
+srs_error_t SrsHttpMessageWriter::sendfile(int fd, int64_t offset, int64_t size)
+{
+    srs_error_t err = srs_success;
+
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(skt);
+    srs_assert(fw);
+
+    // write the header data in memory.
+    if (!header_wrote_) {
+        if (hdr->content_type().empty()) {
+            hdr->set_content_type("application/octet-stream");
+        }
+        if (hdr->content_length() == -1) {
+            hdr->set_content_length(size);
+        }
+        flw_->write_default_header();
+    }
+
+    // whatever header is wrote, we should try to send header.
+    if ((err = send_header(NULL, 0)) != srs_success) {
+        return srs_error_wrap(err, "send header");
+    }
+
+    // check the bytes send and content length.
+    written += size;
+    if (content_length != -1 && written > content_length) {
+        return srs_error_new(ERROR_HTTP_CONTENT_LENGTH, "overflow writen=%" PRId64 ", max=%" PRId64, written, content_length);
+    }
+
+    if (size <= 0) {
+        return err;
+    }
+
+    // directly send with content length
+    if (content_length != -1) {
+        return fw->sendfile(fd, offset, size, NULL);
+    }
+
+    // send in chunked encoding, the file is the chunk body.
+    int nb_size = snprintf(header_cache, SRS_HTTP_HEADER_CACHE_SIZE, "%" PRIx64 "%s", size, SRS_HTTP_CRLF);
+    if (nb_size <= 0 || nb_size >= SRS_HTTP_HEADER_CACHE_SIZE) {
+        return srs_error_new(ERROR_HTTP_CONTENT_LENGTH, "overflow size=%" PRId64 ", expect=%d", size, nb_size);
+    }
+
+    if ((err = skt->write(header_cache, nb_size, NULL)) != srs_success) {
+        return srs_error_wrap(err, "write chunk header");
+    }
+
+    if ((err = fw->sendfile(fd, offset, size, NULL)) != srs_success) {
+        return srs_error_wrap(err, "sendfile chunk");
+    }
+
+    if ((err = skt->write((void*)SRS_HTTP_CRLF, 2, NULL)) != srs_success) {
+        return srs_error_wrap(err, "write chunk eof");
+    }
+
+    return err;
+}
+
 bool SrsHttpMessageWriter::header_wrote()
 {
     return header_wrote_;
@@ -942,6 +1023,21 @@ srs_error_t SrsHttpResponseWriter::writev(const iovec* iov, int iovcnt, ssize_t*
     return writer_->writev(iov, iovcnt, pnwrite);
 }
 
+bool SrsHttpResponseWriter::sendfile_supported()
+{
+    return writer_->sendfile_supported();
+}
+
+srs_error_t SrsHttpResponseWriter::sendfile(int fd, int64_t offset, int64_t size)
+{
+    return writer_->sendfile(fd, offset, size);
+}
+
+srs_error_t SrsHttpResponseWriter::writev_zerocopy(const iovec* iov, int iovcnt, ISrsZeroCopyPin* pin, ssize_t* pnwrite)
+{
+    return writer_->writev_zerocopy(iov, iovcnt, pin, pnwrite);
+}
+
 void SrsHttpResponseWriter::write_header(int code)
 {
     if (writer_->header_wrote()) {
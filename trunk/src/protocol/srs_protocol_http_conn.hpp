@@ -249,13 +249,19 @@ public:
     virtual srs_error_t writev(const iovec* iov, int iovcnt, ssize_t* pnwrite);
     virtual void write_header();
     virtual srs_error_t send_header(char* data, int size);
+    // Send the file as body, see ISrsHttpFileResponseWriter.
+    virtual bool sendfile_supported();
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size);
+    // Write the iovs by MSG_ZEROCOPY, only for chunked encoding, see ISrsHttpFileResponseWriter.
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iovcnt, ISrsZeroCopyPin* pin, ssize_t* pnwrite);
 public:
     bool header_wrote();
     void set_header_filter(ISrsHttpHeaderFilter* hf);
 };
 
 // Response writer use st socket
-class SrsHttpResponseWriter : public ISrsHttpResponseWriter, public ISrsHttpFirstLineWriter
+class SrsHttpResponseWriter : public ISrsHttpResponseWriter, public ISrsHttpFileResponseWriter
+    , public ISrsHttpFirstLineWriter
 {
 protected:
     SrsHttpMessageWriter* writer_;
@@ -273,6 +279,11 @@ public:
     virtual srs_error_t write(char* data, int size);
     virtual srs_error_t writev(const iovec* iov, int iovcnt, ssize_t* pnwrite);
     virtual void write_header(int code);
+// Interface ISrsHttpFileResponseWriter
+public:
+    virtual bool sendfile_supported();
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size);
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iovcnt, ISrsZeroCopyPin* pin, ssize_t* pnwrite);
 // Interface ISrsHttpFirstLineWriter
 public:
     virtual srs_error_t build_first_line(std::stringstream& ss, char* data, int size);
@@ -250,6 +250,14 @@ ISrsHttpResponseWriter::~ISrsHttpResponseWriter()
 {
 }
 
+ISrsHttpFileResponseWriter::ISrsHttpFileResponseWriter()
+{
+}
+
+ISrsHttpFileResponseWriter::~ISrsHttpFileResponseWriter()
+{
+}
+
 ISrsHttpResponseReader::ISrsHttpResponseReader()
 {
 }
@@ -594,6 +602,18 @@ srs_error_t SrsHttpFileServer::copy(ISrsHttpResponseWriter* w, SrsFileReader* fs
 {
     srs_error_t err = srs_success;
     
+    // Send the file by zero copy if supported, for HTTP over TCP, see ISrsHttpFileResponseWriter.
+    ISrsHttpFileResponseWriter* fw = dynamic_cast<ISrsHttpFileResponseWriter*>(w);
+    if (fw && fw->sendfile_supported() && fs->fileno() > 0) {
+        int64_t offset = fs->tellg();
+        if ((err = fw->sendfile(fs->fileno(), offset, size)) != srs_success) {
+            return srs_error_wrap(err, "sendfile offset=%" PRId64 ", size=%" PRId64, offset, size);
+        }
+
+        fs->seek2(offset + size);
+        return err;
+    }
+
     int64_t left = size;
     char* buf = new char[SRS_HTTP_TS_SEND_BUFFER_SIZE];
     SrsAutoFreeA(char, buf);
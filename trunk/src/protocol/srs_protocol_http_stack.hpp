@@ -27,6 +27,7 @@ class SrsHttpMuxEntry;
 class ISrsHttpResponseWriter;
 class SrsJsonObject;
 class ISrsFileReaderFactory;
+class ISrsZeroCopyPin;
 
 // From http specification
 // CR             = <US-ASCII CR, carriage return (13)>
@@ -196,6 +197,22 @@ public:
     virtual void write_header(int code) = 0;
 };
 
+// The response writer to send file by zero copy, for example, sendfile for HTTP over TCP, see
+// SrsHttpFileServer::copy. User should check it by dynamic_cast, and fallback to write if not supported.
+class ISrsHttpFileResponseWriter
+{
+public:
+    ISrsHttpFileResponseWriter();
+    virtual ~ISrsHttpFileResponseWriter();
+public:
+    // Whether the underlayer transport supports sendfile, false for HTTPS.
+    virtual bool sendfile_supported() = 0;
+    // Send size bytes of file fd from offset, as the body of response, never change the position of fd.
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size) = 0;
+    // Write the iovs by MSG_ZEROCOPY if enabled by transport, the pin keeps the buffers and is freed by writer.
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iovcnt, ISrsZeroCopyPin* pin, ssize_t* pnwrite) = 0;
+};
+
 // The reader interface for http response.
 class ISrsHttpResponseReader : public ISrsReader
 {
@@ -30,6 +30,22 @@ ISrsProtocolWriter::~ISrsProtocolWriter()
 {
 }
 
+ISrsZeroCopyPin::ISrsZeroCopyPin()
+{
+}
+
+ISrsZeroCopyPin::~ISrsZeroCopyPin()
+{
+}
+
+ISrsProtocolFileWriter::ISrsProtocolFileWriter()
+{
+}
+
+ISrsProtocolFileWriter::~ISrsProtocolFileWriter()
+{
+}
+
 ISrsProtocolReadWriter::ISrsProtocolReadWriter()
 {
 }
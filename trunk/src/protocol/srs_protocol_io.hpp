@@ -94,6 +94,44 @@ public:
     virtual srs_utime_t get_send_timeout() = 0;
 };
 
+/**
+ * The buffers of the zero copy sending, which must be kept and never changed until kernel completes the sending, see
+ * ISrsProtocolFileWriter::writev_zerocopy.
+ */
+class ISrsZeroCopyPin
+{
+public:
+    ISrsZeroCopyPin();
+    virtual ~ISrsZeroCopyPin();
+};
+
+/**
+ * The writer to send by kernel without copying or encrypting in user space, for example, sendfile, kTLS and
+ * MSG_ZEROCOPY for TCP socket. It's optional for the protocol writer, user should check it by dynamic_cast, and fallback to read and write
+ * if not supported, for example, the SSL connection without kTLS.
+ */
+class ISrsProtocolFileWriter
+{
+public:
+    ISrsProtocolFileWriter();
+    virtual ~ISrsProtocolFileWriter();
+public:
+    // Whether able to sendfile now, for example, the SSL connection is able to sendfile only if kTLS enabled.
+    virtual bool sendfile_supported() = 0;
+    // Send size bytes of file fd from offset, never change the position of fd.
+    // @param nwrite, the actual write bytes, ignore if NULL.
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite) = 0;
+    // Enable kTLS to encrypt the sent data by kernel, the crypto_info is the struct tls12_crypto_info_aes_gcm_128
+    // or 256 of linux, see https://www.kernel.org/doc/html/latest/networking/tls.html
+    virtual srs_error_t enable_ktls(const void* crypto_info, int size) = 0;
+    // Enable MSG_ZEROCOPY for writev_zerocopy, see https://docs.kernel.org/networking/msg_zerocopy.html
+    virtual srs_error_t enable_zerocopy() = 0;
+    // Write the iovs by MSG_ZEROCOPY, or by copy if not enabled. The pin keeps the buffers of iovs, which is freed
+    // by writer when kernel completes the sending, so user should never use the pin after this call.
+    // @param nwrite, the actual write bytes, ignore if NULL.
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite) = 0;
+};
+
 /**
  * The reader and writer.
  */
@@ -190,6 +190,7 @@ SrsProtocol::SrsProtocol(ISrsProtocolReadWriter* io)
     srs_assert(nb_out_iovs >= 2);
     
     warned_c0c3_cache_dry = false;
+    zerocopy_ = false;
     auto_response_when_recv = true;
     show_debug_info = true;
     in_buffer_length = 0;
@@ -279,6 +280,11 @@ srs_error_t SrsProtocol::manual_response_flush()
     return err;
 }
 
+void SrsProtocol::set_zerocopy(bool v)
+{
+    zerocopy_ = v;
+}
+
 #ifdef SRS_PERF_MERGED_READ
 void SrsProtocol::set_merge_read(bool v, IMergeReadHandler* handler)
 {
@@ -415,6 +421,10 @@ srs_error_t SrsProtocol::do_send_messages(SrsSharedPtrMessage** msgs, int nb_msg
             continue;
         }
         
+        // The chunks shared by all connections with the same chunk size, so we only generate the c0 header,
+        // and reuse the c3 headers and payloads of chunks.
+        SrsSharedPtrChunks* chunks = msg->chunks(out_chunk_size);
+        
         // p set to current write position,
         // it's ok when payload is NULL and size is 0.
         char* p = msg->payload;
@@ -427,31 +437,37 @@ srs_error_t SrsProtocol::do_send_messages(SrsSharedPtrMessage** msgs, int nb_msg
             int nbh = msg->chunk_header(c0c3_cache, nb_cache, p == msg->payload);
             srs_assert(nbh > 0);
             
-            // header iov
-            iovs[0].iov_base = c0c3_cache;
-            iovs[0].iov_len = nbh;
-            
-            // payload iov
-            int payload_size = srs_min(out_chunk_size, (int)(pend - p));
-            iovs[1].iov_base = p;
-            iovs[1].iov_len = payload_size;
-            
-            // consume sendout bytes.
-            p += payload_size;
-            
-            // realloc the iovs if exceed,
-            // for we donot know how many messges maybe to send entirely,
-            // we just alloc the iovs, it's ok.
-            if (iov_index >= nb_out_iovs - 2) {
+            // The iovs of chunks, or the header and payload of a chunk.
+            int nb_iovs = chunks? chunks->nb_iovs : 2;
+            if (iov_index + nb_iovs > nb_out_iovs) {
                 int ov = nb_out_iovs;
-                nb_out_iovs = 2 * nb_out_iovs;
-                int realloc_size = sizeof(iovec) * nb_out_iovs;
-                out_iovs = (iovec*)realloc(out_iovs, realloc_size);
+                while (iov_index + nb_iovs > nb_out_iovs) {
+                    nb_out_iovs = 2 * nb_out_iovs;
+                }
+                out_iovs = (iovec*)realloc(out_iovs, sizeof(iovec) * nb_out_iovs);
+                iovs = out_iovs + iov_index;
                 srs_warn("resize iovs %d => %d, max_msgs=%d", ov, nb_out_iovs, SRS_PERF_MW_MSGS);
             }
             
-            // to next pair of iovs
-            iov_index += 2;
+            if (chunks) {
+                memcpy(iovs, chunks->iovs, sizeof(iovec) * nb_iovs);
+                p = pend;
+            } else {
+                // payload iov
+                int payload_size = srs_min(out_chunk_size, (int)(pend - p));
+                iovs[1].iov_base = p;
+                iovs[1].iov_len = payload_size;
+                
+                // consume sendout bytes.
+                p += payload_size;
+            }
+            
+            // header iov
+            iovs[0].iov_base = c0c3_cache;
+            iovs[0].iov_len = nbh;
+            
+            // to next iovs
+            iov_index += nb_iovs;
             iovs = out_iovs + iov_index;
             
             // to next c0c3 header cache
@@ -492,8 +508,10 @@ srs_error_t SrsProtocol::do_send_messages(SrsSharedPtrMessage** msgs, int nb_msg
         return err;
     }
 
-    // Send out iovs at a time.
-    if ((err = do_iovs_send(out_iovs, iov_index)) != srs_success) {
+    // Send out iovs at a time. For MSG_ZEROCOPY, the payloads are pinned by the messages until sent, while the
+    // headers in cache are copied by socket.
+    ISrsZeroCopyPin* pin = zerocopy_ ? new SrsSharedPtrPin(msgs, nb_msgs) : NULL;
+    if ((err = do_iovs_send(out_iovs, iov_index, pin)) != srs_success) {
         return srs_error_wrap(err, "send iovs");
     }
 
@@ -551,8 +569,11 @@ srs_error_t SrsProtocol::do_send_messages(SrsSharedPtrMessage** msgs, int nb_msg
 #endif
 }
 
-srs_error_t SrsProtocol::do_iovs_send(iovec* iovs, int size)
+srs_error_t SrsProtocol::do_iovs_send(iovec* iovs, int size, ISrsZeroCopyPin* pin)
 {
+    if (pin) {
+        return srs_write_large_iovs_zerocopy(skt, iovs, size, pin);
+    }
     return srs_write_large_iovs(skt, iovs, size);
 }
 
@@ -2141,6 +2162,11 @@ void SrsRtmpServer::set_auto_response(bool v)
     protocol->set_auto_response(v);
 }
 
+void SrsRtmpServer::set_zerocopy(bool v)
+{
+    protocol->set_zerocopy(v);
+}
+
 #ifdef SRS_PERF_MERGED_READ
 void SrsRtmpServer::set_merge_read(bool v, IMergeReadHandler* handler)
 {
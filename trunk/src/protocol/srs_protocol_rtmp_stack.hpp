@@ -33,6 +33,7 @@ class SrsSharedPtrMessage;
 class SrsProtocol;
 class ISrsProtocolReader;
 class ISrsProtocolReadWriter;
+class ISrsZeroCopyPin;
 class SrsCreateStreamPacket;
 class SrsFMLEStartPacket;
 class SrsPublishPacket;
@@ -199,6 +200,8 @@ private:
     bool warned_c0c3_cache_dry;
     // The output chunk size, default to 128, set by config.
     int32_t out_chunk_size;
+    // Whether send the payloads of messages by MSG_ZEROCOPY.
+    bool zerocopy_;
 public:
     SrsProtocol(ISrsProtocolReadWriter* io);
     virtual ~SrsProtocol();
@@ -211,6 +214,9 @@ public:
     // need to call this api(the protocol sdk will auto send message).
     // @see the auto_response_when_recv and manual_response_queue.
     virtual srs_error_t manual_response_flush();
+    // Send the messages by MSG_ZEROCOPY, which pins the messages until sent, see ISrsProtocolFileWriter.
+    // @remark User should enable MSG_ZEROCOPY for the socket.
+    virtual void set_zerocopy(bool v);
 public:
 #ifdef SRS_PERF_MERGED_READ
     // To improve read performance, merge some packets then read,
@@ -334,7 +340,8 @@ private:
     // The caller must free the param msgs.
     virtual srs_error_t do_send_messages(SrsSharedPtrMessage** msgs, int nb_msgs);
     // Send iovs. send multiple times if exceed limits.
-    virtual srs_error_t do_iovs_send(iovec* iovs, int size);
+    // @param pin The pin of buffers for MSG_ZEROCOPY, which is freed by socket.
+    virtual srs_error_t do_iovs_send(iovec* iovs, int size, ISrsZeroCopyPin* pin = NULL);
     // The underlayer api for send and free packet.
     virtual srs_error_t do_send_and_free_packet(SrsPacket* packet, int stream_id);
     // The imp for decode_message
@@ -623,6 +630,8 @@ public:
     // Set the auto response message when recv for protocol stack.
     // @param v, whether auto response message when recv message.
     virtual void set_auto_response(bool v);
+    // Send the messages by MSG_ZEROCOPY, see SrsProtocol::set_zerocopy.
+    virtual void set_zerocopy(bool v);
 #ifdef SRS_PERF_MERGED_READ
     // To improve read performance, merge some packets then read,
     // When it on and read small bytes, we sleep to wait more data.,
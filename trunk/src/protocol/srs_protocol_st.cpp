@@ -10,6 +10,7 @@
 #include <fcntl.h>
 #include <sys/socket.h>
 #include <netdb.h>
+#include <unistd.h>
 using namespace std;
 
 #include <srs_core_autofree.hpp>
@@ -17,13 +18,43 @@ using namespace std;
 #include <srs_kernel_log.hpp>
 #include <srs_protocol_utility.hpp>
 #include <srs_kernel_utility.hpp>
+#include <srs_kernel_kbps.hpp>
+#include <srs_core_performance.hpp>
+
+// The bytes of MSG_ZEROCOPY, sent without copy or copied by kernel.
+SrsPps* _srs_pps_zcbytes = NULL;
+SrsPps* _srs_pps_zccopied = NULL;
 
 // nginx also set to 512
 #define SERVER_LISTEN_BACKLOG 512
 
 #ifdef __linux__
 #include <sys/epoll.h>
+#include <sys/sendfile.h>
+#include <netinet/tcp.h>
+#if defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#include <linux/tls.h>
+#endif
+#endif
+#include <linux/errqueue.h>
+#endif
 
+// For MSG_ZEROCOPY, see https://docs.kernel.org/networking/msg_zerocopy.html
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+#ifdef __linux__
 bool srs_st_epoll_is_supported(void)
 {
     struct epoll_event ev;
@@ -71,7 +102,7 @@ srs_error_t srs_st_init()
 
     // Switch to the background cid.
     _srs_context->set_id(cid);
-    srs_info("st_init success, use %s", st_get_eventsys_name());
+    srs_trace("st_init success, use %s", st_get_eventsys_name());
     
     return srs_success;
 }
@@ -468,6 +499,94 @@ int srs_sendmsg(srs_netfd_t stfd, const struct msghdr *msg, int flags, srs_utime
     return st_sendmsg((st_netfd_t)stfd, msg, flags, (st_utime_t)timeout);
 }
 
+#ifdef __linux__
+int srs_recvmmsg(srs_netfd_t stfd, struct mmsghdr* msgvec, unsigned int vlen, int flags, srs_utime_t timeout)
+{
+    int n;
+    int osfd = srs_netfd_fileno(stfd);
+
+    // Never block in syscall, because ST waits for the fd to be readable.
+    flags |= MSG_DONTWAIT;
+
+    while ((n = recvmmsg(osfd, msgvec, vlen, flags, NULL)) < 0) {
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        // Wait until the socket becomes readable.
+        if (st_netfd_poll((st_netfd_t)stfd, POLLIN, (st_utime_t)timeout) < 0) {
+            return -1;
+        }
+    }
+
+    return n;
+}
+
+int srs_sendmmsg(srs_netfd_t stfd, struct mmsghdr* msgvec, unsigned int vlen, int flags, srs_utime_t timeout)
+{
+    int n;
+    int osfd = srs_netfd_fileno(stfd);
+
+    // Never block in syscall, because ST waits for the fd to be writable.
+    flags |= MSG_DONTWAIT;
+
+    while ((n = sendmmsg(osfd, msgvec, vlen, flags)) < 0) {
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        // Wait until the socket becomes writable.
+        if (st_netfd_poll((st_netfd_t)stfd, POLLOUT, (st_utime_t)timeout) < 0) {
+            return -1;
+        }
+    }
+
+    return n;
+}
+#endif
+
+ssize_t srs_sendfile(srs_netfd_t stfd, int in_fd, off_t* offset, size_t count, srs_utime_t timeout)
+{
+#ifdef __linux__
+    ssize_t n;
+    int osfd = srs_netfd_fileno(stfd);
+
+    // The socket is non-blocking, so sendfile never blocks, and ST waits for the fd to be writable.
+    while ((n = ::sendfile(osfd, in_fd, offset, count)) < 0) {
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        // Wait until the socket becomes writable.
+        if (st_netfd_poll((st_netfd_t)stfd, POLLOUT, (st_utime_t)timeout) < 0) {
+            return -1;
+        }
+    }
+
+    return n;
+#else
+    char buf[4096];
+    ssize_t n = ::pread(in_fd, buf, srs_min(count, sizeof(buf)), *offset);
+    if (n <= 0) {
+        return n;
+    }
+
+    if ((n = st_write((st_netfd_t)stfd, buf, n, (st_utime_t)timeout)) > 0) {
+        *offset += n;
+    }
+    return n;
+#endif
+}
+
 srs_netfd_t srs_accept(srs_netfd_t stfd, struct sockaddr *addr, int *addrlen, srs_utime_t timeout)
 {
     return (srs_netfd_t)st_accept((st_netfd_t)stfd, addr, addrlen, (st_utime_t)timeout);
@@ -495,6 +614,25 @@ SrsStSocket::SrsStSocket(srs_netfd_t fd)
 
 SrsStSocket::~SrsStSocket()
 {
+    if (zerocopy_pendings_.empty()) {
+        return;
+    }
+
+    // Free the completed buffers, and reap the closed sockets as well.
+    reap_zerocopy();
+    if (_srs_zerocopy_reaper) {
+        _srs_zerocopy_reaper->reap();
+    }
+
+    // Kernel might still send the buffers after the fd closed, so keep them until completed.
+    if (!zerocopy_pendings_.empty() && _srs_zerocopy_reaper && _srs_zerocopy_reaper->adopt(this)) {
+        return;
+    }
+
+    while (!zerocopy_pendings_.empty()) {
+        free_zerocopy(zerocopy_pendings_.front());
+        zerocopy_pendings_.pop_front();
+    }
 }
 
 void SrsStSocket::init(srs_netfd_t fd)
@@ -502,6 +640,8 @@ void SrsStSocket::init(srs_netfd_t fd)
     stfd_ = fd;
     stm = rtm = SRS_UTIME_NO_TIMEOUT;
     rbytes = sbytes = 0;
+    zerocopy_ = false;
+    zerocopy_id_ = 0;
 }
 
 void SrsStSocket::set_recv_timeout(srs_utime_t tm)
@@ -541,7 +681,9 @@ srs_error_t SrsStSocket::read(void* buf, size_t size, ssize_t* nread)
     srs_assert(stfd_);
 
     ssize_t nb_read;
-    if (rtm == SRS_UTIME_NO_TIMEOUT) {
+    if (zerocopy_) {
+        nb_read = read_zerocopy(buf, size, false);
+    } else if (rtm == SRS_UTIME_NO_TIMEOUT) {
         nb_read = st_read((st_netfd_t)stfd_, buf, size, ST_UTIME_NO_TIMEOUT);
     } else {
         nb_read = st_read((st_netfd_t)stfd_, buf, size, rtm);
@@ -578,7 +720,9 @@ srs_error_t SrsStSocket::read_fully(void* buf, size_t size, ssize_t* nread)
     srs_assert(stfd_);
     
     ssize_t nb_read;
-    if (rtm == SRS_UTIME_NO_TIMEOUT) {
+    if (zerocopy_) {
+        nb_read = read_zerocopy(buf, size, true);
+    } else if (rtm == SRS_UTIME_NO_TIMEOUT) {
         nb_read = st_read_fully((st_netfd_t)stfd_, buf, size, ST_UTIME_NO_TIMEOUT);
     } else {
         nb_read = st_read_fully((st_netfd_t)stfd_, buf, size, rtm);
@@ -613,6 +757,12 @@ srs_error_t SrsStSocket::write(void* buf, size_t size, ssize_t* nwrite)
     srs_error_t err = srs_success;
 
     srs_assert(stfd_);
+
+    // Always use sendmsg for MSG_ZEROCOPY, to reap the notifications when waiting for the socket.
+    if (zerocopy_) {
+        iovec iov = {buf, size};
+        return writev_zerocopy(&iov, 1, NULL, nwrite);
+    }
     
     ssize_t nb_write;
     if (stm == SRS_UTIME_NO_TIMEOUT) {
@@ -645,6 +795,10 @@ srs_error_t SrsStSocket::writev(const iovec *iov, int iov_size, ssize_t* nwrite)
     srs_error_t err = srs_success;
 
     srs_assert(stfd_);
+
+    if (zerocopy_) {
+        return writev_zerocopy(iov, iov_size, NULL, nwrite);
+    }
     
     ssize_t nb_write;
     if (stm == SRS_UTIME_NO_TIMEOUT) {
@@ -672,6 +826,433 @@ srs_error_t SrsStSocket::writev(const iovec *iov, int iov_size, ssize_t* nwrite)
     return err;
 }
 
+bool SrsStSocket::sendfile_supported()
+{
+    return true;
+}
+
+srs_error_t SrsStSocket::sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite)
+{
+    srs_error_t err = srs_success;
+
+    srs_assert(stfd_);
+
+    // Send all bytes like write, the sendfile might send part of file.
+    off_t pos = (off_t)offset;
+    int64_t left = size;
+    while (left > 0) {
+        ssize_t nb_write = srs_sendfile(stfd_, fd, &pos, (size_t)left, stm);
+        if (nb_write <= 0) {
+            if (nb_write < 0 && errno == ETIME) {
+                return srs_error_new(ERROR_SOCKET_TIMEOUT, "sendfile timeout %d ms", srsu2msi(stm));
+            }
+
+            return srs_error_new(ERROR_SOCKET_WRITE, "sendfile offset=%" PRId64 ", left=%" PRId64, (int64_t)pos, left);
+        }
+
+        left -= nb_write;
+        sbytes += nb_write;
+    }
+
+    if (nwrite) {
+        *nwrite = size;
+    }
+
+    return err;
+}
+
+srs_error_t SrsStSocket::enable_ktls(const void* crypto_info, int size)
+{
+    srs_error_t err = srs_success;
+
+    srs_assert(stfd_);
+
+#if defined(TCP_ULP) && defined(SOL_TLS) && defined(TLS_TX)
+    // Attach the TLS ULP, which requires the tls module of kernel, see https://docs.kernel.org/networking/tls.html
+    int fd = srs_netfd_fileno(stfd_);
+    if (::setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) < 0) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "setsockopt TCP_ULP fd=%d", fd);
+    }
+
+    // Setup the key for TX, then kernel encrypts the data of write, writev and sendfile.
+    if (::setsockopt(fd, SOL_TLS, TLS_TX, crypto_info, size) < 0) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "setsockopt TLS_TX fd=%d, size=%d", fd, size);
+    }
+#else
+    return srs_error_new(ERROR_HTTPS_KTLS, "kTLS not supported");
+#endif
+
+    return err;
+}
+
+srs_error_t SrsStSocket::enable_zerocopy()
+{
+    srs_error_t err = srs_success;
+
+    srs_assert(stfd_);
+
+#ifdef __linux__
+    // Requires linux 4.14+, see https://docs.kernel.org/networking/msg_zerocopy.html
+    int fd = srs_netfd_fileno(stfd_);
+    int one = 1;
+    if (::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &one, sizeof(one)) < 0) {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "setsockopt SO_ZEROCOPY fd=%d", fd);
+    }
+    zerocopy_ = true;
+#else
+    return srs_error_new(ERROR_SOCKET_ZEROCOPY, "MSG_ZEROCOPY not supported");
+#endif
+
+    return err;
+}
+
+srs_error_t SrsStSocket::writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite)
+{
+    srs_error_t err = srs_success;
+
+    srs_assert(stfd_);
+
+    if (!zerocopy_) {
+        srs_freep(pin);
+        return writev(iov, iov_size, nwrite);
+    }
+
+    // Copy the iovs, which are changed when partially sent.
+    iovec* iovs = new iovec[srs_max(1, iov_size)];
+    SrsAutoFreeA(iovec, iovs);
+
+    size_t size = 0, small_size = 0;
+    for (int i = 0; i < iov_size; i++) {
+        iovs[i] = iov[i];
+        size += iov[i].iov_len;
+        if (iov[i].iov_len < SRS_PERF_ZEROCOPY_COPY_IOV) {
+            small_size += iov[i].iov_len;
+        }
+    }
+
+    // Without pin, the buffers might be changed after return, so we must copy it. And it's more expensive to pin
+    // the pages than copy for small writes.
+    if (!pin || size < SRS_PERF_ZEROCOPY_MIN_BYTES) {
+        srs_freep(pin);
+        err = do_sendmsg(iovs, iov_size, NULL, nwrite);
+        reap_zerocopy();
+        return err;
+    }
+
+    SrsZeroCopyPending pending;
+    pending.first = zerocopy_id_;
+    pending.count = pending.done = 0;
+    pending.sending = true;
+    pending.copied = false;
+    pending.size = 0;
+    pending.pin = pin;
+    pending.small = small_size ? new char[small_size] : NULL;
+
+    // The small iovs, such as chunk headers, are generally in a reused cache, so we keep a copy until sent.
+    char* p = pending.small;
+    for (int i = 0; i < iov_size; i++) {
+        if (iovs[i].iov_len < SRS_PERF_ZEROCOPY_COPY_IOV) {
+            memcpy(p, iovs[i].iov_base, iovs[i].iov_len);
+            iovs[i].iov_base = p;
+            p += iovs[i].iov_len;
+        }
+    }
+
+    // Push the pending before sending, because the notifications might be reaped when waiting for the socket.
+    // Note that the reference of deque is not invalidated by push_back and pop_front of other elements.
+    zerocopy_pendings_.push_back(pending);
+    SrsZeroCopyPending& sending = zerocopy_pendings_.back();
+
+    err = do_sendmsg(iovs, iov_size, &sending, nwrite);
+    sending.sending = false;
+
+    // Free the buffers if nothing sent by MSG_ZEROCOPY, or already completed.
+    reap_zerocopy();
+
+    return err;
+}
+
+srs_error_t SrsStSocket::do_sendmsg(iovec* iov, int iov_size, SrsZeroCopyPending* pending, ssize_t* nwrite)
+{
+    srs_error_t err = srs_success;
+
+    int fd = srs_netfd_fileno(stfd_);
+
+    ssize_t nn = 0;
+    while (iov_size > 0) {
+        if (!iov->iov_len) {
+            iov++; iov_size--;
+            continue;
+        }
+
+        msghdr msg;
+        memset(&msg, 0, sizeof(msghdr));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = iov_size;
+
+        ssize_t r = ::sendmsg(fd, &msg, (pending ? MSG_ZEROCOPY : 0) | MSG_DONTWAIT);
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // Kernel fails to pin the pages when exceeds the optmem limit, so we copy the left data.
+            if (errno == ENOBUFS && pending) {
+                pending = NULL;
+                continue;
+            }
+
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                err = srs_error_new(ERROR_SOCKET_WRITE, "sendmsg");
+                break;
+            }
+
+            // The notifications make the socket POLLERR, so reap them before waiting, or we never wait.
+            reap_zerocopy();
+            if (st_netfd_poll((st_netfd_t)stfd_, POLLOUT, (st_utime_t)stm) < 0) {
+                if (errno == ETIME) {
+                    err = srs_error_new(ERROR_SOCKET_TIMEOUT, "sendmsg timeout %d ms", srsu2msi(stm));
+                } else {
+                    err = srs_error_new(ERROR_SOCKET_WRITE, "poll");
+                }
+                break;
+            }
+            continue;
+        }
+
+        // Each successful sendmsg with MSG_ZEROCOPY has an id, which is notified when completed.
+        if (pending) {
+            zerocopy_id_++;
+            pending->count++;
+            pending->size += r;
+        } else {
+            _srs_pps_zccopied->sugar += r;
+        }
+
+        nn += r;
+        sbytes += r;
+
+        // Skip the sent bytes, which might be part of iov.
+        while (r > 0) {
+            if (r >= (ssize_t)iov->iov_len) {
+                r -= iov->iov_len;
+                iov++; iov_size--;
+            } else {
+                iov->iov_base = (char*)iov->iov_base + r;
+                iov->iov_len -= r;
+                r = 0;
+            }
+        }
+    }
+
+    if (nwrite) {
+        *nwrite = nn;
+    }
+
+    return err;
+}
+
+ssize_t SrsStSocket::read_zerocopy(void* buf, size_t size, bool fully)
+{
+    int fd = srs_netfd_fileno(stfd_);
+
+    size_t nn = 0;
+    while (nn < size) {
+        ssize_t r = ::read(fd, (char*)buf + nn, size - nn);
+        if (r > 0) {
+            nn += r;
+            if (!fully) break;
+            continue;
+        }
+
+        if (r == 0) {
+            break;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            return -1;
+        }
+
+        // The notifications make the socket POLLERR, so reap them before waiting, or we never wait.
+        reap_zerocopy();
+        if (st_netfd_poll((st_netfd_t)stfd_, POLLIN, (st_utime_t)rtm) < 0) {
+            return -1;
+        }
+    }
+
+    return (ssize_t)nn;
+}
+
+void SrsStSocket::reap_zerocopy()
+{
+#ifdef __linux__
+    int fd = srs_netfd_fileno(stfd_);
+
+    for (;;) {
+        char control[128];
+        msghdr msg;
+        memset(&msg, 0, sizeof(msghdr));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        // Never block, because the error queue is empty when EAGAIN.
+        if (::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            break;
+        }
+
+        for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            bool recverr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+                || (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+            if (!recverr) {
+                continue;
+            }
+
+            sock_extended_err* serr = (sock_extended_err*)CMSG_DATA(cm);
+            if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+
+            // The range of ids [ee_info, ee_data] are completed.
+            on_zerocopy_done(serr->ee_info, serr->ee_data, (serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+        }
+    }
+#endif
+
+    // Free the completed buffers in order.
+    while (!zerocopy_pendings_.empty()) {
+        SrsZeroCopyPending& pending = zerocopy_pendings_.front();
+        if (pending.sending || pending.done < pending.count) {
+            break;
+        }
+
+        free_zerocopy(pending);
+        zerocopy_pendings_.pop_front();
+    }
+}
+
+void SrsStSocket::on_zerocopy_done(uint32_t lo, uint32_t hi, bool copied)
+{
+    for (std::deque<SrsZeroCopyPending>::iterator it = zerocopy_pendings_.begin(); it != zerocopy_pendings_.end(); ++it) {
+        SrsZeroCopyPending& pending = *it;
+        if (!pending.count) {
+            continue;
+        }
+
+        // The overlap of [first, last] and [lo, hi], in serial number arithmetic because the id wraps around.
+        uint32_t last = pending.first + pending.count - 1;
+        uint32_t start = (int32_t)(pending.first - lo) > 0 ? pending.first : lo;
+        uint32_t end = (int32_t)(last - hi) < 0 ? last : hi;
+        if ((int32_t)(end - start) < 0) {
+            continue;
+        }
+
+        pending.done += end - start + 1;
+        // Kernel copies the data for some devices, for example, the loopback.
+        if (copied) {
+            pending.copied = true;
+        }
+    }
+}
+
+void SrsStSocket::free_zerocopy(SrsZeroCopyPending& pending)
+{
+    if (pending.copied) {
+        _srs_pps_zccopied->sugar += pending.size;
+    } else {
+        _srs_pps_zcbytes->sugar += pending.size;
+    }
+
+    srs_freep(pending.pin);
+    srs_freepa(pending.small);
+}
+
+SrsZeroCopyReaper* _srs_zerocopy_reaper = NULL;
+
+SrsZeroCopyReaper::SrsZeroCopyReaper()
+{
+}
+
+SrsZeroCopyReaper::~SrsZeroCopyReaper()
+{
+    for (int i = 0; i < (int)sockets_.size(); i++) {
+        dispose(sockets_[i]);
+    }
+}
+
+bool SrsZeroCopyReaper::adopt(SrsStSocket* skt)
+{
+    int fd = ::dup(srs_netfd_fileno(skt->stfd_));
+    if (fd < 0) {
+        srs_warn("zerocopy: ignore dup fd=%d, pendings=%d", srs_netfd_fileno(skt->stfd_), (int)skt->zerocopy_pendings_.size());
+        return false;
+    }
+
+    srs_netfd_t stfd = srs_netfd_open_socket(fd);
+    if (!stfd) {
+        ::close(fd);
+        srs_warn("zerocopy: ignore open fd=%d, pendings=%d", fd, (int)skt->zerocopy_pendings_.size());
+        return false;
+    }
+
+    // The dup keeps the socket open, so we shutdown it to notify peer when owner closes the fd. Kernel still
+    // sends the left data, and notifies the completions by the error queue.
+    ::shutdown(fd, SHUT_RDWR);
+
+    SrsStSocket* orphan = new SrsStSocket(stfd);
+    orphan->zerocopy_ = true;
+    orphan->zerocopy_id_ = skt->zerocopy_id_;
+    orphan->zerocopy_pendings_.swap(skt->zerocopy_pendings_);
+
+    sockets_.push_back(orphan);
+    deadlines_.push_back(srs_get_system_time() + SRS_PERF_ZEROCOPY_REAP_TIMEOUT);
+
+    return true;
+}
+
+void SrsZeroCopyReaper::reap()
+{
+    srs_utime_t now = srs_get_system_time();
+
+    for (int i = (int)sockets_.size() - 1; i >= 0; i--) {
+        SrsStSocket* skt = sockets_[i];
+
+        skt->reap_zerocopy();
+        if (!skt->zerocopy_pendings_.empty() && now < deadlines_[i]) {
+            continue;
+        }
+
+        if (!skt->zerocopy_pendings_.empty()) {
+            srs_warn("zerocopy: free fd=%d, pendings=%d, timeout=%dms", srs_netfd_fileno(skt->stfd_),
+                (int)skt->zerocopy_pendings_.size(), srsu2msi(SRS_PERF_ZEROCOPY_REAP_TIMEOUT));
+        }
+
+        dispose(skt);
+        sockets_.erase(sockets_.begin() + i);
+        deadlines_.erase(deadlines_.begin() + i);
+    }
+}
+
+int SrsZeroCopyReaper::size()
+{
+    return (int)sockets_.size();
+}
+
+void SrsZeroCopyReaper::dispose(SrsStSocket* skt)
+{
+    // Kernel holds the pages until sent, so it's safe to free the buffers, although the data might be changed.
+    while (!skt->zerocopy_pendings_.empty()) {
+        skt->free_zerocopy(skt->zerocopy_pendings_.front());
+        skt->zerocopy_pendings_.pop_front();
+    }
+
+    srs_netfd_t stfd = skt->stfd_;
+    srs_freep(skt);
+    srs_close_stfd(stfd);
+}
+
 SrsTcpClient::SrsTcpClient(string h, int p, srs_utime_t tm)
 {
     stfd_ = NULL;
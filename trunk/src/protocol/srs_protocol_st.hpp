@@ -10,6 +10,8 @@
 #include <srs_core.hpp>
 
 #include <string>
+#include <deque>
+#include <vector>
 
 #include <srs_protocol_io.hpp>
 #include <srs_kernel_error.hpp>
@@ -92,6 +94,20 @@ extern int srs_sendto(srs_netfd_t stfd, void *buf, int len, const struct sockadd
 extern int srs_recvmsg(srs_netfd_t stfd, struct msghdr *msg, int flags, srs_utime_t timeout);
 extern int srs_sendmsg(srs_netfd_t stfd, const struct msghdr *msg, int flags, srs_utime_t timeout);
 
+#ifdef __linux__
+// Receive multiple UDP messages by one syscall, see https://man7.org/linux/man-pages/man2/recvmmsg.2.html
+// @return The number of messages received, or -1 for error.
+extern int srs_recvmmsg(srs_netfd_t stfd, struct mmsghdr* msgvec, unsigned int vlen, int flags, srs_utime_t timeout);
+// Send multiple UDP messages by one syscall, see https://man7.org/linux/man-pages/man2/sendmmsg.2.html
+// @return The number of messages sent, which might be less than vlen, or -1 for error.
+extern int srs_sendmmsg(srs_netfd_t stfd, struct mmsghdr* msgvec, unsigned int vlen, int flags, srs_utime_t timeout);
+#endif
+
+// Send the file to socket, by sendfile on linux, see https://man7.org/linux/man-pages/man2/sendfile.2.html
+// Otherwise, by read and write with a small buffer.
+// @return The number of bytes sent, which might be less than count, or -1 for error.
+extern ssize_t srs_sendfile(srs_netfd_t stfd, int in_fd, off_t* offset, size_t count, srs_utime_t timeout);
+
 extern srs_netfd_t srs_accept(srs_netfd_t stfd, struct sockaddr *addr, int *addrlen, srs_utime_t timeout);
 
 extern ssize_t srs_read(srs_netfd_t stfd, void *buf, size_t nbyte, srs_utime_t timeout);
@@ -118,10 +134,30 @@ public:
     }
 };
 
+// The writev by MSG_ZEROCOPY, which keeps the buffers until kernel completes the sending.
+struct SrsZeroCopyPending
+{
+    // The id of the first sendmsg, and the number of sendmsg, because the iovs might be sent by multiple sendmsg.
+    uint32_t first;
+    uint32_t count;
+    // The number of sendmsg completed by kernel.
+    uint32_t done;
+    // Whether still sending, that is, the last id is not determined.
+    bool sending;
+    // Whether kernel copied the data, for example, the loopback device.
+    bool copied;
+    // The bytes sent by MSG_ZEROCOPY.
+    int64_t size;
+    // The buffers of user, and the copy of small iovs.
+    ISrsZeroCopyPin* pin;
+    char* small;
+};
+
 // the socket provides TCP socket over st,
 // that is, the sync socket mechanism.
-class SrsStSocket : public ISrsProtocolReadWriter
+class SrsStSocket : public ISrsProtocolReadWriter, public ISrsProtocolFileWriter
 {
+    friend class SrsZeroCopyReaper;
 private:
     // The recv/send timeout in srs_utime_t.
     // @remark Use SRS_UTIME_NO_TIMEOUT for never timeout.
@@ -132,6 +168,12 @@ private:
     int64_t sbytes;
     // The underlayer st fd.
     srs_netfd_t stfd_;
+private:
+    // Whether enabled MSG_ZEROCOPY, and the id of next sendmsg.
+    bool zerocopy_;
+    uint32_t zerocopy_id_;
+    // The writev which waits for the notification of kernel.
+    std::deque<SrsZeroCopyPending> zerocopy_pendings_;
 public:
     SrsStSocket();
     SrsStSocket(srs_netfd_t fd);
@@ -152,8 +194,51 @@ public:
     // @param nwrite, the actual write bytes, ignore if NULL.
     virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
     virtual srs_error_t writev(const iovec *iov, int iov_size, ssize_t* nwrite);
+// Interface ISrsProtocolFileWriter
+public:
+    virtual bool sendfile_supported();
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite);
+    virtual srs_error_t enable_ktls(const void* crypto_info, int size);
+    virtual srs_error_t enable_zerocopy();
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite);
+private:
+    // Send all iovs by sendmsg, with MSG_ZEROCOPY if pending is not NULL, and fallback to copy if kernel is out
+    // of memory to pin the pages.
+    srs_error_t do_sendmsg(iovec* iov, int iov_size, SrsZeroCopyPending* pending, ssize_t* nwrite);
+    // Read by recv directly, to reap the notifications when waiting for the socket.
+    ssize_t read_zerocopy(void* buf, size_t size, bool fully);
+    // Read the notifications from the error queue of socket, and free the completed buffers. Note that the error
+    // queue makes the socket readable with POLLERR, so we must reap it before waiting for the socket.
+    void reap_zerocopy();
+    void on_zerocopy_done(uint32_t lo, uint32_t hi, bool copied);
+    void free_zerocopy(SrsZeroCopyPending& pending);
 };
 
+// The reaper of MSG_ZEROCOPY for the closed sockets. Kernel might still send the pinned buffers after the owner
+// closes the fd, so the reaper keeps the pendings over a dup of fd, until the completions are reaped.
+class SrsZeroCopyReaper
+{
+private:
+    // The sockets over the dup of fd, and the time to free the pendings even not completed.
+    std::vector<SrsStSocket*> sockets_;
+    std::vector<srs_utime_t> deadlines_;
+public:
+    SrsZeroCopyReaper();
+    virtual ~SrsZeroCopyReaper();
+public:
+    // Take the pendings of socket, which is about to be closed by owner.
+    // @return Whether adopted, or the socket should free the pendings itself.
+    bool adopt(SrsStSocket* skt);
+    // Reap the completions, and free the sockets which are completed or timeout.
+    void reap();
+    // The number of sockets which wait for completions.
+    int size();
+private:
+    void dispose(SrsStSocket* skt);
+};
+
+extern SrsZeroCopyReaper* _srs_zerocopy_reaper;
+
 // The client to connect to server over TCP.
 // User must never reuse the client when close it.
 // Usage:
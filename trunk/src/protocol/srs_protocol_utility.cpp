@@ -395,6 +395,75 @@ srs_error_t srs_write_large_iovs(ISrsProtocolReadWriter* skt, iovec* iovs, int s
     return err;
 }
 
+srs_error_t srs_write_large_iovs_zerocopy(ISrsProtocolReadWriter* skt, iovec* iovs, int size, ISrsZeroCopyPin* pin, ssize_t* pnwrite)
+{
+    srs_error_t err = srs_success;
+
+    ISrsProtocolFileWriter* fw = dynamic_cast<ISrsProtocolFileWriter*>(skt);
+    if (!fw) {
+        srs_freep(pin);
+        return srs_write_large_iovs(skt, iovs, size, pnwrite);
+    }
+
+    // the limits of writev iovs.
+#ifndef _WIN32
+    static int limits = (int)sysconf(_SC_IOV_MAX);
+#else
+    static int limits = 1024;
+#endif
+
+    if (pnwrite) {
+        *pnwrite = 0;
+    }
+
+    // send in multiple times.
+    int cur_iov = 0;
+    while (cur_iov < size) {
+        int cur_count = srs_min(limits, size - cur_iov);
+
+        // The socket frees the pins in order, so the buffers are kept by the pin of last part, and we use an empty
+        // pin for other parts.
+        ISrsZeroCopyPin* cur_pin = (cur_iov + cur_count < size) ? new ISrsZeroCopyPin() : pin;
+
+        ssize_t nwrite = 0;
+        if ((err = fw->writev_zerocopy(iovs + cur_iov, cur_count, cur_pin, &nwrite)) != srs_success) {
+            if (cur_pin != pin) {
+                srs_freep(pin);
+            }
+            return srs_error_wrap(err, "writev");
+        }
+
+        cur_iov += cur_count;
+        if (pnwrite) {
+            *pnwrite += nwrite;
+        }
+    }
+
+    // Free the pin if no iovs.
+    if (!size) {
+        srs_freep(pin);
+    }
+
+    return err;
+}
+
+SrsSharedPtrPin::SrsSharedPtrPin(SrsSharedPtrMessage** msgs, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (msgs[i]) {
+            msgs_.push_back(msgs[i]->copy());
+        }
+    }
+}
+
+SrsSharedPtrPin::~SrsSharedPtrPin()
+{
+    for (int i = 0; i < (int)msgs_.size(); i++) {
+        SrsSharedPtrMessage* msg = msgs_.at(i);
+        srs_freep(msg);
+    }
+}
+
 bool srs_is_ipv4(string domain)
 {
     for (int i = 0; i < (int)domain.length(); i++) {
@@ -111,6 +111,19 @@ extern std::string srs_generate_rtmp_url(std::string server, int port, std::stri
 
 // write large numbers of iovs.
 extern srs_error_t srs_write_large_iovs(ISrsProtocolReadWriter* skt, iovec* iovs, int size, ssize_t* pnwrite = NULL);
+// Write large numbers of iovs by MSG_ZEROCOPY, or by copy if skt is not a ISrsProtocolFileWriter.
+// @param pin The pin of buffers, which is freed by socket when sent.
+extern srs_error_t srs_write_large_iovs_zerocopy(ISrsProtocolReadWriter* skt, iovec* iovs, int size, ISrsZeroCopyPin* pin, ssize_t* pnwrite = NULL);
+
+// The pin of shared ptr messages, which keeps the payloads until sent by MSG_ZEROCOPY.
+class SrsSharedPtrPin : public ISrsZeroCopyPin
+{
+private:
+    std::vector<SrsSharedPtrMessage*> msgs_;
+public:
+    SrsSharedPtrPin(SrsSharedPtrMessage** msgs, int count);
+    virtual ~SrsSharedPtrPin();
+};
 
 // join string in vector with indicated separator
 template <typename T>
@@ -7,14 +7,35 @@
 
 using namespace std;
 
+#include <sched.h>
+#include <openssl/evp.h>
+
 #include <srs_kernel_error.hpp>
 #include <srs_app_fragment.hpp>
+#include <srs_app_hls.hpp>
+#include <srs_app_http_static.hpp>
 #include <srs_app_security.hpp>
 #include <srs_app_config.hpp>
+#include <srs_app_log.hpp>
 
 #include <srs_app_st.hpp>
 #include <srs_protocol_conn.hpp>
 #include <srs_app_conn.hpp>
+#include <srs_app_threads.hpp>
+#include <srs_app_rtc_dtls.hpp>
+#include <srs_kernel_rtc_rtp.hpp>
+#include <srs_kernel_buffer.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_core_autofree.hpp>
+#include <srs_app_http_stream.hpp>
+#include <srs_utest_kernel.hpp>
+#include <srs_kernel_ts.hpp>
+#include <srs_kernel_flv.hpp>
+#include <srs_protocol_rtmp_stack.hpp>
+#include <srs_app_hourglass.hpp>
+#include <srs_app_source.hpp>
+#include <srs_protocol_rtmp_msg_array.hpp>
+#include <srs_kernel_kbps.hpp>
 
 class MockIDResource : public ISrsResource
 {
@@ -512,6 +533,117 @@ VOID TEST(AppFragmentTest, CheckDuration)
 	}
 }
 
+VOID TEST(AppFragmentTest, HlsMemorySegment)
+{
+    srs_error_t err;
+
+    // The writer appends to the buffer shared by segment.
+    SrsHlsMemoryWriter writer;
+    HELPER_EXPECT_SUCCESS(writer.open("/hls/memory/live/livestream-0.ts.tmp"));
+    EXPECT_TRUE(writer.is_open());
+
+    SrsHlsSegment* segment = new SrsHlsSegment(NULL, SrsAudioCodecIdAAC, SrsVideoCodecIdAVC, &writer);
+    segment->set_path("/hls/memory/live/livestream-0.ts");
+    segment->buffer = writer.buffer()->copy();
+
+    HELPER_EXPECT_SUCCESS(writer.write((void*)"Hello", 5, NULL));
+    iovec iovs[2];
+    iovs[0].iov_base = (char*)", ";
+    iovs[0].iov_len = 2;
+    iovs[1].iov_base = (char*)"HLS";
+    iovs[1].iov_len = 3;
+    HELPER_EXPECT_SUCCESS(writer.writev(iovs, 2, NULL));
+    EXPECT_EQ(10, writer.tellg());
+    writer.close();
+    EXPECT_EQ(10, segment->buffer->length());
+
+    // Publish the segment, no file on disk.
+    HELPER_EXPECT_SUCCESS(segment->rename());
+    EXPECT_TRUE(_srs_hls_memory->exists("/hls/memory/live/livestream-0.ts"));
+    EXPECT_TRUE(srs_hls_memory_path_exists("/hls/memory/live/livestream-0.ts"));
+    EXPECT_FALSE(srs_path_exists("/hls/memory/live/livestream-0.ts"));
+
+    // The reader holds the bytes, even the segment is expired.
+    SrsHlsMemoryReader reader;
+    HELPER_EXPECT_SUCCESS(reader.open("/hls/memory/live/livestream-0.ts"));
+    EXPECT_EQ(10, reader.filesize());
+
+    srs_freep(segment);
+    EXPECT_FALSE(_srs_hls_memory->exists("/hls/memory/live/livestream-0.ts"));
+
+    char buf[16];
+    ssize_t nread = 0;
+    HELPER_EXPECT_SUCCESS(reader.read(buf, 7, &nread));
+    EXPECT_EQ(7, nread);
+    HELPER_EXPECT_SUCCESS(reader.read(buf + 7, 7, &nread));
+    EXPECT_EQ(3, nread);
+    EXPECT_EQ(0, memcmp(buf, "Hello, HLS", 10));
+    HELPER_EXPECT_FAILED(reader.read(buf, 7, &nread));
+    reader.close();
+
+    // Never remove the file replaced by others.
+    if (true) {
+        SrsHlsMemoryBuffer b0, b1;
+        _srs_hls_memory->set("/hls/memory/live/livestream.m3u8", &b0);
+        _srs_hls_memory->set("/hls/memory/live/livestream.m3u8", &b1);
+        _srs_hls_memory->remove("/hls/memory/live/livestream.m3u8", &b0);
+        EXPECT_TRUE(_srs_hls_memory->exists("/hls/memory/live/livestream.m3u8"));
+        _srs_hls_memory->remove("/hls/memory/live/livestream.m3u8");
+        EXPECT_FALSE(_srs_hls_memory->exists("/hls/memory/live/livestream.m3u8"));
+    }
+}
+
+VOID TEST(AppFragmentTest, HlsBlockingReload)
+{
+    srs_error_t err;
+
+    EXPECT_STREQ("live/livestream-5.0.ts", SrsHlsSegment::part_name("live/livestream-5.ts", 0).c_str());
+    EXPECT_STREQ("live/livestream-5.3.ts?v=1", SrsHlsSegment::part_name("live/livestream-5.ts?v=1", 3).c_str());
+
+    // Ignore the playlist which is not LL-HLS.
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 100, 0));
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_hint("/hls/ll/live/livestream-5.1.ts"));
+
+    // Writing segment 5 with part 0, and the hint is part 1.
+    SrsHlsMemoryBuffer buffer;
+    _srs_hls_memory->update_playlist("/hls/ll/live/livestream.m3u8", &buffer, 5, 0,
+        "/hls/ll/live/livestream-5.1.ts", 10 * SRS_UTIME_MILLISECONDS);
+
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 4, -1));
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 4, 8));
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 5, 0));
+
+    // The segment 5 is not completed, or the part is not ready.
+    err = _srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 5, -1);
+    EXPECT_EQ(ERROR_HLS_BLOCKING_TIMEOUT, srs_error_code(err));
+    srs_freep(err);
+
+    err = _srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 5, 1);
+    EXPECT_EQ(ERROR_HLS_BLOCKING_TIMEOUT, srs_error_code(err));
+    srs_freep(err);
+
+    err = _srs_hls_memory->wait_hint("/hls/ll/live/livestream-5.1.ts");
+    EXPECT_EQ(ERROR_HLS_BLOCKING_TIMEOUT, srs_error_code(err));
+    srs_freep(err);
+
+    // Reject the request for future segments.
+    err = _srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 8, 0);
+    EXPECT_EQ(ERROR_HLS_BLOCKING_INVALID, srs_error_code(err));
+    srs_freep(err);
+
+    // The part 1 is ready.
+    _srs_hls_memory->set("/hls/ll/live/livestream-5.1.ts", &buffer);
+    _srs_hls_memory->update_playlist("/hls/ll/live/livestream.m3u8", &buffer, 5, 1,
+        "/hls/ll/live/livestream-5.2.ts", 10 * SRS_UTIME_MILLISECONDS);
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_hint("/hls/ll/live/livestream-5.1.ts"));
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_playlist("/hls/ll/live/livestream.m3u8", 5, 1));
+
+    _srs_hls_memory->remove("/hls/ll/live/livestream-5.1.ts");
+    _srs_hls_memory->remove_playlist("/hls/ll/live/livestream.m3u8");
+    EXPECT_FALSE(_srs_hls_memory->exists("/hls/ll/live/livestream.m3u8"));
+    HELPER_EXPECT_SUCCESS(_srs_hls_memory->wait_hint("/hls/ll/live/livestream-5.2.ts"));
+}
+
 VOID TEST(AppSecurity, CheckSecurity)
 {
     srs_error_t err;
@@ -783,3 +915,1372 @@ VOID TEST(AppSecurity, CheckSecurity)
     //       4. deny if matches deny strategy.
 }
 
+void* mock_spsc_producer(void* arg)
+{
+    SrsThreadSpscQueue<int>* queue = (SrsThreadSpscQueue<int>*)arg;
+    for (int i = 0; i < 10000;) {
+        if (queue->push(i)) {
+            i++;
+        } else {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+VOID TEST(AppThreadsTest, SpscQueue)
+{
+    // The capacity is rounded up to power of 2.
+    if (true) {
+        SrsThreadSpscQueue<int> queue(3);
+        EXPECT_TRUE(queue.push(1));
+        EXPECT_TRUE(queue.push(2));
+        EXPECT_TRUE(queue.push(3));
+        EXPECT_TRUE(queue.push(4));
+        EXPECT_FALSE(queue.push(5));
+
+        int v = 0;
+        EXPECT_TRUE(queue.pop(&v)); EXPECT_EQ(1, v);
+        EXPECT_TRUE(queue.push(5));
+        EXPECT_TRUE(queue.pop(&v)); EXPECT_EQ(2, v);
+        EXPECT_TRUE(queue.pop(&v)); EXPECT_EQ(3, v);
+        EXPECT_TRUE(queue.pop(&v)); EXPECT_EQ(4, v);
+        EXPECT_TRUE(queue.pop(&v)); EXPECT_EQ(5, v);
+        EXPECT_FALSE(queue.pop(&v));
+    }
+
+    // The items are in order, when producer is another thread.
+    if (true) {
+        SrsThreadSpscQueue<int> queue(64);
+
+        pthread_t trd;
+        ASSERT_EQ(0, pthread_create(&trd, NULL, mock_spsc_producer, &queue));
+
+        int expect = 0;
+        while (expect < 10000) {
+            int v = -1;
+            if (queue.pop(&v)) {
+                ASSERT_EQ(expect, v);
+                expect++;
+            } else {
+                sched_yield();
+            }
+        }
+        pthread_join(trd, NULL);
+
+        int v = 0;
+        EXPECT_FALSE(queue.pop(&v));
+    }
+}
+
+VOID TEST(AppThreadsTest, AsyncSRTPInPlace)
+{
+    srs_error_t err;
+
+    // Ignore the error, because it might be initialized.
+    srtp_init();
+
+    // The keys are swapped, for the sender and receiver.
+    string k0 = string(30, 'a'), k1 = string(30, 'b');
+    SrsSRTP sender, receiver;
+    HELPER_ASSERT_SUCCESS(sender.initialize(k0, k1, SrsSrtpProfileAes128CmSha1_80));
+    HELPER_ASSERT_SUCCESS(receiver.initialize(k1, k0, SrsSrtpProfileAes128CmSha1_80));
+
+    // Protect the packets in place, when there is no crypto worker.
+    SrsAsyncSRTPManager manager;
+    EXPECT_FALSE(manager.enabled());
+
+    char bufs[4][1500];
+    iovec iovs[4];
+    for (int i = 0; i < 4; i++) {
+        SrsRtpPacket pkt;
+        pkt.header.set_ssrc(100);
+        pkt.header.set_sequence(i);
+        pkt.header.set_payload_type(96);
+
+        SrsRtpRawPayload* raw = new SrsRtpRawPayload();
+        raw->payload = (char*)"Hello";
+        raw->nn_payload = 5;
+        pkt.set_payload(raw, SrsRtspPacketPayloadTypeRaw);
+
+        SrsBuffer b(bufs[i], sizeof(bufs[i]));
+        HELPER_ASSERT_SUCCESS(pkt.encode(&b));
+        iovs[i].iov_base = bufs[i];
+        iovs[i].iov_len = b.pos();
+    }
+
+    HELPER_ASSERT_SUCCESS(manager.protect_rtps(&sender, iovs, 4));
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(kRtpHeaderFixedSize + 5 + 10, (int)iovs[i].iov_len);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        int nn = (int)iovs[i].iov_len;
+        HELPER_ASSERT_SUCCESS(receiver.unprotect_rtp(bufs[i], &nn));
+        EXPECT_EQ(kRtpHeaderFixedSize + 5, nn);
+        EXPECT_EQ(0, memcmp(bufs[i] + kRtpHeaderFixedSize, "Hello", 5));
+    }
+
+    // Fail if unprotect again, because of replay.
+    int nn = kRtpHeaderFixedSize + 5 + 10;
+    HELPER_EXPECT_FAILED(receiver.unprotect_rtp(bufs[0], &nn));
+}
+
+class MockDtlsCallback : public ISrsDtlsCallback
+{
+public:
+    // The flights to peer, each is a UDP packet.
+    std::vector<std::string> flights;
+    bool done;
+public:
+    MockDtlsCallback() {
+        done = false;
+    }
+    virtual ~MockDtlsCallback() {
+    }
+public:
+    virtual srs_error_t on_dtls_handshake_done() {
+        done = true;
+        return srs_success;
+    }
+    virtual srs_error_t on_dtls_application_data(const char* /*data*/, const int /*len*/) {
+        return srs_success;
+    }
+    virtual srs_error_t write_dtls_data(void* data, int size) {
+        flights.push_back(string((char*)data, size));
+        return srs_success;
+    }
+    virtual srs_error_t on_dtls_alert(std::string /*type*/, std::string /*desc*/) {
+        return srs_success;
+    }
+};
+
+// Defined in DTLS.
+extern SSL_CTX* srs_build_dtls_ctx(SrsDtlsVersion version, std::string role);
+
+// The DTLS client, like the browser, by SSL over memory BIO.
+class MockDtlsClient
+{
+public:
+    SSL_CTX* ctx;
+    SSL* ssl;
+public:
+    MockDtlsClient() {
+        ctx = srs_build_dtls_ctx(SrsDtlsVersion1_2, "active");
+        ssl = SSL_new(ctx);
+        SSL_set_bio(ssl, BIO_new(BIO_s_mem()), BIO_new(BIO_s_mem()));
+        SSL_set_mtu(ssl, 1200);
+        SSL_set_connect_state(ssl);
+    }
+    virtual ~MockDtlsClient() {
+        SSL_free(ssl);
+        SSL_CTX_free(ctx);
+    }
+public:
+    // Feed the flights from server and return the flight to server, as a packet.
+    string handshake(std::vector<std::string>& flights) {
+        BIO* out = SSL_get_wbio(ssl);
+        BIO_reset(out);
+
+        if (flights.empty()) {
+            SSL_do_handshake(ssl);
+        }
+        for (int i = 0; i < (int)flights.size(); i++) {
+            BIO_write(SSL_get_rbio(ssl), flights[i].data(), (int)flights[i].size());
+            SSL_do_handshake(ssl);
+        }
+        flights.clear();
+
+        char* data = NULL;
+        int size = (int)BIO_get_mem_data(out, &data);
+        return string(data, size);
+    }
+};
+
+void* mock_async_dtls_worker(void* arg)
+{
+    srs_error_t err = SrsAsyncWorker<SrsAsyncDtlsTask>::start(arg);
+    srs_freep(err);
+    return NULL;
+}
+
+// Wait for the handshake task of DTLS to be done by worker.
+void mock_async_dtls_wait(SrsDtlsImpl* dtls)
+{
+    for (int i = 0; i < 3000 && dtls->task_; i++) {
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+    }
+}
+
+VOID TEST(AppThreadsTest, AsyncDtlsHandshake)
+{
+    srs_error_t err;
+
+    // Create a DTLS worker for the manager, which is started later, and joined by the entry.
+    SrsThreadEntry entry;
+    SrsAsyncDtlsManager manager;
+    ASSERT_EQ(0, ::pipe(manager.dones_));
+
+    SrsAsyncWorker<SrsAsyncDtlsTask>* worker = new SrsAsyncWorker<SrsAsyncDtlsTask>(manager.dones_[1], true);
+    HELPER_ASSERT_SUCCESS(worker->initialize(1));
+    manager.workers_.push_back(worker);
+
+    HELPER_ASSERT_SUCCESS(manager.start());
+    EXPECT_TRUE(manager.enabled());
+
+    SrsAsyncDtlsManager* old = _srs_async_dtls;
+    _srs_async_dtls = &manager;
+
+    MockDtlsCallback cb, cb2;
+    SrsDtlsServerImpl server(&cb);
+    SrsDtlsServerImpl* server2 = new SrsDtlsServerImpl(&cb2);
+    HELPER_ASSERT_SUCCESS(server.initialize("dtls1.2", "passive"));
+    HELPER_ASSERT_SUCCESS(server2->initialize("dtls1.2", "passive"));
+
+    MockDtlsClient client, client2;
+    std::vector<std::string> nothing;
+    string hello = client.handshake(nothing);
+    string hello2 = client2.handshake(nothing);
+    ASSERT_FALSE(hello.empty());
+
+    // The ClientHello is posted to worker, and the retransmitted one is queued.
+    HELPER_EXPECT_SUCCESS(server.on_dtls((char*)hello.data(), (int)hello.size()));
+    EXPECT_TRUE(server.task_ != NULL);
+    HELPER_EXPECT_SUCCESS(server.on_dtls((char*)hello.data(), (int)hello.size()));
+    EXPECT_EQ(1, (int)server.pendings_.size());
+
+    // Drop the packet of other session, because the worker is busy.
+    HELPER_EXPECT_SUCCESS(server2->on_dtls((char*)hello2.data(), (int)hello2.size()));
+    EXPECT_TRUE(server2->task_ == NULL);
+    EXPECT_TRUE(cb2.flights.empty());
+
+    ASSERT_EQ(0, pthread_create(&entry.trd, NULL, mock_async_dtls_worker, worker));
+    worker->trd_ = &entry;
+
+    // The handshake is done by worker, while the flights are sent by hybrid thread.
+    for (int i = 0; i < 8 && !SSL_is_init_finished(client.ssl); i++) {
+        mock_async_dtls_wait(&server);
+        ASSERT_TRUE(server.task_ == NULL);
+        ASSERT_FALSE(cb.flights.empty());
+
+        string flight = client.handshake(cb.flights);
+        if (!flight.empty()) {
+            HELPER_ASSERT_SUCCESS(server.on_dtls((char*)flight.data(), (int)flight.size()));
+        }
+    }
+    EXPECT_EQ(1, SSL_is_init_finished(client.ssl));
+    EXPECT_TRUE(cb.done);
+    EXPECT_TRUE(server.handshake_done_for_us);
+    EXPECT_TRUE(server.pendings_.empty());
+
+    // The SRTP keys of server are the same as client.
+    if (true) {
+        string recv_key, send_key;
+        SrsSrtpProfile profile;
+        HELPER_EXPECT_SUCCESS(server.get_srtp_key(recv_key, send_key, &profile));
+
+        unsigned char material[(SRTP_AES_256_KEY_LEN + SRTP_SALT_LEN) * 2] = {0};
+        int nn_material = (SRTP_AES_128_KEY_LEN + SRTP_SALT_LEN) * 2;
+        string label = "EXTRACTOR-dtls_srtp";
+        ASSERT_EQ(1, SSL_export_keying_material(client.ssl, material, nn_material, label.data(), label.size(), NULL, 0, 0));
+        EXPECT_EQ(string((char*)material, SRTP_AES_128_KEY_LEN), recv_key.substr(0, SRTP_AES_128_KEY_LEN));
+    }
+
+    // Free the DTLS when the task is in worker, the SSL is freed by task.
+    HELPER_EXPECT_SUCCESS(server2->on_dtls((char*)hello2.data(), (int)hello2.size()));
+    EXPECT_TRUE(server2->task_ != NULL);
+    srs_freep(server2);
+    for (int i = 0; i < 3000 && worker->inflight_; i++) {
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+    }
+    EXPECT_EQ(0, worker->inflight_);
+    EXPECT_TRUE(cb2.flights.empty());
+
+    _srs_async_dtls = old;
+
+    // Stop the worker thread, by closing the wakeup pipe and join it.
+    worker->stop();
+    EXPECT_TRUE(worker->trd_ == NULL);
+}
+
+extern SrsPps* _srs_pps_adtls_drop;
+
+VOID TEST(AppThreadsTest, AsyncDtlsWithoutCollector)
+{
+    srs_error_t err;
+
+    SrsThreadEntry entry;
+    SrsAsyncDtlsManager manager;
+    ASSERT_EQ(0, ::pipe(manager.dones_));
+
+    SrsAsyncWorker<SrsAsyncDtlsTask>* worker = new SrsAsyncWorker<SrsAsyncDtlsTask>(manager.dones_[1], true);
+    HELPER_ASSERT_SUCCESS(worker->initialize(1));
+    manager.workers_.push_back(worker);
+    HELPER_ASSERT_SUCCESS(manager.start());
+
+    // Stop the collector as if it fails, while the workers are still enabled.
+    manager.trd_->stop();
+    EXPECT_TRUE(manager.enabled());
+
+    SrsAsyncDtlsManager* old = _srs_async_dtls;
+    _srs_async_dtls = &manager;
+
+    MockDtlsCallback cb;
+    SrsDtlsServerImpl* server = new SrsDtlsServerImpl(&cb);
+    HELPER_ASSERT_SUCCESS(server->initialize("dtls1.2", "passive"));
+
+    MockDtlsClient client;
+    std::vector<std::string> nothing;
+    string hello = client.handshake(nothing);
+    ASSERT_FALSE(hello.empty());
+
+    // Drop and count the packets more than the max pendings, when the task is in worker.
+    int64_t dropped = _srs_pps_adtls_drop->sugar;
+    HELPER_EXPECT_SUCCESS(server->on_dtls((char*)hello.data(), (int)hello.size()));
+    EXPECT_TRUE(server->task_ != NULL);
+    for (int i = 0; i < 17; i++) {
+        HELPER_EXPECT_SUCCESS(server->on_dtls((char*)hello.data(), (int)hello.size()));
+    }
+    EXPECT_EQ(16, (int)server->pendings_.size());
+    EXPECT_EQ(1, _srs_pps_adtls_drop->sugar - dropped);
+
+    ASSERT_EQ(0, pthread_create(&entry.trd, NULL, mock_async_dtls_worker, worker));
+    worker->trd_ = &entry;
+
+    // The done task is collected by the retransmitted packet, and the flight is sent.
+    for (int i = 0; i < 3000 && cb.flights.empty(); i++) {
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        HELPER_EXPECT_SUCCESS(server->on_dtls((char*)hello.data(), (int)hello.size()));
+    }
+    EXPECT_FALSE(cb.flights.empty());
+
+    // Free the DTLS, and collect the left tasks.
+    srs_freep(server);
+    for (int i = 0; i < 3000 && worker->inflight_; i++) {
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        manager.collect();
+    }
+    EXPECT_EQ(0, worker->inflight_);
+
+    _srs_async_dtls = old;
+    worker->stop();
+}
+
+void* mock_async_srtp_worker(void* arg)
+{
+    srs_error_t err = SrsAsyncWorker<SrsAsyncSRTPTask>::start(arg);
+    srs_freep(err);
+    return NULL;
+}
+
+VOID TEST(AppThreadsTest, AsyncSRTPWithoutCollector)
+{
+    srs_error_t err;
+
+    // Ignore the error, because it might be initialized.
+    srtp_init();
+
+    string k0 = string(30, 'a'), k1 = string(30, 'b');
+    SrsSRTP sender, receiver;
+    HELPER_ASSERT_SUCCESS(sender.initialize(k0, k1, SrsSrtpProfileAes128CmSha1_80));
+    HELPER_ASSERT_SUCCESS(receiver.initialize(k1, k0, SrsSrtpProfileAes128CmSha1_80));
+
+    SrsThreadEntry entry;
+    SrsAsyncSRTPManager manager;
+    ASSERT_EQ(0, ::pipe(manager.dones_));
+
+    SrsAsyncWorker<SrsAsyncSRTPTask>* worker = new SrsAsyncWorker<SrsAsyncSRTPTask>(manager.dones_[1], false);
+    HELPER_ASSERT_SUCCESS(worker->initialize(1));
+    manager.workers_.push_back(worker);
+    HELPER_ASSERT_SUCCESS(manager.start());
+
+    ASSERT_EQ(0, pthread_create(&entry.trd, NULL, mock_async_srtp_worker, worker));
+    worker->trd_ = &entry;
+
+    // Stop the collector as if it fails, while the workers are still enabled.
+    manager.trd_->stop();
+    EXPECT_TRUE(manager.enabled());
+
+    char buf[1500];
+    iovec iov;
+    if (true) {
+        SrsRtpPacket pkt;
+        pkt.header.set_ssrc(100);
+        pkt.header.set_payload_type(96);
+
+        SrsRtpRawPayload* raw = new SrsRtpRawPayload();
+        raw->payload = (char*)"Hello";
+        raw->nn_payload = 5;
+        pkt.set_payload(raw, SrsRtspPacketPayloadTypeRaw);
+
+        SrsBuffer b(buf, sizeof(buf));
+        HELPER_ASSERT_SUCCESS(pkt.encode(&b));
+        iov.iov_base = buf;
+        iov.iov_len = b.pos();
+    }
+
+    // The task is done by worker, and collected by the coroutine which waits for it.
+    HELPER_ASSERT_SUCCESS(manager.protect_rtps(&sender, &iov, 1));
+    EXPECT_EQ(kRtpHeaderFixedSize + 5 + 10, (int)iov.iov_len);
+    EXPECT_EQ(0, worker->inflight_);
+
+    int nn = (int)iov.iov_len;
+    HELPER_EXPECT_SUCCESS(receiver.unprotect_rtp(buf, &nn));
+    EXPECT_EQ(kRtpHeaderFixedSize + 5, nn);
+
+    worker->stop();
+}
+
+SrsSharedPtrMessage* mock_aac_message(uint32_t timestamp, bool sh)
+{
+    SrsMessageHeader h;
+    h.initialize_audio(7, timestamp, 1);
+
+    // AAC LC, 44.1kHz, stereo, see ISO_IEC_14496-3-AAC-2001.pdf, page 33.
+    char* payload = new char[7];
+    payload[0] = (char)0xaf;
+    payload[1] = sh ? 0x00 : 0x01;
+    payload[2] = 0x12; payload[3] = 0x10; payload[4] = 0x21; payload[5] = 0x00; payload[6] = 0x03;
+
+    SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+    srs_error_t err = msg->create(&h, payload, 7);
+    srs_freep(err);
+    return msg;
+}
+
+VOID TEST(AppHttpStreamTest, TsSharedMuxer)
+{
+    srs_error_t err;
+
+    SrsRequest req;
+    req.vhost = "__defaultVhost__";
+    SrsTsSharedMuxer muxer(NULL, &req);
+
+    SrsTsTransmuxer enc;
+    enc.set_has_video(false);
+    HELPER_ASSERT_SUCCESS(enc.initialize(&muxer));
+
+    // No random access point for the sequence header.
+    if (true) {
+        SrsSharedPtrMessage* msg = mock_aac_message(0, true);
+        SrsAutoFree(SrsSharedPtrMessage, msg);
+        HELPER_ASSERT_SUCCESS(muxer.mux(&enc, msg));
+        EXPECT_TRUE(muxer.runs_.empty());
+    }
+
+    // For pure audio, a random access point for each second, and the previous GOP is kept.
+    for (int i = 0; i <= 30; i++) {
+        SrsSharedPtrMessage* msg = mock_aac_message(i * 100, false);
+        SrsAutoFree(SrsSharedPtrMessage, msg);
+        HELPER_ASSERT_SUCCESS(muxer.mux(&enc, msg));
+    }
+    ASSERT_EQ(11, (int)muxer.runs_.size());
+    EXPECT_EQ(20, muxer.runs_.front()->seq);
+    EXPECT_TRUE(muxer.runs_.front()->random_access);
+    EXPECT_TRUE(muxer.runs_.back()->random_access);
+
+    // Each run is aligned TS packets, the random access point starts with PAT.
+    for (int i = 0; i < (int)muxer.runs_.size(); i++) {
+        SrsTsPacketRun* run = muxer.runs_.at(i);
+        EXPECT_EQ(0, run->packets->size % SRS_TS_PACKET_SIZE);
+        EXPECT_EQ(0x47, (uint8_t)run->packets->payload[0]);
+
+        int pid = ((uint8_t)run->packets->payload[1] & 0x1f) << 8 | (uint8_t)run->packets->payload[2];
+        EXPECT_EQ(run->random_access, pid == 0);
+    }
+
+    // The new viewer starts from the last random access point.
+    if (true) {
+        int64_t seq = -1;
+        std::vector<SrsSharedPtrMessage*> runs;
+        EXPECT_EQ(0, muxer.fetch(seq, runs, 128));
+        EXPECT_EQ(1, (int)runs.size());
+        EXPECT_EQ(31, seq);
+        for (int i = 0; i < (int)runs.size(); i++) {
+            srs_freep(runs[i]);
+        }
+    }
+
+    // The viewer fetch from the sequence, limited by max.
+    if (true) {
+        int64_t seq = 22;
+        std::vector<SrsSharedPtrMessage*> runs;
+        EXPECT_EQ(0, muxer.fetch(seq, runs, 4));
+        EXPECT_EQ(4, (int)runs.size());
+        EXPECT_EQ(26, seq);
+        EXPECT_EQ(muxer.runs_.at(2)->packets->payload, runs[0]->payload);
+        for (int i = 0; i < (int)runs.size(); i++) {
+            srs_freep(runs[i]);
+        }
+    }
+
+    // The slow viewer is resynced to the last random access point, after the discontinuity of each PID.
+    if (true) {
+        int64_t seq = 5;
+        std::vector<SrsSharedPtrMessage*> runs;
+        EXPECT_EQ(25, muxer.fetch(seq, runs, 128));
+        ASSERT_EQ(2, (int)runs.size());
+        EXPECT_EQ(31, seq);
+        EXPECT_EQ(muxer.runs_.back()->packets->payload, runs[1]->payload);
+
+        // The PAT, PMT and audio, each is a packet with only adaptation field, and the continuity counter is
+        // before the first packet of PID in the run.
+        SrsSharedPtrMessage* run = runs[1];
+        ASSERT_EQ(3 * SRS_TS_PACKET_SIZE, runs[0]->size);
+        for (int i = 0; i < 3; i++) {
+            uint8_t* p = (uint8_t*)runs[0]->payload + i * SRS_TS_PACKET_SIZE;
+            uint8_t* q = (uint8_t*)run->payload + i * SRS_TS_PACKET_SIZE;
+            EXPECT_EQ(0x47, p[0]);
+            EXPECT_EQ(q[1] & 0x1f, p[1]);
+            EXPECT_EQ(q[2], p[2]);
+            EXPECT_EQ(0x20, p[3] & 0xf0);
+            EXPECT_EQ((q[3] - 1) & 0x0f, p[3] & 0x0f);
+            EXPECT_EQ(SRS_TS_PACKET_SIZE - 5, p[4]);
+            EXPECT_EQ(0x80, p[5]);
+        }
+
+        for (int i = 0; i < (int)runs.size(); i++) {
+            srs_freep(runs[i]);
+        }
+    }
+
+    // Nothing new for the viewer.
+    if (true) {
+        int64_t seq = 31;
+        std::vector<SrsSharedPtrMessage*> runs;
+        EXPECT_EQ(0, muxer.fetch(seq, runs, 128));
+        EXPECT_TRUE(runs.empty());
+        EXPECT_EQ(31, seq);
+    }
+}
+
+void* mock_async_file_worker(void* arg)
+{
+    srs_error_t err = SrsAsyncWorker<SrsAsyncFileTask>::start(arg);
+    srs_freep(err);
+    return NULL;
+}
+
+VOID TEST(AppThreadsTest, AsyncFileWriter)
+{
+    srs_error_t err;
+
+    string filepath = _srs_tmp_file_prefix + "app-async-file-writer.log";
+    MockFileRemover _mfr(filepath);
+
+    // Start a disk writer thread for the manager, which is joined by the entry.
+    SrsThreadEntry entry;
+    SrsAsyncFileManager manager;
+    ASSERT_EQ(0, ::pipe(manager.dones_));
+
+    SrsAsyncWorker<SrsAsyncFileTask>* worker = new SrsAsyncWorker<SrsAsyncFileTask>(manager.dones_[1], true);
+    HELPER_ASSERT_SUCCESS(worker->initialize(4));
+    manager.workers_.push_back(worker);
+
+    ASSERT_EQ(0, pthread_create(&entry.trd, NULL, mock_async_file_worker, worker));
+    worker->trd_ = &entry;
+    HELPER_ASSERT_SUCCESS(manager.start());
+    EXPECT_TRUE(manager.enabled());
+
+    SrsAsyncFileManager* old = _srs_async_file;
+    _srs_async_file = &manager;
+
+    if (true) {
+        SrsAsyncFileWriter w;
+        HELPER_ASSERT_SUCCESS(w.open(filepath));
+        EXPECT_TRUE(w.async_);
+        EXPECT_TRUE(w.is_open());
+
+        // The small writes are merged, while the large write is posted directly.
+        ssize_t nn = 0;
+        HELPER_EXPECT_SUCCESS(w.write((void*)"Hello", 5, &nn));
+        EXPECT_EQ(5, nn);
+        EXPECT_EQ(5, w.nn_buf_);
+
+        string large(100 * 1024, 'x');
+        HELPER_EXPECT_SUCCESS(w.write((void*)large.data(), large.length(), &nn));
+        EXPECT_EQ(0, w.nn_buf_);
+        EXPECT_EQ(5 + 100 * 1024, w.tellg());
+
+        // Overwrite the first bytes, then seek to end.
+        off_t pos = 0;
+        HELPER_EXPECT_SUCCESS(w.lseek(0, SEEK_SET, &pos));
+        EXPECT_EQ(0, pos);
+        HELPER_EXPECT_SUCCESS(w.write((void*)"World", 5, &nn));
+        HELPER_EXPECT_SUCCESS(w.lseek(0, SEEK_END, &pos));
+        EXPECT_EQ(5 + 100 * 1024, pos);
+        HELPER_EXPECT_SUCCESS(w.write((void*)"!", 1, &nn));
+
+        // All tasks are done when closed.
+        w.close();
+        EXPECT_FALSE(w.is_open());
+        EXPECT_EQ(0, w.nn_tasks_);
+        EXPECT_EQ(0, manager.depth());
+        EXPECT_EQ(0, manager.bytes());
+
+        SrsFileReader r;
+        HELPER_ASSERT_SUCCESS(r.open(filepath));
+        EXPECT_EQ(5 + 100 * 1024 + 1, r.filesize());
+
+        char buf[6] = {0};
+        HELPER_EXPECT_SUCCESS(r.read(buf, 5, &nn));
+        EXPECT_STREQ("World", buf);
+    }
+
+    // Append to the file.
+    if (true) {
+        SrsAsyncFileWriter w;
+        HELPER_ASSERT_SUCCESS(w.open_append(filepath));
+        EXPECT_EQ(5 + 100 * 1024 + 1, w.tellg());
+
+        ssize_t nn = 0;
+        HELPER_EXPECT_SUCCESS(w.write((void*)"Hello", 5, &nn));
+        w.close();
+
+        SrsFileReader r;
+        HELPER_ASSERT_SUCCESS(r.open(filepath));
+        EXPECT_EQ(5 + 100 * 1024 + 1 + 5, r.filesize());
+    }
+
+    // Failed to open file.
+    if (true) {
+        SrsAsyncFileWriter w;
+        HELPER_EXPECT_FAILED(w.open("/not-exists-dir/app-async-file-writer.log"));
+        EXPECT_FALSE(w.is_open());
+        EXPECT_FALSE(w.async_);
+    }
+
+    _srs_async_file = old;
+
+    // Stop the worker thread, by closing the wakeup pipe and join it.
+    worker->stop();
+    EXPECT_TRUE(worker->trd_ == NULL);
+}
+
+VOID TEST(AppThreadsTest, AsyncFileWriterInPlace)
+{
+    srs_error_t err;
+
+    string filepath = _srs_tmp_file_prefix + "app-async-file-writer.log";
+    MockFileRemover _mfr(filepath);
+
+    // Write file in place, when there is no disk writer thread.
+    SrsAsyncFileManager manager;
+    SrsAsyncFileManager* old = _srs_async_file;
+    _srs_async_file = &manager;
+
+    SrsAsyncFileWriter w;
+    HELPER_ASSERT_SUCCESS(w.open(filepath));
+    EXPECT_FALSE(w.async_);
+    EXPECT_TRUE(w.is_open());
+    HELPER_EXPECT_SUCCESS(w.set_iobuf_size(65536));
+
+    ssize_t nn = 0;
+    HELPER_EXPECT_SUCCESS(w.write((void*)"Hello", 5, &nn));
+    EXPECT_EQ(5, w.tellg());
+    w.close();
+
+    _srs_async_file = old;
+
+    SrsFileReader r;
+    HELPER_ASSERT_SUCCESS(r.open(filepath));
+    EXPECT_EQ(5, r.filesize());
+}
+
+VOID TEST(AppLogTest, LogRing)
+{
+    // The capacity is rounded up to power of 2.
+    SrsLogRing ring(5);
+    EXPECT_EQ(8, (int)ring.capacity_);
+
+    iovec iovs[2];
+    int nn_iovs = 0;
+    EXPECT_EQ(0, ring.peek(iovs, &nn_iovs));
+    EXPECT_EQ(0, nn_iovs);
+
+    // Push all or nothing.
+    if (true) {
+        iovec iov[2];
+        iov[0].iov_base = (char*)"Hello";
+        iov[0].iov_len = 5;
+        iov[1].iov_base = (char*)"World";
+        iov[1].iov_len = 5;
+        EXPECT_FALSE(ring.push(iov, 2));
+        EXPECT_TRUE(ring.push(iov, 1));
+        EXPECT_FALSE(ring.push(iov + 1, 1));
+    }
+
+    EXPECT_EQ(5, ring.peek(iovs, &nn_iovs));
+    EXPECT_EQ(1, nn_iovs);
+    EXPECT_EQ(0, memcmp(iovs[0].iov_base, "Hello", 5));
+    ring.consume(5);
+
+    // Wrap around the end of ring, peek in two pieces.
+    if (true) {
+        iovec iov;
+        iov.iov_base = (char*)"World!";
+        iov.iov_len = 6;
+        EXPECT_TRUE(ring.push(&iov, 1));
+    }
+
+    EXPECT_EQ(6, ring.peek(iovs, &nn_iovs));
+    ASSERT_EQ(2, nn_iovs);
+    EXPECT_EQ(3, (int)iovs[0].iov_len);
+    EXPECT_EQ(0, memcmp(iovs[0].iov_base, "Wor", 3));
+    EXPECT_EQ(3, (int)iovs[1].iov_len);
+    EXPECT_EQ(0, memcmp(iovs[1].iov_base, "ld!", 3));
+    ring.consume(6);
+
+    EXPECT_EQ(0, ring.peek(iovs, &nn_iovs));
+}
+
+VOID TEST(AppLogTest, AsyncLogDropped)
+{
+    SrsFileLog log;
+    log.log_to_file_tank = true;
+    log.ring_ = new SrsLogRing(128);
+
+    // Drop the log when ring is full.
+    string line(100, 'x');
+    log.write_async((char*)line.data(), (int)line.length(), SrsLogLevelTrace);
+    log.write_async((char*)line.data(), (int)line.length(), SrsLogLevelTrace);
+    EXPECT_EQ(1, log.dropped_);
+
+    // Notice the dropped logs, when there is space in ring.
+    iovec iovs[2];
+    int nn_iovs = 0;
+    EXPECT_EQ(100, log.ring_->peek(iovs, &nn_iovs));
+    log.ring_->consume(100);
+
+    log.write_async((char*)"Hello\n", 6, SrsLogLevelTrace);
+    EXPECT_EQ(0, log.dropped_);
+
+    int size = log.ring_->peek(iovs, &nn_iovs);
+    string logs;
+    for (int i = 0; i < nn_iovs; i++) {
+        logs.append((char*)iovs[i].iov_base, iovs[i].iov_len);
+    }
+    EXPECT_EQ(size, (int)logs.length());
+    EXPECT_STREQ("[async log] dropped 1 logs, for log thread is too slow\nHello\n", logs.c_str());
+
+    srs_freep(log.ring_);
+}
+
+VOID TEST(AppLogTest, AsyncLogWakeup)
+{
+    SrsFileLog log;
+    log.log_to_file_tank = true;
+    log.ring_ = new SrsLogRing(128);
+    ASSERT_EQ(0, ::pipe(log.wakeup_));
+    log.waiting_ = true;
+
+    // Never wakeup the log thread, until the ring is half full.
+    string line(40, 'x');
+    log.write_async((char*)line.data(), (int)line.length(), SrsLogLevelTrace);
+    EXPECT_TRUE(log.waiting_);
+
+    log.write_async((char*)line.data(), (int)line.length(), SrsLogLevelTrace);
+    EXPECT_FALSE(log.waiting_);
+
+    // Only wakeup once, when the log thread is waiting.
+    log.write_async((char*)line.data(), (int)line.length(), SrsLogLevelTrace);
+
+    ::close(log.wakeup_[1]);
+    log.wakeup_[1] = -1;
+
+    char buf[8];
+    EXPECT_EQ(1, (int)::read(log.wakeup_[0], buf, sizeof(buf)));
+    ::close(log.wakeup_[0]);
+    log.wakeup_[0] = -1;
+
+    srs_freep(log.ring_);
+}
+
+void* mock_async_log_thread(void* arg)
+{
+    srs_error_t err = SrsFileLog::start(arg);
+    srs_freep(err);
+    return NULL;
+}
+
+VOID TEST(AppLogTest, AsyncLogFlushWhenStop)
+{
+    srs_error_t err;
+
+    string filepath = _srs_tmp_file_prefix + "app-async-log.log";
+    MockFileRemover _mfr(filepath);
+
+    // The log thread is joined by the entry, when log is destroyed.
+    SrsThreadEntry entry;
+
+    if (true) {
+        SrsFileLog log;
+        log.log_to_file_tank = true;
+        log.filename_ = filepath;
+        log.ring_ = new SrsLogRing(1024 * 1024);
+        ASSERT_EQ(0, ::pipe(log.wakeup_));
+
+        ASSERT_EQ(0, pthread_create(&entry.trd, NULL, mock_async_log_thread, &log));
+        log.trd_ = &entry;
+
+        for (int i = 0; i < 1000; i++) {
+            log.write_async((char*)"Hello\n", 6, SrsLogLevelTrace);
+        }
+        EXPECT_EQ(0, log.dropped_);
+
+        // All logs in ring are written, when log thread is stopped.
+    }
+
+    SrsFileReader r;
+    HELPER_ASSERT_SUCCESS(r.open(filepath));
+    EXPECT_EQ(6 * 1000, r.filesize());
+}
+
+class MockWheelHandler : public ISrsFastTimer
+{
+public:
+    int count;
+    SrsWheelTimer* cancel;
+    SrsWheelTimer* timer;
+    SrsTimingWheel* wheel;
+    SrsWheelTimer* add;
+public:
+    MockWheelHandler() {
+        count = 0;
+        cancel = NULL;
+        timer = NULL;
+        wheel = NULL;
+        add = NULL;
+    }
+    virtual ~MockWheelHandler() {
+    }
+    virtual srs_error_t on_timer(srs_utime_t interval) {
+        count++;
+        if (cancel) {
+            cancel->cancel();
+        }
+        if (timer) {
+            srs_freep(timer);
+        }
+        if (wheel && add) {
+            wheel->add(add);
+            add = NULL;
+        }
+        return srs_success;
+    }
+};
+
+class MockHourGlassHandler : public ISrsHourGlass
+{
+public:
+    int count;
+public:
+    MockHourGlassHandler() {
+        count = 0;
+    }
+    virtual ~MockHourGlassHandler() {
+    }
+    virtual srs_error_t notify(int event, srs_utime_t interval, srs_utime_t tick) {
+        count++;
+        return srs_error_new(-1, "mock error");
+    }
+};
+
+VOID TEST(AppTimerTest, TimingWheel)
+{
+    srs_error_t err = srs_success;
+
+    // The periodic timers of different intervals.
+    if (true) {
+        SrsTimingWheel wheel("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+        MockWheelHandler h0, h1, h2;
+        SrsWheelTimer t0(&h0, 20 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer t1(&h1, 100 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer t2(&h2, 30 * SRS_UTIME_MILLISECONDS);
+        wheel.add(&t0);
+        wheel.add(&t1);
+        wheel.add(&t2);
+        EXPECT_EQ(3, wheel.size());
+        EXPECT_TRUE(t0.active());
+
+        wheel.advance(1);
+        EXPECT_EQ(1, h0.count);
+        EXPECT_EQ(0, h1.count);
+        EXPECT_EQ(0, h2.count);
+
+        wheel.advance(99);
+        EXPECT_EQ(100, h0.count);
+        EXPECT_EQ(20, h1.count);
+        // Round up to 2 ticks.
+        EXPECT_EQ(50, h2.count);
+
+        // Cancel is O(1) and idempotent.
+        t1.cancel();
+        t1.cancel();
+        EXPECT_FALSE(t1.active());
+        EXPECT_EQ(2, wheel.size());
+
+        wheel.advance(10);
+        EXPECT_EQ(110, h0.count);
+        EXPECT_EQ(20, h1.count);
+
+        // Reset the timer by add again.
+        wheel.add(&t0);
+        wheel.add(&t0);
+        EXPECT_EQ(2, wheel.size());
+    }
+
+    // The timers in upper levels are cascaded, and wrap the levels.
+    if (true) {
+        SrsTimingWheel wheel("utest", 1 * SRS_UTIME_MILLISECONDS);
+
+        MockWheelHandler h0, h1, h2;
+        SrsWheelTimer t0(&h0, 300 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer t1(&h1, 20000 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer t2(&h2, 1 * SRS_UTIME_MILLISECONDS);
+        wheel.add(&t0);
+        wheel.add(&t1);
+        wheel.add(&t2);
+
+        wheel.advance(299);
+        EXPECT_EQ(0, h0.count);
+        wheel.advance(1);
+        EXPECT_EQ(1, h0.count);
+
+        wheel.advance(19699);
+        EXPECT_EQ(0, h1.count);
+        wheel.advance(1);
+        EXPECT_EQ(1, h1.count);
+        EXPECT_EQ(66, h0.count);
+
+        wheel.advance(100000);
+        EXPECT_EQ(6, h1.count);
+        EXPECT_EQ(400, h0.count);
+        EXPECT_EQ(120000, h2.count);
+    }
+
+    // The handler cancels or frees the timer when expired.
+    if (true) {
+        SrsTimingWheel wheel("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+        MockWheelHandler h0, h1, h2;
+        SrsWheelTimer t0(&h0, 20 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer t1(&h1, 20 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer* t2 = new SrsWheelTimer(&h2, 20 * SRS_UTIME_MILLISECONDS);
+        wheel.add(&t0);
+        wheel.add(&t1);
+        wheel.add(t2);
+
+        // The t2 frees itself, then t1 cancels t0, which expires in the same tick.
+        h1.cancel = &t0;
+        h2.timer = t2;
+        wheel.advance(3);
+        EXPECT_EQ(0, h0.count);
+        EXPECT_EQ(3, h1.count);
+        EXPECT_EQ(1, h2.count);
+        EXPECT_EQ(1, wheel.size());
+    }
+
+    // The timer is detached when wheel is free.
+    if (true) {
+        MockWheelHandler h0;
+        SrsWheelTimer t0(&h0, 20 * SRS_UTIME_MILLISECONDS);
+
+        SrsTimingWheel* wheel = new SrsTimingWheel("utest", 20 * SRS_UTIME_MILLISECONDS);
+        wheel->add(&t0);
+        srs_freep(wheel);
+        EXPECT_FALSE(t0.active());
+    }
+
+    // The timer added by handler is not called in current tick, even for the same bucket.
+    if (true) {
+        SrsTimingWheel wheel("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+        MockWheelHandler h0, h1;
+        SrsWheelTimer t0(&h0, 20 * SRS_UTIME_MILLISECONDS);
+        SrsWheelTimer t1(&h1, 20 * SRS_UTIME_MILLISECONDS);
+        wheel.add(&t0);
+
+        h0.wheel = &wheel;
+        h0.add = &t1;
+        wheel.advance(1);
+        EXPECT_EQ(1, h0.count);
+        EXPECT_EQ(0, h1.count);
+        EXPECT_EQ(2, wheel.size());
+
+        wheel.advance(1);
+        EXPECT_EQ(2, h0.count);
+        EXPECT_EQ(1, h1.count);
+
+        // The empty bucket is free when expired, then created again.
+        t0.cancel();
+        t1.cancel();
+        wheel.advance(1);
+        wheel.add(&t0);
+        wheel.advance(1);
+        EXPECT_EQ(3, h0.count);
+    }
+
+    // The hourglass stops when notify fails.
+    if (true) {
+        SrsTimingWheel wheel("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+        MockHourGlassHandler h;
+        SrsHourGlass hg("utest", &h, 20 * SRS_UTIME_MILLISECONDS);
+        HELPER_EXPECT_SUCCESS(hg.tick(1, 20 * SRS_UTIME_MILLISECONDS));
+        wheel.add(hg.timer_);
+
+        wheel.advance(3);
+        EXPECT_EQ(1, h.count);
+        EXPECT_FALSE(hg.timer_->active());
+    }
+}
+
+
+// Mock the AVC message, the frame is 0x17 for keyframe, 0x27 for inter frame, and nalu is the NALU header.
+SrsSharedPtrMessage* mock_avc_message(uint32_t timestamp, uint8_t frame, uint8_t trait, uint8_t nalu)
+{
+    SrsMessageHeader h;
+    h.initialize_video(11, timestamp, 1);
+
+    char* payload = new char[11];
+    payload[0] = (char)frame; payload[1] = (char)trait; payload[2] = payload[3] = payload[4] = 0;
+    payload[5] = payload[6] = payload[7] = 0; payload[8] = 2;
+    payload[9] = (char)nalu; payload[10] = (char)0x88;
+
+    SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+    srs_error_t err = msg->create(&h, payload, 11);
+    srs_freep(err);
+    return msg;
+}
+
+// Mock a stream of GOPs in 1s at 25fps, starts with the sequence headers. The frames are I, P, b, P, b, ..., in
+// which the b is non-reference frame.
+srs_error_t mock_avc_stream(SrsMessageQueue* queue, int nn_gops)
+{
+    srs_error_t err = srs_success;
+
+    if ((err = queue->enqueue(mock_avc_message(0, 0x17, 0x00, 0x67))) != srs_success) {
+        return err;
+    }
+    if ((err = queue->enqueue(mock_aac_message(0, true))) != srs_success) {
+        return err;
+    }
+
+    for (int i = 0; i < nn_gops * 25; i++) {
+        uint32_t timestamp = i * 40;
+        if ((i % 25) == 0) {
+            err = queue->enqueue(mock_avc_message(timestamp, 0x17, 0x01, 0x65));
+        } else {
+            err = queue->enqueue(mock_avc_message(timestamp, 0x27, 0x01, (i % 2) ? 0x41 : 0x01));
+        }
+        if (err != srs_success) {
+            return err;
+        }
+    }
+
+    return err;
+}
+
+VOID TEST(AppSourceTest, AdaptiveDrop)
+{
+    srs_error_t err;
+
+    srs_update_system_time();
+
+    // Disabled, never drop.
+    if (true) {
+        SrsMessageQueue queue;
+        queue.drain_rate_ = 0.5;
+        queue.drain_window_ = srs_get_system_time();
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 5));
+        EXPECT_EQ(2 + 5 * 25, queue.size());
+        EXPECT_EQ(0, queue.nn_drop_frames());
+    }
+
+    // Consumer drains in realtime, never drop.
+    if (true) {
+        SrsMessageQueue queue;
+        queue.set_adaptive_drop(true, 1 * SRS_UTIME_SECONDS, 3 * SRS_UTIME_SECONDS);
+        queue.drain_rate_ = 1.0;
+        queue.drain_window_ = srs_get_system_time();
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 5));
+        EXPECT_EQ(2 + 5 * 25, queue.size());
+        EXPECT_EQ(0, queue.nn_drop_frames());
+        EXPECT_EQ(0, queue.nn_drop_gops());
+    }
+
+    // Unknown drain rate, never drop.
+    if (true) {
+        SrsMessageQueue queue;
+        queue.set_adaptive_drop(true, 1 * SRS_UTIME_SECONDS, 3 * SRS_UTIME_SECONDS);
+        queue.drain_window_ = srs_get_system_time();
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 5));
+        EXPECT_EQ(2 + 5 * 25, queue.size());
+        EXPECT_DOUBLE_EQ(-1, queue.drain_rate());
+    }
+
+    // Slow consumer, drop the non-reference frames, then the GOPs.
+    if (true) {
+        SrsMessageQueue queue;
+        queue.set_adaptive_drop(true, 1 * SRS_UTIME_SECONDS, 3 * SRS_UTIME_SECONDS);
+        queue.drain_rate_ = 0.5;
+        queue.drain_window_ = srs_get_system_time();
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 5));
+
+        // The b frames are dropped when queue exceeds 1s, 11 frames of the second GOP and 12 frames of others.
+        EXPECT_EQ(11 + 3 * 12, queue.nn_drop_frames());
+        EXPECT_EQ(2, queue.nn_drop_gops());
+        EXPECT_GT(queue.nn_drop_bytes(), (11 + 3 * 12) * 11);
+
+        // The sequence headers are kept, followed by the keyframe of the GOP at 2s.
+        SrsSharedPtrMessage* msgs[256];
+        int count = 0;
+        HELPER_ASSERT_SUCCESS(queue.dump_packets(256, msgs, count));
+        ASSERT_EQ(2 + 3 * 13, count);
+        EXPECT_TRUE(SrsFlvVideo::sh(msgs[0]->payload, msgs[0]->size));
+        EXPECT_TRUE(SrsFlvAudio::sh(msgs[1]->payload, msgs[1]->size));
+        EXPECT_TRUE(SrsFlvVideo::keyframe(msgs[2]->payload, msgs[2]->size));
+        EXPECT_EQ(2000, (int)msgs[2]->timestamp);
+        for (int i = 0; i < count; i++) {
+            srs_freep(msgs[i]);
+        }
+    }
+}
+
+VOID TEST(AppSourceTest, MessageRing)
+{
+    srs_error_t err;
+
+    // Wrap around the ring, and grow it.
+    if (true) {
+        SrsMessageRing ring;
+        SrsSharedPtrMessage* msgs[16];
+        for (int i = 0; i < 6; i++) {
+            ring.push_back(mock_aac_message(i, false));
+        }
+        EXPECT_EQ(4, ring.pop_front(msgs, 4));
+        for (int i = 0; i < 4; i++) {
+            EXPECT_EQ(i, (int)msgs[i]->timestamp);
+            srs_freep(msgs[i]);
+        }
+
+        // Now the head is at 4, the ring wraps around.
+        for (int i = 6; i < 12; i++) {
+            ring.push_back(mock_aac_message(i, false));
+        }
+        EXPECT_EQ(8, ring.size());
+        EXPECT_EQ(8, ring.capacity_);
+        EXPECT_EQ(11, (int)ring.at(7)->timestamp);
+
+        ring.push_back(mock_aac_message(12, false));
+        EXPECT_EQ(9, ring.size());
+        EXPECT_LT(8, ring.capacity_);
+
+        EXPECT_EQ(9, ring.pop_front(msgs, 16));
+        for (int i = 0; i < 9; i++) {
+            EXPECT_EQ(i + 4, (int)msgs[i]->timestamp);
+            srs_freep(msgs[i]);
+        }
+        EXPECT_TRUE(ring.empty());
+    }
+
+    // Index the keyframes and sequence headers.
+    if (true) {
+        SrsMessageQueue queue;
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 3));
+
+        SrsMessageRing& ring = queue.msgs;
+        EXPECT_EQ(2 + 3 * 25, ring.size());
+        ASSERT_EQ(3, ring.nn_keyframes());
+        EXPECT_EQ(2, ring.keyframe(0));
+        EXPECT_EQ(27, ring.keyframe(1));
+        EXPECT_EQ(52, ring.keyframe(2));
+        EXPECT_EQ(2, ring.headers(27));
+        EXPECT_TRUE(ring.video_sh() == ring.at(0));
+        EXPECT_TRUE(ring.audio_sh() == ring.at(1));
+
+        // Drop the first GOP, and keep the sequence headers.
+        EXPECT_EQ(25 * 11, ring.drop_front(27));
+        EXPECT_EQ(2 + 2 * 25, ring.size());
+        ASSERT_EQ(2, ring.nn_keyframes());
+        EXPECT_EQ(2, ring.keyframe(0));
+        EXPECT_EQ(1000, (int)ring.at(2)->timestamp);
+        EXPECT_TRUE(ring.video_sh() == ring.at(0));
+        EXPECT_TRUE(ring.audio_sh() == ring.at(1));
+
+        // The sequence headers are not in ring after dumped.
+        SrsMessageArray msgs(2);
+        EXPECT_EQ(2, ring.pop_front(msgs.msgs, 2));
+        EXPECT_TRUE(ring.video_sh() == NULL);
+        EXPECT_TRUE(ring.audio_sh() == NULL);
+        EXPECT_EQ(0, ring.headers(2));
+        EXPECT_EQ(0, ring.keyframe(0));
+
+        srs_freep(msgs.msgs[0]);
+        srs_freep(msgs.msgs[1]);
+    }
+
+    // The index is built when used, and the messages dumped before that are never indexed.
+    if (true) {
+        SrsMessageQueue queue;
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 3));
+
+        SrsMessageRing& ring = queue.msgs;
+        EXPECT_EQ(0, ring.indexed_);
+
+        SrsMessageArray msgs(30);
+        EXPECT_EQ(30, ring.pop_front(msgs.msgs, 30));
+        EXPECT_EQ(0, ring.indexed_);
+
+        ASSERT_EQ(1, ring.nn_keyframes());
+        EXPECT_EQ(52 - 30, ring.keyframe(0));
+        EXPECT_EQ(ring.tail_, ring.indexed_);
+        EXPECT_TRUE(ring.video_sh() == NULL);
+        EXPECT_TRUE(ring.audio_sh() == NULL);
+
+        for (int i = 0; i < 30; i++) {
+            srs_freep(msgs.msgs[i]);
+        }
+    }
+}
+
+VOID TEST(AppSourceTest, ShrinkToLastGop)
+{
+    srs_error_t err;
+
+    // Keep the last GOP, which fits the queue size.
+    if (true) {
+        SrsMessageQueue queue(true);
+        queue.set_queue_size(2 * SRS_UTIME_SECONDS);
+
+        bool is_overflow = false;
+        HELPER_ASSERT_SUCCESS(mock_avc_stream(&queue, 2));
+        HELPER_ASSERT_SUCCESS(queue.enqueue(mock_avc_message(2000, 0x17, 0x01, 0x65)));
+        HELPER_ASSERT_SUCCESS(queue.enqueue(mock_avc_message(2080, 0x27, 0x01, 0x41), &is_overflow));
+        EXPECT_TRUE(is_overflow);
+
+        // The sequence headers, and the GOP at 2s.
+        EXPECT_EQ(4, queue.size());
+        EXPECT_EQ(80 * SRS_UTIME_MILLISECONDS, queue.duration());
+        EXPECT_TRUE(SrsFlvVideo::sh(queue.msgs.at(0)->payload, queue.msgs.at(0)->size));
+        EXPECT_TRUE(SrsFlvAudio::sh(queue.msgs.at(1)->payload, queue.msgs.at(1)->size));
+        EXPECT_EQ(2000, (int)queue.msgs.at(2)->timestamp);
+    }
+
+    // Clear the queue, if the last GOP exceeds the queue size.
+    if (true) {
+        SrsMessageQueue queue(true);
+        queue.set_queue_size(500 * SRS_UTIME_MILLISECONDS);
+
+        bool is_overflow = false;
+        HELPER_ASSERT_SUCCESS(queue.enqueue(mock_avc_message(0, 0x17, 0x00, 0x67)));
+        HELPER_ASSERT_SUCCESS(queue.enqueue(mock_avc_message(40, 0x17, 0x01, 0x65)));
+        for (int i = 2; i < 15; i++) {
+            HELPER_ASSERT_SUCCESS(queue.enqueue(mock_avc_message(i * 40, 0x27, 0x01, 0x41), &is_overflow));
+        }
+        EXPECT_TRUE(is_overflow);
+
+        // Only the sequence header, with the timestamp of queue end.
+        ASSERT_EQ(1, queue.size());
+        EXPECT_TRUE(SrsFlvVideo::sh(queue.msgs.at(0)->payload, queue.msgs.at(0)->size));
+        EXPECT_EQ(560, (int)queue.msgs.at(0)->timestamp);
+        EXPECT_EQ(0, queue.duration());
+    }
+}
+
+// Move the pending data of out BIO to the in BIO of peer.
+void mock_ssl_transfer(BIO* out, BIO* in)
+{
+    char buf[4096];
+    int nn = 0;
+    while ((nn = BIO_read(out, buf, sizeof(buf))) > 0) {
+        BIO_write(in, buf, nn);
+    }
+}
+
+// Encrypt a TLS1.2 AES-GCM record like kernel, see RFC5288 section 3.
+string mock_ssl_gcm_record(string& key, string& salt, uint64_t seq, string plaintext)
+{
+    uint8_t nonce[12], aad[13], tag[16];
+    memcpy(nonce, salt.data(), 4);
+    for (int i = 0; i < 8; i++) {
+        nonce[4 + i] = aad[i] = (uint8_t)(seq >> (56 - 8 * i));
+    }
+    aad[8] = 0x17; aad[9] = 0x03; aad[10] = 0x03;
+    aad[11] = (uint8_t)(plaintext.length() >> 8); aad[12] = (uint8_t)plaintext.length();
+
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    const EVP_CIPHER* cipher = key.length() == 16 ? EVP_aes_128_gcm() : EVP_aes_256_gcm();
+    EVP_EncryptInit_ex(ctx, cipher, NULL, (uint8_t*)key.data(), nonce);
+
+    int nn = 0;
+    string ciphertext(plaintext.length(), 0);
+    EVP_EncryptUpdate(ctx, NULL, &nn, aad, sizeof(aad));
+    EVP_EncryptUpdate(ctx, (uint8_t*)&ciphertext[0], &nn, (uint8_t*)plaintext.data(), plaintext.length());
+    EVP_EncryptFinal_ex(ctx, NULL, &nn);
+    EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, sizeof(tag), tag);
+    EVP_CIPHER_CTX_free(ctx);
+
+    int size = 8 + ciphertext.length() + sizeof(tag);
+    string record("\x17\x03\x03", 3);
+    record.append(1, (char)(size >> 8)).append(1, (char)size);
+    record.append((char*)nonce + 4, 8).append(ciphertext).append((char*)tag, sizeof(tag));
+    return record;
+}
+
+VOID TEST(AppSslTest, ServerWriteKey)
+{
+    srs_error_t err;
+
+    const char* ciphers[] = {"ECDHE-RSA-AES128-GCM-SHA256", "ECDHE-RSA-AES256-GCM-SHA384"};
+    for (int i = 0; i < (int)(sizeof(ciphers) / sizeof(ciphers[0])); i++) {
+        SSL_CTX* sctx = SSL_CTX_new(TLS_server_method());
+        SSL_CTX_set_max_proto_version(sctx, TLS1_2_VERSION);
+        ASSERT_EQ(1, SSL_CTX_use_certificate_file(sctx, "./conf/server.crt", SSL_FILETYPE_PEM));
+        ASSERT_EQ(1, SSL_CTX_use_PrivateKey_file(sctx, "./conf/server.key", SSL_FILETYPE_PEM));
+
+        SSL_CTX* cctx = SSL_CTX_new(TLS_client_method());
+        SSL_CTX_set_max_proto_version(cctx, TLS1_2_VERSION);
+        SSL_CTX_set_cipher_list(cctx, ciphers[i]);
+
+        SSL* server = SSL_new(sctx);
+        BIO* sin = BIO_new(BIO_s_mem()); BIO* sout = BIO_new(BIO_s_mem());
+        SSL_set_bio(server, sin, sout);
+        SSL_set_accept_state(server);
+
+        SSL* client = SSL_new(cctx);
+        BIO* cin = BIO_new(BIO_s_mem()); BIO* cout = BIO_new(BIO_s_mem());
+        SSL_set_bio(client, cin, cout);
+        SSL_set_connect_state(client);
+
+        for (int j = 0; j < 10 && (!SSL_is_init_finished(server) || !SSL_is_init_finished(client)); j++) {
+            SSL_do_handshake(client);
+            mock_ssl_transfer(cout, sin);
+            SSL_do_handshake(server);
+            mock_ssl_transfer(sout, cin);
+        }
+        ASSERT_TRUE(SSL_is_init_finished(server));
+        ASSERT_TRUE(SSL_is_init_finished(client));
+        EXPECT_STREQ(ciphers[i], SSL_CIPHER_get_name(SSL_get_current_cipher(server)));
+
+        string key, salt;
+        HELPER_ASSERT_SUCCESS(srs_ssl_server_write_key(server, key, salt));
+        EXPECT_EQ(i ? 32 : 16, (int)key.length());
+        EXPECT_EQ(4, (int)salt.length());
+
+        // The record encrypted by the derived key, from the sequence 1, should be decrypted by client.
+        string record = mock_ssl_gcm_record(key, salt, 1, "Hello, kTLS!");
+        BIO_write(cin, record.data(), record.length());
+
+        char buf[64];
+        int nn = SSL_read(client, buf, sizeof(buf));
+        ASSERT_EQ(12, nn);
+        EXPECT_STREQ("Hello, kTLS!", string(buf, nn).c_str());
+
+        SSL_free(client); SSL_CTX_free(cctx);
+        SSL_free(server); SSL_CTX_free(sctx);
+    }
+}
+
@@ -3938,6 +3938,91 @@ VOID TEST(ConfigMainTest, SrtServerTlpktDrop)
     }
 }
 
+VOID TEST(ConfigMainTest, VhostSnapshot)
+{
+    srs_error_t err;
+
+    // Use the default values if no vhost.
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF));
+
+        SrsVhostSnapshot* s = conf.get_vhost_snapshot("ossrs.net");
+        EXPECT_TRUE(s->vhost().empty());
+        EXPECT_FALSE(s->is_edge);
+        EXPECT_TRUE(s->gop_cache);
+        EXPECT_EQ(30 * SRS_UTIME_SECONDS, s->queue_length);
+        EXPECT_FALSE(s->atc);
+        EXPECT_TRUE(s->parse_sps);
+        EXPECT_FALSE(s->reduce_sequence_header);
+        EXPECT_FALSE(s->hls_enabled);
+        EXPECT_STREQ("continue", s->hls_on_error.c_str());
+        EXPECT_TRUE(s->rtc_nack_enabled);
+        EXPECT_TRUE(s->rtc_twcc_enabled);
+        EXPECT_EQ(0, conf.snapshots_->size());
+    }
+
+    // Use the default vhost if vhost not exists.
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost __defaultVhost__{play{atc on;} publish{parse_sps off;}} vhost ossrs.net{cluster{mode remote;} hls{enabled on;}}"));
+
+        SrsVhostSnapshot* s = conf.get_vhost_snapshot("ossrs.net");
+        EXPECT_STREQ("ossrs.net", s->vhost().c_str());
+        EXPECT_TRUE(s->is_edge);
+        EXPECT_TRUE(s->hls_enabled);
+        EXPECT_FALSE(s->atc);
+        EXPECT_TRUE(s->parse_sps);
+
+        s = conf.get_vhost_snapshot("not.exists");
+        EXPECT_TRUE(s->vhost().empty());
+        EXPECT_FALSE(s->is_edge);
+        EXPECT_FALSE(s->hls_enabled);
+        EXPECT_TRUE(s->atc);
+        EXPECT_FALSE(s->parse_sps);
+        EXPECT_EQ(s, conf.get_vhost_snapshot("not.exists2"));
+
+        s = conf.get_vhost_snapshot("__defaultVhost__");
+        EXPECT_STREQ("__defaultVhost__", s->vhost().c_str());
+        EXPECT_TRUE(s->atc);
+        EXPECT_EQ(2, conf.snapshots_->size());
+    }
+
+    // Lookup in a large number of vhosts, and rebuild when parse again.
+    if (true) {
+        string buf = _MIN_OK_CONF;
+        for (int i = 0; i < 100; i++) {
+            buf += "vhost v" + srs_int2str(i) + "{play{queue_length " + srs_int2str(i + 1) + ";}} ";
+        }
+
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(buf));
+        EXPECT_TRUE(conf.snapshots_ == NULL);
+
+        for (int i = 0; i < 100; i++) {
+            SrsVhostSnapshot* s = conf.get_vhost_snapshot("v" + srs_int2str(i));
+            EXPECT_STREQ(("v" + srs_int2str(i)).c_str(), s->vhost().c_str());
+            EXPECT_EQ((i + 1) * SRS_UTIME_SECONDS, s->queue_length);
+        }
+        EXPECT_EQ(100, conf.snapshots_->size());
+        EXPECT_EQ(256, (int)conf.snapshots_->buckets_.size());
+
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost v0{play{queue_length 7;}}"));
+        EXPECT_EQ(7 * SRS_UTIME_SECONDS, conf.get_vhost_snapshot("v0")->queue_length);
+        EXPECT_EQ(30 * SRS_UTIME_SECONDS, conf.get_vhost_snapshot("v1")->queue_length);
+        EXPECT_EQ(1, conf.snapshots_->size());
+    }
+
+    // The env overwrites the config, when build the snapshot.
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost ossrs.net{rtc{stun_strict_check off;}}"));
+
+        SrsSetEnvConfig(strict, "SRS_VHOST_RTC_STUN_STRICT_CHECK", "on");
+        EXPECT_TRUE(conf.get_vhost_snapshot("ossrs.net")->rtc_stun_strict_check);
+    }
+}
+
 VOID TEST(ConfigEnvTest, CheckEnvValuesGlobal)
 {
     if (true) {
@@ -3952,6 +4037,10 @@ VOID TEST(ConfigEnvTest, CheckEnvValuesGlobal)
         SrsSetEnvConfig(log_file, "SRS_SRS_LOG_FILE", "xxx2");
         EXPECT_STREQ("xxx2", conf.get_log_file().c_str());
 
+        EXPECT_FALSE(conf.get_log_async());
+        SrsSetEnvConfig(log_async, "SRS_SRS_LOG_ASYNC", "on");
+        EXPECT_TRUE(conf.get_log_async());
+
         SrsSetEnvConfig(log_level, "SRS_SRS_LOG_LEVEL", "xxx3");
         EXPECT_STREQ("xxx3", conf.get_log_level().c_str());
 
@@ -4067,6 +4156,14 @@ VOID TEST(ConfigEnvTest, CheckEnvValuesthreads)
         SrsSetEnvConfig(threads_interval, "SRS_THREADS_INTERVAL", "10");
         EXPECT_EQ(10 * SRS_UTIME_SECONDS, conf.get_threads_interval());
     }
+
+    if (true) {
+        MockSrsConfig conf;
+        EXPECT_EQ(0, conf.get_threads_disk_writers());
+
+        SrsSetEnvConfig(threads_disk_writers, "SRS_THREADS_DISK_WRITERS", "2");
+        EXPECT_EQ(2, conf.get_threads_disk_writers());
+    }
 }
 
 VOID TEST(ConfigEnvTest, CheckEnvValuesRtmp)
@@ -4185,6 +4282,9 @@ VOID TEST(ConfigEnvTest, CheckEnvValuesHttpServer)
 
         SrsSetEnvConfig(https_stream_ssl_cert, "SRS_HTTP_SERVER_HTTPS_CERT", "xxx3");
         EXPECT_STREQ("xxx3", conf.get_https_stream_ssl_cert().c_str());
+
+        SrsSetEnvConfig(https_stream_ktls, "SRS_HTTP_SERVER_HTTPS_KTLS", "on");
+        EXPECT_TRUE(conf.get_https_stream_ktls());
     }
 }
 
@@ -4466,6 +4566,30 @@ VOID TEST(ConfigEnvTest, CheckEnvValuesVhostPlay)
         SrsSetEnvConfig(reduce_sequence_header, "SRS_VHOST_PLAY_REDUCE_SEQUENCE_HEADER", "on");
         EXPECT_TRUE(conf.get_reduce_sequence_header("__defaultVhost__"));
     }
+
+    if (true) {
+        MockSrsConfig conf;
+        EXPECT_FALSE(conf.get_adaptive_drop("__defaultVhost__"));
+        EXPECT_EQ(2 * SRS_UTIME_SECONDS, conf.get_adaptive_drop_nonref("__defaultVhost__"));
+        EXPECT_EQ(5 * SRS_UTIME_SECONDS, conf.get_adaptive_drop_gop("__defaultVhost__"));
+
+        SrsSetEnvConfig(adaptive_drop, "SRS_VHOST_PLAY_ADAPTIVE_DROP", "on");
+        EXPECT_TRUE(conf.get_adaptive_drop("__defaultVhost__"));
+
+        SrsSetEnvConfig(adaptive_drop_nonref, "SRS_VHOST_PLAY_ADAPTIVE_DROP_NONREF", "1000");
+        EXPECT_EQ(1000 * SRS_UTIME_MILLISECONDS, conf.get_adaptive_drop_nonref("__defaultVhost__"));
+
+        SrsSetEnvConfig(adaptive_drop_gop, "SRS_VHOST_PLAY_ADAPTIVE_DROP_GOP", "3000");
+        EXPECT_EQ(3000 * SRS_UTIME_MILLISECONDS, conf.get_adaptive_drop_gop("__defaultVhost__"));
+    }
+
+    if (true) {
+        MockSrsConfig conf;
+        EXPECT_FALSE(conf.get_play_zerocopy("__defaultVhost__"));
+
+        SrsSetEnvConfig(zerocopy, "SRS_VHOST_PLAY_ZEROCOPY", "on");
+        EXPECT_TRUE(conf.get_play_zerocopy("__defaultVhost__"));
+    }
 }
 
 VOID TEST(ConfigEnvTest, CheckEnvValuesVhostPublish)
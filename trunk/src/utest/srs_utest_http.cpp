@@ -2394,3 +2394,115 @@ VOID TEST(ProtocolHTTPTest, PathEscape)
     }
 }
 
+
+class MockSendfileIO : public MockBufferIO, public ISrsProtocolFileWriter
+{
+public:
+    int nn_sendfile;
+public:
+    MockSendfileIO() {
+        nn_sendfile = 0;
+    }
+    virtual ~MockSendfileIO() {
+    }
+public:
+    virtual bool sendfile_supported() {
+        return true;
+    }
+    virtual srs_error_t enable_ktls(const void* crypto_info, int size) {
+        return srs_error_new(ERROR_HTTPS_KTLS, "not supported");
+    }
+    virtual srs_error_t enable_zerocopy() {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "not supported");
+    }
+    virtual srs_error_t writev_zerocopy(const iovec* iov, int iov_size, ISrsZeroCopyPin* pin, ssize_t* nwrite) {
+        srs_freep(pin);
+        return writev(iov, iov_size, nwrite);
+    }
+    virtual srs_error_t sendfile(int fd, int64_t offset, int64_t size, ssize_t* nwrite) {
+        char buf[64];
+        srs_assert(size <= (int64_t)sizeof(buf));
+        if (::pread(fd, buf, size, offset) != size) {
+            return srs_error_new(ERROR_SOCKET_WRITE, "pread");
+        }
+        nn_sendfile++;
+        out_append((uint8_t*)buf, size);
+        if (nwrite) *nwrite = size;
+        return srs_success;
+    }
+};
+
+class MockHttpFileServer : public SrsHttpFileServer
+{
+public:
+    MockHttpFileServer() : SrsHttpFileServer("/tmp") {
+    }
+    virtual ~MockHttpFileServer() {
+    }
+public:
+    using SrsHttpFileServer::copy;
+};
+
+VOID TEST(ProtocolHTTPTest, SendfileCopy)
+{
+    srs_error_t err;
+
+    string filename = _srs_tmp_file_prefix + "sendfile.txt";
+    if (true) {
+        SrsFileWriter fw;
+        HELPER_ASSERT_SUCCESS(fw.open(filename));
+        HELPER_ASSERT_SUCCESS(fw.write((void*)"Hello, world!", 13, NULL));
+    }
+
+    MockHttpFileServer fs;
+    SrsHttpMessage r;
+
+    // Send by sendfile with content-length, from the position of file.
+    if (true) {
+        SrsFileReader fr;
+        HELPER_ASSERT_SUCCESS(fr.open(filename));
+        fr.seek2(7);
+
+        MockResponseWriter m;
+        MockSendfileIO io;
+        SrsHttpResponseWriter w(&io);
+        w.set_header_filter(&m);
+        w.header()->set_content_length(5);
+
+        EXPECT_TRUE(w.sendfile_supported());
+        HELPER_EXPECT_SUCCESS(fs.copy(&w, &fr, &r, 5));
+        EXPECT_EQ(1, io.nn_sendfile);
+        EXPECT_EQ(12, fr.tellg());
+        EXPECT_STREQ(mock_http_response(200, "world").c_str(), HELPER_BUFFER2STR(&io.out_buffer).c_str());
+    }
+
+    // Send by sendfile in chunked encoding, the file is the body of chunk.
+    if (true) {
+        SrsFileReader fr;
+        HELPER_ASSERT_SUCCESS(fr.open(filename));
+
+        MockResponseWriter m;
+        MockSendfileIO io;
+        SrsHttpResponseWriter w(&io);
+        w.set_header_filter(&m);
+        w.write_header(SRS_CONSTS_HTTP_OK);
+
+        HELPER_EXPECT_SUCCESS(w.sendfile(fr.fileno(), 0, 5));
+        HELPER_EXPECT_SUCCESS(w.final_request());
+        EXPECT_EQ(1, io.nn_sendfile);
+        EXPECT_STREQ(mock_http_response2(200, "5\r\nHello\r\n0\r\n\r\n").c_str(), HELPER_BUFFER2STR(&io.out_buffer).c_str());
+    }
+
+    // Fallback to read and write, if writer does not support sendfile.
+    if (true) {
+        SrsFileReader fr;
+        HELPER_ASSERT_SUCCESS(fr.open(filename));
+
+        MockResponseWriter w;
+        w.header()->set_content_length(13);
+        HELPER_EXPECT_SUCCESS(fs.copy(&w, &fr, &r, 13));
+        __MOCK_HTTP_EXPECT_STREQ(200, "Hello, world!", w);
+    }
+
+    ::unlink(filename.c_str());
+}
@@ -670,6 +670,56 @@ VOID TEST(KernelCodecTest, IsSequenceHeader)
     EXPECT_FALSE(SrsFlvVideo::sh((char*)pp, 2));
 }
 
+VOID TEST(KernelCodecTest, IsDisposable)
+{
+    // AVC non-reference B frame, with AUD.
+    if (true) {
+        uint8_t data[] = {0x27, 0x01, 0, 0, 0, 0, 0, 0, 2, 0x09, 0xf0, 0, 0, 0, 2, 0x01, 0xaa};
+        EXPECT_TRUE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, 4));
+
+        // Reference P frame.
+        data[15] = 0x41;
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+
+        // Keyframe.
+        data[0] = 0x17; data[15] = 0x01;
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+
+        // Disposable inter frame.
+        data[0] = 0x37; data[15] = 0x41;
+        EXPECT_TRUE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+
+        // Corrupt NALU length.
+        data[0] = 0x27; data[15] = 0x01; data[14] = 8;
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+    }
+
+    // AVC frame without slice.
+    if (true) {
+        uint8_t data[] = {0x27, 0x01, 0, 0, 0, 0, 0, 0, 2, 0x06, 0x05};
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+    }
+
+    // HEVC TRAIL_N and TRAIL_R.
+    if (true) {
+        uint8_t data[] = {0x2c, 0x01, 0, 0, 0, 0, 0, 0, 3, 0x00, 0x01, 0xaa};
+        EXPECT_TRUE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+
+        data[9] = 0x02;
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+    }
+
+    // Enhanced RTMP HEVC, coded frames without cts.
+    if (true) {
+        uint8_t data[] = {0xa3, 'h', 'v', 'c', '1', 0, 0, 0, 3, 0x08, 0x01, 0xaa};
+        EXPECT_TRUE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+
+        data[4] = '2';
+        EXPECT_FALSE(SrsFlvVideo::disposable((char*)data, sizeof(data)));
+    }
+}
+
 /**
 * test the codec,
 * check whether AAC codec
@@ -4761,6 +4811,49 @@ VOID TEST(KernelFLVTest, CoverAll)
     }
 }
 
+VOID TEST(KernelFLVTest, CoverSharedFlvTag)
+{
+    srs_error_t err;
+
+    SrsMessageHeader h;
+    h.initialize_audio(3, 0x12345678, 1);
+    SrsSharedPtrMessage m;
+    HELPER_EXPECT_SUCCESS(m.create(&h, new char[3], 3));
+    memcpy(m.payload, "\xaf\x01\x02", 3);
+
+    // The first viewer encodes the tag for source, others reuse it.
+    MockSrsFileWriter f0, f1;
+    SrsFlvTransmuxer mux0, mux1;
+    HELPER_EXPECT_SUCCESS(mux0.initialize(&f0));
+    HELPER_EXPECT_SUCCESS(mux1.initialize(&f1));
+
+    for (int i = 0; i < 2; i++) {
+        SrsSharedPtrMessage* copy = m.copy();
+        SrsAutoFree(SrsSharedPtrMessage, copy);
+        HELPER_EXPECT_SUCCESS(i == 0? mux0.write_tags(&copy, 1) : mux1.write_tags(&copy, 1));
+    }
+    EXPECT_EQ(15, mux0.source_bytes());
+    EXPECT_EQ(0, mux0.viewer_bytes());
+    EXPECT_EQ(0, mux1.source_bytes());
+    EXPECT_EQ(0, mux1.viewer_bytes());
+
+    string expect("\x08\x00\x00\x03\x34\x56\x78\x12\x00\x00\x00\xaf\x01\x02\x00\x00\x00\x0e", 18);
+    EXPECT_TRUE(expect == f0.str());
+    EXPECT_TRUE(expect == f1.str());
+
+    // The viewers with different timestamps, encode the tags by itself if exceed the max cache.
+    for (int i = 0; i < 4; i++) {
+        SrsSharedPtrMessage* copy = m.copy();
+        SrsAutoFree(SrsSharedPtrMessage, copy);
+        copy->timestamp = 1000 + i;
+        HELPER_EXPECT_SUCCESS(mux1.write_tags(&copy, 1));
+    }
+    EXPECT_EQ(45, mux1.source_bytes());
+    EXPECT_EQ(15, mux1.viewer_bytes());
+    EXPECT_EQ(18 * 5, (int)f1.str().length());
+    EXPECT_TRUE(0 == memcmp(f1.str().data() + 18 * 4, "\x08\x00\x00\x03\x00\x03\xeb\x00", 8));
+}
+
 VOID TEST(KernelFLVTest, CoverSharedPtrMessage)
 {
 	srs_error_t err;
@@ -5458,6 +5551,84 @@ VOID TEST(KernelTSTest, CoverContextEncode)
     }
 }
 
+// Encode the PES by SrsTsPacket packet by packet, which is the legacy way of SrsTsContext::encode_pes.
+string mock_ts_encode_pes(SrsTsContext* ctx, SrsTsMessage* msg, int16_t pid, uint8_t& cc, int64_t pcr)
+{
+    string output;
+    char* start = msg->payload->bytes();
+    char* end = start + msg->payload->length();
+    char* p = start;
+
+    while (p < end) {
+        SrsTsPacket* pkt = NULL;
+        if (p == start) {
+            pkt = SrsTsPacket::create_pes_first(ctx, pid, msg->sid, cc++, msg->is_discontinuity, pcr, msg->dts, msg->pts, msg->payload->length());
+        } else {
+            pkt = SrsTsPacket::create_pes_continue(ctx, pid, msg->sid, cc++);
+        }
+        SrsAutoFree(SrsTsPacket, pkt);
+
+        char buf[SRS_TS_PACKET_SIZE];
+        int nb_buf = pkt->size();
+        int left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - nb_buf);
+        if (SRS_TS_PACKET_SIZE - nb_buf - left > 0) {
+            memset(buf, 0xFF, SRS_TS_PACKET_SIZE);
+            pkt->padding(SRS_TS_PACKET_SIZE - nb_buf - left);
+            nb_buf = pkt->size();
+            left = (int)srs_min(end - p, SRS_TS_PACKET_SIZE - nb_buf);
+        }
+        memcpy(buf + nb_buf, p, left);
+        p += left;
+
+        SrsBuffer stream(buf, nb_buf);
+        srs_error_t err = pkt->encode(&stream);
+        srs_freep(err);
+
+        output.append(buf, SRS_TS_PACKET_SIZE);
+    }
+
+    return output;
+}
+
+VOID TEST(KernelTSTest, CoverContextEncodePackets)
+{
+    srs_error_t err;
+
+    int sizes[] = {1, 13, 150, 164, 165, 166, 167, 170, 171, 172, 173, 183, 184, 185, 186, 352, 366, 367, 368, 369, 12032, 12033, 70000};
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(int)); i++) {
+        for (int j = 0; j < 4; j++) {
+            bool has_pcr = (j & 0x01);
+            bool has_dts = (j & 0x02);
+
+            SrsTsContext ctx;
+            MockSrsFileWriter f;
+            HELPER_EXPECT_SUCCESS(ctx.encode_pat_pmt(&f, 0x100, SrsTsStreamVideoH264, 0x101, SrsTsStreamAudioAAC));
+
+            SrsTsMessage m;
+            m.sid = SrsTsPESStreamIdVideoCommon;
+            m.write_pcr = has_pcr;
+            m.is_discontinuity = has_pcr;
+            m.dts = 0x1ABCDEF01LL;
+            m.pts = has_dts? m.dts + 3600 : m.dts;
+            for (int k = 0; k < sizes[i]; k++) {
+                char v = (char)k;
+                m.payload->append(&v, 1);
+            }
+
+            // The context should encode the same bytes as the legacy packets, with the continuity counter.
+            uint8_t cc = 0;
+            string expect = mock_ts_encode_pes(&ctx, &m, 0x100, cc, has_pcr? m.dts : -1);
+            expect += mock_ts_encode_pes(&ctx, &m, 0x100, cc, has_pcr? m.dts : -1);
+
+            MockSrsFileWriter w;
+            HELPER_EXPECT_SUCCESS(ctx.encode_pes(&w, &m, 0x100, SrsTsStreamVideoH264, false));
+            HELPER_EXPECT_SUCCESS(ctx.encode_pes(&w, &m, 0x100, SrsTsStreamVideoH264, false));
+            EXPECT_EQ(0, (int)(w.str().length() % SRS_TS_PACKET_SIZE));
+            EXPECT_TRUE(expect == w.str()) << "size=" << sizes[i] << ", pcr=" << has_pcr << ", dts=" << has_dts;
+        }
+    }
+}
+
 VOID TEST(KernelTSTest, CoverContextEncodeHEVC)
 {
     srs_error_t err;
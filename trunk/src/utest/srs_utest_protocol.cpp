@@ -2747,6 +2747,68 @@ VOID TEST(ProtocolStackTest, ProtocolSendVMessage)
     EXPECT_EQ(16, bio.out_buffer.length());
 }
 
+/**
+* send a video message to players, by the shared chunks
+*/
+VOID TEST(ProtocolStackTest, ProtocolSendSharedChunks)
+{
+    srs_error_t err = srs_success;
+
+    SrsCommonMessage* msg = new SrsCommonMessage(); SrsAutoFree(SrsCommonMessage, msg);
+    msg->header.message_type = RTMP_MSG_VideoMessage;
+    msg->header.payload_length = msg->size = 4096;
+    msg->payload = new char[msg->size];
+    for (int i = 0; i < msg->size; i++) {
+        msg->payload[i] = (char)i;
+    }
+
+    SrsSharedPtrMessage m;
+    HELPER_ASSERT_SUCCESS(m.create(msg));
+    m.timestamp = 1000;
+
+    // The players with the same chunk size share the chunks.
+    MockBufferIO bio0, bio1;
+    SrsProtocol proto0(&bio0), proto1(&bio1);
+    HELPER_EXPECT_SUCCESS(proto0.send_and_free_message(m.copy(), 1));
+    HELPER_EXPECT_SUCCESS(proto1.send_and_free_message(m.copy(), 1));
+    EXPECT_EQ(12 + 31 + 4096, bio0.out_buffer.length());
+    EXPECT_EQ(bio0.out_buffer.length(), bio1.out_buffer.length());
+    EXPECT_TRUE(0 == memcmp(bio0.out_buffer.bytes(), bio1.out_buffer.bytes(), bio0.out_buffer.length()));
+
+    SrsSharedPtrChunks* chunks = m.chunks(SRS_CONSTS_RTMP_PROTOCOL_CHUNK_SIZE);
+    ASSERT_TRUE(chunks != NULL);
+    EXPECT_EQ(64, chunks->nb_iovs);
+    EXPECT_TRUE(chunks == m.chunks(SRS_CONSTS_RTMP_PROTOCOL_CHUNK_SIZE));
+
+    // The player can decode the message.
+    if (true) {
+        bio0.in_buffer.append(bio0.out_buffer.bytes(), bio0.out_buffer.length());
+
+        SrsCommonMessage* msg = NULL;
+        HELPER_ASSERT_SUCCESS(proto0.recv_message(&msg));
+        SrsAutoFree(SrsCommonMessage, msg);
+        ASSERT_TRUE(msg->header.is_video());
+        EXPECT_EQ(1000, msg->header.timestamp);
+        EXPECT_EQ(1, msg->header.stream_id);
+        ASSERT_EQ(4096, msg->size);
+        EXPECT_TRUE(0 == memcmp(msg->payload, m.payload, msg->size));
+    }
+
+    // The extended timestamp is not cacheable, and not for too many chunk sizes.
+    if (true) {
+        SrsSharedPtrMessage* copy = m.copy();
+        SrsAutoFree(SrsSharedPtrMessage, copy);
+        copy->timestamp = RTMP_EXTENDED_TIMESTAMP;
+        EXPECT_TRUE(NULL == copy->chunks(SRS_CONSTS_RTMP_PROTOCOL_CHUNK_SIZE));
+
+        EXPECT_TRUE(NULL != m.chunks(1024));
+        EXPECT_TRUE(NULL != m.chunks(2048));
+        EXPECT_TRUE(NULL != m.chunks(4096));
+        EXPECT_TRUE(NULL == m.chunks(8192));
+        EXPECT_EQ(2, m.chunks(4096)->nb_iovs);
+    }
+}
+
 /**
 * send a SrsCallPacket packet
 */
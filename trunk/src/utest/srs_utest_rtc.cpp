@@ -14,6 +14,7 @@
 #include <srs_app_rtc_conn.hpp>
 #include <srs_kernel_codec.hpp>
 #include <srs_app_conn.hpp>
+#include <srs_app_rtc_dtls.hpp>
 
 #include <srs_utest_service.hpp>
 
@@ -706,18 +707,25 @@ VOID TEST(KernelRTCTest, DumpsHexToString)
 
 VOID TEST(KernelRTCTest, NACKFetchRTPPacket)
 {
+    srs_error_t err;
+
     SrsRtcConnection s(NULL, SrsContextId());
     SrsRtcPlayStream play(&s, SrsContextId());
 
     SrsRtcTrackDescription ds;
     SrsRtcVideoSendTrack* track = new SrsRtcVideoSendTrack(&s, &ds);
     SrsAutoFree(SrsRtcVideoSendTrack, track);
+    track->set_track_status(true);
 
-    // The RTP queue will free the packet.
+    // The RTP queue will free the packet, which is shared, with the sequence of player.
     if (true) {
         SrsRtpPacket* pkt = new SrsRtpPacket();
-        pkt->header.set_sequence(100);
-        track->rtp_queue_->set(pkt->header.get_sequence(), pkt);
+        pkt->header.set_sequence(10);
+
+        SrsRtpHeader header;
+        header.set_sequence(100);
+        HELPER_EXPECT_SUCCESS(track->on_nack(pkt, &header));
+        srs_rtp_packet_free(pkt);
     }
 
     // If sequence not match, packet not found.
@@ -745,6 +753,309 @@ VOID TEST(KernelRTCTest, NACKFetchRTPPacket)
     }
 }
 
+VOID TEST(KernelRTCTest, SharedRTPPacket)
+{
+    srs_error_t err;
+
+    SrsRtpPacket* pkt = new SrsRtpPacket();
+    pkt->header.set_ssrc(100);
+    pkt->header.set_sequence(1000);
+    pkt->header.set_timestamp(10000);
+
+    SrsRtpRawPayload* raw = new SrsRtpRawPayload();
+    raw->payload = (char*)"Hello";
+    raw->nn_payload = 5;
+    pkt->set_payload(raw, SrsRtspPacketPayloadTypeRaw);
+
+    // Share the packet with players, free it when the last one released.
+    SrsRtpPacket* p0 = pkt->share();
+    SrsRtpPacket* p1 = pkt->share();
+    EXPECT_TRUE(p0 == pkt && p1 == pkt);
+
+    srs_rtp_packet_free(pkt);
+    EXPECT_TRUE(pkt == NULL);
+    srs_rtp_packet_free(p0);
+    EXPECT_TRUE(p0 == NULL);
+
+    // Encode the shared packet with the header of player, which never changes the packet.
+    SrsRtpHeader header = p1->header;
+    header.set_ssrc(200);
+    header.set_sequence(2000);
+    header.set_timestamp(20000);
+
+    char buf[kRtpPacketSize];
+    SrsBuffer b(buf, sizeof(buf));
+    HELPER_EXPECT_SUCCESS(p1->encode(&b, &header));
+    EXPECT_EQ(kRtpHeaderFixedSize + 5, b.pos());
+
+    EXPECT_EQ(100, (int)p1->header.get_ssrc());
+    EXPECT_EQ(1000, p1->header.get_sequence());
+
+    SrsRtpPacket decoded;
+    SrsBuffer b2(buf, b.pos());
+    HELPER_EXPECT_SUCCESS(decoded.decode(&b2));
+    EXPECT_EQ(200, (int)decoded.header.get_ssrc());
+    EXPECT_EQ(2000, decoded.header.get_sequence());
+    EXPECT_EQ(20000, (int)decoded.header.get_timestamp());
+
+    srs_rtp_packet_free(p1);
+    EXPECT_TRUE(p1 == NULL);
+}
+
+VOID TEST(KernelRTCTest, RTPObjectPool)
+{
+    // Recycle the objects in freelist, until the pool is full.
+    if (true) {
+        SrsRtpObjectPool pool(64, 2);
+        void* p0 = pool.allocate(64);
+        void* p1 = pool.allocate(64);
+        void* p2 = pool.allocate(64);
+        pool.deallocate(p0, 64);
+        pool.deallocate(p1, 64);
+        pool.deallocate(p2, 64);
+        EXPECT_EQ(2, pool.size());
+
+        EXPECT_TRUE(pool.allocate(64) == p1);
+        EXPECT_EQ(1, pool.size());
+
+        // The object of other size is never pooled.
+        void* p3 = pool.allocate(128);
+        pool.deallocate(p3, 128);
+        EXPECT_EQ(1, pool.size());
+        pool.deallocate(p1, 64);
+    }
+
+    // Reset the packet when reused, and reuse the buffer.
+    if (true) {
+        SrsRtpPacket* pkt = new SrsRtpPacket();
+        pkt->header.set_sequence(100);
+        pkt->frame_type = SrsFrameTypeVideo;
+        pkt->set_avsync_time(1000);
+        pkt->set_payload(new SrsRtpRawPayload(), SrsRtspPacketPayloadTypeRaw);
+        char* buf = pkt->wrap(100);
+        srs_rtp_packet_free(pkt);
+
+        pkt = new SrsRtpPacket();
+        EXPECT_EQ(0, pkt->header.get_sequence());
+        EXPECT_EQ(SrsFrameTypeReserved, pkt->frame_type);
+        EXPECT_EQ(-1, pkt->get_avsync_time());
+        EXPECT_TRUE(pkt->payload() == NULL);
+        EXPECT_TRUE(pkt->wrap(200) == buf);
+
+        // The shared buffer is never recycled, until the last one freed.
+        SrsRtpPacket* cp = pkt->copy();
+        srs_rtp_packet_free(pkt);
+        pkt = new SrsRtpPacket();
+        EXPECT_TRUE(pkt->wrap(200) != buf);
+        srs_rtp_packet_free(pkt);
+
+        srs_rtp_packet_free(cp);
+        pkt = new SrsRtpPacket();
+        EXPECT_TRUE(pkt->wrap(200) == buf);
+        srs_rtp_packet_free(pkt);
+    }
+}
+
+SrsRtpPacket* mock_create_rtp_packet(SrsFrameType frame_type, SrsAvcNaluType nalu_type, uint16_t seq)
+{
+    SrsRtpPacket* pkt = new SrsRtpPacket();
+    pkt->header.set_sequence(seq);
+    pkt->frame_type = frame_type;
+    pkt->nalu_type = nalu_type;
+    return pkt;
+}
+
+VOID TEST(KernelRTCTest, RTPPacketRing)
+{
+    // Push and pop packets in FIFO order, with the ring wrapped.
+    if (true) {
+        SrsRtpPacketRing ring(3);
+        EXPECT_TRUE(ring.empty());
+        EXPECT_EQ(3, ring.capacity());
+        EXPECT_TRUE(ring.pop() == NULL);
+
+        for (uint16_t i = 0; i < 10; i++) {
+            ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, i));
+            ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, i + 100));
+            EXPECT_EQ(2, ring.size());
+
+            SrsRtpPacket* pkt = ring.pop();
+            EXPECT_EQ(i, pkt->header.get_sequence());
+            srs_rtp_packet_free(pkt);
+
+            pkt = ring.pop();
+            EXPECT_EQ(i + 100, pkt->header.get_sequence());
+            srs_rtp_packet_free(pkt);
+        }
+        EXPECT_TRUE(ring.empty());
+
+        // Free the packets in ring when destroy.
+        ring.push(mock_create_rtp_packet(SrsFrameTypeAudio, SrsAvcNaluTypeReserved, 0));
+    }
+
+    // Drop packets until the start of next keyframe.
+    if (true) {
+        SrsRtpPacketRing ring(6);
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeIDR, 0));
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeIDR, 1));
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 2));
+        ring.push(mock_create_rtp_packet(SrsFrameTypeAudio, SrsAvcNaluTypeReserved, 3));
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeIDR, 4));
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeIDR, 5));
+        EXPECT_TRUE(ring.full());
+
+        EXPECT_EQ(4, ring.drop_until_keyframe());
+        EXPECT_EQ(2, ring.size());
+
+        SrsRtpPacket* pkt = ring.pop();
+        EXPECT_EQ(4, pkt->header.get_sequence());
+        srs_rtp_packet_free(pkt);
+    }
+
+    // Drop all packets if no keyframe.
+    if (true) {
+        SrsRtpPacketRing ring(2);
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 0));
+        ring.push(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 1));
+        EXPECT_EQ(2, ring.drop_until_keyframe());
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+class MockRtcSourceChangeCallback : public ISrsRtcSourceChangeCallback
+{
+public:
+    int nn_overflows;
+public:
+    MockRtcSourceChangeCallback() {
+        nn_overflows = 0;
+    }
+    virtual ~MockRtcSourceChangeCallback() {
+    }
+public:
+    void on_stream_change(SrsRtcSourceDescription* desc) {
+    }
+    void on_queue_overflow() {
+        nn_overflows++;
+    }
+};
+
+VOID TEST(KernelRTCTest, RTCConsumerQueueOverflow)
+{
+    srs_error_t err;
+
+    SrsRtcSource source;
+    MockRtcSourceChangeCallback handler;
+
+    SrsRtcConsumer consumer(&source);
+    consumer.set_handler(&handler);
+    consumer.set_queue_size(2);
+    EXPECT_EQ(2, consumer.queue_size());
+
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 0)));
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 1)));
+    EXPECT_EQ(2, consumer.queue_depth());
+
+    // Overflow without keyframe, drop all and request keyframe.
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 2)));
+    EXPECT_EQ(1, handler.nn_overflows);
+    EXPECT_EQ(1, consumer.nn_overflows());
+    EXPECT_EQ(3, consumer.nn_dropped());
+    EXPECT_EQ(0, consumer.queue_depth());
+
+    // Never drop the audio packets, while waiting for keyframe.
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeAudio, SrsAvcNaluTypeReserved, 3)));
+    EXPECT_EQ(1, consumer.queue_depth());
+
+    // Restore when got the keyframe.
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeIDR, 4)));
+    EXPECT_EQ(2, consumer.queue_depth());
+    EXPECT_EQ(3, consumer.nn_dropped());
+
+    SrsRtpPacket* pkt = NULL;
+    HELPER_EXPECT_SUCCESS(consumer.dump_packet(&pkt));
+    EXPECT_EQ(3, pkt->header.get_sequence());
+    srs_rtp_packet_free(pkt);
+}
+
+VOID TEST(KernelRTCTest, RTCConsumerQueueOverflowAV1)
+{
+    srs_error_t err;
+
+    SrsRtcSource source;
+    if (true) {
+        SrsRtcSourceDescription desc;
+        SrsRtcTrackDescription* video = new SrsRtcTrackDescription();
+        video->type_ = "video";
+        video->media_ = new SrsVideoPayload(kVideoPayloadType, "AV1", 90000);
+        desc.video_track_descs_.push_back(video);
+        source.set_stream_desc(&desc);
+    }
+
+    SrsRtcConsumer consumer(&source);
+    consumer.set_queue_size(2);
+
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 0)));
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 1)));
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 2)));
+    EXPECT_EQ(1, consumer.nn_overflows());
+    EXPECT_EQ(2, consumer.nn_dropped());
+    EXPECT_EQ(1, consumer.queue_depth());
+
+    // Never wait for keyframe, because we can't parse the keyframe of AV1.
+    HELPER_EXPECT_SUCCESS(consumer.enqueue(mock_create_rtp_packet(SrsFrameTypeVideo, SrsAvcNaluTypeNonIDR, 3)));
+    EXPECT_EQ(2, consumer.queue_depth());
+    EXPECT_EQ(2, consumer.nn_dropped());
+}
+
+VOID TEST(KernelRTCTest, SRTPProfiles)
+{
+    srs_error_t err;
+
+    // Ignore the error, because it might be initialized.
+    srtp_init();
+
+    EXPECT_TRUE(srs_srtp_profile_supported(SrsSrtpProfileAes128CmSha1_80));
+    EXPECT_STREQ("AEAD_AES_128_GCM", srs_srtp_profile_string(SrsSrtpProfileAeadAes128Gcm).c_str());
+
+    // The key is master key and salt, and the size of auth tag depends on profile.
+    SrsSrtpProfile profiles[] = {SrsSrtpProfileAes128CmSha1_80, SrsSrtpProfileAeadAes128Gcm, SrsSrtpProfileAeadAes256Gcm};
+    int keys[] = {30, 28, 44};
+    int tags[] = {10, 16, 16};
+    for (int i = 0; i < 3; i++) {
+        SrsSrtpProfile profile = profiles[i];
+        if (!srs_srtp_profile_supported(profile)) {
+            continue;
+        }
+
+        string k0 = string(keys[i], 'a'), k1 = string(keys[i], 'b');
+        SrsSRTP sender, receiver;
+        HELPER_ASSERT_SUCCESS(sender.initialize(k0, k1, profile));
+        HELPER_ASSERT_SUCCESS(receiver.initialize(k1, k0, profile));
+
+        SrsRtpPacket pkt;
+        pkt.header.set_ssrc(100);
+        pkt.header.set_sequence(1);
+
+        SrsRtpRawPayload* raw = new SrsRtpRawPayload();
+        raw->payload = (char*)"Hello";
+        raw->nn_payload = 5;
+        pkt.set_payload(raw, SrsRtspPacketPayloadTypeRaw);
+
+        char buf[kRtpPacketSize];
+        SrsBuffer b(buf, sizeof(buf));
+        HELPER_ASSERT_SUCCESS(pkt.encode(&b));
+
+        int nn = b.pos();
+        HELPER_ASSERT_SUCCESS(sender.protect_rtp(buf, &nn));
+        EXPECT_EQ(kRtpHeaderFixedSize + 5 + tags[i], nn);
+
+        HELPER_ASSERT_SUCCESS(receiver.unprotect_rtp(buf, &nn));
+        EXPECT_EQ(kRtpHeaderFixedSize + 5, nn);
+        EXPECT_EQ(0, memcmp(buf + kRtpHeaderFixedSize, "Hello", 5));
+    }
+}
+
 VOID TEST(KernelRTCTest, NACKEncode)
 {
     uint32_t ssrc = 123;
@@ -9,6 +9,9 @@ using namespace std;
 
 #include <srs_kernel_error.hpp>
 #include <srs_app_listener.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_kernel_buffer.hpp>
+#include <arpa/inet.h>
 #include <srs_protocol_st.hpp>
 #include <srs_protocol_utility.hpp>
 
@@ -16,6 +19,8 @@ using namespace std;
 #include <srs_protocol_http_conn.hpp>
 #include <srs_protocol_rtmp_stack.hpp>
 #include <srs_core_autofree.hpp>
+#include <srs_kernel_kbps.hpp>
+#include <srs_core_performance.hpp>
 #include <srs_utest_protocol.hpp>
 #include <srs_utest_http.hpp>
 #include <srs_protocol_utility.hpp>
@@ -473,6 +478,165 @@ VOID TEST(TCPServerTest, WritevIOVC)
 	}
 }
 
+class MockZeroCopyPin : public ISrsZeroCopyPin
+{
+public:
+    bool* freed_;
+public:
+    MockZeroCopyPin(bool* freed) {
+        freed_ = freed;
+        *freed_ = false;
+    }
+    virtual ~MockZeroCopyPin() {
+        *freed_ = true;
+    }
+};
+
+extern SrsPps* _srs_pps_zcbytes;
+extern SrsPps* _srs_pps_zccopied;
+
+VOID TEST(TCPServerTest, WritevZeroCopy)
+{
+    srs_error_t err;
+
+    // Copy if not enabled, and free the pin immediately.
+    if (true) {
+        MockTcpHandler h;
+        SrsTcpListener l(&h);
+        l.set_endpoint(_srs_tmp_host, _srs_tmp_port);
+        HELPER_EXPECT_SUCCESS(l.listen());
+
+        SrsTcpClient c(_srs_tmp_host, _srs_tmp_port, _srs_tmp_timeout);
+        HELPER_EXPECT_SUCCESS(c.connect());
+
+        srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+        ASSERT_TRUE(h.fd != NULL);
+        SrsStSocket skt(h.fd);
+
+        bool freed = false;
+        iovec iovs[1];
+        iovs[0].iov_base = (void*)"Hello";
+        iovs[0].iov_len = 5;
+        ssize_t nn = 0;
+        HELPER_EXPECT_SUCCESS(skt.writev_zerocopy(iovs, 1, new MockZeroCopyPin(&freed), &nn));
+        EXPECT_EQ(5, nn);
+        EXPECT_TRUE(freed);
+
+        char buf[16] = {0};
+        HELPER_EXPECT_SUCCESS(c.read_fully(buf, 5, NULL));
+        EXPECT_STREQ(buf, "Hello");
+    }
+
+#ifdef __linux__
+    // Send by MSG_ZEROCOPY, and free the pin when completed.
+    if (true) {
+        MockTcpHandler h;
+        SrsTcpListener l(&h);
+        l.set_endpoint(_srs_tmp_host, _srs_tmp_port);
+        HELPER_EXPECT_SUCCESS(l.listen());
+
+        SrsTcpClient c(_srs_tmp_host, _srs_tmp_port, _srs_tmp_timeout);
+        HELPER_EXPECT_SUCCESS(c.connect());
+
+        srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+        ASSERT_TRUE(h.fd != NULL);
+        SrsStSocket skt(h.fd);
+        skt.set_recv_timeout(_srs_tmp_timeout);
+        HELPER_ASSERT_SUCCESS(skt.enable_zerocopy());
+
+        int64_t sent = _srs_pps_zcbytes->sugar + _srs_pps_zccopied->sugar;
+
+        // The small write is copied, and the pin is freed immediately.
+        bool freed = false;
+        char small[] = "Hello";
+        iovec iovs[2];
+        iovs[0].iov_base = small;
+        iovs[0].iov_len = 5;
+        HELPER_EXPECT_SUCCESS(skt.writev_zerocopy(iovs, 1, new MockZeroCopyPin(&freed), NULL));
+        EXPECT_TRUE(freed);
+
+        // The large write is pinned until completed, while the small header is copied.
+        int size = 2 * SRS_PERF_ZEROCOPY_MIN_BYTES;
+        char* payload = new char[size];
+        SrsAutoFreeA(char, payload);
+        memset(payload, 'x', size);
+
+        char header[] = "FLV";
+        iovs[0].iov_base = header;
+        iovs[0].iov_len = 3;
+        iovs[1].iov_base = payload;
+        iovs[1].iov_len = size;
+
+        ssize_t nn = 0;
+        HELPER_EXPECT_SUCCESS(skt.writev_zerocopy(iovs, 2, new MockZeroCopyPin(&freed), &nn));
+        EXPECT_EQ(3 + size, nn);
+        header[0] = 'X';
+
+        char* buf = new char[5 + 3 + size];
+        SrsAutoFreeA(char, buf);
+        HELPER_EXPECT_SUCCESS(c.read_fully(buf, 5 + 3 + size, NULL));
+        EXPECT_EQ(0, memcmp(buf, "HelloFLVxxx", 11));
+
+        // Reap the notification by read, after peer received all data.
+        HELPER_EXPECT_SUCCESS(c.write((void*)"!", 1, NULL));
+        HELPER_EXPECT_SUCCESS(skt.read(buf, 1, NULL));
+        for (int i = 0; i < 10 && !freed; i++) {
+            srs_usleep(10 * SRS_UTIME_MILLISECONDS);
+            HELPER_EXPECT_SUCCESS(skt.write((void*)"!", 1, NULL));
+        }
+        EXPECT_TRUE(freed);
+        EXPECT_GE(_srs_pps_zcbytes->sugar + _srs_pps_zccopied->sugar - sent, 5 + 3 + size);
+    }
+
+    // Keep the buffers after socket closed, until reaped.
+    if (true) {
+        MockTcpHandler h;
+        SrsTcpListener l(&h);
+        l.set_endpoint(_srs_tmp_host, _srs_tmp_port);
+        HELPER_EXPECT_SUCCESS(l.listen());
+
+        SrsTcpClient c(_srs_tmp_host, _srs_tmp_port, _srs_tmp_timeout);
+        HELPER_EXPECT_SUCCESS(c.connect());
+
+        srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+        ASSERT_TRUE(h.fd != NULL);
+
+        // Larger than the socket buffers, so the send timeout and the left data is pinned.
+        int size = 16 * 1024 * 1024;
+        char* payload = new char[size];
+        SrsAutoFreeA(char, payload);
+        memset(payload, 'x', size);
+
+        bool freed = false;
+        ssize_t nn = 0;
+        if (true) {
+            SrsStSocket skt(h.fd);
+            skt.set_send_timeout(100 * SRS_UTIME_MILLISECONDS);
+            HELPER_ASSERT_SUCCESS(skt.enable_zerocopy());
+
+            iovec iovs[1];
+            iovs[0].iov_base = payload;
+            iovs[0].iov_len = size;
+            HELPER_EXPECT_FAILED(skt.writev_zerocopy(iovs, 1, new MockZeroCopyPin(&freed), &nn));
+            EXPECT_GT(nn, 0);
+        }
+        EXPECT_FALSE(freed);
+        EXPECT_EQ(1, _srs_zerocopy_reaper->size());
+
+        // Peer still receives the data, and the buffers are freed when completed.
+        char* buf = new char[nn];
+        SrsAutoFreeA(char, buf);
+        HELPER_EXPECT_SUCCESS(c.read_fully(buf, nn, NULL));
+        for (int i = 0; i < 10 && !freed; i++) {
+            srs_usleep(10 * SRS_UTIME_MILLISECONDS);
+            _srs_zerocopy_reaper->reap();
+        }
+        EXPECT_TRUE(freed);
+        EXPECT_EQ(0, _srs_zerocopy_reaper->size());
+    }
+#endif
+}
+
 VOID TEST(HTTPServerTest, MessageConnection)
 {
     srs_error_t err;
@@ -918,6 +1082,141 @@ VOID TEST(TCPServerTest, UDPListen)
     }
 }
 
+VOID TEST(TCPServerTest, UDPRecvmmsg)
+{
+    srs_error_t err;
+
+    srs_netfd_t pfd = NULL;
+    HELPER_ASSERT_SUCCESS(srs_udp_listen("127.0.0.1", 1935, &pfd));
+
+    // Send some packets to the listener, by normal UDP socket.
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GT(fd, 0);
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(1935);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+    for (int i = 0; i < 5; i++) {
+        char buf[16];
+        int size = snprintf(buf, sizeof(buf), "Hello%d", i);
+        EXPECT_EQ(size, ::sendto(fd, buf, size, 0, (sockaddr*)&addr, sizeof(addr)));
+    }
+
+    // Receive all packets by one batch, which is larger than the packets.
+    if (true) {
+        SrsUdpMuxBatch batch(pfd, 8);
+        EXPECT_EQ(8, batch.size());
+
+#ifdef __linux__
+        EXPECT_EQ(5, batch.recvmmsg(1 * SRS_UTIME_SECONDS));
+        for (int i = 0; i < 5; i++) {
+            SrsUdpMuxSocket* skt = batch.at(i);
+            EXPECT_EQ(6, skt->size());
+            EXPECT_EQ(srs_fmt("Hello%d", i), string(skt->data(), skt->size()));
+            EXPECT_FALSE(skt->peer_id().empty());
+            EXPECT_STREQ("127.0.0.1", skt->get_peer_ip().c_str());
+            EXPECT_TRUE(skt->fast_id() != 0);
+        }
+#else
+        EXPECT_EQ(1, batch.recvmmsg(1 * SRS_UTIME_SECONDS));
+#endif
+    }
+
+    // Drop the health check packet of Aliyun SLB, which is ignored by size 0.
+    if (true) {
+        SrsUdpMuxBatch batch(pfd, 2);
+
+        const char* hc = "Healthcheck udp check";
+        EXPECT_EQ(21, ::sendto(fd, hc, 21, 0, (sockaddr*)&addr, sizeof(addr)));
+
+#ifdef __linux__
+        EXPECT_EQ(1, batch.recvmmsg(1 * SRS_UTIME_SECONDS));
+        EXPECT_EQ(0, batch.at(0)->size());
+#endif
+    }
+
+    ::close(fd);
+    srs_close_stfd(pfd);
+}
+
+VOID TEST(TCPServerTest, UDPSendmmsg)
+{
+    srs_error_t err;
+
+    srs_netfd_t pfd = NULL;
+    HELPER_ASSERT_SUCCESS(srs_udp_listen("127.0.0.1", 1935, &pfd));
+
+    // The peer is a normal UDP socket, which sends a packet to server to setup the address.
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GT(fd, 0);
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(1935);
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    EXPECT_EQ(5, ::sendto(fd, "Hello", 5, 0, (sockaddr*)&addr, sizeof(addr)));
+
+    SrsUdpMuxSocket skt(pfd);
+    EXPECT_EQ(5, skt.recvfrom(1 * SRS_UTIME_SECONDS));
+
+    // Send packets in different size by sendmmsg, and flush when full.
+    if (true) {
+        SrsUdpMuxSendBatch batch(4, 1500);
+        EXPECT_TRUE(batch.empty());
+
+        for (int i = 0; i < 4; i++) {
+            iovec* iov = NULL; SrsBuffer* buf = NULL;
+            batch.fetch(&iov, &buf);
+            buf->write_string(srs_fmt("Hello%d", i * 10));
+            iov->iov_len = buf->pos();
+            batch.commit();
+        }
+        EXPECT_TRUE(batch.full());
+        EXPECT_EQ(4, batch.nn_packets());
+        EXPECT_EQ(6 + 7 * 3, batch.nn_bytes());
+
+        HELPER_EXPECT_SUCCESS(batch.flush(&skt, 1 * SRS_UTIME_SECONDS));
+        EXPECT_TRUE(batch.empty());
+        EXPECT_EQ(0, batch.nn_bytes());
+
+        for (int i = 0; i < 4; i++) {
+            char buf[1500];
+            int nn = (int)::recv(fd, buf, sizeof(buf), 0);
+            EXPECT_EQ(srs_fmt("Hello%d", i * 10), string(buf, nn));
+        }
+    }
+
+    // Send packets in the same size by GSO, except the last one, which fallbacks to sendmmsg if not supported.
+    if (true) {
+        SrsUdpMuxSendBatch batch(8, 1500);
+        batch.set_gso(true);
+
+        for (int i = 0; i < 3; i++) {
+            iovec* iov = NULL; SrsBuffer* buf = NULL;
+            batch.fetch(&iov, &buf);
+            buf->write_string(i < 2 ? srs_fmt("World%d", i) : "End");
+            iov->iov_len = buf->pos();
+            batch.commit();
+        }
+        EXPECT_FALSE(batch.full());
+        HELPER_EXPECT_SUCCESS(batch.flush(&skt, 1 * SRS_UTIME_SECONDS));
+
+        const char* expects[] = {"World0", "World1", "End"};
+        for (int i = 0; i < 3; i++) {
+            char buf[1500];
+            int nn = (int)::recv(fd, buf, sizeof(buf), 0);
+            EXPECT_STREQ(expects[i], string(buf, nn).c_str());
+        }
+    }
+
+    ::close(fd);
+    srs_close_stfd(pfd);
+}
+
 class MockOnCycleThread : public ISrsCoroutineHandler
 {
 public: